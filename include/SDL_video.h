@@ -202,6 +202,8 @@ typedef struct SDL_VideoInfo {
 #define SDL_YUY2_OVERLAY  0x32595559	/**< Packed mode: Y0+U0+Y1+V0 (1 plane) */
 #define SDL_UYVY_OVERLAY  0x59565955	/**< Packed mode: U0+Y0+V0+Y1 (1 plane) */
 #define SDL_YVYU_OVERLAY  0x55595659	/**< Packed mode: Y0+V0+Y1+U0 (1 plane) */
+#define SDL_NV12_OVERLAY  0x3231564E	/**< Planar mode: Y + U/V interleaved (2 planes) */
+#define SDL_NV21_OVERLAY  0x3132564E	/**< Planar mode: Y + V/U interleaved (2 planes) */
 /*@}*/
 
 /** The YUV hardware video overlay */
@@ -580,6 +582,19 @@ extern DECLSPEC void SDLCALL SDL_FreeSurface(SDL_Surface *surface);
 extern DECLSPEC int SDLCALL SDL_LockSurface(SDL_Surface *surface);
 extern DECLSPEC void SDLCALL SDL_UnlockSurface(SDL_Surface *surface);
 
+/**
+ * SDL_LockSurfaceReadOnly() is SDL_LockSurface() for when the pixels are
+ * only read, and is unlocked with SDL_UnlockSurface() in the same way.
+ * An RLE accelerated surface is then decoded but keeps its encoding, so
+ * it isn't encoded again when it is unlocked, and the decoded pixels are
+ * kept for the next time it is locked.  If it is locked for writing while
+ * it is locked for reading, it is encoded again when it is unlocked.
+ *
+ * SDL_LockSurfaceReadOnly() returns 0, or -1 if the surface couldn't be
+ * locked.
+ */
+extern DECLSPEC int SDLCALL SDL_LockSurfaceReadOnly(SDL_Surface *surface);
+
 /**
  * Load a surface from a seekable SDL data source (memory or file.)
  * If 'freesrc' is non-zero, the source will be closed after being read.
@@ -755,6 +770,113 @@ extern DECLSPEC int SDLCALL SDL_LowerBlit
 			(SDL_Surface *src, SDL_Rect *srcrect,
 			 SDL_Surface *dst, SDL_Rect *dstrect);
 
+/** Blit a batch sorted by destination row, which changes the order in
+ *  which overlapping blits are drawn
+ */
+#define SDL_BLITBATCH_SORT	0x00000001
+
+/**
+ * This function performs 'n' blits from 'src' to 'dst', as if by calling
+ * SDL_BlitSurface(src, &srcrects[i], dst, &dstpoints[i]) for each one,
+ * but checks the surfaces, locks them and picks the blitter only once.
+ * It is meant for many small blits, like tiles or particles.
+ * If 'srcrects' is NULL, the whole source surface is blitted each time.
+ * Only the x and y of 'dstpoints' are used, and they are not changed.
+ * 'flags' may be SDL_BLITBATCH_SORT, to blit in order of destination rows.
+ * This function returns 0 if the blits are successful, or -1 on error.
+ */
+extern DECLSPEC int SDLCALL SDL_BlitSurfaceBatch
+			(SDL_Surface *src, SDL_Rect *srcrects,
+			 SDL_Surface *dst, SDL_Rect *dstpoints,
+			 int n, Uint32 flags);
+
+/**
+ * Large software blits, and the conversion of large software YUV overlays,
+ * are split into bands done by several threads.
+ * This sets how many threads are used, 1 to blit on the calling thread
+ * only, or 0 for one per CPU.  The default comes from the SDL_BLIT_THREADS
+ * environment variable, or is one per CPU.  Blits smaller than
+ * SDL_BLIT_THREAD_MIN pixels (256x256 by default) always run on the
+ * calling thread.  It may be called while other threads are blitting,
+ * blits already split keep going with the old count.
+ * This function returns the number of threads that will be used.
+ */
+extern DECLSPEC int SDLCALL SDL_SetBlitThreads(int threads);
+
+/**
+ * This function returns the name of the blitter SDL_BlitSurface() will use
+ * from 'src' to 'dst', e.g. "BlitRGBtoRGBPixelAlphaSSE2", or "hardware" or
+ * "RLE", or NULL on error.  The blitters are picked from the features of
+ * the CPU, which the SDL_BLIT_FEATURES environment variable can limit to
+ * one of "c", "mmx", "3dnow", "sse", "sse2", "sse3", "ssse3", "neon" or
+ * "altivec".
+ */
+extern DECLSPEC const char * SDLCALL SDL_GetBlitName
+			(SDL_Surface *src, SDL_Surface *dst);
+
+/** Software blit counters for one blitter between two pixel formats */
+typedef struct SDL_BlitStats {
+	const char *name;	/**< As from SDL_GetBlitName(), or "FillRect" */
+	Uint8  src_bpp;		/**< 0 for fills, which have no source */
+	Uint32 src_Rmask, src_Gmask, src_Bmask, src_Amask;
+	Uint8  dst_bpp;
+	Uint32 dst_Rmask, dst_Gmask, dst_Bmask, dst_Amask;
+	Uint32 calls;
+	Uint64 pixels;
+	Uint64 bytes;		/**< Source and destination pixels */
+	Uint64 nanoseconds;
+} SDL_BlitStats;
+
+/**
+ * Enable or disable counting the software blits and fills.
+ * Counting is off by default, unless the SDL_BLIT_STATS environment
+ * variable is set to 1, in which case the counters are also printed to
+ * stderr by SDL_Quit().  It costs a lock and a lookup on every blit.
+ *
+ * @param[in] enable
+ * If 'enable' is 1, counting is enabled.
+ * If 'enable' is 0, counting is disabled.
+ * If 'enable' is -1, the counting state is not changed.
+ *
+ * @return It returns the previous state of counting.
+ */
+extern DECLSPEC int SDLCALL SDL_EnableBlitStats(int enable);
+
+/**
+ * Copy up to 'maxstats' counters into 'stats', which may be NULL.
+ * This function returns the number of counters there are.
+ */
+extern DECLSPEC int SDLCALL SDL_GetBlitStats(SDL_BlitStats *stats,
+					     int maxstats);
+
+/** Clear all the blit counters */
+extern DECLSPEC void SDLCALL SDL_ResetBlitStats(void);
+
+/**
+ * Counters for the RLE encoding of surfaces blitted with SDL_RLEACCEL.
+ * Surfaces are encoded by their first blit, or in the background from
+ * a copy of their pixels if they have at least 64x64, and then blitted
+ * without RLE until the encoding is ready.  Set SDL_RLE_ASYNC to 0 to
+ * encode them all by the first blit.  Surfaces with short runs, or few
+ * transparent or opaque pixels, are not encoded unless
+ * SDL_RLE_HEURISTIC is set to 0.
+ */
+typedef struct SDL_RLEStats {
+	Uint32 encoded;		/**< Encodings made and used */
+	Uint32 skipped;		/**< Surfaces not worth encoding */
+	Uint32 discarded;	/**< Background encodings thrown away */
+	Uint64 bytes;		/**< Size of the encodings used */
+	Uint64 nanoseconds;	/**< Spent encoding, in any thread */
+	Uint32 rle_blits;	/**< Blits using an encoding */
+	Uint32 plain_blits;	/**< Blits asking for one, without it */
+} SDL_RLEStats;
+
+/** Copy the RLE counters into 'stats' */
+extern DECLSPEC void SDLCALL SDL_GetRLEStats(SDL_RLEStats *stats);
+
+/** Clear the RLE counters */
+extern DECLSPEC void SDLCALL SDL_ResetRLEStats(void);
+
 /**
  * This function performs a fast fill of the given rectangle with 'color'
  * The given rectangle is clipped to the destination surface clip area
@@ -941,6 +1063,28 @@ extern DECLSPEC SDL_GrabMode SDLCALL SDL_WM_GrabInput(SDL_GrabMode mode);
 /** @internal Not in public API at the moment - do not use! */
 extern DECLSPEC int SDLCALL SDL_SoftStretch(SDL_Surface *src, SDL_Rect *srcrect,
                                     SDL_Surface *dst, SDL_Rect *dstrect);
+
+/** @name Stretch filters for SDL_SoftStretchFilter() */
+/*@{*/
+#define SDL_STRETCH_NEAREST	0	/**< Nearest pixel */
+#define SDL_STRETCH_BILINEAR	1	/**< Blend the 4 nearest pixels */
+#define SDL_STRETCH_INTEGER	2	/**< Largest whole factor, centred */
+/*@}*/
+
+/**
+ * This function stretches 'srcrect' of 'src' to 'dstrect' of 'dst',
+ * converting between the pixel formats of the surfaces.
+ * If 'srcrect' or 'dstrect' is NULL, the whole surface is used.
+ * A color key or alpha on the source is blended like SDL_BlitSurface()
+ * would, but the rectangles must be inside the surfaces, they are not
+ * clipped.  SDL_STRETCH_INTEGER leaves the destination around the scaled
+ * image alone, and falls back to SDL_STRETCH_NEAREST if the source is
+ * larger than the destination.
+ * This function returns 0 if the stretch is successful, or -1 on error.
+ */
+extern DECLSPEC int SDLCALL SDL_SoftStretchFilter
+			(SDL_Surface *src, SDL_Rect *srcrect,
+			 SDL_Surface *dst, SDL_Rect *dstrect, int filter);
                     
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
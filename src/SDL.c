@@ -27,6 +27,9 @@
 #include "SDL_fatal.h"
 #if !SDL_VIDEO_DISABLED
 #include "video/SDL_leaks.h"
+extern void SDL_QuitBlitThreads(void);
+extern void SDL_QuitRLEThread(void);
+extern void SDL_QuitBlitStats(void);
 #endif
 
 #if SDL_THREAD_PTH
@@ -236,6 +239,15 @@ void SDL_Quit(void)
   printf("[SDL_Quit] : SDL_UninstallParachute()\n"); fflush(stdout);
 #endif
 
+#if !SDL_VIDEO_DISABLED
+	/* Stop the threads used for large blits and RLE encoding */
+	SDL_QuitBlitThreads();
+	SDL_QuitRLEThread();
+
+	/* Print the blit counters, if asked for */
+	SDL_QuitBlitStats();
+#endif
+
 	/* Uninstall any parachute signal handlers */
 	SDL_UninstallParachute();
 
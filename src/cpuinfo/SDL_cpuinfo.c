@@ -31,6 +31,12 @@
 #elif SDL_ALTIVEC_BLITTERS && HAVE_SETJMP
 #include <signal.h>
 #include <setjmp.h>
+#elif defined(__linux__) && defined(__arm__)
+#include <fcntl.h>	/* For NEON check */
+#include <unistd.h>
+#endif
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>	/* For __cpuid() */
 #endif
 
 #define CPU_HAS_RDTSC	0x00000001
@@ -41,6 +47,11 @@
 #define CPU_HAS_SSE	0x00000040
 #define CPU_HAS_SSE2	0x00000080
 #define CPU_HAS_ALTIVEC	0x00000100
+#define CPU_HAS_SSE3	0x00000200
+#define CPU_HAS_SSSE3	0x00000400
+#define CPU_HAS_SSE41	0x00000800
+#define CPU_HAS_AVX2	0x00001000
+#define CPU_HAS_NEON	0x00002000
 
 #if SDL_ALTIVEC_BLITTERS && HAVE_SETJMP && !__MACOSX__
 /* This is the brute force way of detecting instruction sets...
@@ -139,6 +150,8 @@ done:
 "       movl    $1,-8(%rbp)    \n"
 "1:                            \n"
 	);
+#elif defined(_MSC_VER) && defined(_M_X64)
+	has_CPUID = 1;
 #endif
 	return has_CPUID;
 }
@@ -209,6 +222,13 @@ done:
 #endif
 "1:                                \n"
 "        movl    %edi,%ebx\n" );
+#elif defined(_MSC_VER) && defined(_M_X64)
+	int regs[4];
+	__cpuid(regs, 0);
+	if ( regs[0] >= 1 ) {
+		__cpuid(regs, 1);
+		features = regs[3];
+	}
 #endif
 	return features;
 }
@@ -276,10 +296,94 @@ done:
 "1:                               \n"
 "        movl    %edi,%ebx\n"
 	    );
+#elif defined(_MSC_VER) && defined(_M_X64)
+	int regs[4];
+	__cpuid(regs, 0x80000000);
+	if ( (unsigned int)regs[0] >= 0x80000001 ) {
+		__cpuid(regs, 0x80000001);
+		features = regs[3];
+	}
 #endif
 	return features;
 }
 
+/* The eax, ebx, ecx and edx registers of CPUID function 'func' with
+   sub-function 0, or zeros if this compiler can't ask for them */
+static __inline__ void CPU_getCPUID(Uint32 func, Uint32 regs[4])
+{
+	regs[0] = regs[1] = regs[2] = regs[3] = 0;
+	if ( !CPU_haveCPUID() ) {
+		return;
+	}
+#if defined(__GNUC__) && defined(i386)
+	__asm__ (
+"        movl    %%ebx,%%edi                                           \n"
+"        cpuid                                                         \n"
+"        xchgl   %%ebx,%%edi                                           \n"
+	: "=a" (regs[0]), "=D" (regs[1]), "=c" (regs[2]), "=d" (regs[3])
+	: "a" (func), "c" (0)
+	);
+#elif defined(__GNUC__) && defined(__x86_64__)
+	__asm__ (
+"        movq    %%rbx,%%rdi                                           \n"
+"        cpuid                                                         \n"
+"        xchgq   %%rbx,%%rdi                                           \n"
+	: "=a" (regs[0]), "=D" (regs[1]), "=c" (regs[2]), "=d" (regs[3])
+	: "a" (func), "c" (0)
+	);
+#elif (defined(_MSC_VER) && defined(_M_IX86)) || defined(__WATCOMC__)
+	{
+		Uint32 a, b, c, d;
+		__asm {
+        mov     eax, func
+        xor     ecx, ecx
+        cpuid
+        mov     a, eax
+        mov     b, ebx
+        mov     c, ecx
+        mov     d, edx
+		}
+		regs[0] = a;
+		regs[1] = b;
+		regs[2] = c;
+		regs[3] = d;
+	}
+#elif defined(_MSC_VER) && defined(_M_X64) && (_MSC_VER >= 1600)
+	__cpuidex((int *)regs, func, 0);
+#endif
+}
+
+/* Whether the OS saves the SSE and AVX registers on context switches */
+static __inline__ int CPU_OSSavesYMM(void)
+{
+	Uint32 regs[4];
+	Uint32 xcr0 = 0;
+
+	CPU_getCPUID(1, regs);
+	if ( !(regs[2] & 0x08000000) ) {	/* OSXSAVE */
+		return 0;
+	}
+#if defined(__GNUC__) && (defined(i386) || defined(__x86_64__))
+	__asm__ (
+"        .byte   0x0f, 0x01, 0xd0    # xgetbv                          \n"
+	: "=a" (xcr0)
+	: "c" (0)
+	: "%edx"
+	);
+#elif defined(_MSC_VER) && defined(_M_IX86)
+	__asm {
+        xor     ecx, ecx
+        _emit   0x0f
+        _emit   0x01
+        _emit   0xd0                ; xgetbv
+        mov     xcr0, eax
+	}
+#elif defined(_MSC_VER) && defined(_M_X64) && (_MSC_VER >= 1600)
+	xcr0 = (Uint32)_xgetbv(0);
+#endif
+	return ((xcr0 & 0x6) == 0x6);
+}
+
 static __inline__ int CPU_haveRDTSC(void)
 {
 	if ( CPU_haveCPUID() ) {
@@ -336,6 +440,62 @@ static __inline__ int CPU_haveSSE2(void)
 	return 0;
 }
 
+static __inline__ int CPU_haveSSE3(void)
+{
+	Uint32 regs[4];
+	CPU_getCPUID(1, regs);
+	return (regs[2] & 0x00000001);
+}
+
+static __inline__ int CPU_haveSSSE3(void)
+{
+	Uint32 regs[4];
+	CPU_getCPUID(1, regs);
+	return (regs[2] & 0x00000200);
+}
+
+static __inline__ int CPU_haveSSE41(void)
+{
+	Uint32 regs[4];
+	CPU_getCPUID(1, regs);
+	return (regs[2] & 0x00080000);
+}
+
+static __inline__ int CPU_haveAVX2(void)
+{
+	Uint32 regs[4];
+	CPU_getCPUID(0, regs);
+	if ( regs[0] < 7 || !CPU_OSSavesYMM() ) {
+		return 0;
+	}
+	CPU_getCPUID(7, regs);
+	return (regs[1] & 0x00000020);
+}
+
+static __inline__ int CPU_haveNEON(void)
+{
+	int neon = 0;
+#if defined(__aarch64__) || defined(_M_ARM64) || \
+    defined(__ARM_NEON__) || defined(__ARM_NEON)
+	/* Part of ARMv8, or the compiler was told it's there */
+	neon = 1;
+#elif defined(__linux__) && defined(__arm__)
+	/* Look for HWCAP_NEON in the auxiliary vector */
+	int fd = open("/proc/self/auxv", O_RDONLY);
+	if ( fd >= 0 ) {
+		Uint32 aux[2];
+		while ( read(fd, aux, sizeof(aux)) == sizeof(aux) && aux[0] ) {
+			if ( aux[0] == 16 ) {	/* AT_HWCAP */
+				neon = ((aux[1] & (1 << 12)) != 0);
+				break;
+			}
+		}
+		close(fd);
+	}
+#endif
+	return neon;
+}
+
 static __inline__ int CPU_haveAltiVec(void)
 {
 	volatile int altivec = 0;
@@ -388,9 +548,24 @@ static Uint32 SDL_GetCPUFeatures(void)
 		if ( CPU_haveSSE2() ) {
 			SDL_CPUFeatures |= CPU_HAS_SSE2;
 		}
+		if ( CPU_haveSSE3() ) {
+			SDL_CPUFeatures |= CPU_HAS_SSE3;
+		}
+		if ( CPU_haveSSSE3() ) {
+			SDL_CPUFeatures |= CPU_HAS_SSSE3;
+		}
+		if ( CPU_haveSSE41() ) {
+			SDL_CPUFeatures |= CPU_HAS_SSE41;
+		}
+		if ( CPU_haveAVX2() ) {
+			SDL_CPUFeatures |= CPU_HAS_AVX2;
+		}
 		if ( CPU_haveAltiVec() ) {
 			SDL_CPUFeatures |= CPU_HAS_ALTIVEC;
 		}
+		if ( CPU_haveNEON() ) {
+			SDL_CPUFeatures |= CPU_HAS_NEON;
+		}
 	}
 	return SDL_CPUFeatures;
 }
@@ -451,6 +626,38 @@ SDL_bool SDL_HasSSE2(void)
 	return SDL_FALSE;
 }
 
+SDL_bool SDL_HasSSE3(void)
+{
+	if ( SDL_GetCPUFeatures() & CPU_HAS_SSE3 ) {
+		return SDL_TRUE;
+	}
+	return SDL_FALSE;
+}
+
+SDL_bool SDL_HasSSSE3(void)
+{
+	if ( SDL_GetCPUFeatures() & CPU_HAS_SSSE3 ) {
+		return SDL_TRUE;
+	}
+	return SDL_FALSE;
+}
+
+SDL_bool SDL_HasSSE41(void)
+{
+	if ( SDL_GetCPUFeatures() & CPU_HAS_SSE41 ) {
+		return SDL_TRUE;
+	}
+	return SDL_FALSE;
+}
+
+SDL_bool SDL_HasAVX2(void)
+{
+	if ( SDL_GetCPUFeatures() & CPU_HAS_AVX2 ) {
+		return SDL_TRUE;
+	}
+	return SDL_FALSE;
+}
+
 SDL_bool SDL_HasAltiVec(void)
 {
 	if ( SDL_GetCPUFeatures() & CPU_HAS_ALTIVEC ) {
@@ -459,6 +666,14 @@ SDL_bool SDL_HasAltiVec(void)
 	return SDL_FALSE;
 }
 
+SDL_bool SDL_HasNEON(void)
+{
+	if ( SDL_GetCPUFeatures() & CPU_HAS_NEON ) {
+		return SDL_TRUE;
+	}
+	return SDL_FALSE;
+}
+
 #ifdef TEST_MAIN
 
 #include <stdio.h>
@@ -472,7 +687,12 @@ int main()
 	printf("3DNowExt: %d\n", SDL_Has3DNowExt());
 	printf("SSE: %d\n", SDL_HasSSE());
 	printf("SSE2: %d\n", SDL_HasSSE2());
+	printf("SSE3: %d\n", SDL_HasSSE3());
+	printf("SSSE3: %d\n", SDL_HasSSSE3());
+	printf("SSE4.1: %d\n", SDL_HasSSE41());
+	printf("AVX2: %d\n", SDL_HasAVX2());
 	printf("AltiVec: %d\n", SDL_HasAltiVec());
+	printf("NEON: %d\n", SDL_HasNEON());
 	return 0;
 }
 
@@ -76,6 +76,23 @@ void SDL_Unlock_EventThread(void)
 	}
 }
 
+/* Hold the event queue across several of the SDL_Private*() calls, so
+   drivers can queue a batch of input while taking the lock only once.
+   The queue mutex is recursive, so the calls themselves still lock it.
+*/
+void SDL_LockEventQueue(void)
+{
+	if ( SDL_EventQ.lock ) {
+		SDL_mutexP(SDL_EventQ.lock);
+	}
+}
+void SDL_UnlockEventQueue(void)
+{
+	if ( SDL_EventQ.lock ) {
+		SDL_mutexV(SDL_EventQ.lock);
+	}
+}
+
 #ifdef __OS2__
 /*
  * We'll increase the priority of GobbleEvents thread, so it will process
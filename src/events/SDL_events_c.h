@@ -33,6 +33,10 @@ extern void SDL_Lock_EventThread(void);
 extern void SDL_Unlock_EventThread(void);
 extern Uint32 SDL_EventThreadID(void);
 
+/* Batch several events under one lock of the event queue */
+extern void SDL_LockEventQueue(void);
+extern void SDL_UnlockEventQueue(void);
+
 /* Event handler init routines */
 extern int  SDL_AppActiveInit(void);
 extern int  SDL_KeyboardInit(void);
@@ -87,6 +87,8 @@
  */
 
 #include "SDL_video.h"
+#include "SDL_thread.h"
+#include "SDL_mutex.h"
 #include "SDL_sysvideo.h"
 #include "SDL_blit.h"
 #include "SDL_RLEaccel_c.h"
@@ -97,7 +99,7 @@
 
 #ifdef MMX_ASMBLIT
 #include "mmx.h"
-#include "SDL_cpuinfo.h"
+#define RLE_HAS_MMX	(SDL_GetBlitFeatures() & SDL_BLIT_MMX)
 #endif
 
 #ifndef MAX
@@ -107,10 +109,16 @@
 #define MIN(a, b) ((a) < (b) ? (a) : (b))
 #endif
 
+/* Short 32bpp runs are copied a pixel at a time, as that is cheaper
+   than a call to memcpy */
 #define PIXEL_COPY(to, from, len, bpp)			\
 do {							\
-    if(bpp == 4) {					\
-	SDL_memcpy4(to, from, (size_t)(len));		\
+    if(bpp == 4 && (len) < 8) {				\
+	Uint32 *to_ = (Uint32 *)(to);			\
+	const Uint32 *from_ = (const Uint32 *)(from);	\
+	unsigned n_ = (unsigned)(len);			\
+	while(n_--)					\
+	    *to_++ = *from_++;				\
     } else {						\
 	SDL_memcpy(to, from, (size_t)(len) * (bpp));	\
     }							\
@@ -643,7 +651,7 @@ do {							\
 			if(alpha == 128)				\
 			    blitter(2, Uint8, ALPHA_BLIT16_565_50);	\
 			else {						\
-			    if(SDL_HasMMX())				\
+			    if(RLE_HAS_MMX)				\
 				blitter(2, Uint8, ALPHA_BLIT16_565MMX);	\
 			    else					\
 				blitter(2, Uint8, ALPHA_BLIT16_565);	\
@@ -659,7 +667,7 @@ do {							\
 			if(alpha == 128)				\
 			    blitter(2, Uint8, ALPHA_BLIT16_555_50);	\
 			else {						\
-			    if(SDL_HasMMX())				\
+			    if(RLE_HAS_MMX)				\
 				blitter(2, Uint8, ALPHA_BLIT16_555MMX);	\
 			    else					\
 				blitter(2, Uint8, ALPHA_BLIT16_555);	\
@@ -684,14 +692,14 @@ do {							\
 		       || fmt->Bmask == 0xff00)) {			\
 		    if(alpha == 128)					\
 		    {							\
-			if(SDL_HasMMX())				\
+			if(RLE_HAS_MMX)					\
 				blitter(4, Uint16, ALPHA_BLIT32_888_50MMX);\
 			else						\
 				blitter(4, Uint16, ALPHA_BLIT32_888_50);\
 		    }							\
 		    else						\
 		    {							\
-			if(SDL_HasMMX())				\
+			if(RLE_HAS_MMX)					\
 				blitter(4, Uint16, ALPHA_BLIT32_888MMX);\
 			else						\
 				blitter(4, Uint16, ALPHA_BLIT32_888);	\
@@ -844,6 +852,7 @@ int SDL_RLEBlit(SDL_Surface *src, SDL_Rect *srcrect,
 	int x, y;
 	int w = src->w;
 	unsigned alpha;
+	SDL_BlitTime start = 0;
 
 	/* Lock the destination if necessary */
 	if ( SDL_MUSTLOCK(dst) ) {
@@ -851,6 +860,9 @@ int SDL_RLEBlit(SDL_Surface *src, SDL_Rect *srcrect,
 			return(-1);
 		}
 	}
+	if ( SDL_blit_stats ) {
+		start = SDL_StartBlitStats();
+	}
 
 	/* Set up the source and destination pointers */
 	x = dstrect->x;
@@ -933,6 +945,10 @@ int SDL_RLEBlit(SDL_Surface *src, SDL_Rect *srcrect,
 	}
 
 done:
+	if ( SDL_blit_stats ) {
+		SDL_AddBlitStats("RLE", src->format, dst->format,
+		                 srcrect->w, srcrect->h, start);
+	}
 	/* Unlock the destination if necessary */
 	if ( SDL_MUSTLOCK(dst) ) {
 		SDL_UnlockSurface(dst);
@@ -993,6 +1009,111 @@ done:
 	dst = (Uint16)(d | d >> 16);			\
     } while(0)
 
+/* Blend a translucent run of n pixels, a pixel at a time */
+#define BLEND_SPAN_565(dst, src, n)			\
+    do {						\
+	unsigned i_;					\
+	for(i_ = 0; i_ < (unsigned)(n); i_++)		\
+	    BLIT_TRANSL_565((src)[i_], (dst)[i_]);	\
+    } while(0)
+
+#define BLEND_SPAN_555(dst, src, n)			\
+    do {						\
+	unsigned i_;					\
+	for(i_ = 0; i_ < (unsigned)(n); i_++)		\
+	    BLIT_TRANSL_555((src)[i_], (dst)[i_]);	\
+    } while(0)
+
+/* Blend a translucent run onto a 32bpp destination */
+typedef void (*RLEBlendSpan)(Uint32 *dst, const Uint32 *src, unsigned n);
+
+static void BlendSpan888(Uint32 *dst, const Uint32 *src, unsigned n)
+{
+    unsigned i;
+    for(i = 0; i < n; i++)
+	BLIT_TRANSL_888(src[i], dst[i]);
+}
+
+#if SSE2_BLITTERS
+SDL_BEGIN_SSE2
+
+/* d + (s - d) * alpha / 256 in each channel of two pixels widened to 16
+   bits, like BLIT_TRANSL_888 */
+static __inline__ __m128i BlendSpanSSE2(__m128i s, __m128i d)
+{
+    __m128i alpha = _mm_shufflelo_epi16(s, _MM_SHUFFLE(3, 3, 3, 3));
+    alpha = _mm_shufflehi_epi16(alpha, _MM_SHUFFLE(3, 3, 3, 3));
+    return _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(s, alpha),
+		_mm_mullo_epi16(d, _mm_sub_epi16(_mm_set1_epi16(256), alpha))),
+		8);
+}
+
+static void BlendSpan888SSE2(Uint32 *dst, const Uint32 *src, unsigned n)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00ffffff);
+    unsigned i;
+
+    for(i = 0; i + 4 <= n; i += 4) {
+	__m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+	__m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+	__m128i lo = BlendSpanSSE2(_mm_unpacklo_epi8(s, zero),
+				   _mm_unpacklo_epi8(d, zero));
+	__m128i hi = BlendSpanSSE2(_mm_unpackhi_epi8(s, zero),
+				   _mm_unpackhi_epi8(d, zero));
+	_mm_storeu_si128((__m128i *)(dst + i),
+			 _mm_and_si128(_mm_packus_epi16(lo, hi), rgbmask));
+    }
+    BlendSpan888(dst + i, src + i, n - i);
+}
+
+SDL_END_TARGET
+#endif /* SSE2_BLITTERS */
+
+#if NEON_BLITTERS
+SDL_BEGIN_NEON
+
+/* d + (s - d) * alpha / 256, like BLIT_TRANSL_888 */
+static __inline__ uint8x8_t BlendSpanNEON(uint8x8_t s, uint8x8_t d,
+					  uint16x8_t alpha)
+{
+    uint16x8_t inv = vsubq_u16(vdupq_n_u16(256), alpha);
+    return vshrn_n_u16(vmlaq_u16(vmulq_u16(vmovl_u8(s), alpha),
+				 vmovl_u8(d), inv), 8);
+}
+
+static void BlendSpan888NEON(Uint32 *dst, const Uint32 *src, unsigned n)
+{
+    unsigned i;
+
+    for(i = 0; i + 8 <= n; i += 8) {
+	uint8x8x4_t s = vld4_u8((const uint8_t *)(src + i));
+	uint8x8x4_t d = vld4_u8((const uint8_t *)(dst + i));
+	uint16x8_t alpha = vmovl_u8(s.val[3]);
+	d.val[0] = BlendSpanNEON(s.val[0], d.val[0], alpha);
+	d.val[1] = BlendSpanNEON(s.val[1], d.val[1], alpha);
+	d.val[2] = BlendSpanNEON(s.val[2], d.val[2], alpha);
+	d.val[3] = vdup_n_u8(0);
+	vst4_u8((uint8_t *)(dst + i), d);
+    }
+    BlendSpan888(dst + i, src + i, n - i);
+}
+
+SDL_END_TARGET
+#endif /* NEON_BLITTERS */
+
+static RLEBlendSpan ChooseBlendSpan888(void)
+{
+#if SSE2_BLITTERS
+    if(SDL_GetBlitFeatures() & SDL_BLIT_SSE2)
+	return BlendSpan888SSE2;
+#elif NEON_BLITTERS
+    if(SDL_GetBlitFeatures() & SDL_BLIT_NEON)
+	return BlendSpan888NEON;
+#endif
+    return BlendSpan888;
+}
+
 /* used to save the destination format in the encoding. Designed to be
    macro-compatible with SDL_PixelFormat but without the unneeded fields */
 typedef struct {
@@ -1017,10 +1138,10 @@ static void RLEAlphaClipBlit(int w, Uint8 *srcbuf, SDL_Surface *dst,
     SDL_PixelFormat *df = dst->format;
     /*
      * clipped blitter: Ptype is the destination pixel type,
-     * Ctype the translucent count type, and do_blend the macro
-     * to blend one pixel.
+     * Ctype the translucent count type, and do_span the macro
+     * or function to blend a run of pixels.
      */
-#define RLEALPHACLIPBLIT(Ptype, Ctype, do_blend)			  \
+#define RLEALPHACLIPBLIT(Ptype, Ctype, do_span)			  \
     do {								  \
 	int linecount = srcrect->h;					  \
 	int left = srcrect->x;						  \
@@ -1073,13 +1194,9 @@ static void RLEAlphaClipBlit(int w, Uint8 *srcbuf, SDL_Surface *dst,
 		    }							  \
 		    if(crun > right - cofs)				  \
 			crun = right - cofs;				  \
-		    if(crun > 0) {					  \
-			Ptype *dst = (Ptype *)dstbuf + cofs;		  \
-			Uint32 *src = (Uint32 *)srcbuf + (cofs - ofs);	  \
-			int i;						  \
-			for(i = 0; i < crun; i++)			  \
-			    do_blend(src[i], dst[i]);			  \
-		    }							  \
+		    if(crun > 0)					  \
+			do_span((Ptype *)dstbuf + cofs,			  \
+				(Uint32 *)srcbuf + (cofs - ofs), crun);	  \
 		    srcbuf += run * 4;					  \
 		    ofs += run;						  \
 		}							  \
@@ -1092,12 +1209,15 @@ static void RLEAlphaClipBlit(int w, Uint8 *srcbuf, SDL_Surface *dst,
     case 2:
 	if(df->Gmask == 0x07e0 || df->Rmask == 0x07e0
 	   || df->Bmask == 0x07e0)
-	    RLEALPHACLIPBLIT(Uint16, Uint8, BLIT_TRANSL_565);
+	    RLEALPHACLIPBLIT(Uint16, Uint8, BLEND_SPAN_565);
 	else
-	    RLEALPHACLIPBLIT(Uint16, Uint8, BLIT_TRANSL_555);
+	    RLEALPHACLIPBLIT(Uint16, Uint8, BLEND_SPAN_555);
 	break;
     case 4:
-	RLEALPHACLIPBLIT(Uint32, Uint16, BLIT_TRANSL_888);
+	{
+	    RLEBlendSpan blend_span = ChooseBlendSpan888();
+	    RLEALPHACLIPBLIT(Uint32, Uint16, blend_span);
+	}
 	break;
     }
 }
@@ -1110,6 +1230,7 @@ int SDL_RLEAlphaBlit(SDL_Surface *src, SDL_Rect *srcrect,
     int w = src->w;
     Uint8 *srcbuf, *dstbuf;
     SDL_PixelFormat *df = dst->format;
+    SDL_BlitTime start = 0;
 
     /* Lock the destination if necessary */
     if ( SDL_MUSTLOCK(dst) ) {
@@ -1117,6 +1238,9 @@ int SDL_RLEAlphaBlit(SDL_Surface *src, SDL_Rect *srcrect,
 	    return -1;
 	}
     }
+    if ( SDL_blit_stats ) {
+	start = SDL_StartBlitStats();
+    }
 
     x = dstrect->x;
     y = dstrect->y;
@@ -1187,10 +1311,10 @@ int SDL_RLEAlphaBlit(SDL_Surface *src, SDL_Rect *srcrect,
 
 	/*
 	 * non-clipped blitter. Ptype is the destination pixel type,
-	 * Ctype the translucent count type, and do_blend the
-	 * macro to blend one pixel.
+	 * Ctype the translucent count type, and do_span the
+	 * macro or function to blend a run of pixels.
 	 */
-#define RLEALPHABLIT(Ptype, Ctype, do_blend)				 \
+#define RLEALPHABLIT(Ptype, Ctype, do_span)				 \
 	do {								 \
 	    int linecount = srcrect->h;					 \
 	    do {							 \
@@ -1220,14 +1344,9 @@ int SDL_RLEAlphaBlit(SDL_Surface *src, SDL_Rect *srcrect,
 		    run = ((Uint16 *)srcbuf)[1];			 \
 		    srcbuf += 4;					 \
 		    if(run) {						 \
-			Ptype *dst = (Ptype *)dstbuf + ofs;		 \
-			unsigned i;					 \
-			for(i = 0; i < run; i++) {			 \
-			    Uint32 src = *(Uint32 *)srcbuf;		 \
-			    do_blend(src, *dst);			 \
-			    srcbuf += 4;				 \
-			    dst++;					 \
-			}						 \
+			do_span((Ptype *)dstbuf + ofs, (Uint32 *)srcbuf, \
+				run);					 \
+			srcbuf += run * 4;				 \
 			ofs += run;					 \
 		    }							 \
 		} while(ofs < w);					 \
@@ -1239,17 +1358,24 @@ int SDL_RLEAlphaBlit(SDL_Surface *src, SDL_Rect *srcrect,
 	case 2:
 	    if(df->Gmask == 0x07e0 || df->Rmask == 0x07e0
 	       || df->Bmask == 0x07e0)
-		RLEALPHABLIT(Uint16, Uint8, BLIT_TRANSL_565);
+		RLEALPHABLIT(Uint16, Uint8, BLEND_SPAN_565);
 	    else
-		RLEALPHABLIT(Uint16, Uint8, BLIT_TRANSL_555);
+		RLEALPHABLIT(Uint16, Uint8, BLEND_SPAN_555);
 	    break;
 	case 4:
-	    RLEALPHABLIT(Uint32, Uint16, BLIT_TRANSL_888);
+	    {
+		RLEBlendSpan blend_span = ChooseBlendSpan888();
+		RLEALPHABLIT(Uint32, Uint16, blend_span);
+	    }
 	    break;
 	}
     }
 
  done:
+    if ( SDL_blit_stats ) {
+	SDL_AddBlitStats("RLE", src->format, dst->format,
+			 srcrect->w, srcrect->h, start);
+    }
     /* Unlock the destination if necessary */
     if ( SDL_MUSTLOCK(dst) ) {
 	SDL_UnlockSurface(dst);
@@ -1395,7 +1521,8 @@ static int uncopy_32(Uint32 *dst, void *src, int n,
 #define ISTRANSL(pixel, fmt)	\
     ((unsigned)((((pixel) & fmt->Amask) >> fmt->Ashift) - 1U) < 254U)
 
-/* convert surface to be quickly alpha-blittable onto dest, if possible */
+/* convert surface to be quickly alpha-blittable onto dest, if possible,
+   returning the size of the encoding */
 static int RLEAlphaSurface(SDL_Surface *surface)
 {
     SDL_Surface *dest;
@@ -1454,7 +1581,7 @@ static int RLEAlphaSurface(SDL_Surface *surface)
 	    return -1;		/* requires unused high byte */
 	copy_opaque = copy_32;
 	copy_transl = copy_32;
-	max_opaque_run = 255;	/* runs stored as short ints */
+	max_opaque_run = 65535;	/* runs stored as short ints */
 
 	/* worst case is alternating opaque and translucent pixels */
 	maxsize = surface->h * 2 * 4 * (surface->w + 1) + 4;
@@ -1606,7 +1733,7 @@ static int RLEAlphaSurface(SDL_Surface *surface)
 	surface->map->sw_data->aux_data = p;
     }
 
-    return 0;
+    return (int)(dst - rlebuf);
 }
 
 static Uint32 getpix_8(Uint8 *srcbuf)
@@ -1639,6 +1766,30 @@ static getpix_func getpixes[4] = {
     getpix_8, getpix_16, getpix_24, getpix_32
 };
 
+/* the end of the run of pixels from x on that are, or aren't, keyed */
+static __inline__ int ScanKeyRun(Uint8 *srcbuf, int x, int w, int bpp,
+				 Uint32 rgbmask, Uint32 ckey, int keyed)
+{
+    switch(bpp) {
+    case 2:
+	while(x < w && ((((Uint16 *)srcbuf)[x] & rgbmask) == ckey) == keyed)
+	    x++;
+	break;
+    case 4:
+	while(x < w && ((((Uint32 *)srcbuf)[x] & rgbmask) == ckey) == keyed)
+	    x++;
+	break;
+    default:
+	while(x < w
+	      && ((getpixes[bpp - 1](srcbuf + x * bpp) & rgbmask) == ckey)
+		 == keyed)
+	    x++;
+	break;
+    }
+    return x;
+}
+
+/* encode a colorkeyed surface, returning the size of the encoding */
 static int RLEColorkeySurface(SDL_Surface *surface)
 {
         Uint8 *rlebuf, *dst;
@@ -1648,7 +1799,6 @@ static int RLEColorkeySurface(SDL_Surface *surface)
 	int maxsize = 0;
 	int skip, run;
 	int bpp = surface->format->BytesPerPixel;
-	getpix_func getpix;
 	Uint32 ckey, rgbmask;
 	int w, h;
 
@@ -1687,7 +1837,6 @@ static int RLEColorkeySurface(SDL_Surface *surface)
 	rgbmask = ~surface->format->Amask;
 	ckey = surface->format->colorkey & rgbmask;
 	lastline = dst;
-	getpix = getpixes[bpp - 1];
 	w = surface->w;
 	h = surface->h;
 
@@ -1711,11 +1860,9 @@ static int RLEColorkeySurface(SDL_Surface *surface)
 		int skipstart = x;
 
 		/* find run of transparent, then opaque pixels */
-		while(x < w && (getpix(srcbuf + x * bpp) & rgbmask) == ckey)
-		    x++;
+		x = ScanKeyRun(srcbuf, x, w, bpp, rgbmask, ckey, 1);
 		runstart = x;
-		while(x < w && (getpix(srcbuf + x * bpp) & rgbmask) != ckey)
-		    x++;
+		x = ScanKeyRun(srcbuf, x, w, bpp, rgbmask, ckey, 0);
 		skip = runstart - skipstart;
 		if(skip == w)
 		    blankline = 1;
@@ -1767,11 +1914,48 @@ static int RLEColorkeySurface(SDL_Surface *surface)
 	    surface->map->sw_data->aux_data = p;
 	}
 
-	return(0);
+	return((int)(dst - rlebuf));
+}
+
+/* Counters for SDL_GetRLEStats(), changed under the queue lock while
+   the encoding thread runs */
+static SDL_RLEStats rle_stats;
+static SDL_mutex *SDL_LockRLEStats(void);
+static void SDL_UnlockRLEStats(SDL_mutex *lock);
+
+/* Count an encoding of 'size' bytes, or only its time if it's not used */
+static void SDL_AddRLEStats(int size, SDL_BlitTime nanoseconds)
+{
+	SDL_mutex *lock = SDL_LockRLEStats();
+
+	if ( size >= 0 ) {
+		++rle_stats.encoded;
+	}
+#ifdef SDL_HAS_64BIT_TYPE
+	if ( size >= 0 ) {
+		rle_stats.bytes += size;
+	}
+	rle_stats.nanoseconds += nanoseconds;
+#endif
+	SDL_UnlockRLEStats(lock);
+}
+
+/* Encode a surface, returning the size of the encoding or -1 */
+static int RLEEncode(SDL_Surface *surface)
+{
+	if((surface->flags & SDL_SRCCOLORKEY) == SDL_SRCCOLORKEY) {
+	    return RLEColorkeySurface(surface);
+	}
+	if((surface->flags & SDL_SRCALPHA) == SDL_SRCALPHA
+	   && surface->format->Amask != 0) {
+	    return RLEAlphaSurface(surface);
+	}
+	return -1;	/* no RLE for per-surface alpha sans ckey */
 }
 
 int SDL_RLESurface(SDL_Surface *surface)
 {
+	SDL_BlitTime start;
 	int retcode;
 
 	/* Clear any previous RLE conversion */
@@ -1792,15 +1976,8 @@ int SDL_RLESurface(SDL_Surface *surface)
 	}
 
 	/* Encode */
-	if((surface->flags & SDL_SRCCOLORKEY) == SDL_SRCCOLORKEY) {
-	    retcode = RLEColorkeySurface(surface);
-	} else {
-	    if((surface->flags & SDL_SRCALPHA) == SDL_SRCALPHA
-	       && surface->format->Amask != 0)
-		retcode = RLEAlphaSurface(surface);
-	    else
-		retcode = -1;	/* no RLE for per-surface alpha sans ckey */
-	}
+	start = SDL_BlitStatsTime();
+	retcode = RLEEncode(surface);
 
 	/* Unlock the surface if it's in hardware */
 	if ( SDL_MUSTLOCK(surface) ) {
@@ -1809,6 +1986,7 @@ int SDL_RLESurface(SDL_Surface *surface)
 
 	if(retcode < 0)
 	    return -1;
+	SDL_AddRLEStats(retcode, SDL_BlitStatsTime() - start);
 
 	/* The surface is now accelerated */
 	surface->flags |= SDL_RLEACCEL;
@@ -1894,42 +2072,74 @@ static SDL_bool UnRLEAlpha(SDL_Surface *surface)
     return(SDL_TRUE);
 }
 
+/*
+ * Re-create the pixels of an RLE surface from its encoding, which is
+ * kept.  The surface must not have SDL_RLEACCEL set while this is done.
+ */
+static SDL_bool RLEDecode(SDL_Surface *surface)
+{
+    if((surface->flags & SDL_SRCCOLORKEY) == SDL_SRCCOLORKEY) {
+	SDL_Rect full;
+	unsigned alpha_flag;
+
+	/* re-create the original surface */
+	surface->pixels = SDL_malloc(surface->h * surface->pitch);
+	if ( !surface->pixels ) {
+		return(SDL_FALSE);
+	}
+
+	/* fill it with the background colour */
+	SDL_FillRect(surface, NULL, surface->format->colorkey);
+
+	/* now render the encoded surface */
+	full.x = full.y = 0;
+	full.w = surface->w;
+	full.h = surface->h;
+	alpha_flag = surface->flags & SDL_SRCALPHA;
+	surface->flags &= ~SDL_SRCALPHA; /* opaque blit */
+	SDL_RLEBlit(surface, &full, surface, &full);
+	surface->flags |= alpha_flag;
+	return(SDL_TRUE);
+    }
+    return(UnRLEAlpha(surface));
+}
+
+/*
+ * Decode an RLE surface into its pixels for reading, keeping the encoding.
+ * The decoded pixels are kept until the encoding is dropped.
+ */
+int SDL_RLEDecode(SDL_Surface *surface)
+{
+    if ( (surface->flags & SDL_RLEACCEL) != SDL_RLEACCEL ) {
+	return(0);
+    }
+    if ( surface->pixels ) {
+	return(0);	/* preallocated, hardware, or decoded already */
+    }
+    surface->flags &= ~SDL_RLEACCEL;
+    if ( !RLEDecode(surface) ) {
+	surface->flags |= SDL_RLEACCEL;
+	return(-1);
+    }
+    surface->flags |= SDL_RLEACCEL;
+    surface->map->sw_data->rle_pixels = 1;
+    return(0);
+}
+
 void SDL_UnRLESurface(SDL_Surface *surface, int recode)
 {
     if ( (surface->flags & SDL_RLEACCEL) == SDL_RLEACCEL ) {
 	surface->flags &= ~SDL_RLEACCEL;
 
-	if(recode && (surface->flags & SDL_PREALLOC) != SDL_PREALLOC
+	if ( surface->map && surface->map->sw_data->rle_pixels ) {
+	    /* the pixels were decoded by SDL_RLEDecode() */
+	    surface->map->sw_data->rle_pixels = 0;
+	} else if(recode && (surface->flags & SDL_PREALLOC) != SDL_PREALLOC
 	   && (surface->flags & SDL_HWSURFACE) != SDL_HWSURFACE) {
-	    if((surface->flags & SDL_SRCCOLORKEY) == SDL_SRCCOLORKEY) {
-		SDL_Rect full;
-		unsigned alpha_flag;
-
-		/* re-create the original surface */
-		surface->pixels = SDL_malloc(surface->h * surface->pitch);
-		if ( !surface->pixels ) {
-			/* Oh crap... */
-			surface->flags |= SDL_RLEACCEL;
-			return;
-		}
-
-		/* fill it with the background colour */
-		SDL_FillRect(surface, NULL, surface->format->colorkey);
-
-		/* now render the encoded surface */
-		full.x = full.y = 0;
-		full.w = surface->w;
-		full.h = surface->h;
-		alpha_flag = surface->flags & SDL_SRCALPHA;
-		surface->flags &= ~SDL_SRCALPHA; /* opaque blit */
-		SDL_RLEBlit(surface, &full, surface, &full);
-		surface->flags |= alpha_flag;
-	    } else {
-		if ( !UnRLEAlpha(surface) ) {
-		    /* Oh crap... */
-		    surface->flags |= SDL_RLEACCEL;
-		    return;
-		}
+	    if ( !RLEDecode(surface) ) {
+		/* Oh crap... */
+		surface->flags |= SDL_RLEACCEL;
+		return;
 	    }
 	}
 
@@ -1941,3 +2151,424 @@ void SDL_UnRLESurface(SDL_Surface *surface, int recode)
 }
 
 
+
+/*
+ * Deciding whether to encode a surface, and encoding large ones in the
+ * background.
+ *
+ * Unless SDL_RLE_HEURISTIC is set to 0, a sample of the rows is looked at
+ * when the blit is mapped, and surfaces that wouldn't blit faster are not
+ * encoded.  Unless SDL_RLE_ASYNC is set to 0, surfaces of at least
+ * RLE_ASYNC_MIN_PIXELS are encoded by a thread from a copy of their
+ * pixels, and blitted with the plain blitters meanwhile.  The first blit
+ * after the encoding is done takes it over if the pixels still match.
+ */
+
+/* Rows looked at to decide */
+#define RLE_SAMPLE_ROWS		16
+
+/* Fewest pixels per run on average for the encoding to be worth it */
+#define RLE_MIN_RUN		8
+
+/* Smaller surfaces are encoded right away */
+#define RLE_ASYNC_MIN_PIXELS	(64*64)
+
+/* Encodes in the background of one mapping, if the pixels keep changing
+   while they are made */
+#define RLE_ASYNC_TRIES		2
+
+/* Whether an environment variable is unset, or set to other than 0 */
+static int SDL_RLEEnabled(const char *name)
+{
+    const char *env = SDL_getenv(name);
+
+    return(!env || SDL_atoi(env) != 0);
+}
+
+/*
+ * Whether the RLE blitters are likely to be faster for a surface, from
+ * evenly spaced rows.  They skip transparent pixels and copy opaque runs
+ * whole, but pay for every run, and blend translucent pixels one at a
+ * time as the plain blitters do.
+ */
+static SDL_bool RLEWorthIt(SDL_Surface *surface)
+{
+    SDL_PixelFormat *sf = surface->format;
+    int bpp = sf->BytesPerPixel;
+    getpix_func getpix = getpixes[bpp - 1];
+    int alpha = !(surface->flags & SDL_SRCCOLORKEY);
+    Uint32 rgbmask = ~sf->Amask;
+    Uint32 ckey = sf->colorkey & rgbmask;
+    int rows = MIN(surface->h, RLE_SAMPLE_ROWS);
+    int pixels = 0, cheap = 0, runs = 0;
+    int i, x;
+
+    for(i = 0; i < rows; i++) {
+	Uint8 *row = (Uint8 *)surface->pixels
+	             + (2 * i + 1) * surface->h / (2 * rows) * surface->pitch;
+	int last = -1;
+
+	for(x = 0; x < surface->w; x++) {
+	    Uint32 pixel = getpix(row + x * bpp);
+	    int kind;
+
+	    /* 0 transparent, 1 opaque, 2 translucent */
+	    if(alpha)
+		kind = ISOPAQUE(pixel, sf) ? 1 : ISTRANSL(pixel, sf) ? 2 : 0;
+	    else
+		kind = (pixel & rgbmask) != ckey;
+	    if(kind != 2)
+		cheap++;
+	    if(kind != last)
+		runs++;
+	    last = kind;
+	}
+	pixels += surface->w;
+    }
+    return (cheap * 4 >= pixels && runs * RLE_MIN_RUN <= pixels);
+}
+
+#if SDL_THREADS_DISABLED
+
+static SDL_mutex *SDL_LockRLEStats(void)
+{
+    return NULL;
+}
+
+static void SDL_UnlockRLEStats(SDL_mutex *lock)
+{
+}
+
+static int SDL_QueueRLE(SDL_Surface *surface)
+{
+    return -1;
+}
+
+static void SDL_FinishRLE(SDL_Surface *surface)
+{
+}
+
+void SDL_CancelRLE(struct SDL_BlitMap *map)
+{
+}
+
+void SDL_QuitRLEThread(void)
+{
+}
+
+#else
+
+enum { RLE_QUEUED, RLE_RUNNING, RLE_DONE };
+
+/* An encoding of a copy of the pixels of a surface, which follows the job
+   in memory.  The stand-in surface, formats and map are all the encoders
+   look at. */
+struct SDL_RLEJob {
+    struct SDL_RLEJob *next;
+    int state;			/* Changed under the queue lock */
+    int cancelled;		/* Freed by the thread once it's done */
+    int size;			/* Of the encoding, or -1 */
+    SDL_BlitTime nanoseconds;
+    SDL_Surface surface;
+    SDL_PixelFormat format;
+    SDL_Surface dst;
+    SDL_PixelFormat dstformat;
+    SDL_BlitMap map;
+    struct private_swaccel sw_data;
+};
+
+static struct {
+    SDL_Thread *thread;
+    SDL_mutex *lock;
+    SDL_cond *wake;
+    struct SDL_RLEJob *head, *tail;	/* Waiting to be encoded */
+    int quit;
+    int failed;			/* The thread couldn't be started */
+} rle_queue;
+
+/* The queue lock, if there is one yet, is kept by the caller in case the
+   thread is started meanwhile */
+static SDL_mutex *SDL_LockRLEStats(void)
+{
+    SDL_mutex *lock = rle_queue.lock;
+
+    if(lock)
+	SDL_mutexP(lock);
+    return lock;
+}
+
+static void SDL_UnlockRLEStats(SDL_mutex *lock)
+{
+    if(lock)
+	SDL_mutexV(lock);
+}
+
+static void SDL_FreeRLEJob(struct SDL_RLEJob *job)
+{
+    if(job->sw_data.aux_data)
+	SDL_free(job->sw_data.aux_data);
+    SDL_free(job);
+}
+
+static int SDLCALL SDL_RLEWorker(void *unused)
+{
+    struct SDL_RLEJob *job;
+    SDL_BlitTime start;
+
+    SDL_mutexP(rle_queue.lock);
+    while(!rle_queue.quit) {
+	job = rle_queue.head;
+	if(!job) {
+	    SDL_CondWait(rle_queue.wake, rle_queue.lock);
+	    continue;
+	}
+	rle_queue.head = job->next;
+	if(!rle_queue.head)
+	    rle_queue.tail = NULL;
+	job->state = RLE_RUNNING;
+	SDL_mutexV(rle_queue.lock);
+
+	start = SDL_BlitStatsTime();
+	job->size = RLEEncode(&job->surface);
+	job->nanoseconds = SDL_BlitStatsTime() - start;
+
+	SDL_mutexP(rle_queue.lock);
+	if(job->cancelled)
+	    SDL_FreeRLEJob(job);
+	else
+	    job->state = RLE_DONE;
+    }
+    SDL_mutexV(rle_queue.lock);
+    return 0;
+}
+
+void SDL_QuitRLEThread(void)
+{
+    struct SDL_RLEJob *job;
+
+    if(rle_queue.thread) {
+	SDL_mutexP(rle_queue.lock);
+	rle_queue.quit = 1;
+	SDL_CondSignal(rle_queue.wake);
+	SDL_mutexV(rle_queue.lock);
+	SDL_WaitThread(rle_queue.thread, NULL);
+	rle_queue.thread = NULL;
+	rle_queue.quit = 0;
+    }
+
+    /* Jobs that never ran fail, their surfaces keep the plain blitters */
+    for(job = rle_queue.head; job; job = job->next) {
+	job->size = -1;
+	job->state = RLE_DONE;
+    }
+    rle_queue.head = rle_queue.tail = NULL;
+
+    if(rle_queue.lock) {
+	SDL_DestroyMutex(rle_queue.lock);
+	rle_queue.lock = NULL;
+    }
+    if(rle_queue.wake) {
+	SDL_DestroyCond(rle_queue.wake);
+	rle_queue.wake = NULL;
+    }
+    /* the next SDL_Init() may well be able to start it */
+    rle_queue.failed = 0;
+}
+
+static int SDL_StartRLEThread(void)
+{
+    rle_queue.lock = SDL_CreateMutex();
+    rle_queue.wake = SDL_CreateCond();
+    if(rle_queue.lock && rle_queue.wake)
+	rle_queue.thread = SDL_CreateThread(SDL_RLEWorker, NULL);
+    if(!rle_queue.thread) {
+	SDL_QuitRLEThread();
+	rle_queue.failed = 1;	/* don't try again until SDL_Quit() */
+	return -1;
+    }
+    return 0;
+}
+
+/* Start encoding a mapped surface in the background, if it is worth it */
+static int SDL_QueueRLE(SDL_Surface *surface)
+{
+    struct SDL_RLEJob *job;
+    size_t size = (size_t)surface->h * surface->pitch;
+
+    if(rle_queue.failed || SDL_MUSTLOCK(surface) || !surface->pixels
+       || surface->w * surface->h < RLE_ASYNC_MIN_PIXELS
+       || !SDL_RLEEnabled("SDL_RLE_ASYNC"))
+	return -1;
+    if(!rle_queue.thread && SDL_StartRLEThread() < 0)
+	return -1;
+
+    job = (struct SDL_RLEJob *)SDL_malloc(sizeof(*job) + size);
+    if(!job)
+	return -1;
+    SDL_memset(job, 0, sizeof(*job));
+    SDL_memcpy(job + 1, surface->pixels, size);
+    job->format = *surface->format;
+    job->format.palette = NULL;
+    job->dstformat = *surface->map->dst->format;
+    job->dstformat.palette = NULL;
+    job->dst.format = &job->dstformat;
+    job->map.dst = &job->dst;
+    job->map.sw_data = &job->sw_data;
+    /* the copy is freed with the job, not by the encoder */
+    job->surface.flags = SDL_PREALLOC
+	| (surface->flags & (SDL_SRCCOLORKEY|SDL_SRCALPHA));
+    job->surface.format = &job->format;
+    job->surface.w = surface->w;
+    job->surface.h = surface->h;
+    job->surface.pitch = surface->pitch;
+    job->surface.pixels = job + 1;
+    job->surface.map = &job->map;
+
+    SDL_mutexP(rle_queue.lock);
+    if(rle_queue.tail)
+	rle_queue.tail->next = job;
+    else
+	rle_queue.head = job;
+    rle_queue.tail = job;
+    SDL_CondSignal(rle_queue.wake);
+    SDL_mutexV(rle_queue.lock);
+
+    surface->map->sw_data->rle_job = job;
+    return 0;
+}
+
+/* Take over the background encoding of a surface once it is done */
+static void SDL_FinishRLE(SDL_Surface *surface)
+{
+    struct private_swaccel *sw = surface->map->sw_data;
+    struct SDL_RLEJob *job = sw->rle_job;
+    int done;
+
+    if(rle_queue.lock)
+	SDL_mutexP(rle_queue.lock);
+    done = (job->state == RLE_DONE);
+    if(rle_queue.lock)
+	SDL_mutexV(rle_queue.lock);
+    if(!done)
+	return;
+    sw->rle_job = NULL;
+
+    if(job->size < 0) {
+	/* not encodable, keep the plain blitter */
+	SDL_AddRLEStats(-1, job->nanoseconds);
+    } else if(surface->locked || !surface->pixels
+	      || SDL_memcmp(job + 1, surface->pixels,
+			    (size_t)surface->h * surface->pitch) != 0) {
+	/* the pixels were changed meanwhile */
+	SDL_mutex *lock;
+
+	SDL_AddRLEStats(-1, job->nanoseconds);
+	lock = SDL_LockRLEStats();
+	++rle_stats.discarded;
+	SDL_UnlockRLEStats(lock);
+	if(++sw->rle_tries < RLE_ASYNC_TRIES)
+	    SDL_QueueRLE(surface);
+    } else {
+	if((surface->flags & SDL_PREALLOC) != SDL_PREALLOC) {
+	    SDL_free(surface->pixels);
+	    surface->pixels = NULL;
+	}
+	sw->aux_data = job->sw_data.aux_data;
+	job->sw_data.aux_data = NULL;
+	surface->flags |= SDL_RLEACCEL;
+	surface->map->sw_blit = sw->rle_blit;
+	SDL_AddRLEStats(job->size, job->nanoseconds);
+    }
+    SDL_FreeRLEJob(job);
+}
+
+void SDL_CancelRLE(struct SDL_BlitMap *map)
+{
+    struct SDL_RLEJob *job = map->sw_data->rle_job;
+    struct SDL_RLEJob **link, *prev;
+
+    if(!job)
+	return;
+    map->sw_data->rle_job = NULL;
+
+    if(rle_queue.lock)
+	SDL_mutexP(rle_queue.lock);
+    ++rle_stats.discarded;
+    if(job->state == RLE_QUEUED) {
+	prev = NULL;
+	for(link = &rle_queue.head; *link != job; link = &(*link)->next)
+	    prev = *link;
+	*link = job->next;
+	if(rle_queue.tail == job)
+	    rle_queue.tail = prev;
+    } else if(job->state == RLE_RUNNING) {
+	job->cancelled = 1;
+	job = NULL;
+    }
+    if(rle_queue.lock)
+	SDL_mutexV(rle_queue.lock);
+    if(job)
+	SDL_FreeRLEJob(job);
+}
+
+#endif /* SDL_THREADS_DISABLED */
+
+void SDL_RequestRLE(SDL_Surface *surface, SDL_blit blit)
+{
+    struct private_swaccel *sw = surface->map->sw_data;
+
+    /* We don't support RLE encoding of bitmaps, or pixel alpha below
+       32 bits */
+    if(surface->format->BitsPerPixel < 8
+       || (!(surface->flags & SDL_SRCCOLORKEY)
+	   && surface->format->BitsPerPixel != 32))
+	return;
+
+    sw->rle_blit = blit;
+    sw->rle_tries = 0;
+    if(surface->pixels && !SDL_MUSTLOCK(surface)
+       && SDL_RLEEnabled("SDL_RLE_HEURISTIC") && !RLEWorthIt(surface)) {
+	SDL_mutex *lock = SDL_LockRLEStats();
+	++rle_stats.skipped;
+	SDL_UnlockRLEStats(lock);
+	return;
+    }
+    if(SDL_QueueRLE(surface) == 0)
+	return;
+    if(SDL_RLESurface(surface) == 0)
+	surface->map->sw_blit = blit;
+}
+
+void SDL_CheckRLE(SDL_Surface *surface, int blits)
+{
+    struct private_swaccel *sw = surface->map->sw_data;
+    SDL_mutex *lock;
+
+    if(sw->rle_job)
+	SDL_FinishRLE(surface);
+    lock = SDL_LockRLEStats();
+    if(surface->map->sw_blit == sw->rle_blit)
+	rle_stats.rle_blits += blits;
+    else
+	rle_stats.plain_blits += blits;
+    SDL_UnlockRLEStats(lock);
+}
+
+void SDL_GetRLEStats(SDL_RLEStats *stats)
+{
+    SDL_mutex *lock;
+
+    if(stats) {
+	lock = SDL_LockRLEStats();
+	*stats = rle_stats;
+	SDL_UnlockRLEStats(lock);
+    }
+}
+
+void SDL_ResetRLEStats(void)
+{
+    SDL_mutex *lock = SDL_LockRLEStats();
+
+    SDL_memset(&rle_stats, 0, sizeof(rle_stats));
+    SDL_UnlockRLEStats(lock);
+}
@@ -28,4 +28,14 @@ extern int SDL_RLEBlit(SDL_Surface *src, SDL_Rect *srcrect,
                        SDL_Surface *dst, SDL_Rect *dstrect);
 extern int SDL_RLEAlphaBlit(SDL_Surface *src, SDL_Rect *srcrect,
 			    SDL_Surface *dst, SDL_Rect *dstrect);
+extern int SDL_RLEDecode(SDL_Surface *surface);
 extern void SDL_UnRLESurface(SDL_Surface *surface, int recode);
+
+/* Pick the RLE blitter for a surface whose blit was just mapped, and
+   encode it now, in the background or not at all */
+extern void SDL_RequestRLE(SDL_Surface *surface, SDL_blit blit);
+/* Take over a finished background encoding, and count 'blits' blits */
+extern void SDL_CheckRLE(SDL_Surface *surface, int blits);
+/* Drop the background encoding of a mapping being invalidated */
+extern void SDL_CancelRLE(struct SDL_BlitMap *map);
+extern void SDL_QuitRLEThread(void);
@@ -22,8 +22,10 @@
 #include "SDL_config.h"
 
 #include "SDL_video.h"
+#include "SDL_cpuinfo.h"
 #include "SDL_sysvideo.h"
 #include "SDL_blit.h"
+#include "SDL_blit_auto.h"
 #include "SDL_RLEaccel_c.h"
 #include "SDL_pixels_c.h"
 
@@ -35,68 +37,120 @@
 #endif
 
 #if defined(MMX_ASMBLIT)
-#include "SDL_cpuinfo.h"
 #include "mmx.h"
 #endif
 
-/* The general purpose software blit routine */
-static int SDL_SoftBlit(SDL_Surface *src, SDL_Rect *srcrect,
-			SDL_Surface *dst, SDL_Rect *dstrect)
+/* The CPU features the blitters may use, looked up once */
+static Uint32 blit_features = 0xFFFFFFFF;
+
+/* Names for the SDL_BLIT_FEATURES environment variable, which limits the
+   blitters to those using no more than the given instruction set */
+static const struct {
+	const char *name;
+	Uint32 features;
+} blit_ceilings[] = {
+	{ "c",		0 },
+	{ "mmx",	SDL_BLIT_MMX },
+	{ "3dnow",	SDL_BLIT_MMX|SDL_BLIT_3DNOW },
+	{ "sse",	SDL_BLIT_MMX|SDL_BLIT_3DNOW|SDL_BLIT_SSE },
+	{ "sse2",	SDL_BLIT_MMX|SDL_BLIT_3DNOW|SDL_BLIT_SSE|SDL_BLIT_SSE2 },
+	{ "sse3",	SDL_BLIT_MMX|SDL_BLIT_3DNOW|SDL_BLIT_SSE|SDL_BLIT_SSE2|
+			SDL_BLIT_SSE3 },
+	{ "ssse3",	SDL_BLIT_MMX|SDL_BLIT_3DNOW|SDL_BLIT_SSE|SDL_BLIT_SSE2|
+			SDL_BLIT_SSE3|SDL_BLIT_SSSE3 },
+	{ "neon",	SDL_BLIT_NEON },
+	{ "altivec",	SDL_BLIT_ALTIVEC }
+};
+
+/* Every blitter picks its code path from these features, so that setting
+   SDL_BLIT_FEATURES to e.g. "sse2" or "c" compares kernels on one machine.
+   Unknown names leave all the features of the CPU available. */
+Uint32 SDL_GetBlitFeatures(void)
+{
+	const char *env;
+	Uint32 features;
+	int i;
+
+	if ( blit_features != 0xFFFFFFFF ) {
+		return(blit_features);
+	}
+	features = 0;
+	if ( SDL_HasMMX() ) {
+		features |= SDL_BLIT_MMX;
+	}
+	if ( SDL_Has3DNow() ) {
+		features |= SDL_BLIT_3DNOW;
+	}
+	if ( SDL_HasSSE() ) {
+		features |= SDL_BLIT_SSE;
+	}
+	if ( SDL_HasSSE2() ) {
+		features |= SDL_BLIT_SSE2;
+	}
+	if ( SDL_HasSSE3() ) {
+		features |= SDL_BLIT_SSE3;
+	}
+	if ( SDL_HasSSSE3() ) {
+		features |= SDL_BLIT_SSSE3;
+	}
+	if ( SDL_HasSSE41() ) {
+		features |= SDL_BLIT_SSE41;
+	}
+	if ( SDL_HasAVX2() ) {
+		features |= SDL_BLIT_AVX2;
+	}
+	if ( SDL_HasNEON() ) {
+		features |= SDL_BLIT_NEON;
+	}
+	if ( SDL_HasAltiVec() ) {
+		features |= SDL_BLIT_ALTIVEC;
+	}
+	env = SDL_getenv("SDL_BLIT_FEATURES");
+	if ( env ) {
+		for ( i = 0; i < (int)SDL_arraysize(blit_ceilings); ++i ) {
+			if ( SDL_strcasecmp(env, blit_ceilings[i].name) == 0 ) {
+				features &= blit_ceilings[i].features;
+				break;
+			}
+		}
+	}
+	blit_features = features;
+	return(blit_features);
+}
+
+/* Lock the surfaces of a software blit, if they're in hardware */
+static int SDL_LockSoftBlit(SDL_Surface *src, SDL_Surface *dst,
+                            int *src_locked, int *dst_locked)
 {
 	int okay;
-	int src_locked;
-	int dst_locked;
 
 	/* Everything is okay at the beginning...  */
 	okay = 1;
 
 	/* Lock the destination if it's in hardware */
-	dst_locked = 0;
+	*dst_locked = 0;
 	if ( SDL_MUSTLOCK(dst) ) {
 		if ( SDL_LockSurface(dst) < 0 ) {
 			okay = 0;
 		} else {
-			dst_locked = 1;
+			*dst_locked = 1;
 		}
 	}
 	/* Lock the source if it's in hardware */
-	src_locked = 0;
+	*src_locked = 0;
 	if ( SDL_MUSTLOCK(src) ) {
 		if ( SDL_LockSurface(src) < 0 ) {
 			okay = 0;
 		} else {
-			src_locked = 1;
+			*src_locked = 1;
 		}
 	}
+	return(okay);
+}
 
-	/* Set up source and destination buffer pointers, and BLIT! */
-	if ( okay  && srcrect->w && srcrect->h ) {
-		SDL_BlitInfo info;
-		SDL_loblit RunBlit;
-
-		/* Set up the blit information */
-		info.s_pixels = (Uint8 *)src->pixels +
-				(Uint16)srcrect->y*src->pitch +
-				(Uint16)srcrect->x*src->format->BytesPerPixel;
-		info.s_width = srcrect->w;
-		info.s_height = srcrect->h;
-		info.s_skip=src->pitch-info.s_width*src->format->BytesPerPixel;
-		info.d_pixels = (Uint8 *)dst->pixels +
-				(Uint16)dstrect->y*dst->pitch +
-				(Uint16)dstrect->x*dst->format->BytesPerPixel;
-		info.d_width = dstrect->w;
-		info.d_height = dstrect->h;
-		info.d_skip=dst->pitch-info.d_width*dst->format->BytesPerPixel;
-		info.aux_data = src->map->sw_data->aux_data;
-		info.src = src->format;
-		info.table = src->map->table;
-		info.dst = dst->format;
-		RunBlit = src->map->sw_data->blit;
-
-		/* Run the actual software blit */
-		RunBlit(&info);
-	}
-
+static void SDL_UnlockSoftBlit(SDL_Surface *src, SDL_Surface *dst,
+                               int src_locked, int dst_locked)
+{
 	/* We need to unlock the surfaces if they're locked */
 	if ( dst_locked ) {
 		SDL_UnlockSurface(dst);
@@ -104,10 +158,103 @@ static int SDL_SoftBlit(SDL_Surface *src, SDL_Rect *srcrect,
 	if ( src_locked ) {
 		SDL_UnlockSurface(src);
 	}
+}
+
+/* Set up source and destination buffer pointers, and BLIT! */
+static void SDL_RunSoftBlit(SDL_Surface *src, SDL_Rect *srcrect,
+                            SDL_Surface *dst, SDL_Rect *dstrect)
+{
+	SDL_BlitInfo info;
+	SDL_loblit RunBlit;
+	SDL_BlitTime start = 0;
+
+	/* Set up the blit information */
+	info.s_pixels = (Uint8 *)src->pixels +
+			(Uint16)srcrect->y*src->pitch +
+			(Uint16)srcrect->x*src->format->BytesPerPixel;
+	info.s_width = srcrect->w;
+	info.s_height = srcrect->h;
+	info.s_skip=src->pitch-info.s_width*src->format->BytesPerPixel;
+	info.d_pixels = (Uint8 *)dst->pixels +
+			(Uint16)dstrect->y*dst->pitch +
+			(Uint16)dstrect->x*dst->format->BytesPerPixel;
+	info.d_width = dstrect->w;
+	info.d_height = dstrect->h;
+	info.d_skip=dst->pitch-info.d_width*dst->format->BytesPerPixel;
+	info.aux_data = src->map->sw_data->aux_data;
+	info.src = src->format;
+	info.table = src->map->table;
+	info.dst = dst->format;
+	RunBlit = src->map->sw_data->blit;
+
+	if ( SDL_blit_stats ) {
+		start = SDL_StartBlitStats();
+	}
+
+	/* Run the actual software blit, overlapping copies within
+	   one surface must go in order */
+	if ( src == dst ) {
+		RunBlit(&info);
+	} else {
+		SDL_ThreadedBlit(RunBlit, &info, src->pitch, dst->pitch);
+	}
+
+	if ( SDL_blit_stats ) {
+		SDL_AddBlitStats(SDL_GetBlitMapName(src->map),
+		                 src->format, dst->format,
+		                 info.d_width, info.d_height, start);
+	}
+}
+
+/* The general purpose software blit routine */
+static int SDL_SoftBlit(SDL_Surface *src, SDL_Rect *srcrect,
+			SDL_Surface *dst, SDL_Rect *dstrect)
+{
+	int okay;
+	int src_locked;
+	int dst_locked;
+
+	okay = SDL_LockSoftBlit(src, dst, &src_locked, &dst_locked);
+	if ( okay  && srcrect->w && srcrect->h ) {
+		SDL_RunSoftBlit(src, srcrect, dst, dstrect);
+	}
+	SDL_UnlockSoftBlit(src, dst, src_locked, dst_locked);
+
 	/* Blit is done! */
 	return(okay ? 0 : -1);
 }
 
+/* Blit 'n' pairs of clipped source and destination rectangles, locking
+   the surfaces only once for all of them */
+int SDL_SoftBlitBatch(SDL_Surface *src, SDL_Surface *dst,
+                      SDL_Rect *rects, int n)
+{
+	int okay;
+	int src_locked;
+	int dst_locked;
+	int i;
+
+	/* The RLE blitters do their own locking */
+	if ( src->map->sw_blit != SDL_SoftBlit ) {
+		for ( i = 0; i < n; ++i ) {
+			if ( src->map->sw_blit(src, &rects[2*i],
+			                       dst, &rects[2*i+1]) < 0 ) {
+				return(-1);
+			}
+		}
+		return(0);
+	}
+
+	okay = SDL_LockSoftBlit(src, dst, &src_locked, &dst_locked);
+	if ( okay ) {
+		for ( i = 0; i < n; ++i ) {
+			SDL_RunSoftBlit(src, &rects[2*i], dst, &rects[2*i+1]);
+		}
+	}
+	SDL_UnlockSoftBlit(src, dst, src_locked, dst_locked);
+	return(okay ? 0 : -1);
+}
+
 #ifdef MMX_ASMBLIT
 static __inline__ void SDL_memcpyMMX(Uint8 *to, const Uint8 *from, int len)
 {
@@ -166,7 +313,7 @@ static void SDL_BlitCopy(SDL_BlitInfo *info)
 	dstskip = w+info->d_skip;
 
 #ifdef SSE_ASMBLIT
-	if(SDL_HasSSE())
+	if(SDL_GetBlitFeatures() & SDL_BLIT_SSE)
 	{
 		while ( h-- ) {
 			SDL_memcpySSE(dst, src, w);
@@ -180,7 +327,7 @@ static void SDL_BlitCopy(SDL_BlitInfo *info)
 	else
 #endif
 #ifdef MMX_ASMBLIT
-	if(SDL_HasMMX())
+	if(SDL_GetBlitFeatures() & SDL_BLIT_MMX)
 	{
 		while ( h-- ) {
 			SDL_memcpyMMX(dst, src, w);
@@ -229,6 +376,12 @@ static void SDL_BlitCopyOverlap(SDL_BlitInfo *info)
 	}
 }
 
+static const SDL_BlitKernel blit_kernels[] = {
+	SDL_BLIT_KERNEL(SDL_BlitCopy, 0, 0),
+	SDL_BLIT_KERNEL(SDL_BlitCopyOverlap, 0, 0),
+	{ NULL }
+};
+
 /* Figure out which of many blit routines to set up on a surface */
 int SDL_CalculateBlit(SDL_Surface *surface)
 {
@@ -344,11 +497,9 @@ int SDL_CalculateBlit(SDL_Surface *surface)
 	        if(surface->map->identity
 		   && (blit_index == 1
 		       || (blit_index == 3 && !surface->format->Amask))) {
-		        if ( SDL_RLESurface(surface) == 0 )
-			        surface->map->sw_blit = SDL_RLEBlit;
+		        SDL_RequestRLE(surface, SDL_RLEBlit);
 		} else if(blit_index == 2 && surface->format->Amask) {
-		        if ( SDL_RLESurface(surface) == 0 )
-			        surface->map->sw_blit = SDL_RLEAlphaBlit;
+		        SDL_RequestRLE(surface, SDL_RLEAlphaBlit);
 		}
 	}
 	
@@ -358,3 +509,90 @@ int SDL_CalculateBlit(SDL_Surface *surface)
 	return(0);
 }
 
+/* The first blitter in kernels for one of the format pairs whose
+   features are all available, or NULL if there is none */
+SDL_loblit SDL_SelectBlitKernel(const SDL_BlitKernel *kernels, Uint32 pairs)
+{
+	Uint32 features = SDL_GetBlitFeatures();
+
+	for ( ; kernels->blit; ++kernels ) {
+		if ( (kernels->pairs & pairs) &&
+		     (kernels->features & features) == kernels->features ) {
+			return(kernels->blit);
+		}
+	}
+	return(NULL);
+}
+
+static const char *SDL_FindBlitKernel(const SDL_BlitKernel *kernels,
+                                      SDL_loblit blit)
+{
+	for ( ; kernels->blit; ++kernels ) {
+		if ( kernels->blit == blit ) {
+			return(kernels->name);
+		}
+	}
+	return(NULL);
+}
+
+/* The name of the blitter a map resolved to, or NULL if it has none */
+const char *SDL_GetBlitMapName(SDL_BlitMap *map)
+{
+	static const SDL_BlitKernel *tables[] = {
+		blit_kernels,
+		SDL_BlitKernels0,
+		SDL_BlitKernels1,
+		SDL_BlitKernelsN,
+		SDL_AlphaBlitKernels
+	};
+	const SDL_BlitAutoEntry *entry;
+	const char *name;
+	SDL_loblit blit;
+	int i;
+
+	if ( (map->sw_blit == SDL_RLEBlit) ||
+	     (map->sw_blit == SDL_RLEAlphaBlit) ) {
+		return("RLE");
+	}
+	if ( map->sw_data == NULL || map->sw_data->blit == NULL ) {
+		return(NULL);
+	}
+	blit = map->sw_data->blit;
+	for ( i = 0; i < (int)SDL_arraysize(tables); ++i ) {
+		name = SDL_FindBlitKernel(tables[i], blit);
+		if ( name ) {
+			return(name);
+		}
+	}
+	for ( entry = SDL_GeneratedBlitN; entry->srcbpp; ++entry ) {
+		if ( entry->blitfunc == blit ) {
+			return(entry->name);
+		}
+	}
+	return(NULL);
+}
+
+const char *SDL_GetBlitName(SDL_Surface *src, SDL_Surface *dst)
+{
+	const char *name;
+
+	if ( !src || !dst ) {
+		SDL_SetError("SDL_GetBlitName: passed a NULL surface");
+		return(NULL);
+	}
+	/* Map the surfaces the same way SDL_LowerBlit() would */
+	if ( (src->map->dst != dst) ||
+	     (src->map->dst->format_version != src->map->format_version) ) {
+		if ( SDL_MapSurface(src, dst) < 0 ) {
+			return(NULL);
+		}
+	}
+	if ( (src->flags & SDL_HWACCEL) == SDL_HWACCEL ) {
+		return("hardware");
+	}
+	name = SDL_GetBlitMapName(src->map);
+	if ( !name ) {
+		SDL_SetError("Unknown blitter");
+	}
+	return(name);
+}
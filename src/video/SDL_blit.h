@@ -49,6 +49,13 @@ typedef void (*SDL_loblit)(SDL_BlitInfo *info);
 struct private_swaccel {
 	SDL_loblit blit;
 	void *aux_data;
+	int rle_pixels;		/* The RLE surface pixels were decoded */
+	int rle_readonly;	/* The RLE surface is only locked for reading */
+	SDL_blit rle_blit;	/* The RLE blitter, if the mapping asks for one */
+	struct SDL_RLEJob *rle_job;	/* Encoding in the background */
+	int rle_tries;		/* Background encodes of this mapping */
+	int *batch_rows;	/* Kept for sorting SDL_BlitSurfaceBatch() */
+	int batch_maxrows;
 };
 
 /* Blit mapping definition */
@@ -67,14 +74,152 @@ typedef struct SDL_BlitMap {
 } SDL_BlitMap;
 
 
+/* CPU features the low level blitters can use */
+#define SDL_BLIT_MMX		0x00000001
+#define SDL_BLIT_3DNOW		0x00000002
+#define SDL_BLIT_SSE		0x00000004
+#define SDL_BLIT_SSE2		0x00000008
+#define SDL_BLIT_SSE3		0x00000010
+#define SDL_BLIT_SSSE3		0x00000020
+#define SDL_BLIT_SSE41		0x00000040
+#define SDL_BLIT_AVX2		0x00000080
+#define SDL_BLIT_NEON		0x00000100
+#define SDL_BLIT_ALTIVEC	0x00000200
+
+/* SSE2, SSSE3 and NEON blitters are built whenever the compiler can
+   enable the instruction set for a range of functions, even if the rest
+   of SDL doesn't use it (i386, ARMv7 without -mfpu=neon).  The vector
+   code goes between SDL_BEGIN_SSE2 (SDL_BEGIN_SSSE3, SDL_BEGIN_NEON) and
+   SDL_END_TARGET, and is chosen at run time with SDL_GetBlitFeatures().
+   The NEON blitters assume little endian pixels.
+*/
+#if SDL_ASSEMBLY_ROUTINES
+#  if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#    define SSE2_BLITTERS	1
+#    define SSSE3_BLITTERS	1
+#  elif (defined(__i386__) || defined(__x86_64__)) && defined(__clang__)
+#    define SSE2_BLITTERS	1
+#    define SSSE3_BLITTERS	1
+#    define SDL_BEGIN_SSE2	_Pragma("clang attribute push (__attribute__((target(\"sse2\"))), apply_to = function)")
+#    define SDL_BEGIN_SSSE3	_Pragma("clang attribute push (__attribute__((target(\"ssse3\"))), apply_to = function)")
+#    define SDL_END_TARGET	_Pragma("clang attribute pop")
+#  elif (defined(__i386__) || defined(__x86_64__)) && \
+        ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 9)))
+#    define SSE2_BLITTERS	1
+#    define SSSE3_BLITTERS	1
+#    define SDL_BEGIN_SSE2	_Pragma("GCC push_options") _Pragma("GCC target(\"sse2\")")
+#    define SDL_BEGIN_SSSE3	_Pragma("GCC push_options") _Pragma("GCC target(\"ssse3\")")
+#    define SDL_END_TARGET	_Pragma("GCC pop_options")
+#  elif defined(__SSE2__)
+/* Older compilers only have the instruction sets they were told about */
+#    define SSE2_BLITTERS	1
+#    if defined(__SSSE3__)
+#      define SSSE3_BLITTERS	1
+#    endif
+#  elif (defined(__ARM_NEON__) || defined(__ARM_NEON)) && \
+        (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+#    define NEON_BLITTERS	1
+#  elif defined(__arm__) && defined(__ARM_FP) && defined(__GNUC__) && \
+        !defined(__clang__) && (__GNUC__ >= 8) && \
+        (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+/* NEON needs the hard or softfp float ABI, not soft */
+#    define NEON_BLITTERS	1
+#    define SDL_BEGIN_NEON	_Pragma("GCC push_options") _Pragma("GCC target(\"fpu=neon\")")
+#    define SDL_END_TARGET	_Pragma("GCC pop_options")
+#  endif
+#endif
+#ifndef SDL_BEGIN_SSE2
+#define SDL_BEGIN_SSE2
+#endif
+#ifndef SDL_BEGIN_SSSE3
+#define SDL_BEGIN_SSSE3
+#endif
+#ifndef SDL_BEGIN_NEON
+#define SDL_BEGIN_NEON
+#endif
+#ifndef SDL_END_TARGET
+#define SDL_END_TARGET
+#endif
+
+#if SSE2_BLITTERS
+#include <emmintrin.h>
+#endif
+#if SSSE3_BLITTERS
+#include <tmmintrin.h>
+#endif
+#if NEON_BLITTERS
+SDL_BEGIN_NEON
+#include <arm_neon.h>
+SDL_END_TARGET
+#endif
+
+/* A low level blitter, its name for SDL_GetBlitName(), the SDL_BLIT_*
+   features it needs and the format pairs it handles.  Each of
+   SDL_blit_{0,1,N,A}.c lists all of its blitters in a table ending with
+   a NULL blitter, fastest first; test/testblit fails on any blitter
+   missing from them.  The pairs are bits of the file's own, for the
+   blitters SDL_SelectBlitKernel() picks, or 0 for those picked by index
+   or from the normal_blit tables of SDL_blit_N.c. */
+typedef struct {
+	SDL_loblit blit;
+	const char *name;
+	Uint32 features;
+	Uint32 pairs;
+} SDL_BlitKernel;
+
+#define SDL_BLIT_KERNEL(blit, features, pairs)	{ blit, #blit, features, pairs }
+
 /* Functions found in SDL_blit.c */
 extern int SDL_CalculateBlit(SDL_Surface *surface);
+extern Uint32 SDL_GetBlitFeatures(void);
+extern SDL_loblit SDL_SelectBlitKernel(const SDL_BlitKernel *kernels,
+                                       Uint32 pairs);
+extern const char *SDL_GetBlitMapName(SDL_BlitMap *map);
+extern int SDL_SoftBlitBatch(SDL_Surface *src, SDL_Surface *dst,
+                             SDL_Rect *rects, int n);
 
 /* Functions found in SDL_blit_{0,1,N,A}.c */
 extern SDL_loblit SDL_CalculateBlit0(SDL_Surface *surface, int complex);
 extern SDL_loblit SDL_CalculateBlit1(SDL_Surface *surface, int complex);
 extern SDL_loblit SDL_CalculateBlitN(SDL_Surface *surface, int complex);
 extern SDL_loblit SDL_CalculateAlphaBlit(SDL_Surface *surface, int complex);
+extern const SDL_BlitKernel SDL_BlitKernels0[];
+extern const SDL_BlitKernel SDL_BlitKernels1[];
+extern const SDL_BlitKernel SDL_BlitKernelsN[];
+extern const SDL_BlitKernel SDL_AlphaBlitKernels[];
+
+/* Functions found in SDL_blit_threads.c */
+extern void SDL_ThreadedBlit(SDL_loblit blit, SDL_BlitInfo *info,
+                             int src_pitch, int dst_pitch);
+/* Run 'func' on bands of the rows 0 to h-1 of w pixels each, on several
+   threads if there are enough pixels.  Bands start on multiples of
+   'align' rows, and are numbered from 0 to at most SDL_MAX_BANDS-1, so
+   each can use its own part of a scratch buffer. */
+#define SDL_MAX_BANDS	8
+typedef void (*SDL_BandFunc)(void *data, int band, int y, int rows);
+extern void SDL_ThreadedBands(SDL_BandFunc func, void *data, int w, int h,
+                              int align);
+extern void SDL_QuitBlitThreads(void);
+
+/* Functions found in SDL_blit_stats.c.  SDL_blit_stats is nonzero while
+   blits are counted, or -1 until the environment has been read, so a
+   blit is counted with:
+	if ( SDL_blit_stats ) start = SDL_StartBlitStats();
+	... blit ...
+	if ( SDL_blit_stats ) SDL_AddBlitStats(name, src, dst, w, h, start);
+*/
+extern int SDL_blit_stats;
+#ifdef SDL_HAS_64BIT_TYPE
+typedef Uint64 SDL_BlitTime;
+#else
+typedef Uint32 SDL_BlitTime;	/* Wraps, but nothing is counted */
+#endif
+extern SDL_BlitTime SDL_BlitStatsTime(void);	/* In nanoseconds */
+extern SDL_BlitTime SDL_StartBlitStats(void);
+extern void SDL_AddBlitStats(const char *name, SDL_PixelFormat *src,
+                             SDL_PixelFormat *dst, int w, int h,
+                             SDL_BlitTime start);
+extern void SDL_QuitBlitStats(void);
 
 /*
  * Useful macros for blitting routines
@@ -110,6 +255,25 @@ extern SDL_loblit SDL_CalculateAlphaBlit(SDL_Surface *surface, int complex);
 	g = ((Pixel&0xFF00)>>8);		 			\
 	b = (Pixel&0xFF);			 			\
 }
+/* 24-bit pixels are read and written a byte at a time */
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+#define SDL_READ24(p)	((p)[0] | ((p)[1] << 8) | ((p)[2] << 16))
+#define SDL_WRITE24(p, pixel)				\
+	do {						\
+		(p)[0] = (Uint8)(pixel);		\
+		(p)[1] = (Uint8)((pixel) >> 8);		\
+		(p)[2] = (Uint8)((pixel) >> 16);	\
+	} while ( 0 )
+#else
+#define SDL_READ24(p)	(((p)[0] << 16) | ((p)[1] << 8) | (p)[2])
+#define SDL_WRITE24(p, pixel)				\
+	do {						\
+		(p)[0] = (Uint8)((pixel) >> 16);	\
+		(p)[1] = (Uint8)((pixel) >> 8);		\
+		(p)[2] = (Uint8)(pixel);		\
+	} while ( 0 )
+#endif
+
 #define RETRIEVE_RGB_PIXEL(buf, bpp, Pixel)				   \
 do {									   \
 	switch (bpp) {							   \
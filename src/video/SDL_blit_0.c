@@ -440,6 +440,20 @@ static SDL_loblit colorkey_blit[] = {
     NULL, BlitBto1Key, BlitBto2Key, BlitBto3Key, BlitBto4Key
 };
 
+const SDL_BlitKernel SDL_BlitKernels0[] = {
+	SDL_BLIT_KERNEL(BlitBto1, 0, 0),
+	SDL_BLIT_KERNEL(BlitBto2, 0, 0),
+	SDL_BLIT_KERNEL(BlitBto3, 0, 0),
+	SDL_BLIT_KERNEL(BlitBto4, 0, 0),
+	SDL_BLIT_KERNEL(BlitBto1Key, 0, 0),
+	SDL_BLIT_KERNEL(BlitBto2Key, 0, 0),
+	SDL_BLIT_KERNEL(BlitBto3Key, 0, 0),
+	SDL_BLIT_KERNEL(BlitBto4Key, 0, 0),
+	SDL_BLIT_KERNEL(BlitBtoNAlpha, 0, 0),
+	SDL_BLIT_KERNEL(BlitBtoNAlphaKey, 0, 0),
+	{ NULL }
+};
+
 SDL_loblit SDL_CalculateBlit0(SDL_Surface *surface, int blit_index)
 {
 	int which;
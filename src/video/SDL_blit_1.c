@@ -491,6 +491,20 @@ static SDL_loblit one_blitkey[] = {
         NULL, Blit1to1Key, Blit1to2Key, Blit1to3Key, Blit1to4Key
 };
 
+const SDL_BlitKernel SDL_BlitKernels1[] = {
+	SDL_BLIT_KERNEL(Blit1to1, 0, 0),
+	SDL_BLIT_KERNEL(Blit1to2, 0, 0),
+	SDL_BLIT_KERNEL(Blit1to3, 0, 0),
+	SDL_BLIT_KERNEL(Blit1to4, 0, 0),
+	SDL_BLIT_KERNEL(Blit1to1Key, 0, 0),
+	SDL_BLIT_KERNEL(Blit1to2Key, 0, 0),
+	SDL_BLIT_KERNEL(Blit1to3Key, 0, 0),
+	SDL_BLIT_KERNEL(Blit1to4Key, 0, 0),
+	SDL_BLIT_KERNEL(Blit1toNAlpha, 0, 0),
+	SDL_BLIT_KERNEL(Blit1toNAlphaKey, 0, 0),
+	{ NULL }
+};
+
 SDL_loblit SDL_CalculateBlit1(SDL_Surface *surface, int blit_index)
 {
 	int which;
@@ -2719,154 +2719,1236 @@ static void BlitNtoNPixelAlpha(SDL_BlitInfo *info)
 }
 
 
+#if SSE2_BLITTERS || NEON_BLITTERS
+/*
+ * The SSE2 and NEON blitters below blend each channel as
+ * (s*alpha + d*(max-alpha)) >> bits, with an opaque alpha bumped to 'max'
+ * so that it gives the source back.  That is d + (s-d)*alpha/max rounded
+ * down, like the MMX blitters.  The helpers do the same for the pixels
+ * left over at the end of a row.
+ */
+
+/* Blend the RGB bytes of two 8888 pixels, alpha in 0..256 */
+static __inline__ Uint32 BlendRGB888(Uint32 s, Uint32 d, Uint32 alpha)
+{
+	Uint32 rb = ((s & 0xff00ff) * alpha + (d & 0xff00ff) * (256 - alpha)) >> 8;
+	Uint32 g = ((s & 0xff00) * alpha + (d & 0xff00) * (256 - alpha)) >> 8;
+	return (rb & 0xff00ff) | (g & 0xff00);
+}
+
+/* Blend two 16 bit pixels spread out to G0RAB (see Blit565to565SurfaceAlpha),
+   alpha in 0..32 */
+static __inline__ Uint32 BlendSpread16(Uint32 s, Uint32 d, Uint32 alpha,
+                                       Uint32 mask)
+{
+	return ((s * alpha + d * (32 - alpha)) >> 5) & mask;
+}
+
+static __inline__ void BlitRGBtoRGBPixelAlphaTail(Uint32 *srcp, Uint32 *dstp,
+                                                  int width)
+{
+	while ( width-- ) {
+		Uint32 s = *srcp++;
+		Uint32 alpha = s >> 24;
+		if ( alpha ) {
+			Uint32 d = *dstp;
+			alpha += (alpha == SDL_ALPHA_OPAQUE);
+			*dstp = BlendRGB888(s, d, alpha) | (d & 0xff000000);
+		}
+		++dstp;
+	}
+}
+
+static __inline__ void BlitRGBtoRGBSurfaceAlphaTail(Uint32 *srcp, Uint32 *dstp,
+                                                    int width, Uint32 alpha)
+{
+	while ( width-- ) {
+		*dstp = BlendRGB888(*srcp++, *dstp, alpha) | 0xff000000;
+		++dstp;
+	}
+}
+
+/* ARGB8888 to 565 (green6 == 1) or 555 (green6 == 0) */
+static __inline__ void BlitARGBto16PixelAlphaTail(Uint32 *srcp, Uint16 *dstp,
+                                                  int width, int green6)
+{
+	const Uint32 mask = green6 ? 0x07e0f81f : 0x03e07c1f;
+
+	while ( width-- ) {
+		Uint32 s = *srcp++;
+		Uint32 alpha = s >> 27;
+		if ( alpha ) {
+			Uint32 d = *dstp;
+			alpha += (alpha == (SDL_ALPHA_OPAQUE >> 3));
+			if ( green6 ) {
+				s = ((s & 0xfc00) << 11) + (s >> 8 & 0xf800)
+				  + (s >> 3 & 0x1f);
+			} else {
+				s = ((s & 0xf800) << 10) + (s >> 9 & 0x7c00)
+				  + (s >> 3 & 0x1f);
+			}
+			d = BlendSpread16(s, (d | d << 16) & mask, alpha, mask);
+			*dstp = (Uint16)(d | d >> 16);
+		}
+		++dstp;
+	}
+}
+
+static __inline__ void Blit16to16SurfaceAlphaTail(Uint16 *srcp, Uint16 *dstp,
+                                                  int width, Uint32 alpha,
+                                                  Uint32 mask)
+{
+	while ( width-- ) {
+		Uint32 s = *srcp++;
+		Uint32 d = *dstp;
+		d = BlendSpread16((s | s << 16) & mask, (d | d << 16) & mask,
+		                  alpha, mask);
+		*dstp++ = (Uint16)(d | d >> 16);
+	}
+}
+/* Blend the four bytes of two 8888 pixels like ALPHA_BLEND, alpha in 0..255 */
+static __inline__ Uint32 BlendKey8888(Uint32 s, Uint32 d, Uint32 alpha)
+{
+	Uint32 rb = ((s & 0xff00ff) * alpha + (d & 0xff00ff) * (256 - alpha)
+	             + 0xff00ff) >> 8;
+	Uint32 ga = ((s >> 8 & 0xff00ff) * alpha + (d >> 8 & 0xff00ff) * (256 - alpha)
+	             + 0xff00ff);
+	return (rb & 0xff00ff) | (ga & 0xff00ff00);
+}
+
+/* One channel of a 16 bit pixel blended like ALPHA_BLEND, in place */
+static __inline__ Uint32 BlendKeyChannel(Uint32 s, Uint32 d, Uint32 alpha,
+                                         int shift, Uint32 mask, int loss)
+{
+	s = ((s >> shift) & mask) << loss;
+	d = ((d >> shift) & mask) << loss;
+	return ((s * alpha + d * (256 - alpha) + 255) >> (8 + loss)) << shift;
+}
+
+static __inline__ void BlitRGBtoRGBSurfaceAlphaKeyTail(Uint32 *srcp,
+                                                       Uint32 *dstp, int width,
+                                                       Uint32 alpha, Uint32 ckey,
+                                                       Uint32 rgbmask,
+                                                       Uint32 amask)
+{
+	while ( width-- ) {
+		Uint32 s = *srcp++;
+		if ( s != ckey ) {
+			*dstp = (BlendKey8888(s, *dstp, alpha) & rgbmask) | amask;
+		}
+		++dstp;
+	}
+}
+
+static __inline__ void Blit16to16SurfaceAlphaKeyTail(Uint16 *srcp,
+                                                     Uint16 *dstp, int width,
+                                                     Uint32 alpha, Uint32 ckey,
+                                                     int green6)
+{
+	const int rshift = green6 ? 11 : 10;
+	const Uint32 gmask = green6 ? 0x3f : 0x1f;
+	const int gloss = green6 ? 2 : 3;
+
+	while ( width-- ) {
+		Uint32 s = *srcp++;
+		if ( s != ckey ) {
+			Uint32 d = *dstp;
+			*dstp = (Uint16)(BlendKeyChannel(s, d, alpha, rshift, 0x1f, 3) |
+			                 BlendKeyChannel(s, d, alpha, 5, gmask, gloss) |
+			                 BlendKeyChannel(s, d, alpha, 0, 0x1f, 3));
+		}
+		++dstp;
+	}
+}
+#endif /* SSE2_BLITTERS || NEON_BLITTERS */
+
+#if SSE2_BLITTERS
+SDL_BEGIN_SSE2
+
+/* Blend 16 bit channels, alpha in 0..256 */
+static __inline__ __m128i SSE2_Blend8(__m128i s, __m128i d, __m128i alpha)
+{
+	__m128i inv = _mm_sub_epi16(_mm_set1_epi16(256), alpha);
+	return _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(s, alpha),
+	                                    _mm_mullo_epi16(d, inv)), 8);
+}
+
+/* Same for 5 and 6 bit channels, alpha in 0..32 */
+static __inline__ __m128i SSE2_Blend5(__m128i s, __m128i d, __m128i alpha)
+{
+	__m128i inv = _mm_sub_epi16(_mm_set1_epi16(32), alpha);
+	return _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(s, alpha),
+	                                    _mm_mullo_epi16(d, inv)), 5);
+}
+
+/* Alpha of the two pixels in 's' (8 bit channels widened to 16), opaque
+   bumped to 256 */
+static __inline__ __m128i SSE2_SplatAlpha(__m128i s)
+{
+	__m128i alpha;
+
+	alpha = _mm_shufflelo_epi16(s, _MM_SHUFFLE(3, 3, 3, 3));
+	alpha = _mm_shufflehi_epi16(alpha, _MM_SHUFFLE(3, 3, 3, 3));
+	return _mm_sub_epi16(alpha,
+	                     _mm_cmpeq_epi16(alpha, _mm_set1_epi16(255)));
+}
+
+/* fast ARGB888->(A)RGB888 blending with pixel alpha, 4 pixels at a time */
+static void BlitRGBtoRGBPixelAlphaSSE2(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint32 *srcp = (Uint32 *)info->s_pixels;
+	int srcskip = info->s_skip >> 2;
+	Uint32 *dstp = (Uint32 *)info->d_pixels;
+	int dstskip = info->d_skip >> 2;
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i amask = _mm_set1_epi32(0xff000000);
+
+	while ( height-- ) {
+		int n = width;
+		while ( n >= 4 ) {
+			__m128i s = _mm_loadu_si128((const __m128i *)srcp);
+			__m128i a = _mm_and_si128(s, amask);
+
+			/* Skip transparent runs, copy opaque ones */
+			if ( _mm_movemask_epi8(_mm_cmpeq_epi32(a, zero)) != 0xffff ) {
+				__m128i d = _mm_loadu_si128((__m128i *)dstp);
+				__m128i c;
+				if ( _mm_movemask_epi8(_mm_cmpeq_epi32(a, amask)) == 0xffff ) {
+					c = s;
+				} else {
+					__m128i slo = _mm_unpacklo_epi8(s, zero);
+					__m128i shi = _mm_unpackhi_epi8(s, zero);
+					__m128i dlo = _mm_unpacklo_epi8(d, zero);
+					__m128i dhi = _mm_unpackhi_epi8(d, zero);
+					dlo = SSE2_Blend8(slo, dlo, SSE2_SplatAlpha(slo));
+					dhi = SSE2_Blend8(shi, dhi, SSE2_SplatAlpha(shi));
+					c = _mm_packus_epi16(dlo, dhi);
+				}
+				d = _mm_or_si128(_mm_andnot_si128(amask, c),
+				                 _mm_and_si128(amask, d));
+				_mm_storeu_si128((__m128i *)dstp, d);
+			}
+			srcp += 4;
+			dstp += 4;
+			n -= 4;
+		}
+		BlitRGBtoRGBPixelAlphaTail(srcp, dstp, n);
+		srcp += n + srcskip;
+		dstp += n + dstskip;
+	}
+}
+
+/* fast RGB888->(A)RGB888 blending with surface alpha, 4 pixels at a time */
+static void BlitRGBtoRGBSurfaceAlphaSSE2(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint32 *srcp = (Uint32 *)info->s_pixels;
+	int srcskip = info->s_skip >> 2;
+	Uint32 *dstp = (Uint32 *)info->d_pixels;
+	int dstskip = info->d_skip >> 2;
+	Uint32 alpha = info->src->alpha;
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i amask = _mm_set1_epi32(0xff000000);
+	const __m128i a = _mm_set1_epi16((short)alpha);
+
+	while ( height-- ) {
+		int n = width;
+		while ( n >= 4 ) {
+			__m128i s = _mm_loadu_si128((const __m128i *)srcp);
+			__m128i d = _mm_loadu_si128((__m128i *)dstp);
+			__m128i lo = SSE2_Blend8(_mm_unpacklo_epi8(s, zero),
+			                         _mm_unpacklo_epi8(d, zero), a);
+			__m128i hi = SSE2_Blend8(_mm_unpackhi_epi8(s, zero),
+			                         _mm_unpackhi_epi8(d, zero), a);
+			d = _mm_or_si128(_mm_packus_epi16(lo, hi), amask);
+			_mm_storeu_si128((__m128i *)dstp, d);
+			srcp += 4;
+			dstp += 4;
+			n -= 4;
+		}
+		BlitRGBtoRGBSurfaceAlphaTail(srcp, dstp, n, alpha);
+		srcp += n + srcskip;
+		dstp += n + dstskip;
+	}
+}
+
+/* Byte 'shift' of 8 ARGB pixels as 16 bit values */
+#define SSE2_CHANNEL(s0, s1, shift, byte)				\
+	_mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(s0, shift), byte),	\
+	                _mm_and_si128(_mm_srli_epi32(s1, shift), byte))
+
+/* fast ARGB8888->RGB565/RGB555 blending with pixel alpha, 8 pixels at a
+   time.  The low source byte goes to the low 5 bits, like the C version. */
+static __inline__ void BlitARGBto16PixelAlphaSSE2(SDL_BlitInfo *info,
+                                                  int green6)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint32 *srcp = (Uint32 *)info->s_pixels;
+	int srcskip = info->s_skip >> 2;
+	Uint16 *dstp = (Uint16 *)info->d_pixels;
+	int dstskip = info->d_skip >> 1;
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i byte = _mm_set1_epi32(0xff);
+	const __m128i five = _mm_set1_epi16(0x1f);
+	const __m128i gmask = _mm_set1_epi16(green6 ? 0x3f : 0x1f);
+	const __m128i opaque = _mm_set1_epi16(SDL_ALPHA_OPAQUE >> 3);
+	const int gloss = green6 ? 2 : 3;
+	const int rshift = green6 ? 11 : 10;
+
+	while ( height-- ) {
+		int n = width;
+		while ( n >= 8 ) {
+			__m128i s0 = _mm_loadu_si128((const __m128i *)srcp);
+			__m128i s1 = _mm_loadu_si128((const __m128i *)(srcp + 4));
+			__m128i a = _mm_packs_epi32(_mm_srli_epi32(s0, 27),
+			                            _mm_srli_epi32(s1, 27));
+			__m128i keep = _mm_cmpeq_epi16(a, zero);
+
+			if ( _mm_movemask_epi8(keep) != 0xffff ) {
+				__m128i d = _mm_loadu_si128((__m128i *)dstp);
+				__m128i b, g, r;
+
+				a = _mm_sub_epi16(a, _mm_cmpeq_epi16(a, opaque));
+				b = SSE2_Blend5(_mm_srli_epi16(SSE2_CHANNEL(s0, s1, 0, byte), 3),
+				                _mm_and_si128(d, five), a);
+				g = SSE2_Blend5(_mm_srli_epi16(SSE2_CHANNEL(s0, s1, 8, byte), gloss),
+				                _mm_and_si128(_mm_srli_epi16(d, 5), gmask), a);
+				r = SSE2_Blend5(_mm_srli_epi16(SSE2_CHANNEL(s0, s1, 16, byte), 3),
+				                _mm_and_si128(_mm_srli_epi16(d, rshift), five), a);
+				r = _mm_or_si128(_mm_slli_epi16(r, rshift),
+				                 _mm_or_si128(_mm_slli_epi16(g, 5), b));
+
+				/* Transparent pixels are left alone, unused bit included */
+				d = _mm_or_si128(_mm_and_si128(keep, d),
+				                 _mm_andnot_si128(keep, r));
+				_mm_storeu_si128((__m128i *)dstp, d);
+			}
+			srcp += 8;
+			dstp += 8;
+			n -= 8;
+		}
+		BlitARGBto16PixelAlphaTail(srcp, dstp, n, green6);
+		srcp += n + srcskip;
+		dstp += n + dstskip;
+	}
+}
+
+static void BlitARGBto565PixelAlphaSSE2(SDL_BlitInfo *info)
+{
+	BlitARGBto16PixelAlphaSSE2(info, 1);
+}
+
+static void BlitARGBto555PixelAlphaSSE2(SDL_BlitInfo *info)
+{
+	BlitARGBto16PixelAlphaSSE2(info, 0);
+}
+
+/* fast RGB565->RGB565 / RGB555->RGB555 blending with surface alpha,
+   8 pixels at a time */
+static __inline__ void Blit16to16SurfaceAlphaSSE2(SDL_BlitInfo *info,
+                                                  int green6)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint16 *srcp = (Uint16 *)info->s_pixels;
+	int srcskip = info->s_skip >> 1;
+	Uint16 *dstp = (Uint16 *)info->d_pixels;
+	int dstskip = info->d_skip >> 1;
+	Uint32 alpha = info->src->alpha >> 3;	/* downscale alpha to 5 bits */
+	const __m128i a = _mm_set1_epi16((short)alpha);
+	const __m128i five = _mm_set1_epi16(0x1f);
+	const __m128i gmask = _mm_set1_epi16(green6 ? 0x3f : 0x1f);
+	const int rshift = green6 ? 11 : 10;
+
+	while ( height-- ) {
+		int n = width;
+		while ( n >= 8 ) {
+			__m128i s = _mm_loadu_si128((const __m128i *)srcp);
+			__m128i d = _mm_loadu_si128((__m128i *)dstp);
+			__m128i b, g, r;
+
+			b = SSE2_Blend5(_mm_and_si128(s, five),
+			                _mm_and_si128(d, five), a);
+			g = SSE2_Blend5(_mm_and_si128(_mm_srli_epi16(s, 5), gmask),
+			                _mm_and_si128(_mm_srli_epi16(d, 5), gmask), a);
+			r = SSE2_Blend5(_mm_and_si128(_mm_srli_epi16(s, rshift), five),
+			                _mm_and_si128(_mm_srli_epi16(d, rshift), five), a);
+			d = _mm_or_si128(_mm_slli_epi16(r, rshift),
+			                 _mm_or_si128(_mm_slli_epi16(g, 5), b));
+			_mm_storeu_si128((__m128i *)dstp, d);
+			srcp += 8;
+			dstp += 8;
+			n -= 8;
+		}
+		Blit16to16SurfaceAlphaTail(srcp, dstp, n, alpha,
+		                           green6 ? 0x07e0f81f : 0x03e07c1f);
+		srcp += n + srcskip;
+		dstp += n + dstskip;
+	}
+}
+
+static void Blit565to565SurfaceAlphaSSE2(SDL_BlitInfo *info)
+{
+	Blit16to16SurfaceAlphaSSE2(info, 1);
+}
+
+static void Blit555to555SurfaceAlphaSSE2(SDL_BlitInfo *info)
+{
+	Blit16to16SurfaceAlphaSSE2(info, 0);
+}
+
+/* Blend 16 bit channels like ALPHA_BLEND, inv is 256-alpha */
+static __inline__ __m128i SSE2_BlendKey(__m128i s, __m128i d, __m128i alpha,
+                                        __m128i inv)
+{
+	return _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(s, alpha),
+	                                   _mm_mullo_epi16(d, inv)),
+	                     _mm_set1_epi16(255));
+}
+
+/* fast colorkeyed RGB888->(A)RGB888 blending with surface alpha, for any
+   order of the 8 bit channels, 4 pixels at a time */
+static void BlitRGBtoRGBSurfaceAlphaKeySSE2(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint32 *srcp = (Uint32 *)info->s_pixels;
+	int srcskip = info->s_skip >> 2;
+	Uint32 *dstp = (Uint32 *)info->d_pixels;
+	int dstskip = info->d_skip >> 2;
+	SDL_PixelFormat *dstfmt = info->dst;
+	Uint32 alpha = info->src->alpha;
+	Uint32 ckey = info->src->colorkey;
+	Uint32 rgbmask = dstfmt->Rmask | dstfmt->Gmask | dstfmt->Bmask;
+	Uint32 amask = dstfmt->Amask;
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i a = _mm_set1_epi16((short)alpha);
+	const __m128i inv = _mm_set1_epi16((short)(256 - alpha));
+	const __m128i key = _mm_set1_epi32(ckey);
+	const __m128i rgb = _mm_set1_epi32(rgbmask);
+	const __m128i am = _mm_set1_epi32(amask);
+
+	if ( !alpha ) {
+		return;
+	}
+	while ( height-- ) {
+		int n = width;
+		while ( n >= 4 ) {
+			__m128i s = _mm_loadu_si128((const __m128i *)srcp);
+			__m128i d = _mm_loadu_si128((__m128i *)dstp);
+			__m128i keep = _mm_cmpeq_epi32(s, key);
+			__m128i lo = SSE2_BlendKey(_mm_unpacklo_epi8(s, zero),
+			                           _mm_unpacklo_epi8(d, zero), a, inv);
+			__m128i hi = SSE2_BlendKey(_mm_unpackhi_epi8(s, zero),
+			                           _mm_unpackhi_epi8(d, zero), a, inv);
+			s = _mm_packus_epi16(_mm_srli_epi16(lo, 8),
+			                     _mm_srli_epi16(hi, 8));
+			s = _mm_or_si128(_mm_and_si128(s, rgb), am);
+			d = _mm_or_si128(_mm_and_si128(keep, d),
+			                 _mm_andnot_si128(keep, s));
+			_mm_storeu_si128((__m128i *)dstp, d);
+			srcp += 4;
+			dstp += 4;
+			n -= 4;
+		}
+		BlitRGBtoRGBSurfaceAlphaKeyTail(srcp, dstp, n, alpha, ckey,
+		                                rgbmask, amask);
+		srcp += n + srcskip;
+		dstp += n + dstskip;
+	}
+}
+
+/* One channel of 8 16 bit pixels for Blit16to16SurfaceAlphaKeySSE2,
+   in place */
+static __inline__ __m128i SSE2_BlendKeyChannel(__m128i s, __m128i d,
+                                               __m128i alpha, __m128i inv,
+                                               int shift, __m128i mask,
+                                               int loss)
+{
+	s = _mm_slli_epi16(_mm_and_si128(_mm_srli_epi16(s, shift), mask), loss);
+	d = _mm_slli_epi16(_mm_and_si128(_mm_srli_epi16(d, shift), mask), loss);
+	return _mm_slli_epi16(_mm_srli_epi16(SSE2_BlendKey(s, d, alpha, inv),
+	                                     8 + loss), shift);
+}
+
+/* fast colorkeyed RGB565->RGB565 / RGB555->RGB555 blending with surface
+   alpha, 8 pixels at a time */
+static __inline__ void Blit16to16SurfaceAlphaKeySSE2(SDL_BlitInfo *info,
+                                                     int green6)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint16 *srcp = (Uint16 *)info->s_pixels;
+	int srcskip = info->s_skip >> 1;
+	Uint16 *dstp = (Uint16 *)info->d_pixels;
+	int dstskip = info->d_skip >> 1;
+	Uint32 alpha = info->src->alpha;
+	Uint32 ckey = info->src->colorkey;
+	const __m128i a = _mm_set1_epi16((short)alpha);
+	const __m128i inv = _mm_set1_epi16((short)(256 - alpha));
+	const __m128i key = _mm_set1_epi16((short)ckey);
+	const __m128i five = _mm_set1_epi16(0x1f);
+	const __m128i gmask = _mm_set1_epi16(green6 ? 0x3f : 0x1f);
+	const int rshift = green6 ? 11 : 10;
+	const int gloss = green6 ? 2 : 3;
+
+	if ( !alpha ) {
+		return;
+	}
+	while ( height-- ) {
+		int n = width;
+		while ( n >= 8 ) {
+			__m128i s = _mm_loadu_si128((const __m128i *)srcp);
+			__m128i d = _mm_loadu_si128((__m128i *)dstp);
+			__m128i keep = _mm_cmpeq_epi16(s, key);
+			__m128i p;
+
+			p = _mm_or_si128(
+			    _mm_or_si128(
+			        SSE2_BlendKeyChannel(s, d, a, inv, rshift, five, 3),
+			        SSE2_BlendKeyChannel(s, d, a, inv, 5, gmask, gloss)),
+			    SSE2_BlendKeyChannel(s, d, a, inv, 0, five, 3));
+			d = _mm_or_si128(_mm_and_si128(keep, d),
+			                 _mm_andnot_si128(keep, p));
+			_mm_storeu_si128((__m128i *)dstp, d);
+			srcp += 8;
+			dstp += 8;
+			n -= 8;
+		}
+		Blit16to16SurfaceAlphaKeyTail(srcp, dstp, n, alpha, ckey, green6);
+		srcp += n + srcskip;
+		dstp += n + dstskip;
+	}
+}
+
+static void Blit565to565SurfaceAlphaKeySSE2(SDL_BlitInfo *info)
+{
+	Blit16to16SurfaceAlphaKeySSE2(info, 1);
+}
+
+static void Blit555to555SurfaceAlphaKeySSE2(SDL_BlitInfo *info)
+{
+	Blit16to16SurfaceAlphaKeySSE2(info, 0);
+}
+
+SDL_END_TARGET
+#endif /* SSE2_BLITTERS */
+
+#if SSSE3_BLITTERS
+SDL_BEGIN_SSSE3
+/*
+ * The SSSE3 blitters blend like the SSE2 ones, but pick the channels out
+ * of the source pixels with one byte shuffle each, instead of unpacking
+ * and shifting.
+ */
+
+/* Bytes 'byte' of four 8888 pixels into the low four 16 bit values */
+#define SSSE3_CHANNEL_MASK(byte) \
+	_mm_setr_epi8(byte, -1, byte + 4, -1, byte + 8, -1, byte + 12, -1, \
+	              -1, -1, -1, -1, -1, -1, -1, -1)
+
+/* fast ARGB888->(A)RGB888 blending with pixel alpha, 4 pixels at a time */
+static void BlitRGBtoRGBPixelAlphaSSSE3(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint32 *srcp = (Uint32 *)info->s_pixels;
+	int srcskip = info->s_skip >> 2;
+	Uint32 *dstp = (Uint32 *)info->d_pixels;
+	int dstskip = info->d_skip >> 2;
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i amask = _mm_set1_epi32(0xff000000);
+	const __m128i opaque = _mm_set1_epi16(255);
+	/* The alpha of pixels 0-1 and 2-3 spread over their channels */
+	const __m128i alo = _mm_setr_epi8(3, -1, 3, -1, 3, -1, 3, -1,
+	                                  7, -1, 7, -1, 7, -1, 7, -1);
+	const __m128i ahi = _mm_setr_epi8(11, -1, 11, -1, 11, -1, 11, -1,
+	                                  15, -1, 15, -1, 15, -1, 15, -1);
+
+	while ( height-- ) {
+		int n = width;
+		while ( n >= 4 ) {
+			__m128i s = _mm_loadu_si128((const __m128i *)srcp);
+			__m128i a = _mm_and_si128(s, amask);
+
+			/* Skip transparent runs, copy opaque ones */
+			if ( _mm_movemask_epi8(_mm_cmpeq_epi32(a, zero)) != 0xffff ) {
+				__m128i d = _mm_loadu_si128((__m128i *)dstp);
+				__m128i c;
+				if ( _mm_movemask_epi8(_mm_cmpeq_epi32(a, amask)) == 0xffff ) {
+					c = s;
+				} else {
+					__m128i al = _mm_shuffle_epi8(s, alo);
+					__m128i ah = _mm_shuffle_epi8(s, ahi);
+					__m128i dlo, dhi;
+
+					al = _mm_sub_epi16(al, _mm_cmpeq_epi16(al, opaque));
+					ah = _mm_sub_epi16(ah, _mm_cmpeq_epi16(ah, opaque));
+					dlo = SSE2_Blend8(_mm_unpacklo_epi8(s, zero),
+					                  _mm_unpacklo_epi8(d, zero), al);
+					dhi = SSE2_Blend8(_mm_unpackhi_epi8(s, zero),
+					                  _mm_unpackhi_epi8(d, zero), ah);
+					c = _mm_packus_epi16(dlo, dhi);
+				}
+				d = _mm_or_si128(_mm_andnot_si128(amask, c),
+				                 _mm_and_si128(amask, d));
+				_mm_storeu_si128((__m128i *)dstp, d);
+			}
+			srcp += 4;
+			dstp += 4;
+			n -= 4;
+		}
+		BlitRGBtoRGBPixelAlphaTail(srcp, dstp, n);
+		srcp += n + srcskip;
+		dstp += n + dstskip;
+	}
+}
+
+/* One byte of 8 ARGB pixels as 16 bit values */
+#define SSSE3_CHANNEL(s0, s1, mask) \
+	_mm_unpacklo_epi64(_mm_shuffle_epi8(s0, mask), _mm_shuffle_epi8(s1, mask))
+
+/* fast ARGB8888->RGB565/RGB555 blending with pixel alpha, 8 pixels at a
+   time */
+static __inline__ void BlitARGBto16PixelAlphaSSSE3(SDL_BlitInfo *info,
+                                                   int green6)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint32 *srcp = (Uint32 *)info->s_pixels;
+	int srcskip = info->s_skip >> 2;
+	Uint16 *dstp = (Uint16 *)info->d_pixels;
+	int dstskip = info->d_skip >> 1;
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i five = _mm_set1_epi16(0x1f);
+	const __m128i gmask = _mm_set1_epi16(green6 ? 0x3f : 0x1f);
+	const __m128i opaque = _mm_set1_epi16(SDL_ALPHA_OPAQUE >> 3);
+	const __m128i bbyte = SSSE3_CHANNEL_MASK(0);
+	const __m128i gbyte = SSSE3_CHANNEL_MASK(1);
+	const __m128i rbyte = SSSE3_CHANNEL_MASK(2);
+	const __m128i abyte = SSSE3_CHANNEL_MASK(3);
+	const int gloss = green6 ? 2 : 3;
+	const int rshift = green6 ? 11 : 10;
+
+	while ( height-- ) {
+		int n = width;
+		while ( n >= 8 ) {
+			__m128i s0 = _mm_loadu_si128((const __m128i *)srcp);
+			__m128i s1 = _mm_loadu_si128((const __m128i *)(srcp + 4));
+			__m128i a = _mm_srli_epi16(SSSE3_CHANNEL(s0, s1, abyte), 3);
+			__m128i keep = _mm_cmpeq_epi16(a, zero);
+
+			if ( _mm_movemask_epi8(keep) != 0xffff ) {
+				__m128i d = _mm_loadu_si128((__m128i *)dstp);
+				__m128i b, g, r;
+
+				a = _mm_sub_epi16(a, _mm_cmpeq_epi16(a, opaque));
+				b = SSE2_Blend5(_mm_srli_epi16(SSSE3_CHANNEL(s0, s1, bbyte), 3),
+				                _mm_and_si128(d, five), a);
+				g = SSE2_Blend5(_mm_srli_epi16(SSSE3_CHANNEL(s0, s1, gbyte), gloss),
+				                _mm_and_si128(_mm_srli_epi16(d, 5), gmask), a);
+				r = SSE2_Blend5(_mm_srli_epi16(SSSE3_CHANNEL(s0, s1, rbyte), 3),
+				                _mm_and_si128(_mm_srli_epi16(d, rshift), five), a);
+				r = _mm_or_si128(_mm_slli_epi16(r, rshift),
+				                 _mm_or_si128(_mm_slli_epi16(g, 5), b));
+
+				/* Transparent pixels are left alone, unused bit included */
+				d = _mm_or_si128(_mm_and_si128(keep, d),
+				                 _mm_andnot_si128(keep, r));
+				_mm_storeu_si128((__m128i *)dstp, d);
+			}
+			srcp += 8;
+			dstp += 8;
+			n -= 8;
+		}
+		BlitARGBto16PixelAlphaTail(srcp, dstp, n, green6);
+		srcp += n + srcskip;
+		dstp += n + dstskip;
+	}
+}
+
+static void BlitARGBto565PixelAlphaSSSE3(SDL_BlitInfo *info)
+{
+	BlitARGBto16PixelAlphaSSSE3(info, 1);
+}
+
+static void BlitARGBto555PixelAlphaSSSE3(SDL_BlitInfo *info)
+{
+	BlitARGBto16PixelAlphaSSSE3(info, 0);
+}
+
+SDL_END_TARGET
+#endif /* SSSE3_BLITTERS */
+
+#if NEON_BLITTERS
+SDL_BEGIN_NEON
+
+/* Blend 8 bit channels widened to 16, alpha in 0..256 */
+static __inline__ uint8x8_t NEON_Blend8(uint8x8_t s, uint8x8_t d,
+                                        uint16x8_t alpha)
+{
+	uint16x8_t inv = vsubq_u16(vdupq_n_u16(256), alpha);
+	return vshrn_n_u16(vmlaq_u16(vmulq_u16(vmovl_u8(s), alpha),
+	                             vmovl_u8(d), inv), 8);
+}
+
+/* Same for 5 and 6 bit channels, alpha in 0..32 */
+static __inline__ uint16x8_t NEON_Blend5(uint16x8_t s, uint16x8_t d,
+                                         uint16x8_t alpha)
+{
+	uint16x8_t inv = vsubq_u16(vdupq_n_u16(32), alpha);
+	return vshrq_n_u16(vmlaq_u16(vmulq_u16(s, alpha), d, inv), 5);
+}
+
+/* fast ARGB888->(A)RGB888 blending with pixel alpha, 8 pixels at a time */
+static void BlitRGBtoRGBPixelAlphaNEON(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint32 *srcp = (Uint32 *)info->s_pixels;
+	int srcskip = info->s_skip >> 2;
+	Uint32 *dstp = (Uint32 *)info->d_pixels;
+	int dstskip = info->d_skip >> 2;
+
+	while ( height-- ) {
+		int n = width;
+		while ( n >= 8 ) {
+			uint8x8x4_t s = vld4_u8((const uint8_t *)srcp);
+			uint64_t a = vget_lane_u64(vreinterpret_u64_u8(s.val[3]), 0);
+
+			/* Skip transparent runs, copy opaque ones */
+			if ( a != 0 ) {
+				uint8x8x4_t d = vld4_u8((const uint8_t *)dstp);
+				if ( a == ~(uint64_t)0 ) {
+					d.val[0] = s.val[0];
+					d.val[1] = s.val[1];
+					d.val[2] = s.val[2];
+				} else {
+					uint16x8_t alpha = vmovl_u8(s.val[3]);
+					alpha = vsubq_u16(alpha,
+					        vceqq_u16(alpha, vdupq_n_u16(255)));
+					d.val[0] = NEON_Blend8(s.val[0], d.val[0], alpha);
+					d.val[1] = NEON_Blend8(s.val[1], d.val[1], alpha);
+					d.val[2] = NEON_Blend8(s.val[2], d.val[2], alpha);
+				}
+				vst4_u8((uint8_t *)dstp, d);
+			}
+			srcp += 8;
+			dstp += 8;
+			n -= 8;
+		}
+		BlitRGBtoRGBPixelAlphaTail(srcp, dstp, n);
+		srcp += n + srcskip;
+		dstp += n + dstskip;
+	}
+}
+
+/* fast RGB888->(A)RGB888 blending with surface alpha, 8 pixels at a time */
+static void BlitRGBtoRGBSurfaceAlphaNEON(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint32 *srcp = (Uint32 *)info->s_pixels;
+	int srcskip = info->s_skip >> 2;
+	Uint32 *dstp = (Uint32 *)info->d_pixels;
+	int dstskip = info->d_skip >> 2;
+	Uint32 alpha = info->src->alpha;
+	const uint16x8_t a = vdupq_n_u16((uint16_t)alpha);
+
+	while ( height-- ) {
+		int n = width;
+		while ( n >= 8 ) {
+			uint8x8x4_t s = vld4_u8((const uint8_t *)srcp);
+			uint8x8x4_t d = vld4_u8((const uint8_t *)dstp);
+			d.val[0] = NEON_Blend8(s.val[0], d.val[0], a);
+			d.val[1] = NEON_Blend8(s.val[1], d.val[1], a);
+			d.val[2] = NEON_Blend8(s.val[2], d.val[2], a);
+			d.val[3] = vdup_n_u8(0xff);
+			vst4_u8((uint8_t *)dstp, d);
+			srcp += 8;
+			dstp += 8;
+			n -= 8;
+		}
+		BlitRGBtoRGBSurfaceAlphaTail(srcp, dstp, n, alpha);
+		srcp += n + srcskip;
+		dstp += n + dstskip;
+	}
+}
+
+/* fast ARGB8888->RGB565/RGB555 blending with pixel alpha, 8 pixels at a
+   time.  The low source byte goes to the low 5 bits, like the C version. */
+static __inline__ void BlitARGBto16PixelAlphaNEON(SDL_BlitInfo *info,
+                                                  int green6)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint32 *srcp = (Uint32 *)info->s_pixels;
+	int srcskip = info->s_skip >> 2;
+	Uint16 *dstp = (Uint16 *)info->d_pixels;
+	int dstskip = info->d_skip >> 1;
+	const uint16x8_t five = vdupq_n_u16(0x1f);
+	const uint16x8_t gmask = vdupq_n_u16(green6 ? 0x3f : 0x1f);
+	const int16x8_t gloss = vdupq_n_s16(green6 ? -2 : -3);
+	const int16x8_t gshift = vdupq_n_s16(-5);
+	const int16x8_t rshift = vdupq_n_s16(green6 ? -11 : -10);
+
+	while ( height-- ) {
+		int n = width;
+		while ( n >= 8 ) {
+			uint8x8x4_t s = vld4_u8((const uint8_t *)srcp);
+
+			if ( vget_lane_u64(vreinterpret_u64_u8(s.val[3]), 0) ) {
+				uint16x8_t d = vld1q_u16(dstp);
+				uint16x8_t a = vmovl_u8(vshr_n_u8(s.val[3], 3));
+				uint16x8_t keep = vceqq_u16(a, vdupq_n_u16(0));
+				uint16x8_t b, g, r;
+
+				a = vsubq_u16(a, vceqq_u16(a, vdupq_n_u16(SDL_ALPHA_OPAQUE >> 3)));
+				b = NEON_Blend5(vmovl_u8(vshr_n_u8(s.val[0], 3)),
+				                vandq_u16(d, five), a);
+				g = NEON_Blend5(vshlq_u16(vmovl_u8(s.val[1]), gloss),
+				                vandq_u16(vshlq_u16(d, gshift), gmask), a);
+				r = NEON_Blend5(vmovl_u8(vshr_n_u8(s.val[2], 3)),
+				                vandq_u16(vshlq_u16(d, rshift), five), a);
+				r = vorrq_u16(vshlq_u16(r, vnegq_s16(rshift)),
+				              vorrq_u16(vshlq_n_u16(g, 5), b));
+
+				/* Transparent pixels are left alone, unused bit included */
+				vst1q_u16(dstp, vbslq_u16(keep, d, r));
+			}
+			srcp += 8;
+			dstp += 8;
+			n -= 8;
+		}
+		BlitARGBto16PixelAlphaTail(srcp, dstp, n, green6);
+		srcp += n + srcskip;
+		dstp += n + dstskip;
+	}
+}
+
+static void BlitARGBto565PixelAlphaNEON(SDL_BlitInfo *info)
+{
+	BlitARGBto16PixelAlphaNEON(info, 1);
+}
+
+static void BlitARGBto555PixelAlphaNEON(SDL_BlitInfo *info)
+{
+	BlitARGBto16PixelAlphaNEON(info, 0);
+}
+
+/* fast RGB565->RGB565 / RGB555->RGB555 blending with surface alpha,
+   8 pixels at a time */
+static __inline__ void Blit16to16SurfaceAlphaNEON(SDL_BlitInfo *info,
+                                                  int green6)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint16 *srcp = (Uint16 *)info->s_pixels;
+	int srcskip = info->s_skip >> 1;
+	Uint16 *dstp = (Uint16 *)info->d_pixels;
+	int dstskip = info->d_skip >> 1;
+	Uint32 alpha = info->src->alpha >> 3;	/* downscale alpha to 5 bits */
+	const uint16x8_t a = vdupq_n_u16((uint16_t)alpha);
+	const uint16x8_t five = vdupq_n_u16(0x1f);
+	const uint16x8_t gmask = vdupq_n_u16(green6 ? 0x3f : 0x1f);
+	const int16x8_t gshift = vdupq_n_s16(-5);
+	const int16x8_t rshift = vdupq_n_s16(green6 ? -11 : -10);
+
+	while ( height-- ) {
+		int n = width;
+		while ( n >= 8 ) {
+			uint16x8_t s = vld1q_u16(srcp);
+			uint16x8_t d = vld1q_u16(dstp);
+			uint16x8_t b, g, r;
+
+			b = NEON_Blend5(vandq_u16(s, five), vandq_u16(d, five), a);
+			g = NEON_Blend5(vandq_u16(vshlq_u16(s, gshift), gmask),
+			                vandq_u16(vshlq_u16(d, gshift), gmask), a);
+			r = NEON_Blend5(vandq_u16(vshlq_u16(s, rshift), five),
+			                vandq_u16(vshlq_u16(d, rshift), five), a);
+			d = vorrq_u16(vshlq_u16(r, vnegq_s16(rshift)),
+			              vorrq_u16(vshlq_n_u16(g, 5), b));
+			vst1q_u16(dstp, d);
+			srcp += 8;
+			dstp += 8;
+			n -= 8;
+		}
+		Blit16to16SurfaceAlphaTail(srcp, dstp, n, alpha,
+		                           green6 ? 0x07e0f81f : 0x03e07c1f);
+		srcp += n + srcskip;
+		dstp += n + dstskip;
+	}
+}
+
+static void Blit565to565SurfaceAlphaNEON(SDL_BlitInfo *info)
+{
+	Blit16to16SurfaceAlphaNEON(info, 1);
+}
+
+static void Blit555to555SurfaceAlphaNEON(SDL_BlitInfo *info)
+{
+	Blit16to16SurfaceAlphaNEON(info, 0);
+}
+
+/* Blend 8 bit channels like ALPHA_BLEND, inv is 256-alpha */
+static __inline__ uint8x8_t NEON_BlendKey8(uint8x8_t s, uint8x8_t d,
+                                           uint16x8_t alpha, uint16x8_t inv)
+{
+	return vshrn_n_u16(vaddq_u16(vmlaq_u16(vmulq_u16(vmovl_u8(s), alpha),
+	                                       vmovl_u8(d), inv),
+	                             vdupq_n_u16(255)), 8);
+}
+
+/* fast colorkeyed RGB888->(A)RGB888 blending with surface alpha, for any
+   order of the 8 bit channels, 8 pixels at a time */
+static void BlitRGBtoRGBSurfaceAlphaKeyNEON(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint32 *srcp = (Uint32 *)info->s_pixels;
+	int srcskip = info->s_skip >> 2;
+	Uint32 *dstp = (Uint32 *)info->d_pixels;
+	int dstskip = info->d_skip >> 2;
+	SDL_PixelFormat *dstfmt = info->dst;
+	Uint32 alpha = info->src->alpha;
+	Uint32 ckey = info->src->colorkey;
+	Uint32 rgbmask = dstfmt->Rmask | dstfmt->Gmask | dstfmt->Bmask;
+	Uint32 amask = dstfmt->Amask;
+	const uint16x8_t a = vdupq_n_u16((uint16_t)alpha);
+	const uint16x8_t inv = vdupq_n_u16((uint16_t)(256 - alpha));
+	uint8x8_t key[4], rgb[4], am[4];
+	int i;
+
+	if ( !alpha ) {
+		return;
+	}
+	for ( i = 0; i < 4; ++i ) {
+		key[i] = vdup_n_u8((uint8_t)(ckey >> (i * 8)));
+		rgb[i] = vdup_n_u8((uint8_t)(rgbmask >> (i * 8)));
+		am[i] = vdup_n_u8((uint8_t)(amask >> (i * 8)));
+	}
+	while ( height-- ) {
+		int n = width;
+		while ( n >= 8 ) {
+			uint8x8x4_t s = vld4_u8((const uint8_t *)srcp);
+			uint8x8x4_t d = vld4_u8((const uint8_t *)dstp);
+			uint8x8_t keep;
+
+			keep = vand_u8(vand_u8(vceq_u8(s.val[0], key[0]),
+			                       vceq_u8(s.val[1], key[1])),
+			               vand_u8(vceq_u8(s.val[2], key[2]),
+			                       vceq_u8(s.val[3], key[3])));
+			for ( i = 0; i < 4; ++i ) {
+				uint8x8_t p = NEON_BlendKey8(s.val[i], d.val[i], a, inv);
+				p = vorr_u8(vand_u8(p, rgb[i]), am[i]);
+				d.val[i] = vbsl_u8(keep, d.val[i], p);
+			}
+			vst4_u8((uint8_t *)dstp, d);
+			srcp += 8;
+			dstp += 8;
+			n -= 8;
+		}
+		BlitRGBtoRGBSurfaceAlphaKeyTail(srcp, dstp, n, alpha, ckey,
+		                                rgbmask, amask);
+		srcp += n + srcskip;
+		dstp += n + dstskip;
+	}
+}
+
+/* One channel of 8 16 bit pixels for Blit16to16SurfaceAlphaKeyNEON,
+   in place */
+static __inline__ uint16x8_t NEON_BlendKeyChannel(uint16x8_t s, uint16x8_t d,
+                                                  uint16x8_t alpha,
+                                                  uint16x8_t inv, int shift,
+                                                  uint16x8_t mask, int loss)
+{
+	const int16x8_t down = vdupq_n_s16((int16_t)-shift);
+	const int16x8_t up = vdupq_n_s16((int16_t)loss);
+	uint16x8_t p;
+
+	s = vshlq_u16(vandq_u16(vshlq_u16(s, down), mask), up);
+	d = vshlq_u16(vandq_u16(vshlq_u16(d, down), mask), up);
+	p = vaddq_u16(vmlaq_u16(vmulq_u16(s, alpha), d, inv), vdupq_n_u16(255));
+	p = vshlq_u16(p, vdupq_n_s16((int16_t)-(8 + loss)));
+	return vshlq_u16(p, vnegq_s16(down));
+}
+
+/* fast colorkeyed RGB565->RGB565 / RGB555->RGB555 blending with surface
+   alpha, 8 pixels at a time */
+static __inline__ void Blit16to16SurfaceAlphaKeyNEON(SDL_BlitInfo *info,
+                                                     int green6)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint16 *srcp = (Uint16 *)info->s_pixels;
+	int srcskip = info->s_skip >> 1;
+	Uint16 *dstp = (Uint16 *)info->d_pixels;
+	int dstskip = info->d_skip >> 1;
+	Uint32 alpha = info->src->alpha;
+	Uint32 ckey = info->src->colorkey;
+	const uint16x8_t a = vdupq_n_u16((uint16_t)alpha);
+	const uint16x8_t inv = vdupq_n_u16((uint16_t)(256 - alpha));
+	const uint16x8_t key = vdupq_n_u16((uint16_t)ckey);
+	const uint16x8_t five = vdupq_n_u16(0x1f);
+	const uint16x8_t gmask = vdupq_n_u16(green6 ? 0x3f : 0x1f);
+	const int rshift = green6 ? 11 : 10;
+	const int gloss = green6 ? 2 : 3;
+
+	if ( !alpha ) {
+		return;
+	}
+	while ( height-- ) {
+		int n = width;
+		while ( n >= 8 ) {
+			uint16x8_t s = vld1q_u16(srcp);
+			uint16x8_t d = vld1q_u16(dstp);
+			uint16x8_t p;
+
+			p = vorrq_u16(
+			    vorrq_u16(
+			        NEON_BlendKeyChannel(s, d, a, inv, rshift, five, 3),
+			        NEON_BlendKeyChannel(s, d, a, inv, 5, gmask, gloss)),
+			    NEON_BlendKeyChannel(s, d, a, inv, 0, five, 3));
+			vst1q_u16(dstp, vbslq_u16(vceqq_u16(s, key), d, p));
+			srcp += 8;
+			dstp += 8;
+			n -= 8;
+		}
+		Blit16to16SurfaceAlphaKeyTail(srcp, dstp, n, alpha, ckey, green6);
+		srcp += n + srcskip;
+		dstp += n + dstskip;
+	}
+}
+
+static void Blit565to565SurfaceAlphaKeyNEON(SDL_BlitInfo *info)
+{
+	Blit16to16SurfaceAlphaKeyNEON(info, 1);
+}
+
+static void Blit555to555SurfaceAlphaKeyNEON(SDL_BlitInfo *info)
+{
+	Blit16to16SurfaceAlphaKeyNEON(info, 0);
+}
+
+SDL_END_TARGET
+#endif /* NEON_BLITTERS */
+
+/* The format pairs of the alpha blitters, for SDL_SelectBlitKernel().
+   The _SW pairs are to destinations in system memory only. */
+enum {
+    /* Per-surface alpha with a colorkey */
+    SURFKEY_NTO1	= 0x00000001,	/* to 8-bit */
+    SURFKEY_565		= 0x00000002,	/* RGB565 to itself, 16-bit key */
+    SURFKEY_555		= 0x00000004,	/* RGB555 to itself, 16-bit key */
+    SURFKEY_RGB888	= 0x00000008,	/* 32-bit to the same bytewise RGB */
+    SURFKEY_32_SW	= 0x00000010,	/* 32-bit to 32-bit */
+    SURFKEY_NTON	= 0x00000020,	/* anything else */
+    /* Per-surface alpha */
+    SURF_NTO1		= 0x00000040,	/* to 8-bit */
+    SURF_565		= 0x00000080,	/* RGB565 to itself */
+    SURF_555		= 0x00000100,	/* RGB555 to itself */
+    SURF_RGB888		= 0x00000200,	/* 32-bit to the same 8-8-8 bytewise RGB */
+    SURF_RGB_BYTES	= 0x00000400,	/* 32-bit to the same bytewise RGB */
+    SURF_RGB_SW		= 0x00000800,	/* 32-bit to the same 8-8-8 RGB */
+    SURF_RGB		= 0x00001000,	/* 32-bit to the same 8-8-8 RGB */
+    SURF_32_SW		= 0x00002000,	/* 32-bit to 32-bit */
+    SURF_NTON		= 0x00004000,	/* anything else */
+    /* Per-pixel alpha */
+    PIXEL_NTO1		= 0x00008000,	/* to 8-bit */
+    PIXEL_32TO565_SW	= 0x00010000,	/* 32-bit to RGB565 or BGR565 */
+    PIXEL_ARGB565	= 0x00020000,	/* ARGB8888 or ABGR8888 to 565 */
+    PIXEL_ARGB555	= 0x00040000,	/* ARGB8888 or ABGR8888 to 555 */
+    PIXEL_ARGB8888	= 0x00080000,	/* 8-8-8-8 bytewise to the same RGB */
+    PIXEL_RGBA_BYTES	= 0x00100000,	/* bytewise RGBA to the same RGB */
+    PIXEL_ARGB_SW	= 0x00200000,	/* 8-8-8-8 to the same RGB */
+    PIXEL_ARGB		= 0x00400000,	/* 8-8-8-8 to the same RGB */
+    PIXEL_32_SW		= 0x00800000,	/* 32-bit to 32-bit */
+    PIXEL_NTON		= 0x01000000	/* anything else */
+};
+
+const SDL_BlitKernel SDL_AlphaBlitKernels[] = {
+#if SSSE3_BLITTERS
+	SDL_BLIT_KERNEL(BlitRGBtoRGBPixelAlphaSSSE3, SDL_BLIT_SSSE3, PIXEL_ARGB8888),
+	SDL_BLIT_KERNEL(BlitARGBto565PixelAlphaSSSE3, SDL_BLIT_SSSE3, PIXEL_ARGB565),
+	SDL_BLIT_KERNEL(BlitARGBto555PixelAlphaSSSE3, SDL_BLIT_SSSE3, PIXEL_ARGB555),
+#endif
+#if SSE2_BLITTERS
+	SDL_BLIT_KERNEL(BlitRGBtoRGBPixelAlphaSSE2, SDL_BLIT_SSE2, PIXEL_ARGB8888),
+	SDL_BLIT_KERNEL(BlitRGBtoRGBSurfaceAlphaSSE2, SDL_BLIT_SSE2, SURF_RGB888),
+	SDL_BLIT_KERNEL(BlitARGBto565PixelAlphaSSE2, SDL_BLIT_SSE2, PIXEL_ARGB565),
+	SDL_BLIT_KERNEL(BlitARGBto555PixelAlphaSSE2, SDL_BLIT_SSE2, PIXEL_ARGB555),
+	SDL_BLIT_KERNEL(Blit565to565SurfaceAlphaSSE2, SDL_BLIT_SSE2, SURF_565),
+	SDL_BLIT_KERNEL(Blit555to555SurfaceAlphaSSE2, SDL_BLIT_SSE2, SURF_555),
+	SDL_BLIT_KERNEL(BlitRGBtoRGBSurfaceAlphaKeySSE2, SDL_BLIT_SSE2, SURFKEY_RGB888),
+	SDL_BLIT_KERNEL(Blit565to565SurfaceAlphaKeySSE2, SDL_BLIT_SSE2, SURFKEY_565),
+	SDL_BLIT_KERNEL(Blit555to555SurfaceAlphaKeySSE2, SDL_BLIT_SSE2, SURFKEY_555),
+#endif
+#if NEON_BLITTERS
+	SDL_BLIT_KERNEL(BlitRGBtoRGBPixelAlphaNEON, SDL_BLIT_NEON, PIXEL_ARGB8888),
+	SDL_BLIT_KERNEL(BlitRGBtoRGBSurfaceAlphaNEON, SDL_BLIT_NEON, SURF_RGB888),
+	SDL_BLIT_KERNEL(BlitARGBto565PixelAlphaNEON, SDL_BLIT_NEON, PIXEL_ARGB565),
+	SDL_BLIT_KERNEL(BlitARGBto555PixelAlphaNEON, SDL_BLIT_NEON, PIXEL_ARGB555),
+	SDL_BLIT_KERNEL(Blit565to565SurfaceAlphaNEON, SDL_BLIT_NEON, SURF_565),
+	SDL_BLIT_KERNEL(Blit555to555SurfaceAlphaNEON, SDL_BLIT_NEON, SURF_555),
+	SDL_BLIT_KERNEL(BlitRGBtoRGBSurfaceAlphaKeyNEON, SDL_BLIT_NEON, SURFKEY_RGB888),
+	SDL_BLIT_KERNEL(Blit565to565SurfaceAlphaKeyNEON, SDL_BLIT_NEON, SURFKEY_565),
+	SDL_BLIT_KERNEL(Blit555to555SurfaceAlphaKeyNEON, SDL_BLIT_NEON, SURFKEY_555),
+#endif
+#if MMX_ASMBLIT
+	SDL_BLIT_KERNEL(BlitRGBtoRGBSurfaceAlphaMMX, SDL_BLIT_MMX, SURF_RGB_BYTES),
+	SDL_BLIT_KERNEL(BlitRGBtoRGBPixelAlphaMMX3DNOW, SDL_BLIT_MMX|SDL_BLIT_3DNOW, PIXEL_RGBA_BYTES),
+	SDL_BLIT_KERNEL(BlitRGBtoRGBPixelAlphaMMX, SDL_BLIT_MMX, PIXEL_RGBA_BYTES),
+	SDL_BLIT_KERNEL(Blit565to565SurfaceAlphaMMX, SDL_BLIT_MMX, SURF_565),
+	SDL_BLIT_KERNEL(Blit555to555SurfaceAlphaMMX, SDL_BLIT_MMX, SURF_555),
+#endif
+#if SDL_ALTIVEC_BLITTERS
+	SDL_BLIT_KERNEL(Blit32to565PixelAlphaAltivec, SDL_BLIT_ALTIVEC, PIXEL_32TO565_SW),
+	SDL_BLIT_KERNEL(BlitRGBtoRGBPixelAlphaAltivec, SDL_BLIT_ALTIVEC, PIXEL_ARGB_SW),
+	SDL_BLIT_KERNEL(Blit32to32PixelAlphaAltivec, SDL_BLIT_ALTIVEC, PIXEL_32_SW),
+	SDL_BLIT_KERNEL(BlitRGBtoRGBSurfaceAlphaAltivec, SDL_BLIT_ALTIVEC, SURF_RGB_SW),
+	SDL_BLIT_KERNEL(Blit32to32SurfaceAlphaAltivec, SDL_BLIT_ALTIVEC, SURF_32_SW),
+	SDL_BLIT_KERNEL(Blit32to32SurfaceAlphaKeyAltivec, SDL_BLIT_ALTIVEC, SURFKEY_32_SW),
+#endif
+	SDL_BLIT_KERNEL(BlitNto1SurfaceAlpha, 0, SURF_NTO1),
+	SDL_BLIT_KERNEL(BlitNto1PixelAlpha, 0, PIXEL_NTO1),
+	SDL_BLIT_KERNEL(BlitNto1SurfaceAlphaKey, 0, SURFKEY_NTO1),
+	SDL_BLIT_KERNEL(BlitRGBtoRGBSurfaceAlpha, 0, SURF_RGB),
+	SDL_BLIT_KERNEL(BlitRGBtoRGBPixelAlpha, 0, PIXEL_ARGB),
+	SDL_BLIT_KERNEL(Blit565to565SurfaceAlpha, 0, SURF_565),
+	SDL_BLIT_KERNEL(Blit555to555SurfaceAlpha, 0, SURF_555),
+	SDL_BLIT_KERNEL(BlitARGBto565PixelAlpha, 0, PIXEL_ARGB565),
+	SDL_BLIT_KERNEL(BlitARGBto555PixelAlpha, 0, PIXEL_ARGB555),
+	SDL_BLIT_KERNEL(BlitNtoNSurfaceAlpha, 0, SURF_NTON),
+	SDL_BLIT_KERNEL(BlitNtoNSurfaceAlphaKey, 0, SURFKEY_NTON),
+	SDL_BLIT_KERNEL(BlitNtoNPixelAlpha, 0, PIXEL_NTON),
+	{ NULL }
+};
+
 SDL_loblit SDL_CalculateAlphaBlit(SDL_Surface *surface, int blit_index)
 {
     SDL_PixelFormat *sf = surface->format;
     SDL_PixelFormat *df = surface->map->dst->format;
-
+    int sw = !(surface->map->dst->flags & SDL_HWSURFACE);
+    int same_rgb = (sf->BytesPerPixel == 4
+		    && sf->Rmask == df->Rmask
+		    && sf->Gmask == df->Gmask
+		    && sf->Bmask == df->Bmask);
+    int rgb_bytes = (sf->Rshift % 8 == 0
+		     && sf->Gshift % 8 == 0
+		     && sf->Bshift % 8 == 0);
+    Uint32 pairs;
+
+    /* Find all the format pairs of the blit, the blitters for them are
+       picked fastest first */
     if(sf->Amask == 0) {
 	if((surface->flags & SDL_SRCCOLORKEY) == SDL_SRCCOLORKEY) {
 	    if(df->BytesPerPixel == 1)
-		return BlitNto1SurfaceAlphaKey;
-	    else
-#if SDL_ALTIVEC_BLITTERS
-	if (sf->BytesPerPixel == 4 && df->BytesPerPixel == 4 &&
-	    !(surface->map->dst->flags & SDL_HWSURFACE) && SDL_HasAltiVec())
-            return Blit32to32SurfaceAlphaKeyAltivec;
-        else
-#endif
-            return BlitNtoNSurfaceAlphaKey;
+		pairs = SURFKEY_NTO1;
+	    else {
+		pairs = SURFKEY_NTON;
+		if(df->BytesPerPixel == 2 && surface->map->identity
+		   && sf->colorkey <= 0xffff) {
+		    if(df->Gmask == 0x7e0)
+			pairs |= SURFKEY_565;
+		    else if(df->Gmask == 0x3e0)
+			pairs |= SURFKEY_555;
+		}
+		if(df->BytesPerPixel == 4 && same_rgb && rgb_bytes
+		   && sf->Rloss == 0 && sf->Gloss == 0 && sf->Bloss == 0)
+		    pairs |= SURFKEY_RGB888;
+		if(sf->BytesPerPixel == 4 && df->BytesPerPixel == 4 && sw)
+		    pairs |= SURFKEY_32_SW;
+	    }
 	} else {
 	    /* Per-surface alpha blits */
 	    switch(df->BytesPerPixel) {
 	    case 1:
-		return BlitNto1SurfaceAlpha;
+		pairs = SURF_NTO1;
+		break;
 
 	    case 2:
+		pairs = SURF_NTON;
 		if(surface->map->identity) {
 		    if(df->Gmask == 0x7e0)
-		    {
-#if MMX_ASMBLIT
-		if(SDL_HasMMX())
-			return Blit565to565SurfaceAlphaMMX;
-		else
-#endif
-			return Blit565to565SurfaceAlpha;
-		    }
+			pairs = SURF_565;
 		    else if(df->Gmask == 0x3e0)
-		    {
-#if MMX_ASMBLIT
-		if(SDL_HasMMX())
-			return Blit555to555SurfaceAlphaMMX;
-		else
-#endif
-			return Blit555to555SurfaceAlpha;
-		    }
+			pairs = SURF_555;
 		}
-		return BlitNtoNSurfaceAlpha;
+		break;
 
 	    case 4:
-		if(sf->Rmask == df->Rmask
-		   && sf->Gmask == df->Gmask
-		   && sf->Bmask == df->Bmask
-		   && sf->BytesPerPixel == 4)
-		{
-#if MMX_ASMBLIT
-			if(sf->Rshift % 8 == 0
-			   && sf->Gshift % 8 == 0
-			   && sf->Bshift % 8 == 0
-			   && SDL_HasMMX())
-			    return BlitRGBtoRGBSurfaceAlphaMMX;
-#endif
-			if((sf->Rmask | sf->Gmask | sf->Bmask) == 0xffffff)
-			{
-#if SDL_ALTIVEC_BLITTERS
-				if(!(surface->map->dst->flags & SDL_HWSURFACE)
-					&& SDL_HasAltiVec())
-					return BlitRGBtoRGBSurfaceAlphaAltivec;
-#endif
-				return BlitRGBtoRGBSurfaceAlpha;
-			}
+		pairs = SURF_NTON;
+		if(same_rgb) {
+		    if(rgb_bytes)
+			pairs |= SURF_RGB_BYTES;
+		    if((sf->Rmask | sf->Gmask | sf->Bmask) == 0xffffff) {
+			pairs |= SURF_RGB;
+			if(rgb_bytes)
+			    pairs |= SURF_RGB888;
+			if(sw)
+			    pairs |= SURF_RGB_SW;
+		    }
 		}
-#if SDL_ALTIVEC_BLITTERS
-		if((sf->BytesPerPixel == 4) &&
-		   !(surface->map->dst->flags & SDL_HWSURFACE) && SDL_HasAltiVec())
-			return Blit32to32SurfaceAlphaAltivec;
-		else
-#endif
-			return BlitNtoNSurfaceAlpha;
+		if(sf->BytesPerPixel == 4 && sw)
+		    pairs |= SURF_32_SW;
+		break;
 
 	    case 3:
 	    default:
-		return BlitNtoNSurfaceAlpha;
+		pairs = SURF_NTON;
+		break;
 	    }
 	}
     } else {
 	/* Per-pixel alpha blits */
 	switch(df->BytesPerPixel) {
 	case 1:
-	    return BlitNto1PixelAlpha;
+	    pairs = PIXEL_NTO1;
+	    break;
 
 	case 2:
-#if SDL_ALTIVEC_BLITTERS
-	if(sf->BytesPerPixel == 4 && !(surface->map->dst->flags & SDL_HWSURFACE) &&
-           df->Gmask == 0x7e0 &&
-	   df->Bmask == 0x1f && SDL_HasAltiVec())
-            return Blit32to565PixelAlphaAltivec;
-        else
-#endif
+	    pairs = PIXEL_NTON;
+	    if(sf->BytesPerPixel == 4 && sw
+	       && df->Gmask == 0x7e0 && df->Bmask == 0x1f)
+		pairs |= PIXEL_32TO565_SW;
 	    if(sf->BytesPerPixel == 4 && sf->Amask == 0xff000000
 	       && sf->Gmask == 0xff00
 	       && ((sf->Rmask == 0xff && df->Rmask == 0x1f)
 		   || (sf->Bmask == 0xff && df->Bmask == 0x1f))) {
 		if(df->Gmask == 0x7e0)
-		    return BlitARGBto565PixelAlpha;
+		    pairs |= PIXEL_ARGB565;
 		else if(df->Gmask == 0x3e0)
-		    return BlitARGBto555PixelAlpha;
+		    pairs |= PIXEL_ARGB555;
 	    }
-	    return BlitNtoNPixelAlpha;
+	    break;
 
 	case 4:
-	    if(sf->Rmask == df->Rmask
-	       && sf->Gmask == df->Gmask
-	       && sf->Bmask == df->Bmask
-	       && sf->BytesPerPixel == 4)
-	    {
-#if MMX_ASMBLIT
-		if(sf->Rshift % 8 == 0
-		   && sf->Gshift % 8 == 0
-		   && sf->Bshift % 8 == 0
-		   && sf->Ashift % 8 == 0
-		   && sf->Aloss == 0)
-		{
-			if(SDL_Has3DNow())
-				return BlitRGBtoRGBPixelAlphaMMX3DNOW;
-			if(SDL_HasMMX())
-				return BlitRGBtoRGBPixelAlphaMMX;
-		}
-#endif
-		if(sf->Amask == 0xff000000)
-		{
-#if SDL_ALTIVEC_BLITTERS
-			if(!(surface->map->dst->flags & SDL_HWSURFACE)
-				&& SDL_HasAltiVec())
-				return BlitRGBtoRGBPixelAlphaAltivec;
-#endif
-			return BlitRGBtoRGBPixelAlpha;
+	    pairs = PIXEL_NTON;
+	    if(same_rgb) {
+		if(rgb_bytes && sf->Ashift % 8 == 0 && sf->Aloss == 0)
+		    pairs |= PIXEL_RGBA_BYTES;
+		if(sf->Amask == 0xff000000) {
+		    pairs |= PIXEL_ARGB;
+		    if(rgb_bytes)
+			pairs |= PIXEL_ARGB8888;
+		    if(sw)
+			pairs |= PIXEL_ARGB_SW;
 		}
 	    }
-#if SDL_ALTIVEC_BLITTERS
-	    if (sf->Amask && sf->BytesPerPixel == 4 &&
-	        !(surface->map->dst->flags & SDL_HWSURFACE) && SDL_HasAltiVec())
-		return Blit32to32PixelAlphaAltivec;
-	    else
-#endif
-		return BlitNtoNPixelAlpha;
+	    if(sf->BytesPerPixel == 4 && sw)
+		pairs |= PIXEL_32_SW;
+	    break;
 
 	case 3:
 	default:
-	    return BlitNtoNPixelAlpha;
+	    pairs = PIXEL_NTON;
+	    break;
 	}
     }
+    return SDL_SelectBlitKernel(SDL_AlphaBlitKernels, pairs);
 }
 
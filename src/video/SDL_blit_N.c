@@ -25,6 +25,7 @@
 #include "SDL_endian.h"
 #include "SDL_cpuinfo.h"
 #include "SDL_blit.h"
+#include "SDL_blit_auto.h"
 
 /* Functions to blit from N-bit surfaces to other surfaces */
 
@@ -810,6 +811,9 @@ static void ConvertAltivec32to32_prefetch(SDL_BlitInfo *info)
     vec_dss(DST_CHAN_DEST);
 }
 
+/* Not a CPU feature: the AltiVec blitters shouldn't prefetch */
+#define BLIT_NO_PREFETCH	0x80000000
+
 static Uint32 GetBlitFeatures( void )
 {
     static Uint32 features = 0xffffffff;
@@ -817,18 +821,22 @@ static Uint32 GetBlitFeatures( void )
         /* Provide an override for testing .. */
         char *override = SDL_getenv("SDL_ALTIVEC_BLIT_FEATURES");
         if (override) {
-            features = 0;
-            SDL_sscanf(override, "%u", &features);
-        } else {
+            Uint32 bits = 0;
+            SDL_sscanf(override, "%u", &bits);
             features = ( 0
                 /* Feature 1 is has-MMX */
-                | ((SDL_HasMMX()) ? 1 : 0)
+                | ((bits & 1) ? SDL_BLIT_MMX : 0)
                 /* Feature 2 is has-AltiVec */
-                | ((SDL_HasAltiVec()) ? 2 : 0)
+                | ((bits & 2) ? SDL_BLIT_ALTIVEC : 0)
                 /* Feature 4 is dont-use-prefetch */
-                /* !!!! FIXME: Check for G5 or later, not the cache size! Always prefetch on a G4. */
-                | ((GetL3CacheSize() == 0) ? 4 : 0)
+                | ((bits & 4) ? BLIT_NO_PREFETCH : 0)
             );
+        } else {
+            features = SDL_GetBlitFeatures();
+            /* !!!! FIXME: Check for G5 or later, not the cache size! Always prefetch on a G4. */
+            if (GetL3CacheSize() == 0) {
+                features |= BLIT_NO_PREFETCH;
+            }
         }
     }
     return features;
@@ -837,8 +845,7 @@ static Uint32 GetBlitFeatures( void )
 #pragma altivec_model off
 #endif
 #else
-/* Feature 1 is has-MMX */
-#define GetBlitFeatures() ((Uint32)(SDL_HasMMX() ? 1 : 0))
+#define GetBlitFeatures()	SDL_GetBlitFeatures()
 #endif
 
 /* This is now endian dependent */
@@ -2269,6 +2276,322 @@ static void BlitNtoNKeyCopyAlpha(SDL_BlitInfo *info)
 	}
 }
 
+#if SSE2_BLITTERS || NEON_BLITTERS
+/* The bits of a keyed 32-bit pixel that get copied to a surface of the
+   same format.  Like BlitNtoNKey, alpha is only kept when there is an
+   alpha channel (BlitNtoNKeyCopyAlpha). */
+static Uint32 Key4to4WriteMask(SDL_PixelFormat *fmt)
+{
+	if ( fmt->Amask ) {
+		return 0xFFFFFFFF;
+	}
+	return fmt->Rmask | fmt->Gmask | fmt->Bmask;
+}
+
+static __inline__ void Blit4to4KeyTail(Uint32 *srcp, Uint32 *dstp, int width,
+                                       Uint32 rgbmask, Uint32 ckey, Uint32 keep)
+{
+	while ( width-- ) {
+		if ( (*srcp & rgbmask) != ckey ) {
+			*dstp = *srcp & keep;
+		}
+		++srcp;
+		++dstp;
+	}
+}
+#endif /* SSE2_BLITTERS || NEON_BLITTERS */
+
+#if NEON_BLITTERS
+SDL_BEGIN_NEON
+/* NEON blitters for 16-bit surfaces, 8 pixels at a time.  The pixels
+   left over at the end of a row get the same arithmetic in C. */
+
+/* 8888 -> 565/555, truncating like RGB888_RGB565().  'r' and 'b' are
+   the source bytes going to the high and the low field, 'g6' selects
+   565, 'rshift' is 11 or 10. */
+static __inline__ void Blit_8888_16NEON(SDL_BlitInfo *info,
+                                        int r, int b, int g6, int rshift)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint16 *dst = (Uint16 *)info->d_pixels;
+	int dstskip = info->d_skip >> 1;
+	const int gloss = g6 ? 2 : 3;
+	const int16x8_t gshift = vdupq_n_s16(-gloss);
+	const int16x8_t hishift = vdupq_n_s16(rshift);
+
+	while ( height-- ) {
+		int n = width;
+		while ( n >= 8 ) {
+			uint8x8x4_t s = vld4_u8(src);
+			uint16x8_t hi, mid, lo;
+
+			hi = vmovl_u8(vshr_n_u8(s.val[r], 3));
+			lo = vmovl_u8(vshr_n_u8(s.val[b], 3));
+			mid = vshlq_u16(vmovl_u8(s.val[1]), gshift);
+			mid = vshlq_n_u16(mid, 5);
+			vst1q_u16(dst, vorrq_u16(vshlq_u16(hi, hishift),
+			                         vorrq_u16(mid, lo)));
+			src += 32;
+			dst += 8;
+			n -= 8;
+		}
+		while ( n-- ) {
+			*dst++ = (Uint16)(((src[r] >> 3) << rshift) |
+			                  ((src[1] >> gloss) << 5) |
+			                  (src[b] >> 3));
+			src += 4;
+		}
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB888_RGB565NEON(SDL_BlitInfo *info)
+{
+	Blit_8888_16NEON(info, 2, 0, 1, 11);
+}
+
+static void Blit_RGB888_BGR565NEON(SDL_BlitInfo *info)
+{
+	Blit_8888_16NEON(info, 0, 2, 1, 11);
+}
+
+static void Blit_RGB888_RGB555NEON(SDL_BlitInfo *info)
+{
+	Blit_8888_16NEON(info, 2, 0, 0, 10);
+}
+
+static void Blit_RGB888_BGR555NEON(SDL_BlitInfo *info)
+{
+	Blit_8888_16NEON(info, 0, 2, 0, 10);
+}
+
+/* 565 -> 8888 with opaque alpha, giving the same values as the
+   RGB565_*_LUT tables.  Red and blue are v*255/31, which is
+   (v*1053)>>7.  The tables add up green from the two source bytes,
+   (g&0x38)*255/63 + (g&7)*255/63, which is ((g&0x38)*259>>6) + (g&7)*4.
+   The arguments are the byte each channel goes to. */
+static __inline__ void Blit_RGB565_32NEON(SDL_BlitInfo *info,
+                                          int r, int g, int b, int a)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint16 *src = (Uint16 *)info->s_pixels;
+	int srcskip = info->s_skip >> 1;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+	const uint16x8_t mul5 = vdupq_n_u16(1053);
+	const uint16x8_t mul6 = vdupq_n_u16(259);
+	const uint16x8_t five = vdupq_n_u16(0x1f);
+	const uint16x8_t ghi = vdupq_n_u16(0x38), glo = vdupq_n_u16(0x07);
+
+	while ( height-- ) {
+		int n = width;
+		while ( n >= 8 ) {
+			uint16x8_t s = vld1q_u16(src);
+			uint16x8_t green = vshrq_n_u16(s, 5);
+			uint8x8x4_t d;
+
+			d.val[r] = vshrn_n_u16(vmulq_u16(vshrq_n_u16(s, 11),
+			                                 mul5), 7);
+			green = vaddq_u16(vshrq_n_u16(vmulq_u16(
+			                  vandq_u16(green, ghi), mul6), 6),
+			                  vshlq_n_u16(vandq_u16(green, glo), 2));
+			d.val[g] = vmovn_u16(green);
+			d.val[b] = vshrn_n_u16(vmulq_u16(vandq_u16(s, five),
+			                                 mul5), 7);
+			d.val[a] = vdup_n_u8(0xff);
+			vst4_u8(dst, d);
+			src += 8;
+			dst += 32;
+			n -= 8;
+		}
+		while ( n-- ) {
+			Uint32 p = *src++;
+			dst[r] = (Uint8)(((p >> 11) * 1053) >> 7);
+			dst[g] = (Uint8)(((((p >> 5) & 0x38) * 259) >> 6) +
+			                 (((p >> 5) & 0x07) << 2));
+			dst[b] = (Uint8)(((p & 0x1f) * 1053) >> 7);
+			dst[a] = 0xff;
+			dst += 4;
+		}
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB565_ARGB8888NEON(SDL_BlitInfo *info)
+{
+	Blit_RGB565_32NEON(info, 2, 1, 0, 3);
+}
+
+static void Blit_RGB565_ABGR8888NEON(SDL_BlitInfo *info)
+{
+	Blit_RGB565_32NEON(info, 0, 1, 2, 3);
+}
+
+static void Blit_RGB565_RGBA8888NEON(SDL_BlitInfo *info)
+{
+	Blit_RGB565_32NEON(info, 3, 2, 1, 0);
+}
+
+static void Blit_RGB565_BGRA8888NEON(SDL_BlitInfo *info)
+{
+	Blit_RGB565_32NEON(info, 1, 2, 3, 0);
+}
+
+/* Colour key between two 16-bit surfaces of the same format */
+static void Blit2to2KeyNEON(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint16 *srcp = (Uint16 *)info->s_pixels;
+	int srcskip = info->s_skip >> 1;
+	Uint16 *dstp = (Uint16 *)info->d_pixels;
+	int dstskip = info->d_skip >> 1;
+	Uint16 rgbmask = (Uint16)~info->src->Amask;
+	Uint16 ckey = (Uint16)info->src->colorkey & rgbmask;
+	const uint16x8_t mask = vdupq_n_u16(rgbmask);
+	const uint16x8_t key = vdupq_n_u16(ckey);
+
+	while ( height-- ) {
+		int n = width;
+		while ( n >= 8 ) {
+			uint16x8_t s = vld1q_u16(srcp);
+			uint16x8_t keep = vceqq_u16(vandq_u16(s, mask), key);
+			vst1q_u16(dstp, vbslq_u16(keep, vld1q_u16(dstp), s));
+			srcp += 8;
+			dstp += 8;
+			n -= 8;
+		}
+		while ( n-- ) {
+			if ( (*srcp & rgbmask) != ckey ) {
+				*dstp = *srcp;
+			}
+			++srcp;
+			++dstp;
+		}
+		srcp += srcskip;
+		dstp += dstskip;
+	}
+}
+
+/* Colour key between two 32-bit surfaces of the same format */
+static void Blit4to4KeyNEON(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint32 *srcp = (Uint32 *)info->s_pixels;
+	int srcskip = info->s_skip >> 2;
+	Uint32 *dstp = (Uint32 *)info->d_pixels;
+	int dstskip = info->d_skip >> 2;
+	Uint32 rgbmask = ~info->src->Amask;
+	Uint32 ckey = info->src->colorkey & rgbmask;
+	Uint32 keep = Key4to4WriteMask(info->dst);
+	const uint32x4_t mask = vdupq_n_u32(rgbmask);
+	const uint32x4_t key = vdupq_n_u32(ckey);
+	const uint32x4_t write = vdupq_n_u32(keep);
+
+	while ( height-- ) {
+		int n = width;
+		while ( n >= 4 ) {
+			uint32x4_t s = vld1q_u32(srcp);
+			uint32x4_t keyed = vceqq_u32(vandq_u32(s, mask), key);
+			vst1q_u32(dstp, vbslq_u32(keyed, vld1q_u32(dstp),
+			                          vandq_u32(s, write)));
+			srcp += 4;
+			dstp += 4;
+			n -= 4;
+		}
+		Blit4to4KeyTail(srcp, dstp, n, rgbmask, ckey, keep);
+		srcp += n + srcskip;
+		dstp += n + dstskip;
+	}
+}
+SDL_END_TARGET
+#endif /* NEON_BLITTERS */
+
+#if SSE2_BLITTERS
+SDL_BEGIN_SSE2
+/* Colour key between two 16-bit surfaces of the same format */
+static void Blit2to2KeySSE2(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint16 *srcp = (Uint16 *)info->s_pixels;
+	int srcskip = info->s_skip >> 1;
+	Uint16 *dstp = (Uint16 *)info->d_pixels;
+	int dstskip = info->d_skip >> 1;
+	Uint16 rgbmask = (Uint16)~info->src->Amask;
+	Uint16 ckey = (Uint16)info->src->colorkey & rgbmask;
+	const __m128i mask = _mm_set1_epi16((short)rgbmask);
+	const __m128i key = _mm_set1_epi16((short)ckey);
+
+	while ( height-- ) {
+		int n = width;
+		while ( n >= 8 ) {
+			__m128i s = _mm_loadu_si128((const __m128i *)srcp);
+			__m128i d = _mm_loadu_si128((__m128i *)dstp);
+			__m128i keyed = _mm_cmpeq_epi16(_mm_and_si128(s, mask), key);
+			d = _mm_or_si128(_mm_and_si128(keyed, d),
+			                 _mm_andnot_si128(keyed, s));
+			_mm_storeu_si128((__m128i *)dstp, d);
+			srcp += 8;
+			dstp += 8;
+			n -= 8;
+		}
+		while ( n-- ) {
+			if ( (*srcp & rgbmask) != ckey ) {
+				*dstp = *srcp;
+			}
+			++srcp;
+			++dstp;
+		}
+		srcp += srcskip;
+		dstp += dstskip;
+	}
+}
+
+/* Colour key between two 32-bit surfaces of the same format */
+static void Blit4to4KeySSE2(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint32 *srcp = (Uint32 *)info->s_pixels;
+	int srcskip = info->s_skip >> 2;
+	Uint32 *dstp = (Uint32 *)info->d_pixels;
+	int dstskip = info->d_skip >> 2;
+	Uint32 rgbmask = ~info->src->Amask;
+	Uint32 ckey = info->src->colorkey & rgbmask;
+	Uint32 keep = Key4to4WriteMask(info->dst);
+	const __m128i mask = _mm_set1_epi32((int)rgbmask);
+	const __m128i key = _mm_set1_epi32((int)ckey);
+	const __m128i write = _mm_set1_epi32((int)keep);
+
+	while ( height-- ) {
+		int n = width;
+		while ( n >= 4 ) {
+			__m128i s = _mm_loadu_si128((const __m128i *)srcp);
+			__m128i d = _mm_loadu_si128((__m128i *)dstp);
+			__m128i keyed = _mm_cmpeq_epi32(_mm_and_si128(s, mask), key);
+			d = _mm_or_si128(_mm_and_si128(keyed, d),
+			                 _mm_andnot_si128(keyed, _mm_and_si128(s, write)));
+			_mm_storeu_si128((__m128i *)dstp, d);
+			srcp += 4;
+			dstp += 4;
+			n -= 4;
+		}
+		Blit4to4KeyTail(srcp, dstp, n, rgbmask, ckey, keep);
+		srcp += n + srcskip;
+		dstp += n + dstskip;
+	}
+}
+SDL_END_TARGET
+#endif /* SSE2_BLITTERS */
+
 /* Normal N to N optimized blitters */
 struct blit_table {
 	Uint32 srcR, srcG, srcB;
@@ -2294,9 +2617,20 @@ static const struct blit_table normal_blit_2[] = {
 #elif SDL_ALTIVEC_BLITTERS
     /* has-altivec */
     { 0x0000F800,0x000007E0,0x0000001F, 4, 0x00000000,0x00000000,0x00000000,
-      2, NULL, Blit_RGB565_32Altivec, NO_ALPHA | COPY_ALPHA | SET_ALPHA },
+      SDL_BLIT_ALTIVEC, NULL, Blit_RGB565_32Altivec, NO_ALPHA | COPY_ALPHA | SET_ALPHA },
     { 0x00007C00,0x000003E0,0x0000001F, 4, 0x00000000,0x00000000,0x00000000,
-      2, NULL, Blit_RGB555_32Altivec, NO_ALPHA | COPY_ALPHA | SET_ALPHA },
+      SDL_BLIT_ALTIVEC, NULL, Blit_RGB555_32Altivec, NO_ALPHA | COPY_ALPHA | SET_ALPHA },
+#endif
+#if NEON_BLITTERS
+    /* has-NEON */
+    { 0x0000F800,0x000007E0,0x0000001F, 4, 0x00FF0000,0x0000FF00,0x000000FF,
+      SDL_BLIT_NEON, NULL, Blit_RGB565_ARGB8888NEON, SET_ALPHA },
+    { 0x0000F800,0x000007E0,0x0000001F, 4, 0x000000FF,0x0000FF00,0x00FF0000,
+      SDL_BLIT_NEON, NULL, Blit_RGB565_ABGR8888NEON, SET_ALPHA },
+    { 0x0000F800,0x000007E0,0x0000001F, 4, 0xFF000000,0x00FF0000,0x0000FF00,
+      SDL_BLIT_NEON, NULL, Blit_RGB565_RGBA8888NEON, SET_ALPHA },
+    { 0x0000F800,0x000007E0,0x0000001F, 4, 0x0000FF00,0x00FF0000,0xFF000000,
+      SDL_BLIT_NEON, NULL, Blit_RGB565_BGRA8888NEON, SET_ALPHA },
 #endif
     { 0x0000F800,0x000007E0,0x0000001F, 4, 0x00FF0000,0x0000FF00,0x000000FF,
       0, NULL, Blit_RGB565_ARGB8888, SET_ALPHA },
@@ -2317,23 +2651,23 @@ static const struct blit_table normal_blit_3[] = {
 static const struct blit_table normal_blit_4[] = {
 #if SDL_HERMES_BLITTERS
     { 0x00FF0000,0x0000FF00,0x000000FF, 2, 0x0000F800,0x000007E0,0x0000001F,
-      1, ConvertMMXpII32_16RGB565, ConvertMMX, NO_ALPHA },
+      SDL_BLIT_MMX, ConvertMMXpII32_16RGB565, ConvertMMX, NO_ALPHA },
     { 0x00FF0000,0x0000FF00,0x000000FF, 2, 0x0000F800,0x000007E0,0x0000001F,
       0, ConvertX86p32_16RGB565, ConvertX86, NO_ALPHA },
     { 0x00FF0000,0x0000FF00,0x000000FF, 2, 0x0000001F,0x000007E0,0x0000F800,
-      1, ConvertMMXpII32_16BGR565, ConvertMMX, NO_ALPHA },
+      SDL_BLIT_MMX, ConvertMMXpII32_16BGR565, ConvertMMX, NO_ALPHA },
     { 0x00FF0000,0x0000FF00,0x000000FF, 2, 0x0000001F,0x000007E0,0x0000F800,
       0, ConvertX86p32_16BGR565, ConvertX86, NO_ALPHA },
     { 0x00FF0000,0x0000FF00,0x000000FF, 2, 0x00007C00,0x000003E0,0x0000001F,
-      1, ConvertMMXpII32_16RGB555, ConvertMMX, NO_ALPHA },
+      SDL_BLIT_MMX, ConvertMMXpII32_16RGB555, ConvertMMX, NO_ALPHA },
     { 0x00FF0000,0x0000FF00,0x000000FF, 2, 0x00007C00,0x000003E0,0x0000001F,
       0, ConvertX86p32_16RGB555, ConvertX86, NO_ALPHA },
     { 0x00FF0000,0x0000FF00,0x000000FF, 2, 0x0000001F,0x000003E0,0x00007C00,
-      1, ConvertMMXpII32_16BGR555, ConvertMMX, NO_ALPHA },
+      SDL_BLIT_MMX, ConvertMMXpII32_16BGR555, ConvertMMX, NO_ALPHA },
     { 0x00FF0000,0x0000FF00,0x000000FF, 2, 0x0000001F,0x000003E0,0x00007C00,
       0, ConvertX86p32_16BGR555, ConvertX86, NO_ALPHA },
     { 0x00FF0000,0x0000FF00,0x000000FF, 3, 0x00FF0000,0x0000FF00,0x000000FF,
-      1, ConvertMMXpII32_24RGB888, ConvertMMX, NO_ALPHA },
+      SDL_BLIT_MMX, ConvertMMXpII32_24RGB888, ConvertMMX, NO_ALPHA },
     { 0x00FF0000,0x0000FF00,0x000000FF, 3, 0x00FF0000,0x0000FF00,0x000000FF,
       0, ConvertX86p32_24RGB888, ConvertX86, NO_ALPHA },
     { 0x00FF0000,0x0000FF00,0x000000FF, 3, 0x000000FF,0x0000FF00,0x00FF0000,
@@ -2348,13 +2682,24 @@ static const struct blit_table normal_blit_4[] = {
 #if SDL_ALTIVEC_BLITTERS
     /* has-altivec | dont-use-prefetch */
     { 0x00000000,0x00000000,0x00000000, 4, 0x00000000,0x00000000,0x00000000,
-      6, NULL, ConvertAltivec32to32_noprefetch, NO_ALPHA | COPY_ALPHA | SET_ALPHA },
+      SDL_BLIT_ALTIVEC|BLIT_NO_PREFETCH, NULL, ConvertAltivec32to32_noprefetch, NO_ALPHA | COPY_ALPHA | SET_ALPHA },
     /* has-altivec */
     { 0x00000000,0x00000000,0x00000000, 4, 0x00000000,0x00000000,0x00000000,
-      2, NULL, ConvertAltivec32to32_prefetch, NO_ALPHA | COPY_ALPHA | SET_ALPHA },
+      SDL_BLIT_ALTIVEC, NULL, ConvertAltivec32to32_prefetch, NO_ALPHA | COPY_ALPHA | SET_ALPHA },
     /* has-altivec */
     { 0x00000000,0x00000000,0x00000000, 2, 0x0000F800,0x000007E0,0x0000001F,
-      2, NULL, Blit_RGB888_RGB565Altivec, NO_ALPHA },
+      SDL_BLIT_ALTIVEC, NULL, Blit_RGB888_RGB565Altivec, NO_ALPHA },
+#endif
+#if NEON_BLITTERS
+    /* has-NEON */
+    { 0x00FF0000,0x0000FF00,0x000000FF, 2, 0x0000F800,0x000007E0,0x0000001F,
+      SDL_BLIT_NEON, NULL, Blit_RGB888_RGB565NEON, NO_ALPHA },
+    { 0x00FF0000,0x0000FF00,0x000000FF, 2, 0x0000001F,0x000007E0,0x0000F800,
+      SDL_BLIT_NEON, NULL, Blit_RGB888_BGR565NEON, NO_ALPHA },
+    { 0x00FF0000,0x0000FF00,0x000000FF, 2, 0x00007C00,0x000003E0,0x0000001F,
+      SDL_BLIT_NEON, NULL, Blit_RGB888_RGB555NEON, NO_ALPHA },
+    { 0x00FF0000,0x0000FF00,0x000000FF, 2, 0x0000001F,0x000003E0,0x00007C00,
+      SDL_BLIT_NEON, NULL, Blit_RGB888_BGR555NEON, NO_ALPHA },
 #endif
     { 0x00FF0000,0x0000FF00,0x000000FF, 2, 0x0000F800,0x000007E0,0x0000001F,
       0, NULL, Blit_RGB888_RGB565, NO_ALPHA },
@@ -2371,6 +2716,101 @@ static const struct blit_table *normal_blit[] = {
 /* Mask matches table, or table entry is zero */
 #define MASKOK(x, y) (((x) == (y)) || ((y) == 0x00000000))
 
+/* SDL_BLIT_GENERATED=0 turns the generated blitters off, and
+   Blit4to4MaskAlpha with them, to test them against BlitNtoN */
+static int GeneratedBlitNEnabled(void)
+{
+	const char *env = SDL_getenv("SDL_BLIT_GENERATED");
+
+	return(!env || SDL_atoi(env));
+}
+
+/* A generated blitter for the formats, or NULL */
+static SDL_loblit FindGeneratedBlitN(SDL_PixelFormat *srcfmt,
+                                     SDL_PixelFormat *dstfmt, int copy_alpha)
+{
+	const SDL_BlitAutoEntry *entry;
+
+	if ( !GeneratedBlitNEnabled() ) {
+		return(NULL);
+	}
+	for ( entry = SDL_GeneratedBlitN; entry->srcbpp; ++entry ) {
+		if ( entry->srcbpp == srcfmt->BytesPerPixel &&
+		     entry->srcR == srcfmt->Rmask &&
+		     entry->srcG == srcfmt->Gmask &&
+		     entry->srcB == srcfmt->Bmask &&
+		     entry->dstbpp == dstfmt->BytesPerPixel &&
+		     entry->dstR == dstfmt->Rmask &&
+		     entry->dstG == dstfmt->Gmask &&
+		     entry->dstB == dstfmt->Bmask &&
+		     entry->dstA == dstfmt->Amask &&
+		     entry->copy_alpha == copy_alpha &&
+		     (!copy_alpha || entry->srcA == srcfmt->Amask) ) {
+			return(entry->blitfunc);
+		}
+	}
+	return(NULL);
+}
+
+/* The format pairs of the colorkey blitters, for SDL_SelectBlitKernel() */
+enum {
+	KEY_2TO2	= 0x01,		/* 16-bit to the same format */
+	KEY_NTO1	= 0x02,		/* to 8-bit */
+	KEY_4TO4	= 0x04,		/* 32-bit to the same format */
+	KEY_32TO32	= 0x08,		/* 32-bit to 32-bit */
+	KEY_COPYALPHA	= 0x10,		/* alpha to alpha */
+	KEY_NTON	= 0x20		/* anything else */
+};
+
+const SDL_BlitKernel SDL_BlitKernelsN[] = {
+#if SDL_HERMES_BLITTERS
+	SDL_BLIT_KERNEL(ConvertMMX, SDL_BLIT_MMX, 0),
+	SDL_BLIT_KERNEL(ConvertX86, 0, 0),
+#else
+	SDL_BLIT_KERNEL(Blit_RGB888_index8, 0, 0),
+	SDL_BLIT_KERNEL(Blit_RGB888_RGB555, 0, 0),
+	SDL_BLIT_KERNEL(Blit_RGB888_RGB565, 0, 0),
+#endif
+#if SDL_ALTIVEC_BLITTERS
+	SDL_BLIT_KERNEL(Blit_RGB888_RGB565Altivec, SDL_BLIT_ALTIVEC, 0),
+	SDL_BLIT_KERNEL(Blit_RGB565_32Altivec, SDL_BLIT_ALTIVEC, 0),
+	SDL_BLIT_KERNEL(Blit_RGB555_32Altivec, SDL_BLIT_ALTIVEC, 0),
+	SDL_BLIT_KERNEL(Blit32to32KeyAltivec, SDL_BLIT_ALTIVEC, KEY_32TO32),
+	SDL_BLIT_KERNEL(ConvertAltivec32to32_noprefetch, SDL_BLIT_ALTIVEC, 0),
+	SDL_BLIT_KERNEL(ConvertAltivec32to32_prefetch, SDL_BLIT_ALTIVEC, 0),
+#endif
+#if NEON_BLITTERS
+	SDL_BLIT_KERNEL(Blit_RGB888_RGB565NEON, SDL_BLIT_NEON, 0),
+	SDL_BLIT_KERNEL(Blit_RGB888_BGR565NEON, SDL_BLIT_NEON, 0),
+	SDL_BLIT_KERNEL(Blit_RGB888_RGB555NEON, SDL_BLIT_NEON, 0),
+	SDL_BLIT_KERNEL(Blit_RGB888_BGR555NEON, SDL_BLIT_NEON, 0),
+	SDL_BLIT_KERNEL(Blit_RGB565_ARGB8888NEON, SDL_BLIT_NEON, 0),
+	SDL_BLIT_KERNEL(Blit_RGB565_ABGR8888NEON, SDL_BLIT_NEON, 0),
+	SDL_BLIT_KERNEL(Blit_RGB565_RGBA8888NEON, SDL_BLIT_NEON, 0),
+	SDL_BLIT_KERNEL(Blit_RGB565_BGRA8888NEON, SDL_BLIT_NEON, 0),
+	SDL_BLIT_KERNEL(Blit2to2KeyNEON, SDL_BLIT_NEON, KEY_2TO2),
+	SDL_BLIT_KERNEL(Blit4to4KeyNEON, SDL_BLIT_NEON, KEY_4TO4),
+#endif
+#if SSE2_BLITTERS
+	SDL_BLIT_KERNEL(Blit2to2KeySSE2, SDL_BLIT_SSE2, KEY_2TO2),
+	SDL_BLIT_KERNEL(Blit4to4KeySSE2, SDL_BLIT_SSE2, KEY_4TO4),
+#endif
+	SDL_BLIT_KERNEL(Blit_RGB565_ARGB8888, 0, 0),
+	SDL_BLIT_KERNEL(Blit_RGB565_ABGR8888, 0, 0),
+	SDL_BLIT_KERNEL(Blit_RGB565_RGBA8888, 0, 0),
+	SDL_BLIT_KERNEL(Blit_RGB565_BGRA8888, 0, 0),
+	SDL_BLIT_KERNEL(Blit_RGB888_index8_map, 0, 0),
+	SDL_BLIT_KERNEL(BlitNto1, 0, 0),
+	SDL_BLIT_KERNEL(Blit4to4MaskAlpha, 0, 0),
+	SDL_BLIT_KERNEL(BlitNtoN, 0, 0),
+	SDL_BLIT_KERNEL(BlitNtoNCopyAlpha, 0, 0),
+	SDL_BLIT_KERNEL(Blit2to2Key, 0, KEY_2TO2),
+	SDL_BLIT_KERNEL(BlitNto1Key, 0, KEY_NTO1),
+	SDL_BLIT_KERNEL(BlitNtoNKeyCopyAlpha, 0, KEY_COPYALPHA),
+	SDL_BLIT_KERNEL(BlitNtoNKey, 0, KEY_NTON),
+	{ NULL }
+};
+
 SDL_loblit SDL_CalculateBlitN(SDL_Surface *surface, int blit_index)
 {
 	struct private_swaccel *sdata;
@@ -2399,24 +2839,21 @@ SDL_loblit SDL_CalculateBlitN(SDL_Surface *surface, int blit_index)
 	    /* colorkey blit: Here we don't have too many options, mostly
 	       because RLE is the preferred fast way to deal with this.
 	       If a particular case turns out to be useful we'll add it. */
+	    Uint32 pairs;
 
 	    if(srcfmt->BytesPerPixel == 2
 	       && surface->map->identity)
-		return Blit2to2Key;
+		pairs = KEY_2TO2;
 	    else if(dstfmt->BytesPerPixel == 1)
-		return BlitNto1Key;
+		pairs = KEY_NTO1;
 	    else {
-#if SDL_ALTIVEC_BLITTERS
-        if((srcfmt->BytesPerPixel == 4) && (dstfmt->BytesPerPixel == 4) && SDL_HasAltiVec()) {
-            return Blit32to32KeyAltivec;
-        } else
-#endif
-
-		if(srcfmt->Amask && dstfmt->Amask)
-		    return BlitNtoNKeyCopyAlpha;
-		else
-		    return BlitNtoNKey;
+		pairs = (srcfmt->Amask && dstfmt->Amask) ? KEY_COPYALPHA : KEY_NTON;
+		if(srcfmt->BytesPerPixel == 4 && surface->map->identity)
+		    pairs |= KEY_4TO4;
+		if(srcfmt->BytesPerPixel == 4 && dstfmt->BytesPerPixel == 4)
+		    pairs |= KEY_32TO32;
 	    }
+	    return SDL_SelectBlitKernel(SDL_BlitKernelsN, pairs);
 	}
 
 	blitfun = NULL;
@@ -2461,8 +2898,14 @@ SDL_loblit SDL_CalculateBlitN(SDL_Surface *surface, int blit_index)
 		blitfun = table[which].blitfunc;
 
 		if(blitfun == BlitNtoN) {  /* default C fallback catch-all. Slow! */
+			SDL_loblit generated = FindGeneratedBlitN(srcfmt, dstfmt,
+			                                   a_need == COPY_ALPHA);
+			if ( generated ) {
+				blitfun = generated;
+			} else
 			/* Fastpath C fallback: 32bit RGB<->RGBA blit with matching RGB */
-			if ( srcfmt->BytesPerPixel == 4 && dstfmt->BytesPerPixel == 4 &&
+			if ( GeneratedBlitNEnabled() &&
+			     srcfmt->BytesPerPixel == 4 && dstfmt->BytesPerPixel == 4 &&
 			     srcfmt->Rmask == dstfmt->Rmask &&
 			     srcfmt->Gmask == dstfmt->Gmask &&
 			     srcfmt->Bmask == dstfmt->Bmask ) {
@@ -0,0 +1,3754 @@
+/* DO NOT EDIT!  This file is generated by sdlgenblit.pl */
+/*
+    SDL - Simple DirectMedia Layer
+    Copyright (C) 1997-2009 Sam Lantinga
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+    Sam Lantinga
+    slouken@libsdl.org
+*/
+#include "SDL_config.h"
+
+/* Specialized N to N blitters for common pairs of pixel formats */
+
+#include "SDL_video.h"
+#include "SDL_blit.h"
+#include "SDL_blit_auto.h"
+
+/* The byte of a 24-bit pixel that holds the bits from 'shift' up */
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+#define BLIT_AUTO_BYTE24(shift)	((shift) / 8)
+#else
+#define BLIT_AUTO_BYTE24(shift)	(2 - (shift) / 8)
+#endif
+
+static void Blit_RGB565_BGR565(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = (((pixel & 0x0000F800) >> 11) << 3);
+			Uint32 G = (((pixel & 0x000007E0) >> 5) << 2);
+			Uint32 B = ((pixel & 0x0000001F) << 3);
+			pixel = (R >> 3) |
+			       ((G >> 2) << 5) |
+			       ((B >> 3) << 11);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 2;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB565_RGB555(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = (((pixel & 0x0000F800) >> 11) << 3);
+			Uint32 G = (((pixel & 0x000007E0) >> 5) << 2);
+			Uint32 B = ((pixel & 0x0000001F) << 3);
+			pixel = ((R >> 3) << 10) |
+			       ((G >> 3) << 5) |
+			       (B >> 3);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 2;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB565_BGR555(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = (((pixel & 0x0000F800) >> 11) << 3);
+			Uint32 G = (((pixel & 0x000007E0) >> 5) << 2);
+			Uint32 B = ((pixel & 0x0000001F) << 3);
+			pixel = (R >> 3) |
+			       ((G >> 3) << 5) |
+			       ((B >> 3) << 10);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 2;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB565_RGB24(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = (((pixel & 0x0000F800) >> 11) << 3);
+			Uint32 G = (((pixel & 0x000007E0) >> 5) << 2);
+			Uint32 B = ((pixel & 0x0000001F) << 3);
+			dst[BLIT_AUTO_BYTE24(16)] = (Uint8)R;
+			dst[BLIT_AUTO_BYTE24(8)] = (Uint8)G;
+			dst[BLIT_AUTO_BYTE24(0)] = (Uint8)B;
+			src += 2;
+			dst += 3;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB565_BGR24(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = (((pixel & 0x0000F800) >> 11) << 3);
+			Uint32 G = (((pixel & 0x000007E0) >> 5) << 2);
+			Uint32 B = ((pixel & 0x0000001F) << 3);
+			dst[BLIT_AUTO_BYTE24(0)] = (Uint8)R;
+			dst[BLIT_AUTO_BYTE24(8)] = (Uint8)G;
+			dst[BLIT_AUTO_BYTE24(16)] = (Uint8)B;
+			src += 2;
+			dst += 3;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB565_RGB888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = (((pixel & 0x0000F800) >> 11) << 3);
+			Uint32 G = (((pixel & 0x000007E0) >> 5) << 2);
+			Uint32 B = ((pixel & 0x0000001F) << 3);
+			pixel = (R << 16) |
+			       (G << 8) |
+			       B;
+			*(Uint32 *)dst = pixel;
+			src += 2;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB565_BGR888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = (((pixel & 0x0000F800) >> 11) << 3);
+			Uint32 G = (((pixel & 0x000007E0) >> 5) << 2);
+			Uint32 B = ((pixel & 0x0000001F) << 3);
+			pixel = R |
+			       (G << 8) |
+			       (B << 16);
+			*(Uint32 *)dst = pixel;
+			src += 2;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB565_ARGB8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+	Uint32 A = ((Uint32)info->src->alpha << 24);
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = (((pixel & 0x0000F800) >> 11) << 3);
+			Uint32 G = (((pixel & 0x000007E0) >> 5) << 2);
+			Uint32 B = ((pixel & 0x0000001F) << 3);
+			pixel = (R << 16) |
+			       (G << 8) |
+			       B |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 2;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB565_ABGR8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+	Uint32 A = ((Uint32)info->src->alpha << 24);
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = (((pixel & 0x0000F800) >> 11) << 3);
+			Uint32 G = (((pixel & 0x000007E0) >> 5) << 2);
+			Uint32 B = ((pixel & 0x0000001F) << 3);
+			pixel = R |
+			       (G << 8) |
+			       (B << 16) |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 2;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB565_RGBA8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+	Uint32 A = (Uint32)info->src->alpha;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = (((pixel & 0x0000F800) >> 11) << 3);
+			Uint32 G = (((pixel & 0x000007E0) >> 5) << 2);
+			Uint32 B = ((pixel & 0x0000001F) << 3);
+			pixel = (R << 24) |
+			       (G << 16) |
+			       (B << 8) |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 2;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB565_BGRA8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+	Uint32 A = (Uint32)info->src->alpha;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = (((pixel & 0x0000F800) >> 11) << 3);
+			Uint32 G = (((pixel & 0x000007E0) >> 5) << 2);
+			Uint32 B = ((pixel & 0x0000001F) << 3);
+			pixel = (R << 8) |
+			       (G << 16) |
+			       (B << 24) |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 2;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR565_RGB565(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = ((pixel & 0x0000001F) << 3);
+			Uint32 G = (((pixel & 0x000007E0) >> 5) << 2);
+			Uint32 B = (((pixel & 0x0000F800) >> 11) << 3);
+			pixel = ((R >> 3) << 11) |
+			       ((G >> 2) << 5) |
+			       (B >> 3);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 2;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR565_RGB555(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = ((pixel & 0x0000001F) << 3);
+			Uint32 G = (((pixel & 0x000007E0) >> 5) << 2);
+			Uint32 B = (((pixel & 0x0000F800) >> 11) << 3);
+			pixel = ((R >> 3) << 10) |
+			       ((G >> 3) << 5) |
+			       (B >> 3);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 2;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR565_BGR555(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = ((pixel & 0x0000001F) << 3);
+			Uint32 G = (((pixel & 0x000007E0) >> 5) << 2);
+			Uint32 B = (((pixel & 0x0000F800) >> 11) << 3);
+			pixel = (R >> 3) |
+			       ((G >> 3) << 5) |
+			       ((B >> 3) << 10);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 2;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR565_RGB24(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = ((pixel & 0x0000001F) << 3);
+			Uint32 G = (((pixel & 0x000007E0) >> 5) << 2);
+			Uint32 B = (((pixel & 0x0000F800) >> 11) << 3);
+			dst[BLIT_AUTO_BYTE24(16)] = (Uint8)R;
+			dst[BLIT_AUTO_BYTE24(8)] = (Uint8)G;
+			dst[BLIT_AUTO_BYTE24(0)] = (Uint8)B;
+			src += 2;
+			dst += 3;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR565_BGR24(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = ((pixel & 0x0000001F) << 3);
+			Uint32 G = (((pixel & 0x000007E0) >> 5) << 2);
+			Uint32 B = (((pixel & 0x0000F800) >> 11) << 3);
+			dst[BLIT_AUTO_BYTE24(0)] = (Uint8)R;
+			dst[BLIT_AUTO_BYTE24(8)] = (Uint8)G;
+			dst[BLIT_AUTO_BYTE24(16)] = (Uint8)B;
+			src += 2;
+			dst += 3;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR565_RGB888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = ((pixel & 0x0000001F) << 3);
+			Uint32 G = (((pixel & 0x000007E0) >> 5) << 2);
+			Uint32 B = (((pixel & 0x0000F800) >> 11) << 3);
+			pixel = (R << 16) |
+			       (G << 8) |
+			       B;
+			*(Uint32 *)dst = pixel;
+			src += 2;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR565_BGR888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = ((pixel & 0x0000001F) << 3);
+			Uint32 G = (((pixel & 0x000007E0) >> 5) << 2);
+			Uint32 B = (((pixel & 0x0000F800) >> 11) << 3);
+			pixel = R |
+			       (G << 8) |
+			       (B << 16);
+			*(Uint32 *)dst = pixel;
+			src += 2;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR565_ARGB8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+	Uint32 A = ((Uint32)info->src->alpha << 24);
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = ((pixel & 0x0000001F) << 3);
+			Uint32 G = (((pixel & 0x000007E0) >> 5) << 2);
+			Uint32 B = (((pixel & 0x0000F800) >> 11) << 3);
+			pixel = (R << 16) |
+			       (G << 8) |
+			       B |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 2;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR565_ABGR8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+	Uint32 A = ((Uint32)info->src->alpha << 24);
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = ((pixel & 0x0000001F) << 3);
+			Uint32 G = (((pixel & 0x000007E0) >> 5) << 2);
+			Uint32 B = (((pixel & 0x0000F800) >> 11) << 3);
+			pixel = R |
+			       (G << 8) |
+			       (B << 16) |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 2;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR565_RGBA8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+	Uint32 A = (Uint32)info->src->alpha;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = ((pixel & 0x0000001F) << 3);
+			Uint32 G = (((pixel & 0x000007E0) >> 5) << 2);
+			Uint32 B = (((pixel & 0x0000F800) >> 11) << 3);
+			pixel = (R << 24) |
+			       (G << 16) |
+			       (B << 8) |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 2;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR565_BGRA8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+	Uint32 A = (Uint32)info->src->alpha;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = ((pixel & 0x0000001F) << 3);
+			Uint32 G = (((pixel & 0x000007E0) >> 5) << 2);
+			Uint32 B = (((pixel & 0x0000F800) >> 11) << 3);
+			pixel = (R << 8) |
+			       (G << 16) |
+			       (B << 24) |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 2;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB555_RGB565(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = (((pixel & 0x00007C00) >> 10) << 3);
+			Uint32 G = (((pixel & 0x000003E0) >> 5) << 3);
+			Uint32 B = ((pixel & 0x0000001F) << 3);
+			pixel = ((R >> 3) << 11) |
+			       ((G >> 2) << 5) |
+			       (B >> 3);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 2;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB555_BGR565(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = (((pixel & 0x00007C00) >> 10) << 3);
+			Uint32 G = (((pixel & 0x000003E0) >> 5) << 3);
+			Uint32 B = ((pixel & 0x0000001F) << 3);
+			pixel = (R >> 3) |
+			       ((G >> 2) << 5) |
+			       ((B >> 3) << 11);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 2;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB555_BGR555(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = (((pixel & 0x00007C00) >> 10) << 3);
+			Uint32 G = (((pixel & 0x000003E0) >> 5) << 3);
+			Uint32 B = ((pixel & 0x0000001F) << 3);
+			pixel = (R >> 3) |
+			       ((G >> 3) << 5) |
+			       ((B >> 3) << 10);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 2;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB555_RGB24(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = (((pixel & 0x00007C00) >> 10) << 3);
+			Uint32 G = (((pixel & 0x000003E0) >> 5) << 3);
+			Uint32 B = ((pixel & 0x0000001F) << 3);
+			dst[BLIT_AUTO_BYTE24(16)] = (Uint8)R;
+			dst[BLIT_AUTO_BYTE24(8)] = (Uint8)G;
+			dst[BLIT_AUTO_BYTE24(0)] = (Uint8)B;
+			src += 2;
+			dst += 3;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB555_BGR24(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = (((pixel & 0x00007C00) >> 10) << 3);
+			Uint32 G = (((pixel & 0x000003E0) >> 5) << 3);
+			Uint32 B = ((pixel & 0x0000001F) << 3);
+			dst[BLIT_AUTO_BYTE24(0)] = (Uint8)R;
+			dst[BLIT_AUTO_BYTE24(8)] = (Uint8)G;
+			dst[BLIT_AUTO_BYTE24(16)] = (Uint8)B;
+			src += 2;
+			dst += 3;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB555_RGB888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = (((pixel & 0x00007C00) >> 10) << 3);
+			Uint32 G = (((pixel & 0x000003E0) >> 5) << 3);
+			Uint32 B = ((pixel & 0x0000001F) << 3);
+			pixel = (R << 16) |
+			       (G << 8) |
+			       B;
+			*(Uint32 *)dst = pixel;
+			src += 2;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB555_BGR888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = (((pixel & 0x00007C00) >> 10) << 3);
+			Uint32 G = (((pixel & 0x000003E0) >> 5) << 3);
+			Uint32 B = ((pixel & 0x0000001F) << 3);
+			pixel = R |
+			       (G << 8) |
+			       (B << 16);
+			*(Uint32 *)dst = pixel;
+			src += 2;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB555_ARGB8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+	Uint32 A = ((Uint32)info->src->alpha << 24);
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = (((pixel & 0x00007C00) >> 10) << 3);
+			Uint32 G = (((pixel & 0x000003E0) >> 5) << 3);
+			Uint32 B = ((pixel & 0x0000001F) << 3);
+			pixel = (R << 16) |
+			       (G << 8) |
+			       B |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 2;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB555_ABGR8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+	Uint32 A = ((Uint32)info->src->alpha << 24);
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = (((pixel & 0x00007C00) >> 10) << 3);
+			Uint32 G = (((pixel & 0x000003E0) >> 5) << 3);
+			Uint32 B = ((pixel & 0x0000001F) << 3);
+			pixel = R |
+			       (G << 8) |
+			       (B << 16) |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 2;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB555_RGBA8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+	Uint32 A = (Uint32)info->src->alpha;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = (((pixel & 0x00007C00) >> 10) << 3);
+			Uint32 G = (((pixel & 0x000003E0) >> 5) << 3);
+			Uint32 B = ((pixel & 0x0000001F) << 3);
+			pixel = (R << 24) |
+			       (G << 16) |
+			       (B << 8) |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 2;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB555_BGRA8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+	Uint32 A = (Uint32)info->src->alpha;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = (((pixel & 0x00007C00) >> 10) << 3);
+			Uint32 G = (((pixel & 0x000003E0) >> 5) << 3);
+			Uint32 B = ((pixel & 0x0000001F) << 3);
+			pixel = (R << 8) |
+			       (G << 16) |
+			       (B << 24) |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 2;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR555_RGB565(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = ((pixel & 0x0000001F) << 3);
+			Uint32 G = (((pixel & 0x000003E0) >> 5) << 3);
+			Uint32 B = (((pixel & 0x00007C00) >> 10) << 3);
+			pixel = ((R >> 3) << 11) |
+			       ((G >> 2) << 5) |
+			       (B >> 3);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 2;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR555_BGR565(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = ((pixel & 0x0000001F) << 3);
+			Uint32 G = (((pixel & 0x000003E0) >> 5) << 3);
+			Uint32 B = (((pixel & 0x00007C00) >> 10) << 3);
+			pixel = (R >> 3) |
+			       ((G >> 2) << 5) |
+			       ((B >> 3) << 11);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 2;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR555_RGB555(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = ((pixel & 0x0000001F) << 3);
+			Uint32 G = (((pixel & 0x000003E0) >> 5) << 3);
+			Uint32 B = (((pixel & 0x00007C00) >> 10) << 3);
+			pixel = ((R >> 3) << 10) |
+			       ((G >> 3) << 5) |
+			       (B >> 3);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 2;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR555_RGB24(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = ((pixel & 0x0000001F) << 3);
+			Uint32 G = (((pixel & 0x000003E0) >> 5) << 3);
+			Uint32 B = (((pixel & 0x00007C00) >> 10) << 3);
+			dst[BLIT_AUTO_BYTE24(16)] = (Uint8)R;
+			dst[BLIT_AUTO_BYTE24(8)] = (Uint8)G;
+			dst[BLIT_AUTO_BYTE24(0)] = (Uint8)B;
+			src += 2;
+			dst += 3;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR555_BGR24(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = ((pixel & 0x0000001F) << 3);
+			Uint32 G = (((pixel & 0x000003E0) >> 5) << 3);
+			Uint32 B = (((pixel & 0x00007C00) >> 10) << 3);
+			dst[BLIT_AUTO_BYTE24(0)] = (Uint8)R;
+			dst[BLIT_AUTO_BYTE24(8)] = (Uint8)G;
+			dst[BLIT_AUTO_BYTE24(16)] = (Uint8)B;
+			src += 2;
+			dst += 3;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR555_RGB888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = ((pixel & 0x0000001F) << 3);
+			Uint32 G = (((pixel & 0x000003E0) >> 5) << 3);
+			Uint32 B = (((pixel & 0x00007C00) >> 10) << 3);
+			pixel = (R << 16) |
+			       (G << 8) |
+			       B;
+			*(Uint32 *)dst = pixel;
+			src += 2;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR555_BGR888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = ((pixel & 0x0000001F) << 3);
+			Uint32 G = (((pixel & 0x000003E0) >> 5) << 3);
+			Uint32 B = (((pixel & 0x00007C00) >> 10) << 3);
+			pixel = R |
+			       (G << 8) |
+			       (B << 16);
+			*(Uint32 *)dst = pixel;
+			src += 2;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR555_ARGB8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+	Uint32 A = ((Uint32)info->src->alpha << 24);
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = ((pixel & 0x0000001F) << 3);
+			Uint32 G = (((pixel & 0x000003E0) >> 5) << 3);
+			Uint32 B = (((pixel & 0x00007C00) >> 10) << 3);
+			pixel = (R << 16) |
+			       (G << 8) |
+			       B |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 2;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR555_ABGR8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+	Uint32 A = ((Uint32)info->src->alpha << 24);
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = ((pixel & 0x0000001F) << 3);
+			Uint32 G = (((pixel & 0x000003E0) >> 5) << 3);
+			Uint32 B = (((pixel & 0x00007C00) >> 10) << 3);
+			pixel = R |
+			       (G << 8) |
+			       (B << 16) |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 2;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR555_RGBA8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+	Uint32 A = (Uint32)info->src->alpha;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = ((pixel & 0x0000001F) << 3);
+			Uint32 G = (((pixel & 0x000003E0) >> 5) << 3);
+			Uint32 B = (((pixel & 0x00007C00) >> 10) << 3);
+			pixel = (R << 24) |
+			       (G << 16) |
+			       (B << 8) |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 2;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR555_BGRA8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+	Uint32 A = (Uint32)info->src->alpha;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint16 *)src;
+			Uint32 R = ((pixel & 0x0000001F) << 3);
+			Uint32 G = (((pixel & 0x000003E0) >> 5) << 3);
+			Uint32 B = (((pixel & 0x00007C00) >> 10) << 3);
+			pixel = (R << 8) |
+			       (G << 16) |
+			       (B << 24) |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 2;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB24_RGB565(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = SDL_READ24(src);
+			Uint32 R = ((pixel & 0x00FF0000) >> 16);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = (pixel & 0x000000FF);
+			pixel = ((R >> 3) << 11) |
+			       ((G >> 2) << 5) |
+			       (B >> 3);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 3;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB24_BGR565(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = SDL_READ24(src);
+			Uint32 R = ((pixel & 0x00FF0000) >> 16);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = (pixel & 0x000000FF);
+			pixel = (R >> 3) |
+			       ((G >> 2) << 5) |
+			       ((B >> 3) << 11);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 3;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB24_RGB555(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = SDL_READ24(src);
+			Uint32 R = ((pixel & 0x00FF0000) >> 16);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = (pixel & 0x000000FF);
+			pixel = ((R >> 3) << 10) |
+			       ((G >> 3) << 5) |
+			       (B >> 3);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 3;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB24_BGR555(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = SDL_READ24(src);
+			Uint32 R = ((pixel & 0x00FF0000) >> 16);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = (pixel & 0x000000FF);
+			pixel = (R >> 3) |
+			       ((G >> 3) << 5) |
+			       ((B >> 3) << 10);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 3;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB24_BGR24(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = SDL_READ24(src);
+			Uint32 R = ((pixel & 0x00FF0000) >> 16);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = (pixel & 0x000000FF);
+			dst[BLIT_AUTO_BYTE24(0)] = (Uint8)R;
+			dst[BLIT_AUTO_BYTE24(8)] = (Uint8)G;
+			dst[BLIT_AUTO_BYTE24(16)] = (Uint8)B;
+			src += 3;
+			dst += 3;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB24_RGB888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = SDL_READ24(src);
+			Uint32 R = ((pixel & 0x00FF0000) >> 16);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = (pixel & 0x000000FF);
+			pixel = (R << 16) |
+			       (G << 8) |
+			       B;
+			*(Uint32 *)dst = pixel;
+			src += 3;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB24_BGR888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = SDL_READ24(src);
+			Uint32 R = ((pixel & 0x00FF0000) >> 16);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = (pixel & 0x000000FF);
+			pixel = R |
+			       (G << 8) |
+			       (B << 16);
+			*(Uint32 *)dst = pixel;
+			src += 3;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB24_ARGB8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+	Uint32 A = ((Uint32)info->src->alpha << 24);
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = SDL_READ24(src);
+			Uint32 R = ((pixel & 0x00FF0000) >> 16);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = (pixel & 0x000000FF);
+			pixel = (R << 16) |
+			       (G << 8) |
+			       B |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 3;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB24_ABGR8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+	Uint32 A = ((Uint32)info->src->alpha << 24);
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = SDL_READ24(src);
+			Uint32 R = ((pixel & 0x00FF0000) >> 16);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = (pixel & 0x000000FF);
+			pixel = R |
+			       (G << 8) |
+			       (B << 16) |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 3;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB24_RGBA8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+	Uint32 A = (Uint32)info->src->alpha;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = SDL_READ24(src);
+			Uint32 R = ((pixel & 0x00FF0000) >> 16);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = (pixel & 0x000000FF);
+			pixel = (R << 24) |
+			       (G << 16) |
+			       (B << 8) |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 3;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB24_BGRA8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+	Uint32 A = (Uint32)info->src->alpha;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = SDL_READ24(src);
+			Uint32 R = ((pixel & 0x00FF0000) >> 16);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = (pixel & 0x000000FF);
+			pixel = (R << 8) |
+			       (G << 16) |
+			       (B << 24) |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 3;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR24_RGB565(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = SDL_READ24(src);
+			Uint32 R = (pixel & 0x000000FF);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = ((pixel & 0x00FF0000) >> 16);
+			pixel = ((R >> 3) << 11) |
+			       ((G >> 2) << 5) |
+			       (B >> 3);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 3;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR24_BGR565(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = SDL_READ24(src);
+			Uint32 R = (pixel & 0x000000FF);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = ((pixel & 0x00FF0000) >> 16);
+			pixel = (R >> 3) |
+			       ((G >> 2) << 5) |
+			       ((B >> 3) << 11);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 3;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR24_RGB555(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = SDL_READ24(src);
+			Uint32 R = (pixel & 0x000000FF);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = ((pixel & 0x00FF0000) >> 16);
+			pixel = ((R >> 3) << 10) |
+			       ((G >> 3) << 5) |
+			       (B >> 3);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 3;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR24_BGR555(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = SDL_READ24(src);
+			Uint32 R = (pixel & 0x000000FF);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = ((pixel & 0x00FF0000) >> 16);
+			pixel = (R >> 3) |
+			       ((G >> 3) << 5) |
+			       ((B >> 3) << 10);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 3;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR24_RGB24(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = SDL_READ24(src);
+			Uint32 R = (pixel & 0x000000FF);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = ((pixel & 0x00FF0000) >> 16);
+			dst[BLIT_AUTO_BYTE24(16)] = (Uint8)R;
+			dst[BLIT_AUTO_BYTE24(8)] = (Uint8)G;
+			dst[BLIT_AUTO_BYTE24(0)] = (Uint8)B;
+			src += 3;
+			dst += 3;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR24_RGB888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = SDL_READ24(src);
+			Uint32 R = (pixel & 0x000000FF);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = ((pixel & 0x00FF0000) >> 16);
+			pixel = (R << 16) |
+			       (G << 8) |
+			       B;
+			*(Uint32 *)dst = pixel;
+			src += 3;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR24_BGR888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = SDL_READ24(src);
+			Uint32 R = (pixel & 0x000000FF);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = ((pixel & 0x00FF0000) >> 16);
+			pixel = R |
+			       (G << 8) |
+			       (B << 16);
+			*(Uint32 *)dst = pixel;
+			src += 3;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR24_ARGB8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+	Uint32 A = ((Uint32)info->src->alpha << 24);
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = SDL_READ24(src);
+			Uint32 R = (pixel & 0x000000FF);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = ((pixel & 0x00FF0000) >> 16);
+			pixel = (R << 16) |
+			       (G << 8) |
+			       B |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 3;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR24_ABGR8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+	Uint32 A = ((Uint32)info->src->alpha << 24);
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = SDL_READ24(src);
+			Uint32 R = (pixel & 0x000000FF);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = ((pixel & 0x00FF0000) >> 16);
+			pixel = R |
+			       (G << 8) |
+			       (B << 16) |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 3;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR24_RGBA8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+	Uint32 A = (Uint32)info->src->alpha;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = SDL_READ24(src);
+			Uint32 R = (pixel & 0x000000FF);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = ((pixel & 0x00FF0000) >> 16);
+			pixel = (R << 24) |
+			       (G << 16) |
+			       (B << 8) |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 3;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR24_BGRA8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+	Uint32 A = (Uint32)info->src->alpha;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = SDL_READ24(src);
+			Uint32 R = (pixel & 0x000000FF);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = ((pixel & 0x00FF0000) >> 16);
+			pixel = (R << 8) |
+			       (G << 16) |
+			       (B << 24) |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 3;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB888_RGB565(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = ((pixel & 0x00FF0000) >> 16);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = (pixel & 0x000000FF);
+			pixel = ((R >> 3) << 11) |
+			       ((G >> 2) << 5) |
+			       (B >> 3);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 4;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB888_BGR565(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = ((pixel & 0x00FF0000) >> 16);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = (pixel & 0x000000FF);
+			pixel = (R >> 3) |
+			       ((G >> 2) << 5) |
+			       ((B >> 3) << 11);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 4;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB888_RGB555(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = ((pixel & 0x00FF0000) >> 16);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = (pixel & 0x000000FF);
+			pixel = ((R >> 3) << 10) |
+			       ((G >> 3) << 5) |
+			       (B >> 3);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 4;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB888_BGR555(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = ((pixel & 0x00FF0000) >> 16);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = (pixel & 0x000000FF);
+			pixel = (R >> 3) |
+			       ((G >> 3) << 5) |
+			       ((B >> 3) << 10);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 4;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB888_RGB24(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = ((pixel & 0x00FF0000) >> 16);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = (pixel & 0x000000FF);
+			dst[BLIT_AUTO_BYTE24(16)] = (Uint8)R;
+			dst[BLIT_AUTO_BYTE24(8)] = (Uint8)G;
+			dst[BLIT_AUTO_BYTE24(0)] = (Uint8)B;
+			src += 4;
+			dst += 3;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB888_BGR24(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = ((pixel & 0x00FF0000) >> 16);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = (pixel & 0x000000FF);
+			dst[BLIT_AUTO_BYTE24(0)] = (Uint8)R;
+			dst[BLIT_AUTO_BYTE24(8)] = (Uint8)G;
+			dst[BLIT_AUTO_BYTE24(16)] = (Uint8)B;
+			src += 4;
+			dst += 3;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB888_BGR888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = ((pixel & 0x00FF0000) >> 16);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = (pixel & 0x000000FF);
+			pixel = R |
+			       (G << 8) |
+			       (B << 16);
+			*(Uint32 *)dst = pixel;
+			src += 4;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB888_ABGR8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+	Uint32 A = ((Uint32)info->src->alpha << 24);
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = ((pixel & 0x00FF0000) >> 16);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = (pixel & 0x000000FF);
+			pixel = R |
+			       (G << 8) |
+			       (B << 16) |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 4;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB888_RGBA8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+	Uint32 A = (Uint32)info->src->alpha;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = ((pixel & 0x00FF0000) >> 16);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = (pixel & 0x000000FF);
+			pixel = (R << 24) |
+			       (G << 16) |
+			       (B << 8) |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 4;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGB888_BGRA8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+	Uint32 A = (Uint32)info->src->alpha;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = ((pixel & 0x00FF0000) >> 16);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = (pixel & 0x000000FF);
+			pixel = (R << 8) |
+			       (G << 16) |
+			       (B << 24) |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 4;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR888_RGB565(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = (pixel & 0x000000FF);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = ((pixel & 0x00FF0000) >> 16);
+			pixel = ((R >> 3) << 11) |
+			       ((G >> 2) << 5) |
+			       (B >> 3);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 4;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR888_BGR565(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = (pixel & 0x000000FF);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = ((pixel & 0x00FF0000) >> 16);
+			pixel = (R >> 3) |
+			       ((G >> 2) << 5) |
+			       ((B >> 3) << 11);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 4;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR888_RGB555(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = (pixel & 0x000000FF);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = ((pixel & 0x00FF0000) >> 16);
+			pixel = ((R >> 3) << 10) |
+			       ((G >> 3) << 5) |
+			       (B >> 3);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 4;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR888_BGR555(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = (pixel & 0x000000FF);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = ((pixel & 0x00FF0000) >> 16);
+			pixel = (R >> 3) |
+			       ((G >> 3) << 5) |
+			       ((B >> 3) << 10);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 4;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR888_RGB24(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = (pixel & 0x000000FF);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = ((pixel & 0x00FF0000) >> 16);
+			dst[BLIT_AUTO_BYTE24(16)] = (Uint8)R;
+			dst[BLIT_AUTO_BYTE24(8)] = (Uint8)G;
+			dst[BLIT_AUTO_BYTE24(0)] = (Uint8)B;
+			src += 4;
+			dst += 3;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR888_BGR24(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = (pixel & 0x000000FF);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = ((pixel & 0x00FF0000) >> 16);
+			dst[BLIT_AUTO_BYTE24(0)] = (Uint8)R;
+			dst[BLIT_AUTO_BYTE24(8)] = (Uint8)G;
+			dst[BLIT_AUTO_BYTE24(16)] = (Uint8)B;
+			src += 4;
+			dst += 3;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR888_RGB888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = (pixel & 0x000000FF);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = ((pixel & 0x00FF0000) >> 16);
+			pixel = (R << 16) |
+			       (G << 8) |
+			       B;
+			*(Uint32 *)dst = pixel;
+			src += 4;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR888_ARGB8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+	Uint32 A = ((Uint32)info->src->alpha << 24);
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = (pixel & 0x000000FF);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = ((pixel & 0x00FF0000) >> 16);
+			pixel = (R << 16) |
+			       (G << 8) |
+			       B |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 4;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR888_RGBA8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+	Uint32 A = (Uint32)info->src->alpha;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = (pixel & 0x000000FF);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = ((pixel & 0x00FF0000) >> 16);
+			pixel = (R << 24) |
+			       (G << 16) |
+			       (B << 8) |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 4;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGR888_BGRA8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+	Uint32 A = (Uint32)info->src->alpha;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = (pixel & 0x000000FF);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = ((pixel & 0x00FF0000) >> 16);
+			pixel = (R << 8) |
+			       (G << 16) |
+			       (B << 24) |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 4;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_ARGB8888_ABGR8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = ((pixel & 0x00FF0000) >> 16);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = (pixel & 0x000000FF);
+			Uint32 A = ((pixel & 0xFF000000) >> 24);
+			pixel = R |
+			       (G << 8) |
+			       (B << 16) |
+			       (A << 24);
+			*(Uint32 *)dst = pixel;
+			src += 4;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_ARGB8888_RGBA8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = ((pixel & 0x00FF0000) >> 16);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = (pixel & 0x000000FF);
+			Uint32 A = ((pixel & 0xFF000000) >> 24);
+			pixel = (R << 24) |
+			       (G << 16) |
+			       (B << 8) |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 4;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_ARGB8888_BGRA8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = ((pixel & 0x00FF0000) >> 16);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = (pixel & 0x000000FF);
+			Uint32 A = ((pixel & 0xFF000000) >> 24);
+			pixel = (R << 8) |
+			       (G << 16) |
+			       (B << 24) |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 4;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_ABGR8888_ARGB8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = (pixel & 0x000000FF);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = ((pixel & 0x00FF0000) >> 16);
+			Uint32 A = ((pixel & 0xFF000000) >> 24);
+			pixel = (R << 16) |
+			       (G << 8) |
+			       B |
+			       (A << 24);
+			*(Uint32 *)dst = pixel;
+			src += 4;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_ABGR8888_RGBA8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = (pixel & 0x000000FF);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = ((pixel & 0x00FF0000) >> 16);
+			Uint32 A = ((pixel & 0xFF000000) >> 24);
+			pixel = (R << 24) |
+			       (G << 16) |
+			       (B << 8) |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 4;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_ABGR8888_BGRA8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = (pixel & 0x000000FF);
+			Uint32 G = ((pixel & 0x0000FF00) >> 8);
+			Uint32 B = ((pixel & 0x00FF0000) >> 16);
+			Uint32 A = ((pixel & 0xFF000000) >> 24);
+			pixel = (R << 8) |
+			       (G << 16) |
+			       (B << 24) |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 4;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGBA8888_RGB565(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = ((pixel & 0xFF000000) >> 24);
+			Uint32 G = ((pixel & 0x00FF0000) >> 16);
+			Uint32 B = ((pixel & 0x0000FF00) >> 8);
+			pixel = ((R >> 3) << 11) |
+			       ((G >> 2) << 5) |
+			       (B >> 3);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 4;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGBA8888_BGR565(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = ((pixel & 0xFF000000) >> 24);
+			Uint32 G = ((pixel & 0x00FF0000) >> 16);
+			Uint32 B = ((pixel & 0x0000FF00) >> 8);
+			pixel = (R >> 3) |
+			       ((G >> 2) << 5) |
+			       ((B >> 3) << 11);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 4;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGBA8888_RGB555(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = ((pixel & 0xFF000000) >> 24);
+			Uint32 G = ((pixel & 0x00FF0000) >> 16);
+			Uint32 B = ((pixel & 0x0000FF00) >> 8);
+			pixel = ((R >> 3) << 10) |
+			       ((G >> 3) << 5) |
+			       (B >> 3);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 4;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGBA8888_BGR555(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = ((pixel & 0xFF000000) >> 24);
+			Uint32 G = ((pixel & 0x00FF0000) >> 16);
+			Uint32 B = ((pixel & 0x0000FF00) >> 8);
+			pixel = (R >> 3) |
+			       ((G >> 3) << 5) |
+			       ((B >> 3) << 10);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 4;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGBA8888_RGB24(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = ((pixel & 0xFF000000) >> 24);
+			Uint32 G = ((pixel & 0x00FF0000) >> 16);
+			Uint32 B = ((pixel & 0x0000FF00) >> 8);
+			dst[BLIT_AUTO_BYTE24(16)] = (Uint8)R;
+			dst[BLIT_AUTO_BYTE24(8)] = (Uint8)G;
+			dst[BLIT_AUTO_BYTE24(0)] = (Uint8)B;
+			src += 4;
+			dst += 3;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGBA8888_BGR24(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = ((pixel & 0xFF000000) >> 24);
+			Uint32 G = ((pixel & 0x00FF0000) >> 16);
+			Uint32 B = ((pixel & 0x0000FF00) >> 8);
+			dst[BLIT_AUTO_BYTE24(0)] = (Uint8)R;
+			dst[BLIT_AUTO_BYTE24(8)] = (Uint8)G;
+			dst[BLIT_AUTO_BYTE24(16)] = (Uint8)B;
+			src += 4;
+			dst += 3;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGBA8888_RGB888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = ((pixel & 0xFF000000) >> 24);
+			Uint32 G = ((pixel & 0x00FF0000) >> 16);
+			Uint32 B = ((pixel & 0x0000FF00) >> 8);
+			pixel = (R << 16) |
+			       (G << 8) |
+			       B;
+			*(Uint32 *)dst = pixel;
+			src += 4;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGBA8888_BGR888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = ((pixel & 0xFF000000) >> 24);
+			Uint32 G = ((pixel & 0x00FF0000) >> 16);
+			Uint32 B = ((pixel & 0x0000FF00) >> 8);
+			pixel = R |
+			       (G << 8) |
+			       (B << 16);
+			*(Uint32 *)dst = pixel;
+			src += 4;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGBA8888_ARGB8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = ((pixel & 0xFF000000) >> 24);
+			Uint32 G = ((pixel & 0x00FF0000) >> 16);
+			Uint32 B = ((pixel & 0x0000FF00) >> 8);
+			Uint32 A = (pixel & 0x000000FF);
+			pixel = (R << 16) |
+			       (G << 8) |
+			       B |
+			       (A << 24);
+			*(Uint32 *)dst = pixel;
+			src += 4;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGBA8888_ABGR8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = ((pixel & 0xFF000000) >> 24);
+			Uint32 G = ((pixel & 0x00FF0000) >> 16);
+			Uint32 B = ((pixel & 0x0000FF00) >> 8);
+			Uint32 A = (pixel & 0x000000FF);
+			pixel = R |
+			       (G << 8) |
+			       (B << 16) |
+			       (A << 24);
+			*(Uint32 *)dst = pixel;
+			src += 4;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_RGBA8888_BGRA8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = ((pixel & 0xFF000000) >> 24);
+			Uint32 G = ((pixel & 0x00FF0000) >> 16);
+			Uint32 B = ((pixel & 0x0000FF00) >> 8);
+			Uint32 A = (pixel & 0x000000FF);
+			pixel = (R << 8) |
+			       (G << 16) |
+			       (B << 24) |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 4;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGRA8888_RGB565(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = ((pixel & 0x0000FF00) >> 8);
+			Uint32 G = ((pixel & 0x00FF0000) >> 16);
+			Uint32 B = ((pixel & 0xFF000000) >> 24);
+			pixel = ((R >> 3) << 11) |
+			       ((G >> 2) << 5) |
+			       (B >> 3);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 4;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGRA8888_BGR565(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = ((pixel & 0x0000FF00) >> 8);
+			Uint32 G = ((pixel & 0x00FF0000) >> 16);
+			Uint32 B = ((pixel & 0xFF000000) >> 24);
+			pixel = (R >> 3) |
+			       ((G >> 2) << 5) |
+			       ((B >> 3) << 11);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 4;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGRA8888_RGB555(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = ((pixel & 0x0000FF00) >> 8);
+			Uint32 G = ((pixel & 0x00FF0000) >> 16);
+			Uint32 B = ((pixel & 0xFF000000) >> 24);
+			pixel = ((R >> 3) << 10) |
+			       ((G >> 3) << 5) |
+			       (B >> 3);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 4;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGRA8888_BGR555(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = ((pixel & 0x0000FF00) >> 8);
+			Uint32 G = ((pixel & 0x00FF0000) >> 16);
+			Uint32 B = ((pixel & 0xFF000000) >> 24);
+			pixel = (R >> 3) |
+			       ((G >> 3) << 5) |
+			       ((B >> 3) << 10);
+			*(Uint16 *)dst = (Uint16)pixel;
+			src += 4;
+			dst += 2;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGRA8888_RGB24(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = ((pixel & 0x0000FF00) >> 8);
+			Uint32 G = ((pixel & 0x00FF0000) >> 16);
+			Uint32 B = ((pixel & 0xFF000000) >> 24);
+			dst[BLIT_AUTO_BYTE24(16)] = (Uint8)R;
+			dst[BLIT_AUTO_BYTE24(8)] = (Uint8)G;
+			dst[BLIT_AUTO_BYTE24(0)] = (Uint8)B;
+			src += 4;
+			dst += 3;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGRA8888_BGR24(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = ((pixel & 0x0000FF00) >> 8);
+			Uint32 G = ((pixel & 0x00FF0000) >> 16);
+			Uint32 B = ((pixel & 0xFF000000) >> 24);
+			dst[BLIT_AUTO_BYTE24(0)] = (Uint8)R;
+			dst[BLIT_AUTO_BYTE24(8)] = (Uint8)G;
+			dst[BLIT_AUTO_BYTE24(16)] = (Uint8)B;
+			src += 4;
+			dst += 3;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGRA8888_RGB888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = ((pixel & 0x0000FF00) >> 8);
+			Uint32 G = ((pixel & 0x00FF0000) >> 16);
+			Uint32 B = ((pixel & 0xFF000000) >> 24);
+			pixel = (R << 16) |
+			       (G << 8) |
+			       B;
+			*(Uint32 *)dst = pixel;
+			src += 4;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGRA8888_BGR888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = ((pixel & 0x0000FF00) >> 8);
+			Uint32 G = ((pixel & 0x00FF0000) >> 16);
+			Uint32 B = ((pixel & 0xFF000000) >> 24);
+			pixel = R |
+			       (G << 8) |
+			       (B << 16);
+			*(Uint32 *)dst = pixel;
+			src += 4;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGRA8888_ARGB8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = ((pixel & 0x0000FF00) >> 8);
+			Uint32 G = ((pixel & 0x00FF0000) >> 16);
+			Uint32 B = ((pixel & 0xFF000000) >> 24);
+			Uint32 A = (pixel & 0x000000FF);
+			pixel = (R << 16) |
+			       (G << 8) |
+			       B |
+			       (A << 24);
+			*(Uint32 *)dst = pixel;
+			src += 4;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGRA8888_ABGR8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = ((pixel & 0x0000FF00) >> 8);
+			Uint32 G = ((pixel & 0x00FF0000) >> 16);
+			Uint32 B = ((pixel & 0xFF000000) >> 24);
+			Uint32 A = (pixel & 0x000000FF);
+			pixel = R |
+			       (G << 8) |
+			       (B << 16) |
+			       (A << 24);
+			*(Uint32 *)dst = pixel;
+			src += 4;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+static void Blit_BGRA8888_RGBA8888(SDL_BlitInfo *info)
+{
+	int width = info->d_width;
+	int height = info->d_height;
+	Uint8 *src = info->s_pixels;
+	int srcskip = info->s_skip;
+	Uint8 *dst = info->d_pixels;
+	int dstskip = info->d_skip;
+
+	while ( height-- ) {
+		DUFFS_LOOP(
+		{
+			Uint32 pixel = *(Uint32 *)src;
+			Uint32 R = ((pixel & 0x0000FF00) >> 8);
+			Uint32 G = ((pixel & 0x00FF0000) >> 16);
+			Uint32 B = ((pixel & 0xFF000000) >> 24);
+			Uint32 A = (pixel & 0x000000FF);
+			pixel = (R << 24) |
+			       (G << 16) |
+			       (B << 8) |
+			       A;
+			*(Uint32 *)dst = pixel;
+			src += 4;
+			dst += 4;
+		},
+		width);
+		src += srcskip;
+		dst += dstskip;
+	}
+}
+
+const SDL_BlitAutoEntry SDL_GeneratedBlitN[] = {
+	{ 2, 0x0000F800, 0x000007E0, 0x0000001F, 0x00000000,
+	  2, 0x0000001F, 0x000007E0, 0x0000F800, 0x00000000,
+	  0, Blit_RGB565_BGR565, "Blit_RGB565_BGR565" },
+	{ 2, 0x0000F800, 0x000007E0, 0x0000001F, 0x00000000,
+	  2, 0x00007C00, 0x000003E0, 0x0000001F, 0x00000000,
+	  0, Blit_RGB565_RGB555, "Blit_RGB565_RGB555" },
+	{ 2, 0x0000F800, 0x000007E0, 0x0000001F, 0x00000000,
+	  2, 0x0000001F, 0x000003E0, 0x00007C00, 0x00000000,
+	  0, Blit_RGB565_BGR555, "Blit_RGB565_BGR555" },
+	{ 2, 0x0000F800, 0x000007E0, 0x0000001F, 0x00000000,
+	  3, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  0, Blit_RGB565_RGB24, "Blit_RGB565_RGB24" },
+	{ 2, 0x0000F800, 0x000007E0, 0x0000001F, 0x00000000,
+	  3, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  0, Blit_RGB565_BGR24, "Blit_RGB565_BGR24" },
+	{ 2, 0x0000F800, 0x000007E0, 0x0000001F, 0x00000000,
+	  4, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  0, Blit_RGB565_RGB888, "Blit_RGB565_RGB888" },
+	{ 2, 0x0000F800, 0x000007E0, 0x0000001F, 0x00000000,
+	  4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  0, Blit_RGB565_BGR888, "Blit_RGB565_BGR888" },
+	{ 2, 0x0000F800, 0x000007E0, 0x0000001F, 0x00000000,
+	  4, 0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000,
+	  0, Blit_RGB565_ARGB8888, "Blit_RGB565_ARGB8888" },
+	{ 2, 0x0000F800, 0x000007E0, 0x0000001F, 0x00000000,
+	  4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000,
+	  0, Blit_RGB565_ABGR8888, "Blit_RGB565_ABGR8888" },
+	{ 2, 0x0000F800, 0x000007E0, 0x0000001F, 0x00000000,
+	  4, 0xFF000000, 0x00FF0000, 0x0000FF00, 0x000000FF,
+	  0, Blit_RGB565_RGBA8888, "Blit_RGB565_RGBA8888" },
+	{ 2, 0x0000F800, 0x000007E0, 0x0000001F, 0x00000000,
+	  4, 0x0000FF00, 0x00FF0000, 0xFF000000, 0x000000FF,
+	  0, Blit_RGB565_BGRA8888, "Blit_RGB565_BGRA8888" },
+	{ 2, 0x0000001F, 0x000007E0, 0x0000F800, 0x00000000,
+	  2, 0x0000F800, 0x000007E0, 0x0000001F, 0x00000000,
+	  0, Blit_BGR565_RGB565, "Blit_BGR565_RGB565" },
+	{ 2, 0x0000001F, 0x000007E0, 0x0000F800, 0x00000000,
+	  2, 0x00007C00, 0x000003E0, 0x0000001F, 0x00000000,
+	  0, Blit_BGR565_RGB555, "Blit_BGR565_RGB555" },
+	{ 2, 0x0000001F, 0x000007E0, 0x0000F800, 0x00000000,
+	  2, 0x0000001F, 0x000003E0, 0x00007C00, 0x00000000,
+	  0, Blit_BGR565_BGR555, "Blit_BGR565_BGR555" },
+	{ 2, 0x0000001F, 0x000007E0, 0x0000F800, 0x00000000,
+	  3, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  0, Blit_BGR565_RGB24, "Blit_BGR565_RGB24" },
+	{ 2, 0x0000001F, 0x000007E0, 0x0000F800, 0x00000000,
+	  3, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  0, Blit_BGR565_BGR24, "Blit_BGR565_BGR24" },
+	{ 2, 0x0000001F, 0x000007E0, 0x0000F800, 0x00000000,
+	  4, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  0, Blit_BGR565_RGB888, "Blit_BGR565_RGB888" },
+	{ 2, 0x0000001F, 0x000007E0, 0x0000F800, 0x00000000,
+	  4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  0, Blit_BGR565_BGR888, "Blit_BGR565_BGR888" },
+	{ 2, 0x0000001F, 0x000007E0, 0x0000F800, 0x00000000,
+	  4, 0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000,
+	  0, Blit_BGR565_ARGB8888, "Blit_BGR565_ARGB8888" },
+	{ 2, 0x0000001F, 0x000007E0, 0x0000F800, 0x00000000,
+	  4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000,
+	  0, Blit_BGR565_ABGR8888, "Blit_BGR565_ABGR8888" },
+	{ 2, 0x0000001F, 0x000007E0, 0x0000F800, 0x00000000,
+	  4, 0xFF000000, 0x00FF0000, 0x0000FF00, 0x000000FF,
+	  0, Blit_BGR565_RGBA8888, "Blit_BGR565_RGBA8888" },
+	{ 2, 0x0000001F, 0x000007E0, 0x0000F800, 0x00000000,
+	  4, 0x0000FF00, 0x00FF0000, 0xFF000000, 0x000000FF,
+	  0, Blit_BGR565_BGRA8888, "Blit_BGR565_BGRA8888" },
+	{ 2, 0x00007C00, 0x000003E0, 0x0000001F, 0x00000000,
+	  2, 0x0000F800, 0x000007E0, 0x0000001F, 0x00000000,
+	  0, Blit_RGB555_RGB565, "Blit_RGB555_RGB565" },
+	{ 2, 0x00007C00, 0x000003E0, 0x0000001F, 0x00000000,
+	  2, 0x0000001F, 0x000007E0, 0x0000F800, 0x00000000,
+	  0, Blit_RGB555_BGR565, "Blit_RGB555_BGR565" },
+	{ 2, 0x00007C00, 0x000003E0, 0x0000001F, 0x00000000,
+	  2, 0x0000001F, 0x000003E0, 0x00007C00, 0x00000000,
+	  0, Blit_RGB555_BGR555, "Blit_RGB555_BGR555" },
+	{ 2, 0x00007C00, 0x000003E0, 0x0000001F, 0x00000000,
+	  3, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  0, Blit_RGB555_RGB24, "Blit_RGB555_RGB24" },
+	{ 2, 0x00007C00, 0x000003E0, 0x0000001F, 0x00000000,
+	  3, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  0, Blit_RGB555_BGR24, "Blit_RGB555_BGR24" },
+	{ 2, 0x00007C00, 0x000003E0, 0x0000001F, 0x00000000,
+	  4, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  0, Blit_RGB555_RGB888, "Blit_RGB555_RGB888" },
+	{ 2, 0x00007C00, 0x000003E0, 0x0000001F, 0x00000000,
+	  4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  0, Blit_RGB555_BGR888, "Blit_RGB555_BGR888" },
+	{ 2, 0x00007C00, 0x000003E0, 0x0000001F, 0x00000000,
+	  4, 0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000,
+	  0, Blit_RGB555_ARGB8888, "Blit_RGB555_ARGB8888" },
+	{ 2, 0x00007C00, 0x000003E0, 0x0000001F, 0x00000000,
+	  4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000,
+	  0, Blit_RGB555_ABGR8888, "Blit_RGB555_ABGR8888" },
+	{ 2, 0x00007C00, 0x000003E0, 0x0000001F, 0x00000000,
+	  4, 0xFF000000, 0x00FF0000, 0x0000FF00, 0x000000FF,
+	  0, Blit_RGB555_RGBA8888, "Blit_RGB555_RGBA8888" },
+	{ 2, 0x00007C00, 0x000003E0, 0x0000001F, 0x00000000,
+	  4, 0x0000FF00, 0x00FF0000, 0xFF000000, 0x000000FF,
+	  0, Blit_RGB555_BGRA8888, "Blit_RGB555_BGRA8888" },
+	{ 2, 0x0000001F, 0x000003E0, 0x00007C00, 0x00000000,
+	  2, 0x0000F800, 0x000007E0, 0x0000001F, 0x00000000,
+	  0, Blit_BGR555_RGB565, "Blit_BGR555_RGB565" },
+	{ 2, 0x0000001F, 0x000003E0, 0x00007C00, 0x00000000,
+	  2, 0x0000001F, 0x000007E0, 0x0000F800, 0x00000000,
+	  0, Blit_BGR555_BGR565, "Blit_BGR555_BGR565" },
+	{ 2, 0x0000001F, 0x000003E0, 0x00007C00, 0x00000000,
+	  2, 0x00007C00, 0x000003E0, 0x0000001F, 0x00000000,
+	  0, Blit_BGR555_RGB555, "Blit_BGR555_RGB555" },
+	{ 2, 0x0000001F, 0x000003E0, 0x00007C00, 0x00000000,
+	  3, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  0, Blit_BGR555_RGB24, "Blit_BGR555_RGB24" },
+	{ 2, 0x0000001F, 0x000003E0, 0x00007C00, 0x00000000,
+	  3, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  0, Blit_BGR555_BGR24, "Blit_BGR555_BGR24" },
+	{ 2, 0x0000001F, 0x000003E0, 0x00007C00, 0x00000000,
+	  4, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  0, Blit_BGR555_RGB888, "Blit_BGR555_RGB888" },
+	{ 2, 0x0000001F, 0x000003E0, 0x00007C00, 0x00000000,
+	  4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  0, Blit_BGR555_BGR888, "Blit_BGR555_BGR888" },
+	{ 2, 0x0000001F, 0x000003E0, 0x00007C00, 0x00000000,
+	  4, 0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000,
+	  0, Blit_BGR555_ARGB8888, "Blit_BGR555_ARGB8888" },
+	{ 2, 0x0000001F, 0x000003E0, 0x00007C00, 0x00000000,
+	  4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000,
+	  0, Blit_BGR555_ABGR8888, "Blit_BGR555_ABGR8888" },
+	{ 2, 0x0000001F, 0x000003E0, 0x00007C00, 0x00000000,
+	  4, 0xFF000000, 0x00FF0000, 0x0000FF00, 0x000000FF,
+	  0, Blit_BGR555_RGBA8888, "Blit_BGR555_RGBA8888" },
+	{ 2, 0x0000001F, 0x000003E0, 0x00007C00, 0x00000000,
+	  4, 0x0000FF00, 0x00FF0000, 0xFF000000, 0x000000FF,
+	  0, Blit_BGR555_BGRA8888, "Blit_BGR555_BGRA8888" },
+	{ 3, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  2, 0x0000F800, 0x000007E0, 0x0000001F, 0x00000000,
+	  0, Blit_RGB24_RGB565, "Blit_RGB24_RGB565" },
+	{ 3, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  2, 0x0000001F, 0x000007E0, 0x0000F800, 0x00000000,
+	  0, Blit_RGB24_BGR565, "Blit_RGB24_BGR565" },
+	{ 3, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  2, 0x00007C00, 0x000003E0, 0x0000001F, 0x00000000,
+	  0, Blit_RGB24_RGB555, "Blit_RGB24_RGB555" },
+	{ 3, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  2, 0x0000001F, 0x000003E0, 0x00007C00, 0x00000000,
+	  0, Blit_RGB24_BGR555, "Blit_RGB24_BGR555" },
+	{ 3, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  3, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  0, Blit_RGB24_BGR24, "Blit_RGB24_BGR24" },
+	{ 3, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  4, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  0, Blit_RGB24_RGB888, "Blit_RGB24_RGB888" },
+	{ 3, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  0, Blit_RGB24_BGR888, "Blit_RGB24_BGR888" },
+	{ 3, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  4, 0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000,
+	  0, Blit_RGB24_ARGB8888, "Blit_RGB24_ARGB8888" },
+	{ 3, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000,
+	  0, Blit_RGB24_ABGR8888, "Blit_RGB24_ABGR8888" },
+	{ 3, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  4, 0xFF000000, 0x00FF0000, 0x0000FF00, 0x000000FF,
+	  0, Blit_RGB24_RGBA8888, "Blit_RGB24_RGBA8888" },
+	{ 3, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  4, 0x0000FF00, 0x00FF0000, 0xFF000000, 0x000000FF,
+	  0, Blit_RGB24_BGRA8888, "Blit_RGB24_BGRA8888" },
+	{ 3, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  2, 0x0000F800, 0x000007E0, 0x0000001F, 0x00000000,
+	  0, Blit_BGR24_RGB565, "Blit_BGR24_RGB565" },
+	{ 3, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  2, 0x0000001F, 0x000007E0, 0x0000F800, 0x00000000,
+	  0, Blit_BGR24_BGR565, "Blit_BGR24_BGR565" },
+	{ 3, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  2, 0x00007C00, 0x000003E0, 0x0000001F, 0x00000000,
+	  0, Blit_BGR24_RGB555, "Blit_BGR24_RGB555" },
+	{ 3, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  2, 0x0000001F, 0x000003E0, 0x00007C00, 0x00000000,
+	  0, Blit_BGR24_BGR555, "Blit_BGR24_BGR555" },
+	{ 3, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  3, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  0, Blit_BGR24_RGB24, "Blit_BGR24_RGB24" },
+	{ 3, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  4, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  0, Blit_BGR24_RGB888, "Blit_BGR24_RGB888" },
+	{ 3, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  0, Blit_BGR24_BGR888, "Blit_BGR24_BGR888" },
+	{ 3, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  4, 0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000,
+	  0, Blit_BGR24_ARGB8888, "Blit_BGR24_ARGB8888" },
+	{ 3, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000,
+	  0, Blit_BGR24_ABGR8888, "Blit_BGR24_ABGR8888" },
+	{ 3, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  4, 0xFF000000, 0x00FF0000, 0x0000FF00, 0x000000FF,
+	  0, Blit_BGR24_RGBA8888, "Blit_BGR24_RGBA8888" },
+	{ 3, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  4, 0x0000FF00, 0x00FF0000, 0xFF000000, 0x000000FF,
+	  0, Blit_BGR24_BGRA8888, "Blit_BGR24_BGRA8888" },
+	{ 4, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  2, 0x0000F800, 0x000007E0, 0x0000001F, 0x00000000,
+	  0, Blit_RGB888_RGB565, "Blit_RGB888_RGB565" },
+	{ 4, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  2, 0x0000001F, 0x000007E0, 0x0000F800, 0x00000000,
+	  0, Blit_RGB888_BGR565, "Blit_RGB888_BGR565" },
+	{ 4, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  2, 0x00007C00, 0x000003E0, 0x0000001F, 0x00000000,
+	  0, Blit_RGB888_RGB555, "Blit_RGB888_RGB555" },
+	{ 4, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  2, 0x0000001F, 0x000003E0, 0x00007C00, 0x00000000,
+	  0, Blit_RGB888_BGR555, "Blit_RGB888_BGR555" },
+	{ 4, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  3, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  0, Blit_RGB888_RGB24, "Blit_RGB888_RGB24" },
+	{ 4, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  3, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  0, Blit_RGB888_BGR24, "Blit_RGB888_BGR24" },
+	{ 4, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  0, Blit_RGB888_BGR888, "Blit_RGB888_BGR888" },
+	{ 4, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000,
+	  0, Blit_RGB888_ABGR8888, "Blit_RGB888_ABGR8888" },
+	{ 4, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  4, 0xFF000000, 0x00FF0000, 0x0000FF00, 0x000000FF,
+	  0, Blit_RGB888_RGBA8888, "Blit_RGB888_RGBA8888" },
+	{ 4, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  4, 0x0000FF00, 0x00FF0000, 0xFF000000, 0x000000FF,
+	  0, Blit_RGB888_BGRA8888, "Blit_RGB888_BGRA8888" },
+	{ 4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  2, 0x0000F800, 0x000007E0, 0x0000001F, 0x00000000,
+	  0, Blit_BGR888_RGB565, "Blit_BGR888_RGB565" },
+	{ 4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  2, 0x0000001F, 0x000007E0, 0x0000F800, 0x00000000,
+	  0, Blit_BGR888_BGR565, "Blit_BGR888_BGR565" },
+	{ 4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  2, 0x00007C00, 0x000003E0, 0x0000001F, 0x00000000,
+	  0, Blit_BGR888_RGB555, "Blit_BGR888_RGB555" },
+	{ 4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  2, 0x0000001F, 0x000003E0, 0x00007C00, 0x00000000,
+	  0, Blit_BGR888_BGR555, "Blit_BGR888_BGR555" },
+	{ 4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  3, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  0, Blit_BGR888_RGB24, "Blit_BGR888_RGB24" },
+	{ 4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  3, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  0, Blit_BGR888_BGR24, "Blit_BGR888_BGR24" },
+	{ 4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  4, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  0, Blit_BGR888_RGB888, "Blit_BGR888_RGB888" },
+	{ 4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  4, 0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000,
+	  0, Blit_BGR888_ARGB8888, "Blit_BGR888_ARGB8888" },
+	{ 4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  4, 0xFF000000, 0x00FF0000, 0x0000FF00, 0x000000FF,
+	  0, Blit_BGR888_RGBA8888, "Blit_BGR888_RGBA8888" },
+	{ 4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  4, 0x0000FF00, 0x00FF0000, 0xFF000000, 0x000000FF,
+	  0, Blit_BGR888_BGRA8888, "Blit_BGR888_BGRA8888" },
+	{ 4, 0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000,
+	  4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000,
+	  1, Blit_ARGB8888_ABGR8888, "Blit_ARGB8888_ABGR8888" },
+	{ 4, 0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000,
+	  4, 0xFF000000, 0x00FF0000, 0x0000FF00, 0x000000FF,
+	  1, Blit_ARGB8888_RGBA8888, "Blit_ARGB8888_RGBA8888" },
+	{ 4, 0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000,
+	  4, 0x0000FF00, 0x00FF0000, 0xFF000000, 0x000000FF,
+	  1, Blit_ARGB8888_BGRA8888, "Blit_ARGB8888_BGRA8888" },
+	{ 4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000,
+	  4, 0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000,
+	  1, Blit_ABGR8888_ARGB8888, "Blit_ABGR8888_ARGB8888" },
+	{ 4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000,
+	  4, 0xFF000000, 0x00FF0000, 0x0000FF00, 0x000000FF,
+	  1, Blit_ABGR8888_RGBA8888, "Blit_ABGR8888_RGBA8888" },
+	{ 4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000,
+	  4, 0x0000FF00, 0x00FF0000, 0xFF000000, 0x000000FF,
+	  1, Blit_ABGR8888_BGRA8888, "Blit_ABGR8888_BGRA8888" },
+	{ 4, 0xFF000000, 0x00FF0000, 0x0000FF00, 0x00000000,
+	  2, 0x0000F800, 0x000007E0, 0x0000001F, 0x00000000,
+	  0, Blit_RGBA8888_RGB565, "Blit_RGBA8888_RGB565" },
+	{ 4, 0xFF000000, 0x00FF0000, 0x0000FF00, 0x00000000,
+	  2, 0x0000001F, 0x000007E0, 0x0000F800, 0x00000000,
+	  0, Blit_RGBA8888_BGR565, "Blit_RGBA8888_BGR565" },
+	{ 4, 0xFF000000, 0x00FF0000, 0x0000FF00, 0x00000000,
+	  2, 0x00007C00, 0x000003E0, 0x0000001F, 0x00000000,
+	  0, Blit_RGBA8888_RGB555, "Blit_RGBA8888_RGB555" },
+	{ 4, 0xFF000000, 0x00FF0000, 0x0000FF00, 0x00000000,
+	  2, 0x0000001F, 0x000003E0, 0x00007C00, 0x00000000,
+	  0, Blit_RGBA8888_BGR555, "Blit_RGBA8888_BGR555" },
+	{ 4, 0xFF000000, 0x00FF0000, 0x0000FF00, 0x00000000,
+	  3, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  0, Blit_RGBA8888_RGB24, "Blit_RGBA8888_RGB24" },
+	{ 4, 0xFF000000, 0x00FF0000, 0x0000FF00, 0x00000000,
+	  3, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  0, Blit_RGBA8888_BGR24, "Blit_RGBA8888_BGR24" },
+	{ 4, 0xFF000000, 0x00FF0000, 0x0000FF00, 0x00000000,
+	  4, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  0, Blit_RGBA8888_RGB888, "Blit_RGBA8888_RGB888" },
+	{ 4, 0xFF000000, 0x00FF0000, 0x0000FF00, 0x00000000,
+	  4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  0, Blit_RGBA8888_BGR888, "Blit_RGBA8888_BGR888" },
+	{ 4, 0xFF000000, 0x00FF0000, 0x0000FF00, 0x000000FF,
+	  4, 0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000,
+	  1, Blit_RGBA8888_ARGB8888, "Blit_RGBA8888_ARGB8888" },
+	{ 4, 0xFF000000, 0x00FF0000, 0x0000FF00, 0x000000FF,
+	  4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000,
+	  1, Blit_RGBA8888_ABGR8888, "Blit_RGBA8888_ABGR8888" },
+	{ 4, 0xFF000000, 0x00FF0000, 0x0000FF00, 0x000000FF,
+	  4, 0x0000FF00, 0x00FF0000, 0xFF000000, 0x000000FF,
+	  1, Blit_RGBA8888_BGRA8888, "Blit_RGBA8888_BGRA8888" },
+	{ 4, 0x0000FF00, 0x00FF0000, 0xFF000000, 0x00000000,
+	  2, 0x0000F800, 0x000007E0, 0x0000001F, 0x00000000,
+	  0, Blit_BGRA8888_RGB565, "Blit_BGRA8888_RGB565" },
+	{ 4, 0x0000FF00, 0x00FF0000, 0xFF000000, 0x00000000,
+	  2, 0x0000001F, 0x000007E0, 0x0000F800, 0x00000000,
+	  0, Blit_BGRA8888_BGR565, "Blit_BGRA8888_BGR565" },
+	{ 4, 0x0000FF00, 0x00FF0000, 0xFF000000, 0x00000000,
+	  2, 0x00007C00, 0x000003E0, 0x0000001F, 0x00000000,
+	  0, Blit_BGRA8888_RGB555, "Blit_BGRA8888_RGB555" },
+	{ 4, 0x0000FF00, 0x00FF0000, 0xFF000000, 0x00000000,
+	  2, 0x0000001F, 0x000003E0, 0x00007C00, 0x00000000,
+	  0, Blit_BGRA8888_BGR555, "Blit_BGRA8888_BGR555" },
+	{ 4, 0x0000FF00, 0x00FF0000, 0xFF000000, 0x00000000,
+	  3, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  0, Blit_BGRA8888_RGB24, "Blit_BGRA8888_RGB24" },
+	{ 4, 0x0000FF00, 0x00FF0000, 0xFF000000, 0x00000000,
+	  3, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  0, Blit_BGRA8888_BGR24, "Blit_BGRA8888_BGR24" },
+	{ 4, 0x0000FF00, 0x00FF0000, 0xFF000000, 0x00000000,
+	  4, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000,
+	  0, Blit_BGRA8888_RGB888, "Blit_BGRA8888_RGB888" },
+	{ 4, 0x0000FF00, 0x00FF0000, 0xFF000000, 0x00000000,
+	  4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000,
+	  0, Blit_BGRA8888_BGR888, "Blit_BGRA8888_BGR888" },
+	{ 4, 0x0000FF00, 0x00FF0000, 0xFF000000, 0x000000FF,
+	  4, 0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000,
+	  1, Blit_BGRA8888_ARGB8888, "Blit_BGRA8888_ARGB8888" },
+	{ 4, 0x0000FF00, 0x00FF0000, 0xFF000000, 0x000000FF,
+	  4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000,
+	  1, Blit_BGRA8888_ABGR8888, "Blit_BGRA8888_ABGR8888" },
+	{ 4, 0x0000FF00, 0x00FF0000, 0xFF000000, 0x000000FF,
+	  4, 0xFF000000, 0x00FF0000, 0x0000FF00, 0x000000FF,
+	  1, Blit_BGRA8888_RGBA8888, "Blit_BGRA8888_RGBA8888" },
+	{ 0 }
+};
@@ -0,0 +1,43 @@
+/* DO NOT EDIT!  This file is generated by sdlgenblit.pl */
+/*
+    SDL - Simple DirectMedia Layer
+    Copyright (C) 1997-2009 Sam Lantinga
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+    Sam Lantinga
+    slouken@libsdl.org
+*/
+#include "SDL_config.h"
+
+#ifndef _SDL_blit_auto_h
+#define _SDL_blit_auto_h
+
+/* A blitter from SDL_blit_auto.c.  The source alpha mask is only set for
+   blitters that copy alpha, the others ignore the source alpha. */
+typedef struct {
+	int srcbpp;
+	Uint32 srcR, srcG, srcB, srcA;
+	int dstbpp;
+	Uint32 dstR, dstG, dstB, dstA;
+	int copy_alpha;
+	SDL_loblit blitfunc;
+	const char *name;
+} SDL_BlitAutoEntry;
+
+/* Terminated by an entry with srcbpp 0 */
+extern const SDL_BlitAutoEntry SDL_GeneratedBlitN[];
+
+#endif /* _SDL_blit_auto_h */
@@ -0,0 +1,314 @@
+/*
+    SDL - Simple DirectMedia Layer
+    Copyright (C) 1997-2009 Sam Lantinga
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+    Sam Lantinga
+    slouken@libsdl.org
+*/
+#include "SDL_config.h"
+
+/* Counting the software blits and fills, per blitter and pair of formats.
+
+   Nothing is counted unless SDL_BLIT_STATS is set in the environment or
+   SDL_EnableBlitStats() is called, and then every counted blit takes a
+   lock and looks up its blitter by name.  With SDL_BLIT_STATS set the
+   counters are printed to stderr by SDL_Quit().
+*/
+
+#include <stdio.h>
+
+#include "SDL_video.h"
+#include "SDL_mutex.h"
+#include "SDL_timer.h"
+#include "SDL_blit.h"
+
+#if defined(__WIN32__)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#if HAVE_CLOCK_GETTIME || HAVE_MONOTONIC_CLOCK
+#include <time.h>
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/time.h>
+#endif
+#endif
+
+/* Most pairs of blitter and formats that are counted, the others are
+   dropped */
+#define BLIT_STATS_MAX	128
+
+int SDL_blit_stats = -1;
+
+/* Nanoseconds from some point, only the difference of two is useful.
+   The monotonic clock is used whenever there is one, gettimeofday() can
+   jump. */
+SDL_BlitTime SDL_BlitStatsTime(void)
+{
+#if defined(__WIN32__)
+	static LARGE_INTEGER freq;
+	LARGE_INTEGER now;
+
+	if ( !freq.QuadPart && !QueryPerformanceFrequency(&freq) ) {
+		return((SDL_BlitTime)SDL_GetTicks() * 1000000);
+	}
+	QueryPerformanceCounter(&now);
+	return((SDL_BlitTime)((now.QuadPart % freq.QuadPart) * 1000000000 /
+	                      freq.QuadPart + (now.QuadPart / freq.QuadPart) *
+	                      1000000000));
+#else
+#if (HAVE_CLOCK_GETTIME || HAVE_MONOTONIC_CLOCK) && defined(CLOCK_MONOTONIC)
+	struct timespec ts;
+
+	if ( clock_gettime(CLOCK_MONOTONIC, &ts) == 0 ) {
+		return((SDL_BlitTime)ts.tv_sec * 1000000000 + ts.tv_nsec);
+	}
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+	{
+		struct timeval now;
+
+		gettimeofday(&now, NULL);
+		return((SDL_BlitTime)now.tv_sec * 1000000000 +
+		       (SDL_BlitTime)now.tv_usec * 1000);
+	}
+#else
+	return((SDL_BlitTime)SDL_GetTicks() * 1000000);
+#endif
+#endif
+}
+
+#ifndef SDL_HAS_64BIT_TYPE
+
+/* The counters need 64-bit integers */
+SDL_BlitTime SDL_StartBlitStats(void)
+{
+	SDL_blit_stats = 0;
+	return(0);
+}
+
+void SDL_AddBlitStats(const char *name, SDL_PixelFormat *src,
+                      SDL_PixelFormat *dst, int w, int h, SDL_BlitTime start)
+{
+}
+
+int SDL_EnableBlitStats(int enable)
+{
+	SDL_blit_stats = 0;
+	return(0);
+}
+
+int SDL_GetBlitStats(SDL_BlitStats *stats, int maxstats)
+{
+	return(0);
+}
+
+void SDL_ResetBlitStats(void)
+{
+}
+
+void SDL_QuitBlitStats(void)
+{
+}
+
+#else
+
+static SDL_BlitStats stats[BLIT_STATS_MAX];
+static int numstats = 0;
+static int dump = 0;		/* Print the counters at quit */
+static SDL_mutex *lock = NULL;
+
+static void SDL_InitBlitStats(void)
+{
+	const char *env;
+
+	if ( SDL_blit_stats >= 0 ) {
+		return;
+	}
+	env = SDL_getenv("SDL_BLIT_STATS");
+	dump = (env && SDL_atoi(env));
+	SDL_blit_stats = dump;
+	if ( SDL_blit_stats && !lock ) {
+		lock = SDL_CreateMutex();
+	}
+}
+
+SDL_BlitTime SDL_StartBlitStats(void)
+{
+	SDL_InitBlitStats();
+	return(SDL_blit_stats ? SDL_BlitStatsTime() : 0);
+}
+
+static void SDL_LockBlitStats(void)
+{
+	if ( lock ) {
+		SDL_mutexP(lock);
+	}
+}
+
+static void SDL_UnlockBlitStats(void)
+{
+	if ( lock ) {
+		SDL_mutexV(lock);
+	}
+}
+
+static int SDL_SameBlitStats(const SDL_BlitStats *a, const SDL_BlitStats *b)
+{
+	return(a->name == b->name &&
+	       a->src_bpp == b->src_bpp && a->dst_bpp == b->dst_bpp &&
+	       a->src_Rmask == b->src_Rmask && a->dst_Rmask == b->dst_Rmask &&
+	       a->src_Gmask == b->src_Gmask && a->dst_Gmask == b->dst_Gmask &&
+	       a->src_Bmask == b->src_Bmask && a->dst_Bmask == b->dst_Bmask &&
+	       a->src_Amask == b->src_Amask && a->dst_Amask == b->dst_Amask);
+}
+
+void SDL_AddBlitStats(const char *name, SDL_PixelFormat *src,
+                      SDL_PixelFormat *dst, int w, int h, SDL_BlitTime start)
+{
+	SDL_BlitTime elapsed = SDL_BlitStatsTime() - start;
+	SDL_BlitStats key, *entry;
+	Uint64 pixels;
+	int i;
+
+	if ( SDL_blit_stats <= 0 ) {
+		return;
+	}
+	SDL_memset(&key, 0, sizeof(key));
+	key.name = name ? name : "unknown";
+	if ( src ) {
+		key.src_bpp = src->BitsPerPixel;
+		key.src_Rmask = src->Rmask;
+		key.src_Gmask = src->Gmask;
+		key.src_Bmask = src->Bmask;
+		key.src_Amask = src->Amask;
+	}
+	key.dst_bpp = dst->BitsPerPixel;
+	key.dst_Rmask = dst->Rmask;
+	key.dst_Gmask = dst->Gmask;
+	key.dst_Bmask = dst->Bmask;
+	key.dst_Amask = dst->Amask;
+	pixels = (Uint64)w * h;
+
+	SDL_LockBlitStats();
+	entry = NULL;
+	for ( i = 0; i < numstats; ++i ) {
+		if ( SDL_SameBlitStats(&stats[i], &key) ) {
+			entry = &stats[i];
+			break;
+		}
+	}
+	if ( !entry && (numstats < BLIT_STATS_MAX) ) {
+		entry = &stats[numstats++];
+		*entry = key;
+	}
+	if ( entry ) {
+		++entry->calls;
+		entry->pixels += pixels;
+		entry->bytes += pixels * ((src ? src->BytesPerPixel : 0) +
+		                          dst->BytesPerPixel);
+		entry->nanoseconds += elapsed;
+	}
+	SDL_UnlockBlitStats();
+}
+
+int SDL_EnableBlitStats(int enable)
+{
+	int previous;
+
+	SDL_InitBlitStats();
+	previous = SDL_blit_stats;
+	if ( enable >= 0 ) {
+		if ( enable && !lock ) {
+			lock = SDL_CreateMutex();
+		}
+		SDL_blit_stats = enable ? 1 : 0;
+	}
+	return(previous);
+}
+
+int SDL_GetBlitStats(SDL_BlitStats *entries, int maxentries)
+{
+	int count;
+
+	SDL_LockBlitStats();
+	count = numstats;
+	if ( entries ) {
+		if ( maxentries > numstats ) {
+			maxentries = numstats;
+		}
+		if ( maxentries > 0 ) {
+			SDL_memcpy(entries, stats, maxentries * sizeof(*stats));
+		}
+	}
+	SDL_UnlockBlitStats();
+	return(count);
+}
+
+void SDL_ResetBlitStats(void)
+{
+	SDL_LockBlitStats();
+	numstats = 0;
+	SDL_UnlockBlitStats();
+}
+
+static void SDL_PrintBlitStatsFormat(Uint8 bpp, Uint32 Rmask, Uint32 Gmask,
+                                     Uint32 Bmask, Uint32 Amask)
+{
+	if ( bpp ) {
+		fprintf(stderr, " %d:%X/%X/%X/%X", bpp,
+		        Rmask, Gmask, Bmask, Amask);
+	} else {
+		fprintf(stderr, " -");
+	}
+}
+
+void SDL_QuitBlitStats(void)
+{
+	int i;
+
+	if ( dump && numstats ) {
+		fprintf(stderr, "SDL blit stats: calls, Mpixels, ms, "
+		                "Mpixels/s, blitter, source, destination\n");
+		for ( i = 0; i < numstats; ++i ) {
+			const SDL_BlitStats *entry = &stats[i];
+			double mpixels = (double)(Sint64)entry->pixels / 1e6;
+			double ms = (double)(Sint64)entry->nanoseconds / 1e6;
+
+			fprintf(stderr, "%8u %10.3f %10.3f %10.1f %s",
+			        entry->calls, mpixels, ms,
+			        ms > 0.0 ? mpixels * 1000.0 / ms : 0.0,
+			        entry->name);
+			SDL_PrintBlitStatsFormat(entry->src_bpp,
+			        entry->src_Rmask, entry->src_Gmask,
+			        entry->src_Bmask, entry->src_Amask);
+			SDL_PrintBlitStatsFormat(entry->dst_bpp,
+			        entry->dst_Rmask, entry->dst_Gmask,
+			        entry->dst_Bmask, entry->dst_Amask);
+			fprintf(stderr, "\n");
+		}
+	}
+	numstats = 0;
+	dump = 0;
+	SDL_blit_stats = -1;
+	if ( lock ) {
+		SDL_DestroyMutex(lock);
+		lock = NULL;
+	}
+}
+
+#endif /* SDL_HAS_64BIT_TYPE */
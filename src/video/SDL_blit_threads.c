@@ -0,0 +1,357 @@
+/*
+    SDL - Simple DirectMedia Layer
+    Copyright (C) 1997-2009 Sam Lantinga
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+    Sam Lantinga
+    slouken@libsdl.org
+*/
+#include "SDL_config.h"
+
+/* Running large software blits on several threads.
+
+   The blit is cut into horizontal bands, each with its own SDL_BlitInfo,
+   which are handed out to a pool of worker threads.  The calling thread
+   takes bands as well and returns once all of them are done.  The low
+   level blitters only ever look at the rows they are given, so any of
+   them can be run this way, except for copies within one surface.
+   Other row by row work, like converting YUV overlays, goes through
+   SDL_ThreadedBands() with a function called for each band.
+*/
+
+#include "SDL_video.h"
+#include "SDL_thread.h"
+#include "SDL_mutex.h"
+#include "SDL_blit.h"
+
+#if defined(__WIN32__)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+/* Most threads a blit is split across, one band each */
+#define BLIT_MAX_THREADS	SDL_MAX_BANDS
+
+/* Blits smaller than this (in pixels) are never split, they would spend
+   more time waking up the workers than blitting */
+#define BLIT_THREAD_MIN_PIXELS	(256*256)
+
+/* Fewest rows in one band */
+#define BLIT_BAND_MIN_ROWS	16
+
+#if SDL_THREADS_DISABLED
+
+int SDL_SetBlitThreads(int threads)
+{
+	return(1);
+}
+
+void SDL_ThreadedBlit(SDL_loblit blit, SDL_BlitInfo *info,
+                      int src_pitch, int dst_pitch)
+{
+	blit(info);
+}
+
+void SDL_ThreadedBands(SDL_BandFunc func, void *data, int w, int h,
+                       int align)
+{
+	func(data, 0, 0, h);
+}
+
+void SDL_QuitBlitThreads(void)
+{
+}
+
+#else
+
+static struct {
+	int configured;		/* The environment was read */
+	int min_pixels;
+	int threads;		/* Wanted, including the calling thread */
+	int started;		/* Workers running */
+	SDL_Thread *workers[BLIT_MAX_THREADS-1];
+	SDL_mutex *lock;
+	SDL_cond *wake;		/* New bands, or quit */
+	SDL_cond *done;		/* The last band finished */
+	int busy;		/* A blit is using the pool */
+	int quit;
+
+	/* The current bands, under 'lock' */
+	SDL_BandFunc func;
+	void *data;
+	int starts[BLIT_MAX_THREADS+1];	/* First row of each band */
+	int numbands;
+	int nextband;
+	int pending;
+} pool;
+
+/* A blit being split by SDL_ThreadedBlit() */
+typedef struct {
+	SDL_loblit blit;
+	SDL_BlitInfo *info;
+	int src_pitch;
+	int dst_pitch;
+} SDL_BlitBands;
+
+static int SDL_BlitCPUCount(void)
+{
+	int count = 1;
+
+#if defined(__WIN32__)
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	count = (int)info.dwNumberOfProcessors;
+#elif defined(_SC_NPROCESSORS_ONLN)
+	count = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+	if ( count < 1 ) {
+		count = 1;
+	}
+	return(count);
+}
+
+static int SDL_ClampBlitThreads(int threads)
+{
+	if ( threads <= 0 ) {
+		threads = SDL_BlitCPUCount();
+	}
+	if ( threads > BLIT_MAX_THREADS ) {
+		threads = BLIT_MAX_THREADS;
+	}
+	return(threads);
+}
+
+/* Read the environment the first time the pool is looked at */
+static void SDL_InitBlitThreadConfig(void)
+{
+	const char *env;
+
+	if ( pool.configured ) {
+		return;
+	}
+	pool.min_pixels = BLIT_THREAD_MIN_PIXELS;
+	env = SDL_getenv("SDL_BLIT_THREAD_MIN");
+	if ( env && (SDL_atoi(env) > 0) ) {
+		pool.min_pixels = SDL_atoi(env);
+	}
+	env = SDL_getenv("SDL_BLIT_THREADS");
+	pool.threads = SDL_ClampBlitThreads(env ? SDL_atoi(env) : 0);
+	pool.configured = 1;
+}
+
+/* Take bands until there are none left, with the pool locked */
+static void SDL_RunBlitBands(void)
+{
+	int band;
+
+	while ( pool.nextband < pool.numbands ) {
+		band = pool.nextband++;
+		SDL_mutexV(pool.lock);
+		pool.func(pool.data, band, pool.starts[band],
+		          pool.starts[band+1] - pool.starts[band]);
+		SDL_mutexP(pool.lock);
+		if ( --pool.pending == 0 ) {
+			SDL_CondSignal(pool.done);
+		}
+	}
+}
+
+static int SDLCALL SDL_BlitWorker(void *unused)
+{
+	SDL_mutexP(pool.lock);
+	while ( ! pool.quit ) {
+		SDL_RunBlitBands();
+		SDL_CondWait(pool.wake, pool.lock);
+	}
+	SDL_mutexV(pool.lock);
+	return(0);
+}
+
+void SDL_QuitBlitThreads(void)
+{
+	int i;
+
+	if ( pool.started ) {
+		SDL_mutexP(pool.lock);
+		pool.quit = 1;
+		SDL_CondBroadcast(pool.wake);
+		SDL_mutexV(pool.lock);
+		for ( i = 0; i < pool.started; ++i ) {
+			SDL_WaitThread(pool.workers[i], NULL);
+		}
+		pool.started = 0;
+		pool.quit = 0;
+	}
+	if ( pool.lock ) {
+		SDL_DestroyMutex(pool.lock);
+		pool.lock = NULL;
+	}
+	if ( pool.wake ) {
+		SDL_DestroyCond(pool.wake);
+		pool.wake = NULL;
+	}
+	if ( pool.done ) {
+		SDL_DestroyCond(pool.done);
+		pool.done = NULL;
+	}
+}
+
+static int SDL_StartBlitThreads(void)
+{
+	pool.lock = SDL_CreateMutex();
+	pool.wake = SDL_CreateCond();
+	pool.done = SDL_CreateCond();
+	if ( !pool.lock || !pool.wake || !pool.done ) {
+		SDL_QuitBlitThreads();
+		return(-1);
+	}
+	return(0);
+}
+
+/* Start workers up to the wanted count, with the pool locked.  Workers
+   beyond it, after the count was lowered, stay idle. */
+static void SDL_StartBlitWorkers(void)
+{
+	while ( pool.started < (pool.threads - 1) ) {
+		pool.workers[pool.started] = SDL_CreateThread(SDL_BlitWorker, NULL);
+		if ( pool.workers[pool.started] == NULL ) {
+			/* Don't try again on every blit */
+			pool.threads = pool.started + 1;
+			break;
+		}
+		++pool.started;
+	}
+}
+
+int SDL_SetBlitThreads(int threads)
+{
+	SDL_InitBlitThreadConfig();
+	threads = SDL_ClampBlitThreads(threads);
+
+	/* Blits in progress keep their bands, the next ones use the new
+	   count */
+	if ( pool.lock ) {
+		SDL_mutexP(pool.lock);
+		pool.threads = threads;
+		SDL_mutexV(pool.lock);
+	} else {
+		pool.threads = threads;
+	}
+	return(threads);
+}
+
+static void SDL_BlitBand(void *data, int unused, int y, int rows)
+{
+	SDL_BlitBands *bands = (SDL_BlitBands *)data;
+	SDL_BlitInfo band = *bands->info;
+
+	band.s_height = band.d_height = rows;
+	band.s_pixels += y * bands->src_pitch;
+	band.d_pixels += y * bands->dst_pitch;
+	bands->blit(&band);
+}
+
+void SDL_ThreadedBlit(SDL_loblit blit, SDL_BlitInfo *info,
+                      int src_pitch, int dst_pitch)
+{
+	SDL_BlitBands bands;
+
+	/* Small blits pay nothing beyond these tests */
+	SDL_InitBlitThreadConfig();
+	if ( (info->d_width * info->d_height) < pool.min_pixels ) {
+		blit(info);
+		return;
+	}
+	bands.blit = blit;
+	bands.info = info;
+	bands.src_pitch = src_pitch;
+	bands.dst_pitch = dst_pitch;
+	SDL_ThreadedBands(SDL_BlitBand, &bands,
+	                  info->d_width, info->d_height, 1);
+}
+
+void SDL_ThreadedBands(SDL_BandFunc func, void *data, int w, int h,
+                       int align)
+{
+	int numbands, rows, extra, y, i;
+
+	SDL_InitBlitThreadConfig();
+	if ( (w * h) < pool.min_pixels ) {
+		func(data, 0, 0, h);
+		return;
+	}
+
+	numbands = h / BLIT_BAND_MIN_ROWS;
+	if ( numbands < 2 ) {
+		func(data, 0, 0, h);
+		return;
+	}
+	if ( !pool.lock && (SDL_StartBlitThreads() < 0) ) {
+		func(data, 0, 0, h);
+		return;
+	}
+
+	/* Another thread is using the pool, don't wait for it */
+	SDL_mutexP(pool.lock);
+	if ( pool.busy ) {
+		SDL_mutexV(pool.lock);
+		func(data, 0, 0, h);
+		return;
+	}
+	/* SDL_SetBlitThreads() changes the count under the lock */
+	SDL_StartBlitWorkers();
+	if ( numbands > pool.threads ) {
+		numbands = pool.threads;
+	}
+	if ( numbands > (pool.started + 1) ) {
+		numbands = pool.started + 1;
+	}
+	if ( numbands < 2 ) {
+		SDL_mutexV(pool.lock);
+		func(data, 0, 0, h);
+		return;
+	}
+	pool.busy = 1;
+
+	/* Cut the rows into bands of (nearly) equal height, each starting
+	   on a multiple of 'align' */
+	rows = (h / align) / numbands;
+	extra = (h / align) % numbands;
+	y = 0;
+	for ( i = 0; i < numbands; ++i ) {
+		pool.starts[i] = y;
+		y += (rows + (i < extra)) * align;
+	}
+	pool.starts[numbands] = h;
+	pool.func = func;
+	pool.data = data;
+	pool.numbands = numbands;
+	pool.nextband = 0;
+	pool.pending = numbands;
+	SDL_CondBroadcast(pool.wake);
+
+	/* Help out, then wait for the bands still being run */
+	SDL_RunBlitBands();
+	while ( pool.pending > 0 ) {
+		SDL_CondWait(pool.done, pool.lock);
+	}
+	pool.busy = 0;
+	SDL_mutexV(pool.lock);
+}
+
+#endif /* SDL_THREADS_DISABLED */
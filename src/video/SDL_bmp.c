@@ -424,7 +424,7 @@ int SDL_SaveBMP_RW (SDL_Surface *saveme, SDL_RWops *dst, int freedst)
 		}
 	}
 
-	if ( surface && (SDL_LockSurface(surface) == 0) ) {
+	if ( surface && (SDL_LockSurfaceReadOnly(surface) == 0) ) {
 		const int bw = surface->w*surface->format->BytesPerPixel;
 
 		/* Set the BMP file header values */
@@ -36,6 +36,7 @@
 #endif
 
 #include "SDL_sysvideo.h"
+#include "SDL_present_c.h"
 
 
 static void CalculateGammaRamp(float gamma, Uint16 *ramp)
@@ -187,6 +188,11 @@ int SDL_SetGammaRamp(const Uint16 *red, const Uint16 *green, const Uint16 *blue)
 	succeeded = -1;
 	if ( video->SetGammaRamp ) {
 		succeeded = video->SetGammaRamp(this, video->gamma);
+	} else if ( video->gamma_lut && !(screen->flags & SDL_OPENGL) ) {
+		/* Emulated by the driver, redraw the screen with it */
+		SDL_BuildGammaLUT(video->gamma_lut, video->gamma);
+		SDL_UpdateRect(screen, 0, 0, 0, 0);
+		succeeded = 0;
 	} else {
 		SDL_SetError("Gamma ramp manipulation not supported");
 	}
@@ -534,6 +534,10 @@ void SDL_InvalidateMap(SDL_BlitMap *map)
 	}
 	map->dst = NULL;
 	map->format_version = (unsigned int)-1;
+	if ( map->sw_data ) {
+		SDL_CancelRLE(map);
+		map->sw_data->rle_blit = NULL;
+	}
 	if ( map->table ) {
 		SDL_free(map->table);
 		map->table = NULL;
@@ -619,6 +623,9 @@ void SDL_FreeBlitMap(SDL_BlitMap *map)
 	if ( map ) {
 		SDL_InvalidateMap(map);
 		if ( map->sw_data != NULL ) {
+			if ( map->sw_data->batch_rows ) {
+				SDL_free(map->sw_data->batch_rows);
+			}
 			SDL_free(map->sw_data);
 		}
 		SDL_free(map);
@@ -0,0 +1,948 @@
+/*
+    SDL - Simple DirectMedia Layer
+    Copyright (C) 1997-2009 Sam Lantinga
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+    Sam Lantinga
+    slouken@libsdl.org
+*/
+#include "SDL_config.h"
+
+/* The present stage: logical surface -> physical surface in one pass.
+
+   Every physical pixel is mapped back to a logical position with a
+   16.16 fixed point affine transform (scale + rotation), sampled with
+   the selected filter and converted to the physical pixel format, so
+   the frame is only read and written once.  Rotated presents are done
+   in square tiles, so that the column walk over the logical surface
+   stays in the data cache.  A software gamma ramp is applied on the
+   R-G-B values of the conversion, so it costs no extra pass either.
+   Unscaled copies in the same format, which have no conversion, go
+   through SDL_GammaRotateRect(), which applies it as it copies.
+*/
+
+#include "SDL_video.h"
+#include "SDL_cpuinfo.h"
+#include "SDL_blit.h"
+#include "SDL_present_c.h"
+#include "SDL_rotate_c.h"
+
+/* Size of the physical tiles used for rotated presents */
+#define PRESENT_TILE	32
+
+/* Nearest neighbour kernels for the common pixel sizes */
+#define PRESENT_NEAREST(name, stype, dtype, CONVERT)			\
+static void name(const SDL_PresentInfo *info, Uint8 *dst,		\
+                 int width, Sint32 sx, Sint32 sy)			\
+{									\
+	const Uint8 *pixels = (const Uint8 *)info->src->pixels;		\
+	const int pitch = info->src->pitch;				\
+	const Sint32 du_x = info->du_x;					\
+	const Sint32 du_y = info->du_y;					\
+	dtype *d = (dtype *)dst;					\
+	Uint32 s;							\
+									\
+	while ( width-- ) {						\
+		s = ((const stype *)(pixels + (sy >> 16) * pitch))[sx >> 16]; \
+		CONVERT;						\
+		sx += du_x;						\
+		sy += du_y;						\
+	}								\
+}
+
+#define PRESENT_COPY(dtype)						\
+	*d++ = (dtype)s
+
+#define PRESENT_MAP(dtype)						\
+	*d++ = (dtype)info->map[s]
+
+#define PRESENT_CONVERT(dtype)						\
+{									\
+	const SDL_PixelFormat *sf = info->src->format;			\
+	const SDL_PixelFormat *df = info->dst->format;			\
+	Uint32 r, g, b, p;						\
+	RGB_FROM_PIXEL(s, sf, r, g, b);					\
+	PIXEL_FROM_RGB(p, df, r, g, b);					\
+	*d++ = (dtype)p;						\
+}
+
+/* Same as PRESENT_CONVERT, through the gamma tables */
+#define PRESENT_GAMMA(dtype)						\
+{									\
+	const SDL_PixelFormat *sf = info->src->format;			\
+	const SDL_PixelFormat *df = info->dst->format;			\
+	const SDL_GammaLUT *lut = info->lut;				\
+	Uint32 r, g, b, p;						\
+	RGB_FROM_PIXEL(s, sf, r, g, b);					\
+	PIXEL_FROM_RGB(p, df, lut->r[r], lut->g[g], lut->b[b]);	\
+	*d++ = (dtype)p;						\
+}
+
+PRESENT_NEAREST(Present_Copy16, Uint16, Uint16, PRESENT_COPY(Uint16))
+PRESENT_NEAREST(Present_Copy32, Uint32, Uint32, PRESENT_COPY(Uint32))
+PRESENT_NEAREST(Present_Map8to16, Uint8, Uint16, PRESENT_MAP(Uint16))
+PRESENT_NEAREST(Present_Map8to32, Uint8, Uint32, PRESENT_MAP(Uint32))
+PRESENT_NEAREST(Present_16to16, Uint16, Uint16, PRESENT_CONVERT(Uint16))
+PRESENT_NEAREST(Present_16to32, Uint16, Uint32, PRESENT_CONVERT(Uint32))
+PRESENT_NEAREST(Present_32to16, Uint32, Uint16, PRESENT_CONVERT(Uint16))
+PRESENT_NEAREST(Present_32to32, Uint32, Uint32, PRESENT_CONVERT(Uint32))
+PRESENT_NEAREST(Present_Gamma16to16, Uint16, Uint16, PRESENT_GAMMA(Uint16))
+PRESENT_NEAREST(Present_Gamma16to32, Uint16, Uint32, PRESENT_GAMMA(Uint32))
+PRESENT_NEAREST(Present_Gamma32to16, Uint32, Uint16, PRESENT_GAMMA(Uint16))
+PRESENT_NEAREST(Present_Gamma32to32, Uint32, Uint32, PRESENT_GAMMA(Uint32))
+
+/* Get the R-G-B values of a logical pixel, whatever its size */
+static __inline__ void Present_GetRGB(const SDL_PresentInfo *info,
+                                      int x, int y,
+                                      Uint32 *r, Uint32 *g, Uint32 *b)
+{
+	const SDL_Surface *src = info->src;
+	const SDL_PixelFormat *sf = src->format;
+	const Uint8 *p;
+	Uint32 pixel;
+
+	p = (const Uint8 *)src->pixels + y*src->pitch + x*sf->BytesPerPixel;
+	if ( sf->BytesPerPixel == 1 ) {
+		const SDL_Color *c = &sf->palette->colors[*p];
+		*r = c->r;
+		*g = c->g;
+		*b = c->b;
+	} else {
+		Uint32 sr, sg, sb;
+		DISEMBLE_RGB(p, sf->BytesPerPixel, sf, pixel, sr, sg, sb);
+		*r = sr;
+		*g = sg;
+		*b = sb;
+	}
+}
+
+/* Nearest neighbour for anything not covered above (24 bpp) */
+static void Present_NearestAny(const SDL_PresentInfo *info, Uint8 *dst,
+                               int width, Sint32 sx, Sint32 sy)
+{
+	const SDL_PixelFormat *df = info->dst->format;
+	const SDL_GammaLUT *lut = info->lut;
+	const int dbpp = df->BytesPerPixel;
+	Uint32 r, g, b;
+
+	while ( width-- ) {
+		Present_GetRGB(info, sx >> 16, sy >> 16, &r, &g, &b);
+		if ( lut ) {
+			r = lut->r[r];
+			g = lut->g[g];
+			b = lut->b[b];
+		}
+		ASSEMBLE_RGB(dst, dbpp, df, r, g, b);
+		dst += dbpp;
+		sx += info->du_x;
+		sy += info->du_y;
+	}
+}
+
+/* Bilinear filter, 8 bits of sub-pixel precision */
+static void Present_Bilinear(const SDL_PresentInfo *info, Uint8 *dst,
+                             int width, Sint32 sx, Sint32 sy)
+{
+	const SDL_PixelFormat *df = info->dst->format;
+	const SDL_GammaLUT *lut = info->lut;
+	const int dbpp = df->BytesPerPixel;
+	const int last_x = info->src->w - 1;
+	const int last_y = info->src->h - 1;
+	const Sint32 max_x = last_x << 16;
+	const Sint32 max_y = last_y << 16;
+	Sint32 x, y;
+	int x0, y0, x1, y1;
+	Uint32 fx, fy;
+	Uint32 r00, g00, b00, r10, g10, b10;
+	Uint32 r01, g01, b01, r11, g11, b11;
+	Uint32 r, g, b;
+
+	while ( width-- ) {
+		x = (sx < 0) ? 0 : ((sx > max_x) ? max_x : sx);
+		y = (sy < 0) ? 0 : ((sy > max_y) ? max_y : sy);
+		x0 = x >> 16;
+		y0 = y >> 16;
+		x1 = (x0 < last_x) ? x0 + 1 : x0;
+		y1 = (y0 < last_y) ? y0 + 1 : y0;
+		fx = (x >> 8) & 0xFF;
+		fy = (y >> 8) & 0xFF;
+
+		Present_GetRGB(info, x0, y0, &r00, &g00, &b00);
+		Present_GetRGB(info, x1, y0, &r10, &g10, &b10);
+		Present_GetRGB(info, x0, y1, &r01, &g01, &b01);
+		Present_GetRGB(info, x1, y1, &r11, &g11, &b11);
+
+#define BILINEAR(c00, c10, c01, c11) \
+	((((c00)*(256-fx) + (c10)*fx) * (256-fy) + \
+	  ((c01)*(256-fx) + (c11)*fx) * fy) >> 16)
+		r = BILINEAR(r00, r10, r01, r11);
+		g = BILINEAR(g00, g10, g01, g11);
+		b = BILINEAR(b00, b10, b01, b11);
+#undef BILINEAR
+		if ( lut ) {
+			r = lut->r[r];
+			g = lut->g[g];
+			b = lut->b[b];
+		}
+
+		ASSEMBLE_RGB(dst, dbpp, df, r, g, b);
+		dst += dbpp;
+		sx += info->du_x;
+		sy += info->du_y;
+	}
+}
+
+static int Present_SameFormat(const SDL_PixelFormat *a,
+                              const SDL_PixelFormat *b)
+{
+	return ( (a->BitsPerPixel == b->BitsPerPixel) &&
+	         (a->Rmask == b->Rmask) && (a->Gmask == b->Gmask) &&
+	         (a->Bmask == b->Bmask) );
+}
+
+static SDL_PresentRow Present_ChooseRow(const SDL_PresentInfo *info)
+{
+	const SDL_PixelFormat *sf = info->src->format;
+	const SDL_PixelFormat *df = info->dst->format;
+
+	if ( info->filter == SDL_PRESENT_BILINEAR ) {
+		return Present_Bilinear;
+	}
+	switch (sf->BytesPerPixel) {
+	    case 1:
+		if ( df->BytesPerPixel == 2 ) {
+			return Present_Map8to16;
+		}
+		if ( df->BytesPerPixel == 4 ) {
+			return Present_Map8to32;
+		}
+		break;
+	    case 2:
+		if ( info->lut ) {
+			if ( df->BytesPerPixel == 2 ) {
+				return Present_Gamma16to16;
+			}
+			if ( df->BytesPerPixel == 4 ) {
+				return Present_Gamma16to32;
+			}
+			break;
+		}
+		if ( df->BytesPerPixel == 2 ) {
+			if ( Present_SameFormat(sf, df) ) {
+				return Present_Copy16;
+			}
+			return Present_16to16;
+		}
+		if ( df->BytesPerPixel == 4 ) {
+			return Present_16to32;
+		}
+		break;
+	    case 4:
+		if ( info->lut ) {
+			if ( df->BytesPerPixel == 2 ) {
+				return Present_Gamma32to16;
+			}
+			if ( df->BytesPerPixel == 4 ) {
+				return Present_Gamma32to32;
+			}
+			break;
+		}
+		if ( df->BytesPerPixel == 2 ) {
+			return Present_32to16;
+		}
+		if ( df->BytesPerPixel == 4 ) {
+			if ( Present_SameFormat(sf, df) ) {
+				return Present_Copy32;
+			}
+			return Present_32to32;
+		}
+		break;
+	}
+	return Present_NearestAny;
+}
+
+static void Present_SetRow(SDL_PresentInfo *info)
+{
+	const SDL_PixelFormat *sf = info->src->format;
+
+	info->row = Present_ChooseRow(info);
+
+	/* Plain rotated copies go through the shared rotation code, which
+	   also applies the gamma tables */
+	info->unscaled = ( (info->area.w == info->rot_w) &&
+	                   (info->area.h == info->rot_h) &&
+	                   (info->filter == SDL_PRESENT_NEAREST) &&
+	                   ((sf->BytesPerPixel == 2) ||
+	                    (sf->BytesPerPixel == 4)) &&
+	                   Present_SameFormat(sf, info->dst->format) );
+}
+
+void SDL_BuildGammaLUT(SDL_GammaLUT *lut, const Uint16 *ramp)
+{
+	int i;
+
+	lut->identity = 1;
+	for ( i = 0; i < 256; ++i ) {
+		if ( ramp ) {
+			lut->r[i] = (Uint8)(ramp[0*256+i] >> 8);
+			lut->g[i] = (Uint8)(ramp[1*256+i] >> 8);
+			lut->b[i] = (Uint8)(ramp[2*256+i] >> 8);
+		} else {
+			lut->r[i] = lut->g[i] = lut->b[i] = (Uint8)i;
+		}
+		if ( (lut->r[i] != i) || (lut->g[i] != i) || (lut->b[i] != i) ) {
+			lut->identity = 0;
+		}
+	}
+}
+
+void SDL_PresentSetGamma(SDL_PresentInfo *info, const SDL_GammaLUT *lut)
+{
+	info->gamma = lut;
+}
+
+/* Apply the tables to the start of a row of 16-bit pixels, returning
+   the number of pixels done */
+typedef int (*Gamma_Row16)(const SDL_GammaFields *fields,
+                           const SDL_PixelFormat *fmt,
+                           const Uint16 *src, Uint16 *dst, int width);
+
+static void Gamma_BuildField(Uint8 *field, const Uint8 *lut, int loss)
+{
+	int i;
+
+	for ( i = 0; i < (256 >> loss); ++i ) {
+		field[i] = (Uint8)(lut[i << loss] >> loss);
+	}
+}
+
+/* The fields get the same values as the present kernels compute */
+void SDL_BuildGammaFields(SDL_GammaFields *fields, const SDL_GammaLUT *lut,
+                          const SDL_PixelFormat *fmt)
+{
+	Gamma_BuildField(fields->r, lut->r, fmt->Rloss);
+	Gamma_BuildField(fields->g, lut->g, fmt->Gloss);
+	Gamma_BuildField(fields->b, lut->b, fmt->Bloss);
+	fields->keep = ~(fmt->Rmask | fmt->Gmask | fmt->Bmask);
+}
+
+#if SSSE3_BLITTERS
+SDL_BEGIN_SSSE3
+/* Look up 16 field values of up to 6 bits in a 64 entry table.  pshufb
+   only sees the low 4 bits of an index and returns 0 when the top bit is
+   set, so each 16 entry part of the table gets the indexes moved down
+   into 0x70-0x7F and everything else saturated up to 0xFF. */
+static __inline__ __m128i Gamma_LookupSSSE3(const __m128i *table, __m128i idx)
+{
+    const __m128i bias = _mm_set1_epi8(0x70);
+    const __m128i step = _mm_set1_epi8(16);
+    __m128i v;
+    int i;
+
+    v = _mm_shuffle_epi8(table[0], _mm_adds_epu8(idx, bias));
+    for (i = 1; i < 4; ++i) {
+        idx = _mm_sub_epi8(idx, step);
+        v = _mm_or_si128(v, _mm_shuffle_epi8(table[i],
+                                             _mm_adds_epu8(idx, bias)));
+    }
+    return v;
+}
+
+static int Gamma_Row16SSSE3(const SDL_GammaFields *fields,
+                            const SDL_PixelFormat *fmt,
+                            const Uint16 *src, Uint16 *dst, int width)
+{
+    const Uint8 *tables[3];
+    const Uint32 masks[3] = { fmt->Rmask, fmt->Gmask, fmt->Bmask };
+    const int shifts[3] = { fmt->Rshift, fmt->Gshift, fmt->Bshift };
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i keep = _mm_set1_epi16(
+        (short)~(fmt->Rmask | fmt->Gmask | fmt->Bmask));
+    __m128i table[3][4], field[3], count[3];
+    __m128i a, b, oa, ob, idx, v;
+    int c, i, n;
+
+    tables[0] = fields->r;
+    tables[1] = fields->g;
+    tables[2] = fields->b;
+    for (c = 0; c < 3; ++c) {
+        for (i = 0; i < 4; ++i) {
+            table[c][i] = _mm_loadu_si128((const __m128i *)(tables[c] + 16 * i));
+        }
+        field[c] = _mm_set1_epi16((short)(masks[c] >> shifts[c]));
+        count[c] = _mm_cvtsi32_si128(shifts[c]);
+    }
+
+    for (n = 0; n + 16 <= width; n += 16) {
+        a = _mm_loadu_si128((const __m128i *)(src + n));
+        b = _mm_loadu_si128((const __m128i *)(src + n + 8));
+        oa = _mm_and_si128(a, keep);
+        ob = _mm_and_si128(b, keep);
+        for (c = 0; c < 3; ++c) {
+            idx = _mm_packus_epi16(
+                _mm_and_si128(_mm_srl_epi16(a, count[c]), field[c]),
+                _mm_and_si128(_mm_srl_epi16(b, count[c]), field[c]));
+            v = Gamma_LookupSSSE3(table[c], idx);
+            oa = _mm_or_si128(oa, _mm_sll_epi16(_mm_unpacklo_epi8(v, zero),
+                                                count[c]));
+            ob = _mm_or_si128(ob, _mm_sll_epi16(_mm_unpackhi_epi8(v, zero),
+                                                count[c]));
+        }
+        _mm_storeu_si128((__m128i *)(dst + n), oa);
+        _mm_storeu_si128((__m128i *)(dst + n + 8), ob);
+    }
+    return n;
+}
+SDL_END_TARGET
+#endif /* SSSE3_BLITTERS */
+
+#if NEON_BLITTERS
+SDL_BEGIN_NEON
+/* The field tables go in two 32 byte vtbl4 lookups, vtbx4 keeps the
+   first result for indexes below 32 */
+static int Gamma_Row16NEON(const SDL_GammaFields *fields,
+                           const SDL_PixelFormat *fmt,
+                           const Uint16 *src, Uint16 *dst, int width)
+{
+    const Uint8 *tables[3];
+    const Uint32 masks[3] = { fmt->Rmask, fmt->Gmask, fmt->Bmask };
+    const int shifts[3] = { fmt->Rshift, fmt->Gshift, fmt->Bshift };
+    const uint16x8_t keep = vdupq_n_u16(
+        (uint16_t)~(fmt->Rmask | fmt->Gmask | fmt->Bmask));
+    const uint8x8_t step = vdup_n_u8(32);
+    uint8x8x4_t table[3][2];
+    uint16x8_t field[3];
+    int16x8_t left[3], right[3];
+    uint16x8_t p, o;
+    uint8x8_t idx, v;
+    int c, i, j, n;
+
+    tables[0] = fields->r;
+    tables[1] = fields->g;
+    tables[2] = fields->b;
+    for (c = 0; c < 3; ++c) {
+        for (i = 0; i < 2; ++i) {
+            for (j = 0; j < 4; ++j) {
+                table[c][i].val[j] = vld1_u8(tables[c] + 32 * i + 8 * j);
+            }
+        }
+        field[c] = vdupq_n_u16((uint16_t)(masks[c] >> shifts[c]));
+        left[c] = vdupq_n_s16((int16_t)shifts[c]);
+        right[c] = vdupq_n_s16((int16_t)-shifts[c]);
+    }
+
+    for (n = 0; n + 8 <= width; n += 8) {
+        p = vld1q_u16(src + n);
+        o = vandq_u16(p, keep);
+        for (c = 0; c < 3; ++c) {
+            idx = vmovn_u16(vandq_u16(vshlq_u16(p, right[c]), field[c]));
+            v = vtbl4_u8(table[c][0], idx);
+            v = vtbx4_u8(v, table[c][1], vsub_u8(idx, step));
+            o = vorrq_u16(o, vshlq_u16(vmovl_u8(v), left[c]));
+        }
+        vst1q_u16(dst + n, o);
+    }
+    return n;
+}
+SDL_END_TARGET
+#endif /* NEON_BLITTERS */
+
+/* 256 entry tables don't fit in vector registers, so only 16-bit pixels
+   with fields of up to 6 bits get a vector kernel.  32-bit pixels, and
+   16-bit ones with wider fields, are looked up one field at a time. */
+static Gamma_Row16 Gamma_GetRow16(const SDL_PixelFormat *fmt)
+{
+	if ( (fmt->Rloss < 2) || (fmt->Gloss < 2) || (fmt->Bloss < 2) ) {
+		return NULL;
+	}
+#if SSSE3_BLITTERS
+	if ( SDL_HasSSSE3() ) {
+		return Gamma_Row16SSSE3;
+	}
+#elif NEON_BLITTERS
+	if ( SDL_HasNEON() ) {
+		return Gamma_Row16NEON;
+	}
+#endif
+	return NULL;
+}
+
+void SDL_GammaCopy(const SDL_GammaLUT *lut, const SDL_PixelFormat *fmt,
+                   const Uint8 *src, int src_pitch,
+                   Uint8 *dst, int dst_pitch, int w, int h)
+{
+	const int bpp = fmt->BytesPerPixel;
+	SDL_GammaFields fields;
+	Gamma_Row16 row16 = NULL;
+	int x;
+
+	if ( (w <= 0) || (h <= 0) ) {
+		return;
+	}
+	if ( !lut || lut->identity || (bpp == 1) ) {
+		if ( src != dst ) {
+			while ( h-- ) {
+				SDL_memcpy(dst, src, w * bpp);
+				src += src_pitch;
+				dst += dst_pitch;
+			}
+		}
+		return;
+	}
+
+	SDL_BuildGammaFields(&fields, lut, fmt);
+	if ( bpp == 2 ) {
+		row16 = Gamma_GetRow16(fmt);
+	}
+
+	while ( h-- ) {
+		switch (bpp) {
+		    case 2: {
+			const Uint16 *s = (const Uint16 *)src;
+			Uint16 *d = (Uint16 *)dst;
+			x = row16 ? row16(&fields, fmt, s, d, w) : 0;
+			for ( ; x < w; ++x ) {
+				d[x] = (Uint16)SDL_GAMMA_PIXEL(&fields, fmt, (Uint32)s[x]);
+			}
+			break;
+		    }
+		    case 3: {
+			const Uint8 *s = src;
+			Uint8 *d = dst;
+			Uint32 p;
+			for ( x = 0; x < w; ++x ) {
+				p = SDL_READ24(s);
+				p = SDL_GAMMA_PIXEL(&fields, fmt, p);
+				SDL_WRITE24(d, p);
+				s += 3;
+				d += 3;
+			}
+			break;
+		    }
+		    case 4: {
+			const Uint32 *s = (const Uint32 *)src;
+			Uint32 *d = (Uint32 *)dst;
+			for ( x = 0; x < w; ++x ) {
+				d[x] = SDL_GAMMA_PIXEL(&fields, fmt, s[x]);
+			}
+			break;
+		    }
+		}
+		src += src_pitch;
+		dst += dst_pitch;
+	}
+}
+
+void SDL_PresentFitArea(int w, int h, int rotation,
+                        int dst_w, int dst_h, int integer, SDL_Rect *area)
+{
+	int rot_w, rot_h, scale;
+
+	if ( rotation & 1 ) {
+		rot_w = h;
+		rot_h = w;
+	} else {
+		rot_w = w;
+		rot_h = h;
+	}
+
+	scale = 0;
+	if ( integer ) {
+		scale = dst_w / rot_w;
+		if ( (dst_h / rot_h) < scale ) {
+			scale = dst_h / rot_h;
+		}
+	}
+	if ( scale > 0 ) {
+		area->w = rot_w * scale;
+		area->h = rot_h * scale;
+	} else if ( dst_w * rot_h <= dst_h * rot_w ) {
+		area->w = dst_w;
+		area->h = (rot_h * dst_w) / rot_w;
+	} else {
+		area->w = (rot_w * dst_h) / rot_h;
+		area->h = dst_h;
+	}
+	area->x = (dst_w - area->w) / 2;
+	area->y = (dst_h - area->h) / 2;
+}
+
+int SDL_SetupPresent(SDL_PresentInfo *info,
+                     SDL_Surface *src, SDL_Surface *dst,
+                     const SDL_Rect *area, int rotation, int filter)
+{
+	Sint32 step_x, step_y;
+	Sint32 ru, rv, last_x, last_y;
+
+	if ( (src->format->BytesPerPixel < 1) ||
+	     (dst->format->BytesPerPixel < 2) ) {
+		SDL_SetError("Unsupported surface format for presenting");
+		return(-1);
+	}
+	if ( area ) {
+		if ( (area->x < 0) || (area->y < 0) ||
+		     (area->w == 0) || (area->h == 0) ||
+		     ((area->x+area->w) > dst->w) ||
+		     ((area->y+area->h) > dst->h) ) {
+			SDL_SetError("Invalid presentation area");
+			return(-1);
+		}
+		info->area = *area;
+	} else {
+		info->area.x = 0;
+		info->area.y = 0;
+		info->area.w = dst->w;
+		info->area.h = dst->h;
+	}
+	info->src = src;
+	info->dst = dst;
+	info->rotation = (rotation & 3);
+	info->filter = filter;
+
+	if ( info->rotation & 1 ) {
+		info->rot_w = src->h;
+		info->rot_h = src->w;
+	} else {
+		info->rot_w = src->w;
+		info->rot_h = src->h;
+	}
+
+	/* Logical step per physical pixel in the rotated logical space */
+	step_x = (info->rot_w << 16) / info->area.w;
+	step_y = (info->rot_h << 16) / info->area.h;
+
+	/* Sample at pixel centers.  Nearest picks the pixel the center
+	   falls into, bilinear interpolates between pixel centers. */
+	ru = step_x / 2;
+	rv = step_y / 2;
+	if ( filter == SDL_PRESENT_BILINEAR ) {
+		ru -= 0x8000;
+		rv -= 0x8000;
+		last_x = (src->w - 1) << 16;
+		last_y = (src->h - 1) << 16;
+	} else {
+		/* Mirrored nearest must stay inside the same pixel */
+		last_x = (src->w << 16) - 1;
+		last_y = (src->h << 16) - 1;
+	}
+
+	/* Undo the rotation: physical right/down in logical steps */
+	switch (info->rotation) {
+	    case SDL_PRESENT_ROTATE_0:
+		info->origin_x = ru;
+		info->origin_y = rv;
+		info->du_x = step_x;
+		info->du_y = 0;
+		info->dv_x = 0;
+		info->dv_y = step_y;
+		break;
+	    case SDL_PRESENT_ROTATE_90:
+		info->origin_x = rv;
+		info->origin_y = last_y - ru;
+		info->du_x = 0;
+		info->du_y = -step_x;
+		info->dv_x = step_y;
+		info->dv_y = 0;
+		break;
+	    case SDL_PRESENT_ROTATE_180:
+		info->origin_x = last_x - ru;
+		info->origin_y = last_y - rv;
+		info->du_x = -step_x;
+		info->du_y = 0;
+		info->dv_x = 0;
+		info->dv_y = -step_y;
+		break;
+	    case SDL_PRESENT_ROTATE_270:
+		info->origin_x = last_x - rv;
+		info->origin_y = ru;
+		info->du_x = 0;
+		info->du_y = step_x;
+		info->dv_x = -step_y;
+		info->dv_y = 0;
+		break;
+	}
+
+	info->gamma = NULL;
+	info->lut = NULL;
+	Present_SetRow(info);
+	return(0);
+}
+
+/* Find the physical rectangle affected by a logical one */
+static int Present_MapRect(const SDL_PresentInfo *info,
+                           const SDL_Rect *rect, SDL_Rect *dstrect)
+{
+	const SDL_Surface *src = info->src;
+	const SDL_Rect *area = &info->area;
+	int x, y, w, h;
+	int rx, ry, rw, rh;
+	int x0, y0, x1, y1;
+
+	/* Clip to the logical surface */
+	x = rect->x;
+	y = rect->y;
+	w = rect->w;
+	h = rect->h;
+	if ( x < 0 ) {
+		w += x;
+		x = 0;
+	}
+	if ( y < 0 ) {
+		h += y;
+		y = 0;
+	}
+	if ( (x + w) > src->w ) {
+		w = src->w - x;
+	}
+	if ( (y + h) > src->h ) {
+		h = src->h - y;
+	}
+	if ( (w <= 0) || (h <= 0) ) {
+		dstrect->x = dstrect->y = 0;
+		dstrect->w = dstrect->h = 0;
+		return(0);
+	}
+
+	/* Rotate */
+	switch (info->rotation) {
+	    default:
+		rx = x;
+		ry = y;
+		rw = w;
+		rh = h;
+		break;
+	    case SDL_PRESENT_ROTATE_90:
+		rx = src->h - (y + h);
+		ry = x;
+		rw = h;
+		rh = w;
+		break;
+	    case SDL_PRESENT_ROTATE_180:
+		rx = src->w - (x + w);
+		ry = src->h - (y + h);
+		rw = w;
+		rh = h;
+		break;
+	    case SDL_PRESENT_ROTATE_270:
+		rx = y;
+		ry = src->w - (x + w);
+		rw = h;
+		rh = w;
+		break;
+	}
+
+	/* Neighbours are blended in, so they change as well */
+	if ( info->filter == SDL_PRESENT_BILINEAR ) {
+		rx -= 1;
+		ry -= 1;
+		rw += 2;
+		rh += 2;
+		if ( rx < 0 ) {
+			rw += rx;
+			rx = 0;
+		}
+		if ( ry < 0 ) {
+			rh += ry;
+			ry = 0;
+		}
+		if ( (rx + rw) > info->rot_w ) {
+			rw = info->rot_w - rx;
+		}
+		if ( (ry + rh) > info->rot_h ) {
+			rh = info->rot_h - ry;
+		}
+	}
+
+	/* Scale, rounding outwards */
+	x0 = (rx * area->w) / info->rot_w;
+	y0 = (ry * area->h) / info->rot_h;
+	x1 = ((rx + rw) * area->w + info->rot_w - 1) / info->rot_w;
+	y1 = ((ry + rh) * area->h + info->rot_h - 1) / info->rot_h;
+
+	dstrect->x = area->x + x0;
+	dstrect->y = area->y + y0;
+	dstrect->w = x1 - x0;
+	dstrect->h = y1 - y0;
+	return(1);
+}
+
+static void Present_Rect(const SDL_PresentInfo *info, const SDL_Rect *rect)
+{
+	const SDL_Surface *dst = info->dst;
+	const int bpp = dst->format->BytesPerPixel;
+	int tile_w, tile_h;
+	int tx, ty, tw, th, u, v, y;
+	Sint32 sx, sy;
+	Uint8 *dstp;
+
+	/* Unrotated rows are read sequentially, no need for tiles */
+	if ( info->rotation & 1 ) {
+		tile_w = PRESENT_TILE;
+		tile_h = PRESENT_TILE;
+	} else {
+		tile_w = rect->w;
+		tile_h = rect->h;
+	}
+
+	for ( ty = 0; ty < rect->h; ty += tile_h ) {
+		th = rect->h - ty;
+		if ( th > tile_h ) {
+			th = tile_h;
+		}
+		for ( tx = 0; tx < rect->w; tx += tile_w ) {
+			tw = rect->w - tx;
+			if ( tw > tile_w ) {
+				tw = tile_w;
+			}
+			u = rect->x - info->area.x + tx;
+			v = rect->y - info->area.y + ty;
+			sx = info->origin_x + u * info->du_x + v * info->dv_x;
+			sy = info->origin_y + u * info->du_y + v * info->dv_y;
+			dstp = (Uint8 *)dst->pixels +
+			       (rect->y + ty) * dst->pitch +
+			       (rect->x + tx) * bpp;
+			for ( y = 0; y < th; ++y ) {
+				info->row(info, dstp, tw, sx, sy);
+				sx += info->dv_x;
+				sy += info->dv_y;
+				dstp += dst->pitch;
+			}
+		}
+	}
+}
+
+static void Present_Unscaled(const SDL_PresentInfo *info,
+                             const SDL_Rect *rect)
+{
+	const SDL_Surface *src = info->src;
+	const SDL_Surface *dst = info->dst;
+	const int bpp = dst->format->BytesPerPixel;
+
+	SDL_GammaRotateRect(info->lut, dst->format, src->pixels, src->pitch,
+	                    (Uint8 *)dst->pixels + info->area.y * dst->pitch +
+	                                           info->area.x * bpp,
+	                    dst->pitch, src->w, src->h, rect, info->rotation);
+}
+
+void SDL_PresentRects(SDL_PresentInfo *info,
+                      int numrects, const SDL_Rect *rects,
+                      SDL_Rect *dstrects)
+{
+	SDL_Surface *src = info->src;
+	SDL_Surface *dst = info->dst;
+	const SDL_GammaLUT *lut;
+	SDL_Rect dstrect;
+	int i;
+
+	/* Switch kernels when the gamma ramp was set or reset */
+	lut = info->gamma;
+	if ( lut && lut->identity ) {
+		lut = NULL;
+	}
+	if ( lut != info->lut ) {
+		info->lut = lut;
+		Present_SetRow(info);
+	}
+
+	if ( SDL_MUSTLOCK(dst) && (SDL_LockSurface(dst) < 0) ) {
+		return;
+	}
+	if ( SDL_MUSTLOCK(src) && (SDL_LockSurface(src) < 0) ) {
+		if ( SDL_MUSTLOCK(dst) ) {
+			SDL_UnlockSurface(dst);
+		}
+		return;
+	}
+
+	/* The palette may have changed since the last frame */
+	if ( src->format->BytesPerPixel == 1 ) {
+		const SDL_Palette *pal = src->format->palette;
+		for ( i = 0; i < pal->ncolors; ++i ) {
+			const SDL_Color *c = &pal->colors[i];
+			if ( lut ) {
+				info->map[i] = SDL_MapRGB(dst->format,
+				                          lut->r[c->r],
+				                          lut->g[c->g],
+				                          lut->b[c->b]);
+			} else {
+				info->map[i] = SDL_MapRGB(dst->format,
+				                          c->r, c->g, c->b);
+			}
+		}
+	}
+
+	for ( i = 0; i < numrects; ++i ) {
+		if ( Present_MapRect(info, &rects[i], &dstrect) ) {
+			if ( info->unscaled ) {
+				Present_Unscaled(info, &rects[i]);
+			} else {
+				Present_Rect(info, &dstrect);
+			}
+		}
+		if ( dstrects ) {
+			dstrects[i] = dstrect;
+		}
+	}
+
+	if ( SDL_MUSTLOCK(src) ) {
+		SDL_UnlockSurface(src);
+	}
+	if ( SDL_MUSTLOCK(dst) ) {
+		SDL_UnlockSurface(dst);
+	}
+}
+
+int SDL_PresentMapPoint(const SDL_PresentInfo *info, int *x, int *y)
+{
+	const SDL_Rect *area = &info->area;
+	int u, v, ru, rv, inside;
+
+	u = *x - area->x;
+	v = *y - area->y;
+	inside = ( (u >= 0) && (v >= 0) && (u < area->w) && (v < area->h) );
+	if ( u < 0 ) {
+		u = 0;
+	} else if ( u >= area->w ) {
+		u = area->w - 1;
+	}
+	if ( v < 0 ) {
+		v = 0;
+	} else if ( v >= area->h ) {
+		v = area->h - 1;
+	}
+
+	ru = (u * info->rot_w) / area->w;
+	rv = (v * info->rot_h) / area->h;
+	switch (info->rotation) {
+	    default:
+		*x = ru;
+		*y = rv;
+		break;
+	    case SDL_PRESENT_ROTATE_90:
+		*x = rv;
+		*y = info->src->h - 1 - ru;
+		break;
+	    case SDL_PRESENT_ROTATE_180:
+		*x = info->src->w - 1 - ru;
+		*y = info->src->h - 1 - rv;
+		break;
+	    case SDL_PRESENT_ROTATE_270:
+		*x = info->src->w - 1 - rv;
+		*y = ru;
+		break;
+	}
+	return(inside);
+}
@@ -0,0 +1,158 @@
+/*
+    SDL - Simple DirectMedia Layer
+    Copyright (C) 1997-2009 Sam Lantinga
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+    Sam Lantinga
+    slouken@libsdl.org
+*/
+#include "SDL_config.h"
+
+#ifndef _SDL_present_c_h
+#define _SDL_present_c_h
+
+/* The present stage copies the surface an application draws on (the
+   "logical" surface) to the surface shown on the display (the "physical"
+   surface), scaling, rotating and converting the pixel format in a single
+   pass.  Video drivers whose display doesn't match the requested mode can
+   call SDL_PresentRects() from their UpdateRects function.
+*/
+
+#include "SDL_video.h"
+
+/* Clockwise rotation of the logical surface on the physical one */
+#define SDL_PRESENT_ROTATE_0	0
+#define SDL_PRESENT_ROTATE_90	1
+#define SDL_PRESENT_ROTATE_180	2
+#define SDL_PRESENT_ROTATE_270	3
+
+/* Scaling filters */
+#define SDL_PRESENT_NEAREST	0
+#define SDL_PRESENT_BILINEAR	1
+
+typedef struct SDL_PresentInfo SDL_PresentInfo;
+
+/* Software gamma: the top 8 bits of a gamma ramp, one table per channel */
+typedef struct SDL_GammaLUT {
+	int identity;		/* Nothing to do */
+	Uint8 r[256];
+	Uint8 g[256];
+	Uint8 b[256];
+} SDL_GammaLUT;
+
+/* Fill 'width' physical pixels, starting at the 16.16 fixed point
+   logical position (sx, sy) */
+typedef void (*SDL_PresentRow)(const SDL_PresentInfo *info, Uint8 *dst,
+                               int width, Sint32 sx, Sint32 sy);
+
+struct SDL_PresentInfo {
+	SDL_Surface *src;	/* The logical surface */
+	SDL_Surface *dst;	/* The physical surface */
+	SDL_Rect area;		/* The part of dst covered by src */
+	int rotation;
+	int filter;
+
+	/* Everything below is set up by SDL_SetupPresent() */
+	int rot_w, rot_h;	/* The size of src after rotation */
+	Sint32 origin_x;	/* Logical position of the top-left */
+	Sint32 origin_y;	/*   physical pixel in 'area' */
+	Sint32 du_x, du_y;	/* Logical step for one physical pixel right */
+	Sint32 dv_x, dv_y;	/* Logical step for one physical pixel down */
+	Uint32 map[256];	/* Physical pixels for 8-bit logical surfaces */
+	SDL_PresentRow row;
+	int unscaled;		/* Same size and format, only rotated */
+	const SDL_GammaLUT *gamma;	/* Set by SDL_PresentSetGamma() */
+	const SDL_GammaLUT *lut;	/* gamma, unless it is the identity */
+};
+
+/* Fill 'lut' from a 3*256 entry gamma ramp as kept in SDL_VideoDevice,
+   or with the identity if 'ramp' is NULL.
+*/
+extern void SDL_BuildGammaLUT(SDL_GammaLUT *lut, const Uint16 *ramp);
+
+/* The gamma tables for the bit fields of one pixel format: the corrected
+   field for each field value */
+typedef struct SDL_GammaFields {
+	Uint8 r[256];
+	Uint8 g[256];
+	Uint8 b[256];
+	Uint32 keep;		/* The bits that aren't R, G or B */
+} SDL_GammaFields;
+
+/* Fill 'fields' from 'lut' for pixels of 'format', 2 to 4 bytes each */
+extern void SDL_BuildGammaFields(SDL_GammaFields *fields,
+                                 const SDL_GammaLUT *lut,
+                                 const SDL_PixelFormat *format);
+
+/* A pixel of 'format' through the tables */
+#define SDL_GAMMA_PIXEL(fields, format, p)				\
+	(((p) & (fields)->keep) |					\
+	 ((Uint32)(fields)->r[((p) & (format)->Rmask) >> (format)->Rshift] \
+	  << (format)->Rshift) |					\
+	 ((Uint32)(fields)->g[((p) & (format)->Gmask) >> (format)->Gshift] \
+	  << (format)->Gshift) |					\
+	 ((Uint32)(fields)->b[((p) & (format)->Bmask) >> (format)->Bshift] \
+	  << (format)->Bshift))
+
+/* Copy a w x h block of pixels in 'format' from 'src' to 'dst' through
+   'lut', or apply it in place if they are the same.  This is for video
+   drivers that put the screen on the display without the present stage.
+   8-bit pixels are copied unchanged.
+*/
+extern void SDL_GammaCopy(const SDL_GammaLUT *lut,
+                          const SDL_PixelFormat *format,
+                          const Uint8 *src, int src_pitch,
+                          Uint8 *dst, int dst_pitch, int w, int h);
+
+/* Compute the largest rectangle of a dst_w x dst_h display that shows a
+   w x h surface rotated by 'rotation' with the right aspect ratio,
+   centered.  If 'integer' is set, only whole scaling factors are used
+   (unless the surface doesn't fit at all).
+*/
+extern void SDL_PresentFitArea(int w, int h, int rotation,
+                               int dst_w, int dst_h, int integer,
+                               SDL_Rect *area);
+
+/* Prepare 'info' for presenting 'src' inside 'area' of 'dst' (all of dst
+   if area is NULL).  Returns 0, or -1 if the formats aren't supported.
+   Both surfaces must stay valid (and keep their pixels) until the next
+   call to SDL_SetupPresent().
+*/
+extern int SDL_SetupPresent(SDL_PresentInfo *info,
+                            SDL_Surface *src, SDL_Surface *dst,
+                            const SDL_Rect *area, int rotation, int filter);
+
+/* Apply 'lut' to every presented pixel, as part of the format
+   conversion.  The table is read on each SDL_PresentRects() call, so it
+   may be changed in place.  Reset by SDL_SetupPresent(), NULL disables.
+*/
+extern void SDL_PresentSetGamma(SDL_PresentInfo *info,
+                                const SDL_GammaLUT *lut);
+
+/* Present the given logical rectangles.  If 'dstrects' isn't NULL it
+   receives the physical rectangle written for each of them, suitable for
+   passing on to the display.
+*/
+extern void SDL_PresentRects(SDL_PresentInfo *info,
+                             int numrects, const SDL_Rect *rects,
+                             SDL_Rect *dstrects);
+
+/* Convert a physical position (e.g. of the mouse) to logical coordinates.
+   Returns 0 if the position is outside the presented area.
+*/
+extern int SDL_PresentMapPoint(const SDL_PresentInfo *info, int *x, int *y);
+
+#endif /* _SDL_present_c_h */
@@ -0,0 +1,515 @@
+/*
+    SDL - Simple DirectMedia Layer
+    Copyright (C) 1997-2009 Sam Lantinga
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+    Sam Lantinga
+    slouken@libsdl.org
+*/
+#include "SDL_config.h"
+
+/* Rotated copies for video drivers with a shadow buffer */
+
+#include "SDL_video.h"
+#include "SDL_cpuinfo.h"
+#include "SDL_rotate_c.h"
+#include "SDL_blit.h"
+
+/* The 90 and 270 degree copies work on square tiles, so that the lines
+   of the destination being written stay in the cache for the whole tile
+   instead of one line being touched per source pixel.
+*/
+#define ROTATE_TILE	32
+
+/* Transpose one square block of pixels.  Row i of the block is read from
+   src + i*src_step and column i is written to dst + i*dst_step.
+*/
+typedef void (*Rotate_Transpose)(const Uint8 *src, int src_step,
+                                 Uint8 *dst, int dst_step);
+
+#if SSE2_BLITTERS
+SDL_BEGIN_SSE2
+static void Transpose16SSE2(const Uint8 *src, int src_step,
+                            Uint8 *dst, int dst_step)
+{
+	__m128i a0, a1, a2, a3, a4, a5, a6, a7;
+	__m128i b0, b1, b2, b3, b4, b5, b6, b7;
+
+	a0 = _mm_loadu_si128((const __m128i *)src); src += src_step;
+	a1 = _mm_loadu_si128((const __m128i *)src); src += src_step;
+	a2 = _mm_loadu_si128((const __m128i *)src); src += src_step;
+	a3 = _mm_loadu_si128((const __m128i *)src); src += src_step;
+	a4 = _mm_loadu_si128((const __m128i *)src); src += src_step;
+	a5 = _mm_loadu_si128((const __m128i *)src); src += src_step;
+	a6 = _mm_loadu_si128((const __m128i *)src); src += src_step;
+	a7 = _mm_loadu_si128((const __m128i *)src);
+
+	b0 = _mm_unpacklo_epi16(a0, a1);
+	b1 = _mm_unpackhi_epi16(a0, a1);
+	b2 = _mm_unpacklo_epi16(a2, a3);
+	b3 = _mm_unpackhi_epi16(a2, a3);
+	b4 = _mm_unpacklo_epi16(a4, a5);
+	b5 = _mm_unpackhi_epi16(a4, a5);
+	b6 = _mm_unpacklo_epi16(a6, a7);
+	b7 = _mm_unpackhi_epi16(a6, a7);
+
+	a0 = _mm_unpacklo_epi32(b0, b2);
+	a1 = _mm_unpackhi_epi32(b0, b2);
+	a2 = _mm_unpacklo_epi32(b1, b3);
+	a3 = _mm_unpackhi_epi32(b1, b3);
+	a4 = _mm_unpacklo_epi32(b4, b6);
+	a5 = _mm_unpackhi_epi32(b4, b6);
+	a6 = _mm_unpacklo_epi32(b5, b7);
+	a7 = _mm_unpackhi_epi32(b5, b7);
+
+	_mm_storeu_si128((__m128i *)dst, _mm_unpacklo_epi64(a0, a4));
+	dst += dst_step;
+	_mm_storeu_si128((__m128i *)dst, _mm_unpackhi_epi64(a0, a4));
+	dst += dst_step;
+	_mm_storeu_si128((__m128i *)dst, _mm_unpacklo_epi64(a1, a5));
+	dst += dst_step;
+	_mm_storeu_si128((__m128i *)dst, _mm_unpackhi_epi64(a1, a5));
+	dst += dst_step;
+	_mm_storeu_si128((__m128i *)dst, _mm_unpacklo_epi64(a2, a6));
+	dst += dst_step;
+	_mm_storeu_si128((__m128i *)dst, _mm_unpackhi_epi64(a2, a6));
+	dst += dst_step;
+	_mm_storeu_si128((__m128i *)dst, _mm_unpacklo_epi64(a3, a7));
+	dst += dst_step;
+	_mm_storeu_si128((__m128i *)dst, _mm_unpackhi_epi64(a3, a7));
+}
+
+static void Transpose32SSE2(const Uint8 *src, int src_step,
+                            Uint8 *dst, int dst_step)
+{
+	__m128i a0, a1, a2, a3;
+	__m128i b0, b1, b2, b3;
+
+	a0 = _mm_loadu_si128((const __m128i *)src); src += src_step;
+	a1 = _mm_loadu_si128((const __m128i *)src); src += src_step;
+	a2 = _mm_loadu_si128((const __m128i *)src); src += src_step;
+	a3 = _mm_loadu_si128((const __m128i *)src);
+
+	b0 = _mm_unpacklo_epi32(a0, a1);
+	b1 = _mm_unpackhi_epi32(a0, a1);
+	b2 = _mm_unpacklo_epi32(a2, a3);
+	b3 = _mm_unpackhi_epi32(a2, a3);
+
+	_mm_storeu_si128((__m128i *)dst, _mm_unpacklo_epi64(b0, b2));
+	dst += dst_step;
+	_mm_storeu_si128((__m128i *)dst, _mm_unpackhi_epi64(b0, b2));
+	dst += dst_step;
+	_mm_storeu_si128((__m128i *)dst, _mm_unpacklo_epi64(b1, b3));
+	dst += dst_step;
+	_mm_storeu_si128((__m128i *)dst, _mm_unpackhi_epi64(b1, b3));
+}
+SDL_END_TARGET
+#endif /* SSE2_BLITTERS */
+
+#if NEON_BLITTERS
+SDL_BEGIN_NEON
+static void Transpose16NEON(const Uint8 *src, int src_step,
+                            Uint8 *dst, int dst_step)
+{
+	uint16x8_t a0, a1, a2, a3, a4, a5, a6, a7;
+	uint16x8x2_t t01, t23, t45, t67;
+	uint32x4x2_t u0, u1, u2, u3;
+
+	a0 = vld1q_u16((const uint16_t *)src); src += src_step;
+	a1 = vld1q_u16((const uint16_t *)src); src += src_step;
+	a2 = vld1q_u16((const uint16_t *)src); src += src_step;
+	a3 = vld1q_u16((const uint16_t *)src); src += src_step;
+	a4 = vld1q_u16((const uint16_t *)src); src += src_step;
+	a5 = vld1q_u16((const uint16_t *)src); src += src_step;
+	a6 = vld1q_u16((const uint16_t *)src); src += src_step;
+	a7 = vld1q_u16((const uint16_t *)src);
+
+	t01 = vtrnq_u16(a0, a1);
+	t23 = vtrnq_u16(a2, a3);
+	t45 = vtrnq_u16(a4, a5);
+	t67 = vtrnq_u16(a6, a7);
+
+	u0 = vtrnq_u32(vreinterpretq_u32_u16(t01.val[0]),
+	               vreinterpretq_u32_u16(t23.val[0]));
+	u1 = vtrnq_u32(vreinterpretq_u32_u16(t01.val[1]),
+	               vreinterpretq_u32_u16(t23.val[1]));
+	u2 = vtrnq_u32(vreinterpretq_u32_u16(t45.val[0]),
+	               vreinterpretq_u32_u16(t67.val[0]));
+	u3 = vtrnq_u32(vreinterpretq_u32_u16(t45.val[1]),
+	               vreinterpretq_u32_u16(t67.val[1]));
+
+#define STORE_COLUMN(half, lo, hi) \
+	vst1q_u32((uint32_t *)dst, vcombine_u32(vget_##half##_u32(lo), \
+	                                        vget_##half##_u32(hi))); \
+	dst += dst_step;
+
+	STORE_COLUMN(low, u0.val[0], u2.val[0])
+	STORE_COLUMN(low, u1.val[0], u3.val[0])
+	STORE_COLUMN(low, u0.val[1], u2.val[1])
+	STORE_COLUMN(low, u1.val[1], u3.val[1])
+	STORE_COLUMN(high, u0.val[0], u2.val[0])
+	STORE_COLUMN(high, u1.val[0], u3.val[0])
+	STORE_COLUMN(high, u0.val[1], u2.val[1])
+	STORE_COLUMN(high, u1.val[1], u3.val[1])
+}
+
+static void Transpose32NEON(const Uint8 *src, int src_step,
+                            Uint8 *dst, int dst_step)
+{
+	uint32x4_t a0, a1, a2, a3;
+	uint32x4x2_t t01, t23;
+
+	a0 = vld1q_u32((const uint32_t *)src); src += src_step;
+	a1 = vld1q_u32((const uint32_t *)src); src += src_step;
+	a2 = vld1q_u32((const uint32_t *)src); src += src_step;
+	a3 = vld1q_u32((const uint32_t *)src);
+
+	t01 = vtrnq_u32(a0, a1);
+	t23 = vtrnq_u32(a2, a3);
+
+	STORE_COLUMN(low, t01.val[0], t23.val[0])
+	STORE_COLUMN(low, t01.val[1], t23.val[1])
+	STORE_COLUMN(high, t01.val[0], t23.val[0])
+	STORE_COLUMN(high, t01.val[1], t23.val[1])
+#undef STORE_COLUMN
+}
+SDL_END_TARGET
+#endif /* NEON_BLITTERS */
+
+/* Copy a w x h block of pixels one at a time.  'dpix' and 'drow' are the
+   changes of the destination address for one source pixel to the right
+   and one source row down.
+*/
+#define ROTATE_BLOCK(type) \
+	while ( h-- ) { \
+		const type *s = (const type *)src; \
+		Uint8 *d = dst; \
+		for ( i = w; i; --i ) { \
+			*(type *)d = *s++; \
+			d += dpix; \
+		} \
+		src += src_pitch; \
+		dst += drow; \
+	}
+
+static void Rotate_Block(const Uint8 *src, int src_pitch,
+                         Uint8 *dst, int dpix, int drow,
+                         int bpp, int w, int h)
+{
+	int i;
+
+	switch (bpp) {
+	    case 1:
+		ROTATE_BLOCK(Uint8)
+		break;
+	    case 2:
+		ROTATE_BLOCK(Uint16)
+		break;
+	    case 3:
+		while ( h-- ) {
+			const Uint8 *s = src;
+			Uint8 *d = dst;
+			for ( i = w; i; --i ) {
+				d[0] = s[0];
+				d[1] = s[1];
+				d[2] = s[2];
+				s += 3;
+				d += dpix;
+			}
+			src += src_pitch;
+			dst += drow;
+		}
+		break;
+	    case 4:
+		ROTATE_BLOCK(Uint32)
+		break;
+	}
+}
+
+/* Same as ROTATE_BLOCK, storing each pixel through the gamma tables */
+#define ROTATE_GAMMA_BLOCK(type) \
+	while ( h-- ) { \
+		const type *s = (const type *)src; \
+		Uint8 *d = dst; \
+		for ( i = w; i; --i ) { \
+			p = *s++; \
+			*(type *)d = (type)SDL_GAMMA_PIXEL(gamma, fmt, p); \
+			d += dpix; \
+		} \
+		src += src_pitch; \
+		dst += drow; \
+	}
+
+static void Rotate_GammaBlock(const SDL_GammaFields *gamma,
+                              const SDL_PixelFormat *fmt,
+                              const Uint8 *src, int src_pitch,
+                              Uint8 *dst, int dpix, int drow, int w, int h)
+{
+	Uint32 p;
+	int i;
+
+	switch (fmt->BytesPerPixel) {
+	    case 2:
+		ROTATE_GAMMA_BLOCK(Uint16)
+		break;
+	    case 3:
+		while ( h-- ) {
+			const Uint8 *s = src;
+			Uint8 *d = dst;
+			for ( i = w; i; --i ) {
+				p = SDL_READ24(s);
+				p = SDL_GAMMA_PIXEL(gamma, fmt, p);
+				SDL_WRITE24(d, p);
+				s += 3;
+				d += dpix;
+			}
+			src += src_pitch;
+			dst += drow;
+		}
+		break;
+	    case 4:
+		ROTATE_GAMMA_BLOCK(Uint32)
+		break;
+	}
+}
+
+static Rotate_Transpose Rotate_GetTranspose(int bpp, int *size)
+{
+#if SSE2_BLITTERS
+	if ( SDL_HasSSE2() ) {
+		if ( bpp == 2 ) {
+			*size = 8;
+			return Transpose16SSE2;
+		}
+		if ( bpp == 4 ) {
+			*size = 4;
+			return Transpose32SSE2;
+		}
+	}
+#elif NEON_BLITTERS
+	if ( SDL_HasNEON() ) {
+		if ( bpp == 2 ) {
+			*size = 8;
+			return Transpose16NEON;
+		}
+		if ( bpp == 4 ) {
+			*size = 4;
+			return Transpose32NEON;
+		}
+	}
+#endif
+	*size = 1;
+	return NULL;
+}
+
+/* The 90 and 270 degree copies, where source rows become columns.  With
+   gamma tables the pixels are looked up one at a time, not transposed. */
+static void Rotate_Tiled(const SDL_GammaFields *gamma,
+                         const SDL_PixelFormat *fmt,
+                         const Uint8 *src, int src_pitch,
+                         Uint8 *dst, int dpix, int drow,
+                         int bpp, int w, int h)
+{
+	Rotate_Transpose transpose;
+	int n;
+	int x, y, i, j;
+	int tw, th, bw, bh;
+
+	transpose = Rotate_GetTranspose(bpp, &n);
+	for ( y = 0; y < h; y += ROTATE_TILE ) {
+		th = h - y;
+		if ( th > ROTATE_TILE ) {
+			th = ROTATE_TILE;
+		}
+		for ( x = 0; x < w; x += ROTATE_TILE ) {
+			const Uint8 *s = src + y * src_pitch + x * bpp;
+			Uint8 *d = dst + y * drow + x * dpix;
+
+			tw = w - x;
+			if ( tw > ROTATE_TILE ) {
+				tw = ROTATE_TILE;
+			}
+			if ( gamma ) {
+				Rotate_GammaBlock(gamma, fmt, s, src_pitch,
+				                  d, dpix, drow, tw, th);
+				continue;
+			}
+			if ( !transpose ) {
+				Rotate_Block(s, src_pitch, d, dpix, drow,
+				             bpp, tw, th);
+				continue;
+			}
+
+			/* The transposed columns are written with ascending
+			   addresses, so the rows are fed in reverse order
+			   when they go right to left in the destination.
+			 */
+			bw = tw - (tw % n);
+			bh = th - (th % n);
+			for ( j = 0; j < bh; j += n ) {
+				for ( i = 0; i < bw; i += n ) {
+					const Uint8 *bs = s + j * src_pitch + i * bpp;
+					Uint8 *bd = d + j * drow + i * dpix;
+
+					if ( drow < 0 ) {
+						transpose(bs + (n - 1) * src_pitch,
+						          -src_pitch,
+						          bd + (n - 1) * drow, dpix);
+					} else {
+						transpose(bs, src_pitch, bd, dpix);
+					}
+				}
+			}
+			Rotate_Block(s + bw * bpp, src_pitch, d + bw * dpix,
+			             dpix, drow, bpp, tw - bw, bh);
+			Rotate_Block(s + bh * src_pitch, src_pitch, d + bh * drow,
+			             dpix, drow, bpp, tw, th - bh);
+		}
+	}
+}
+
+void SDL_RotatedRect(int w, int h, const SDL_Rect *rect,
+                     int rotation, SDL_Rect *rotated)
+{
+	switch (rotation) {
+	    case SDL_PRESENT_ROTATE_90:
+		rotated->x = h - (rect->y + rect->h);
+		rotated->y = rect->x;
+		rotated->w = rect->h;
+		rotated->h = rect->w;
+		break;
+	    case SDL_PRESENT_ROTATE_180:
+		rotated->x = w - (rect->x + rect->w);
+		rotated->y = h - (rect->y + rect->h);
+		rotated->w = rect->w;
+		rotated->h = rect->h;
+		break;
+	    case SDL_PRESENT_ROTATE_270:
+		rotated->x = rect->y;
+		rotated->y = w - (rect->x + rect->w);
+		rotated->w = rect->h;
+		rotated->h = rect->w;
+		break;
+	    default:
+		*rotated = *rect;
+		break;
+	}
+}
+
+/* SDL_RotateRect(), through 'lut' for pixels of 'fmt' if it isn't NULL */
+static void Rotate_Rect(const SDL_GammaLUT *lut, const SDL_PixelFormat *fmt,
+                        const void *src, int src_pitch,
+                        void *dst, int dst_pitch, int bpp,
+                        int w, int h, const SDL_Rect *rect,
+                        int rotation)
+{
+	SDL_GammaFields fields;
+	const SDL_GammaFields *gamma = NULL;
+	const Uint8 *s;
+	Uint8 *d;
+	int x, y, rw, rh;
+
+	/* Clip the rectangle to the image */
+	x = rect->x;
+	y = rect->y;
+	rw = x + rect->w;
+	rh = y + rect->h;
+	if ( x < 0 ) {
+		x = 0;
+	}
+	if ( y < 0 ) {
+		y = 0;
+	}
+	if ( rw > w ) {
+		rw = w;
+	}
+	if ( rh > h ) {
+		rh = h;
+	}
+	rw -= x;
+	rh -= y;
+	if ( (rw <= 0) || (rh <= 0) ) {
+		return;
+	}
+
+	/* Unrotated copies go through the vector kernels of SDL_GammaCopy() */
+	if ( lut && (rotation != SDL_PRESENT_ROTATE_0) ) {
+		SDL_BuildGammaFields(&fields, lut, fmt);
+		gamma = &fields;
+	}
+
+	s = (const Uint8 *)src + y * src_pitch + x * bpp;
+	switch (rotation) {
+	    case SDL_PRESENT_ROTATE_90:
+		d = (Uint8 *)dst + x * dst_pitch + (h - 1 - y) * bpp;
+		Rotate_Tiled(gamma, fmt, s, src_pitch,
+		             d, dst_pitch, -bpp, bpp, rw, rh);
+		break;
+	    case SDL_PRESENT_ROTATE_180:
+		/* Rows stay rows, no need for tiles */
+		d = (Uint8 *)dst + (h - 1 - y) * dst_pitch + (w - 1 - x) * bpp;
+		if ( gamma ) {
+			Rotate_GammaBlock(gamma, fmt, s, src_pitch,
+			                  d, -bpp, -dst_pitch, rw, rh);
+		} else {
+			Rotate_Block(s, src_pitch, d, -bpp, -dst_pitch,
+			             bpp, rw, rh);
+		}
+		break;
+	    case SDL_PRESENT_ROTATE_270:
+		d = (Uint8 *)dst + (w - 1 - x) * dst_pitch + y * bpp;
+		Rotate_Tiled(gamma, fmt, s, src_pitch,
+		             d, -dst_pitch, bpp, bpp, rw, rh);
+		break;
+	    default:
+		d = (Uint8 *)dst + y * dst_pitch + x * bpp;
+		if ( lut ) {
+			SDL_GammaCopy(lut, fmt, s, src_pitch, d, dst_pitch,
+			              rw, rh);
+			break;
+		}
+		rw *= bpp;
+		while ( rh-- ) {
+			SDL_memcpy(d, s, rw);
+			s += src_pitch;
+			d += dst_pitch;
+		}
+		break;
+	}
+}
+
+void SDL_RotateRect(const void *src, int src_pitch,
+                    void *dst, int dst_pitch, int bpp,
+                    int w, int h, const SDL_Rect *rect,
+                    int rotation)
+{
+	Rotate_Rect(NULL, NULL, src, src_pitch, dst, dst_pitch, bpp,
+	            w, h, rect, rotation);
+}
+
+void SDL_GammaRotateRect(const SDL_GammaLUT *lut, const SDL_PixelFormat *fmt,
+                         const void *src, int src_pitch,
+                         void *dst, int dst_pitch,
+                         int w, int h, const SDL_Rect *rect,
+                         int rotation)
+{
+	/* 8-bit pixels are copied unchanged, as by SDL_GammaCopy() */
+	if ( lut && (lut->identity || (fmt->BytesPerPixel == 1)) ) {
+		lut = NULL;
+	}
+	Rotate_Rect(lut, fmt, src, src_pitch, dst, dst_pitch,
+	            fmt->BytesPerPixel, w, h, rect, rotation);
+}
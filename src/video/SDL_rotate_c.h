@@ -0,0 +1,61 @@
+/*
+    SDL - Simple DirectMedia Layer
+    Copyright (C) 1997-2009 Sam Lantinga
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+    Sam Lantinga
+    slouken@libsdl.org
+*/
+#include "SDL_config.h"
+
+#ifndef _SDL_rotate_c_h
+#define _SDL_rotate_c_h
+
+/* Copying of a rectangle of pixels to a display mounted at 90, 180 or
+   270 degrees.  This is shared by the video drivers that keep a shadow
+   buffer for a rotated framebuffer, the rotation values are the same as
+   those of the present stage.
+*/
+
+#include "SDL_video.h"
+#include "SDL_present_c.h"
+
+/* Compute where the rectangle 'rect' of a w x h image ends up after
+   rotating the image clockwise by 'rotation'.
+*/
+extern void SDL_RotatedRect(int w, int h, const SDL_Rect *rect,
+                            int rotation, SDL_Rect *rotated);
+
+/* Copy 'rect' of the w x h image at 'src' to its rotated position in
+   'dst', which is at least h x w (or w x h for 0 and 180 degrees).
+   'bpp' is in bytes and may be 1 to 4; both images have the same format.
+*/
+extern void SDL_RotateRect(const void *src, int src_pitch,
+                           void *dst, int dst_pitch, int bpp,
+                           int w, int h, const SDL_Rect *rect,
+                           int rotation);
+
+/* Same as SDL_RotateRect() for pixels of 'fmt', going through 'lut' on
+   the way unless it is NULL, so the gamma ramp costs no extra pass.
+*/
+extern void SDL_GammaRotateRect(const SDL_GammaLUT *lut,
+                                const SDL_PixelFormat *fmt,
+                                const void *src, int src_pitch,
+                                void *dst, int dst_pitch,
+                                int w, int h, const SDL_Rect *rect,
+                                int rotation);
+
+#endif /* _SDL_rotate_c_h */
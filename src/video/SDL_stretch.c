@@ -25,201 +25,758 @@
    Tomasz Cejner - thanks! :)
 
    April 27, 2000 - Sam Lantinga
+
+   Where each destination column samples the source is worked out once
+   per call into tables.  Surfaces of the same format are stretched by
+   copying raw pixels, anything else goes through rows of 0xAARRGGBB
+   pixels, premultiplied by alpha when the source is blended, so the
+   filters don't need to know about pixel formats.
 */
 
 #include "SDL_video.h"
 #include "SDL_blit.h"
+#include "SDL_pixels_c.h"
+
+/* x/255 rounded, for x in 0..255*255 */
+#define STRETCH_DIV255(x)	((((x) + 128) + (((x) + 128) >> 8)) >> 8)
+
+/* Functions for filtering rows of 0xAARRGGBB pixels */
+typedef void (*SDL_StretchLerpH)(Uint32 *dst, const Uint32 *row,
+                                 const int *x0, const int *x1,
+                                 const Uint8 *fx, int width);
+typedef void (*SDL_StretchLerpV)(Uint32 *dst, const Uint32 *row0,
+                                 const Uint32 *row1, int fy, int width);
+
+/* The state of one stretch, the buffers are freed at the end of it */
+typedef struct {
+	SDL_Surface *src;
+	Uint8 *srcp;		/* The top left of the source rectangle */
+	int src_w;
+	int dst_w;
+	int blend;		/* Premultiply the source and blend it */
+	int *x0, *x1;		/* Source columns for each destination column */
+	Uint8 *fx;		/* Weight of x1 in 1/256ths */
+	Uint32 *srcrow;		/* A converted source row */
+	Uint32 *hrow[2];	/* Filtered source rows, for source rows hy[] */
+	int hy[2];
+	SDL_StretchLerpH lerph;
+} SDL_StretchInfo;
+
+/* Where destination pixel 'i' of 'dst_n' samples the source: between
+   source pixels *i0 and *i1, *frac/256ths of the way to *i1.
+ */
+static void SDL_StretchStep(int i, int src_n, int dst_n, int filter,
+                            int *i0, int *i1, int *frac)
+{
+	int inc = (src_n << 16) / dst_n;
+	int pos;
+
+	switch (filter) {
+	    case SDL_STRETCH_BILINEAR:
+		/* Line up the pixel centres */
+		pos = i * inc + inc / 2 - 0x8000;
+		if ( pos < 0 ) {
+			pos = 0;
+		}
+		*i0 = pos >> 16;
+		*frac = (pos >> 8) & 0xFF;
+		if ( *i0 >= src_n - 1 ) {
+			*i0 = src_n - 1;
+			*frac = 0;
+		}
+		*i1 = *i0 + (*frac != 0);
+		break;
+	    case SDL_STRETCH_INTEGER:
+		/* 'dst_n' is a whole multiple of 'src_n' */
+		*i0 = *i1 = i * src_n / dst_n;
+		*frac = 0;
+		break;
+	    default:
+		/* The same steps as the original stretch blit */
+		*i0 = *i1 = (i * inc) >> 16;
+		*frac = 0;
+		break;
+	}
+}
 
-/* This isn't ready for general consumption yet - it should be folded
-   into the general blitting mechanism.
-*/
+/* Blend two pixels, 'f' in 0..255 is the weight of 'b' in 1/256ths */
+static __inline__ Uint32 SDL_StretchLerp(Uint32 a, Uint32 b, Uint32 f)
+{
+	Uint32 rb, ag;
 
-#if ((defined(_MFC_VER) && defined(_M_IX86)/* && !defined(_WIN32_WCE) still needed? */) || \
-     defined(__WATCOMC__) || \
-     (defined(__GNUC__) && defined(__i386__))) && SDL_ASSEMBLY_ROUTINES
-/* There's a bug with gcc 4.4.1 and -O2 where srcp doesn't get the correct
- * value after the first scanline.  FIXME? */
-/*#define USE_ASM_STRETCH*/
-#endif
+	rb = ((a & 0x00FF00FF) * (256 - f) +
+	      (b & 0x00FF00FF) * f + 0x00800080) >> 8;
+	ag = (((a >> 8) & 0x00FF00FF) * (256 - f) +
+	      ((b >> 8) & 0x00FF00FF) * f + 0x00800080) >> 8;
+	return((rb & 0x00FF00FF) | ((ag & 0x00FF00FF) << 8));
+}
 
-#ifdef USE_ASM_STRETCH
+static void SDL_StretchLerpHC(Uint32 *dst, const Uint32 *row,
+                              const int *x0, const int *x1,
+                              const Uint8 *fx, int width)
+{
+	int i;
 
-#ifdef HAVE_MPROTECT
-#include <sys/types.h>
-#include <sys/mman.h>
-#endif
-#ifdef __GNUC__
-#define PAGE_ALIGNED __attribute__((__aligned__(4096)))
-#else
-#define PAGE_ALIGNED
-#endif
+	for ( i = 0; i < width; ++i ) {
+		dst[i] = SDL_StretchLerp(row[x0[i]], row[x1[i]], fx[i]);
+	}
+}
 
-#if defined(_M_IX86) || defined(i386)
-#define PREFIX16	0x66
-#define STORE_BYTE	0xAA
-#define STORE_WORD	0xAB
-#define LOAD_BYTE	0xAC
-#define LOAD_WORD	0xAD
-#define RETURN		0xC3
-#else
-#error Need assembly opcodes for this architecture
-#endif
+static void SDL_StretchLerpVC(Uint32 *dst, const Uint32 *row0,
+                              const Uint32 *row1, int fy, int width)
+{
+	int i;
 
-static unsigned char copy_row[4096] PAGE_ALIGNED;
+	for ( i = 0; i < width; ++i ) {
+		dst[i] = SDL_StretchLerp(row0[i], row1[i], fy);
+	}
+}
+
+/* The nearest filter only picks columns, without weights */
+static void SDL_StretchNearestH(Uint32 *dst, const Uint32 *row,
+                                const int *x0, const int *x1,
+                                const Uint8 *fx, int width)
+{
+	int i;
+
+	for ( i = 0; i < width; ++i ) {
+		dst[i] = row[x0[i]];
+	}
+}
 
-static int generate_rowbytes(int src_w, int dst_w, int bpp)
+/* Stores of 0xAARRGGBB rows to (A)RGB8888 and RGB565 destinations */
+static void SDL_StretchStore8888C(Uint32 *dst, const Uint32 *row,
+                                  Uint32 mask, int width)
 {
-	static struct {
-		int bpp;
-		int src_w;
-		int dst_w;
-		int status;
-	} last;
+	int i;
+
+	for ( i = 0; i < width; ++i ) {
+		dst[i] = row[i] & mask;
+	}
+}
 
+static void SDL_StretchStore565C(Uint16 *dst, const Uint32 *row, int width)
+{
 	int i;
-	int pos, inc;
-	unsigned char *eip;
-	unsigned char load, store;
 
-	/* See if we need to regenerate the copy buffer */
-	if ( (src_w == last.src_w) &&
-	     (dst_w == last.dst_w) && (bpp == last.bpp) ) {
-		return(last.status);
+	for ( i = 0; i < width; ++i ) {
+		Uint32 color = row[i];
+		dst[i] = (Uint16)(((color >> 8) & 0xF800) |
+		                  ((color >> 5) & 0x07E0) |
+		                  ((color >> 3) & 0x001F));
 	}
-	last.bpp = bpp;
-	last.src_w = src_w;
-	last.dst_w = dst_w;
-	last.status = -1;
+}
 
-	switch (bpp) {
-	    case 1:
-		load = LOAD_BYTE;
-		store = STORE_BYTE;
-		break;
-	    case 2:
-	    case 4:
-		load = LOAD_WORD;
-		store = STORE_WORD;
-		break;
-	    default:
-		SDL_SetError("ASM stretch of %d bytes isn't supported\n", bpp);
-		return(-1);
+#if SSE2_BLITTERS
+SDL_BEGIN_SSE2
+
+/* Blend 8 bit channels widened to 16, 'f' is the weight of 'b' */
+static __inline__ __m128i SSE2_StretchLerp(__m128i a, __m128i b, __m128i f)
+{
+	__m128i inv = _mm_sub_epi16(_mm_set1_epi16(256), f);
+	return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(
+	                      _mm_mullo_epi16(a, inv), _mm_mullo_epi16(b, f)),
+	                      _mm_set1_epi16(128)), 8);
+}
+
+static void SDL_StretchLerpHSSE2(Uint32 *dst, const Uint32 *row,
+                                 const int *x0, const int *x1,
+                                 const Uint8 *fx, int width)
+{
+	const __m128i zero = _mm_setzero_si128();
+	int i;
+
+	for ( i = 0; i + 4 <= width; i += 4 ) {
+		__m128i a = _mm_set_epi32(row[x0[i+3]], row[x0[i+2]],
+		                          row[x0[i+1]], row[x0[i]]);
+		__m128i b = _mm_set_epi32(row[x1[i+3]], row[x1[i+2]],
+		                          row[x1[i+1]], row[x1[i]]);
+		__m128i flo = _mm_set_epi16(fx[i+1], fx[i+1], fx[i+1], fx[i+1],
+		                            fx[i], fx[i], fx[i], fx[i]);
+		__m128i fhi = _mm_set_epi16(fx[i+3], fx[i+3], fx[i+3], fx[i+3],
+		                            fx[i+2], fx[i+2], fx[i+2], fx[i+2]);
+		__m128i lo = SSE2_StretchLerp(_mm_unpacklo_epi8(a, zero),
+		                              _mm_unpacklo_epi8(b, zero), flo);
+		__m128i hi = SSE2_StretchLerp(_mm_unpackhi_epi8(a, zero),
+		                              _mm_unpackhi_epi8(b, zero), fhi);
+		_mm_storeu_si128((__m128i *)&dst[i], _mm_packus_epi16(lo, hi));
 	}
-#ifdef HAVE_MPROTECT
-	/* Make the code writeable */
-	if ( mprotect(copy_row, sizeof(copy_row), PROT_READ|PROT_WRITE) < 0 ) {
-		SDL_SetError("Couldn't make copy buffer writeable");
-		return(-1);
+	SDL_StretchLerpHC(dst + i, row, x0 + i, x1 + i, fx + i, width - i);
+}
+
+static void SDL_StretchLerpVSSE2(Uint32 *dst, const Uint32 *row0,
+                                 const Uint32 *row1, int fy, int width)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i f = _mm_set1_epi16((short)fy);
+	int i;
+
+	for ( i = 0; i + 4 <= width; i += 4 ) {
+		__m128i a = _mm_loadu_si128((const __m128i *)&row0[i]);
+		__m128i b = _mm_loadu_si128((const __m128i *)&row1[i]);
+		__m128i lo = SSE2_StretchLerp(_mm_unpacklo_epi8(a, zero),
+		                              _mm_unpacklo_epi8(b, zero), f);
+		__m128i hi = SSE2_StretchLerp(_mm_unpackhi_epi8(a, zero),
+		                              _mm_unpackhi_epi8(b, zero), f);
+		_mm_storeu_si128((__m128i *)&dst[i], _mm_packus_epi16(lo, hi));
 	}
-#endif
-	pos = 0x10000;
-	inc = (src_w << 16) / dst_w;
-	eip = copy_row;
-	for ( i=0; i<dst_w; ++i ) {
-		while ( pos >= 0x10000L ) {
-			if ( bpp == 2 ) {
-				*eip++ = PREFIX16;
+	SDL_StretchLerpVC(dst + i, row0 + i, row1 + i, fy, width - i);
+}
+
+static void SDL_StretchStore8888SSE2(Uint32 *dst, const Uint32 *row,
+                                     Uint32 mask, int width)
+{
+	const __m128i m = _mm_set1_epi32((int)mask);
+	int i;
+
+	for ( i = 0; i + 4 <= width; i += 4 ) {
+		__m128i a = _mm_loadu_si128((const __m128i *)&row[i]);
+		_mm_storeu_si128((__m128i *)&dst[i], _mm_and_si128(a, m));
+	}
+	SDL_StretchStore8888C(dst + i, row + i, mask, width - i);
+}
+
+/* 8 pixels at a time, the fields are sign extended so that the signed
+   pack keeps all 16 bits */
+static __inline__ __m128i SSE2_Stretch565(__m128i c)
+{
+	c = _mm_or_si128(_mm_or_si128(
+	        _mm_and_si128(_mm_srli_epi32(c, 8), _mm_set1_epi32(0xF800)),
+	        _mm_and_si128(_mm_srli_epi32(c, 5), _mm_set1_epi32(0x07E0))),
+	        _mm_and_si128(_mm_srli_epi32(c, 3), _mm_set1_epi32(0x001F)));
+	return _mm_srai_epi32(_mm_slli_epi32(c, 16), 16);
+}
+
+static void SDL_StretchStore565SSE2(Uint16 *dst, const Uint32 *row,
+                                    int width)
+{
+	int i;
+
+	for ( i = 0; i + 8 <= width; i += 8 ) {
+		__m128i lo = _mm_loadu_si128((const __m128i *)&row[i]);
+		__m128i hi = _mm_loadu_si128((const __m128i *)&row[i+4]);
+		_mm_storeu_si128((__m128i *)&dst[i],
+		                 _mm_packs_epi32(SSE2_Stretch565(lo),
+		                                 SSE2_Stretch565(hi)));
+	}
+	SDL_StretchStore565C(dst + i, row + i, width - i);
+}
+
+SDL_END_TARGET
+#endif /* SSE2_BLITTERS */
+
+#if NEON_BLITTERS
+SDL_BEGIN_NEON
+
+/* Blend 8 bit channels, 'f' is the weight of 'b' */
+static __inline__ uint8x8_t NEON_StretchLerp(uint8x8_t a, uint8x8_t b,
+                                             uint16x8_t f)
+{
+	uint16x8_t inv = vsubq_u16(vdupq_n_u16(256), f);
+	return vrshrn_n_u16(vmlaq_u16(vmulq_u16(vmovl_u8(a), inv),
+	                              vmovl_u8(b), f), 8);
+}
+
+static void SDL_StretchLerpHNEON(Uint32 *dst, const Uint32 *row,
+                                 const int *x0, const int *x1,
+                                 const Uint8 *fx, int width)
+{
+	int i;
+
+	for ( i = 0; i + 4 <= width; i += 4 ) {
+		Uint32 pa[4], pb[4];
+		uint8x16_t a, b;
+		uint16x8_t flo, fhi;
+		uint8x8_t lo, hi;
+
+		pa[0] = row[x0[i]]; pa[1] = row[x0[i+1]];
+		pa[2] = row[x0[i+2]]; pa[3] = row[x0[i+3]];
+		pb[0] = row[x1[i]]; pb[1] = row[x1[i+1]];
+		pb[2] = row[x1[i+2]]; pb[3] = row[x1[i+3]];
+		a = vreinterpretq_u8_u32(vld1q_u32(pa));
+		b = vreinterpretq_u8_u32(vld1q_u32(pb));
+		flo = vcombine_u16(vdup_n_u16(fx[i]), vdup_n_u16(fx[i+1]));
+		fhi = vcombine_u16(vdup_n_u16(fx[i+2]), vdup_n_u16(fx[i+3]));
+		lo = NEON_StretchLerp(vget_low_u8(a), vget_low_u8(b), flo);
+		hi = NEON_StretchLerp(vget_high_u8(a), vget_high_u8(b), fhi);
+		vst1q_u32(&dst[i], vreinterpretq_u32_u8(vcombine_u8(lo, hi)));
+	}
+	SDL_StretchLerpHC(dst + i, row, x0 + i, x1 + i, fx + i, width - i);
+}
+
+static void SDL_StretchLerpVNEON(Uint32 *dst, const Uint32 *row0,
+                                 const Uint32 *row1, int fy, int width)
+{
+	const uint16x8_t f = vdupq_n_u16((uint16_t)fy);
+	int i;
+
+	for ( i = 0; i + 4 <= width; i += 4 ) {
+		uint8x16_t a = vreinterpretq_u8_u32(vld1q_u32(&row0[i]));
+		uint8x16_t b = vreinterpretq_u8_u32(vld1q_u32(&row1[i]));
+		uint8x8_t lo = NEON_StretchLerp(vget_low_u8(a), vget_low_u8(b), f);
+		uint8x8_t hi = NEON_StretchLerp(vget_high_u8(a), vget_high_u8(b), f);
+		vst1q_u32(&dst[i], vreinterpretq_u32_u8(vcombine_u8(lo, hi)));
+	}
+	SDL_StretchLerpVC(dst + i, row0 + i, row1 + i, fy, width - i);
+}
+
+static void SDL_StretchStore8888NEON(Uint32 *dst, const Uint32 *row,
+                                     Uint32 mask, int width)
+{
+	const uint32x4_t m = vdupq_n_u32(mask);
+	int i;
+
+	for ( i = 0; i + 4 <= width; i += 4 ) {
+		vst1q_u32(&dst[i], vandq_u32(vld1q_u32(&row[i]), m));
+	}
+	SDL_StretchStore8888C(dst + i, row + i, mask, width - i);
+}
+
+/* 8 pixels at a time, from the blue, green and red bytes */
+static void SDL_StretchStore565NEON(Uint16 *dst, const Uint32 *row,
+                                    int width)
+{
+	int i;
+
+	for ( i = 0; i + 8 <= width; i += 8 ) {
+		uint8x8x4_t s = vld4_u8((const Uint8 *)&row[i]);
+		uint16x8_t r = vmovl_u8(vshr_n_u8(s.val[2], 3));
+		uint16x8_t g = vmovl_u8(vshr_n_u8(s.val[1], 2));
+		uint16x8_t b = vmovl_u8(vshr_n_u8(s.val[0], 3));
+
+		vst1q_u16(&dst[i], vorrq_u16(vorrq_u16(vshlq_n_u16(r, 11),
+		                                       vshlq_n_u16(g, 5)), b));
+	}
+	SDL_StretchStore565C(dst + i, row + i, width - i);
+}
+
+SDL_END_TARGET
+#endif /* NEON_BLITTERS */
+
+/* Convert a source row to 0xAARRGGBB.  When blending, color keyed
+   pixels become transparent, the surface alpha is applied and the
+   color is premultiplied by the alpha.
+ */
+static void SDL_StretchFetch(SDL_StretchInfo *info, int y, Uint32 *row)
+{
+	SDL_Surface *src = info->src;
+	SDL_PixelFormat *fmt = src->format;
+	const int bpp = fmt->BytesPerPixel;
+	const Uint8 *srcp = info->srcp + y * src->pitch;
+	int keyed = info->blend && (src->flags & SDL_SRCCOLORKEY);
+	Uint32 rgbmask = ~fmt->Amask;
+	Uint32 ckey = fmt->colorkey & rgbmask;
+	unsigned alpha = SDL_ALPHA_OPAQUE;
+	int i;
+
+	if ( info->blend && (src->flags & SDL_SRCALPHA) ) {
+		alpha = fmt->alpha;
+	}
+
+	/* (A)RGB8888 sources that are copied */
+	if ( (bpp == 4) && !info->blend && (fmt->Rmask == 0x00FF0000) &&
+	     (fmt->Gmask == 0x0000FF00) && (fmt->Bmask == 0x000000FF) ) {
+		const Uint32 *p = (const Uint32 *)srcp;
+		Uint32 opaque = fmt->Amask ? 0 : 0xFF000000;
+
+		for ( i = 0; i < info->src_w; ++i ) {
+			row[i] = p[i] | opaque;
+		}
+		return;
+	}
+
+	for ( i = 0; i < info->src_w; ++i ) {
+		Uint32 pixel;
+		unsigned r, g, b, a;
+
+		switch (bpp) {
+		    case 1:
+			pixel = *srcp;
+			break;
+		    case 2:
+			pixel = *(const Uint16 *)srcp;
+			break;
+		    case 3:
+			pixel = SDL_READ24(srcp);
+			break;
+		    default:
+			pixel = *(const Uint32 *)srcp;
+			break;
+		}
+		srcp += bpp;
+		if ( keyed && ((pixel & rgbmask) == ckey) ) {
+			row[i] = 0;
+			continue;
+		}
+		if ( bpp == 1 ) {
+			const SDL_Color *c = &fmt->palette->colors[pixel];
+			r = c->r;
+			g = c->g;
+			b = c->b;
+			a = SDL_ALPHA_OPAQUE;
+		} else {
+			r = ((pixel & fmt->Rmask) >> fmt->Rshift) << fmt->Rloss;
+			g = ((pixel & fmt->Gmask) >> fmt->Gshift) << fmt->Gloss;
+			b = ((pixel & fmt->Bmask) >> fmt->Bshift) << fmt->Bloss;
+			if ( fmt->Amask ) {
+				a = ((pixel & fmt->Amask) >> fmt->Ashift) <<
+				    fmt->Aloss;
+			} else {
+				a = SDL_ALPHA_OPAQUE;
 			}
-			*eip++ = load;
-			pos -= 0x10000L;
 		}
-		if ( bpp == 2 ) {
-			*eip++ = PREFIX16;
+		if ( info->blend ) {
+			if ( alpha != SDL_ALPHA_OPAQUE ) {
+				a = STRETCH_DIV255(a * alpha);
+			}
+			if ( a != SDL_ALPHA_OPAQUE ) {
+				r = STRETCH_DIV255(r * a);
+				g = STRETCH_DIV255(g * a);
+				b = STRETCH_DIV255(b * a);
+			}
 		}
-		*eip++ = store;
-		pos += inc;
+		row[i] = (a << 24) | (r << 16) | (g << 8) | b;
 	}
-	*eip++ = RETURN;
+}
 
-	/* Verify that we didn't overflow (too late!!!) */
-	if ( eip > (copy_row+sizeof(copy_row)) ) {
-		SDL_SetError("Copy buffer overflow");
-		return(-1);
+/* A source row converted and filtered horizontally, 'keep' is a row
+   that is still needed and mustn't be thrown out of the cache.
+ */
+static Uint32 *SDL_StretchRow(SDL_StretchInfo *info, int y, int keep)
+{
+	int k;
+
+	if ( info->hy[0] == y ) {
+		return(info->hrow[0]);
 	}
-#ifdef HAVE_MPROTECT
-	/* Make the code executable but not writeable */
-	if ( mprotect(copy_row, sizeof(copy_row), PROT_READ|PROT_EXEC) < 0 ) {
-		SDL_SetError("Couldn't make copy buffer executable");
-		return(-1);
+	if ( info->hy[1] == y ) {
+		return(info->hrow[1]);
 	}
+	k = (info->hy[0] == keep);
+	SDL_StretchFetch(info, y, info->srcrow);
+	info->lerph(info->hrow[k], info->srcrow,
+	            info->x0, info->x1, info->fx, info->dst_w);
+	info->hy[k] = y;
+	return(info->hrow[k]);
+}
+
+static __inline__ Uint32 SDL_StretchPack(SDL_PixelFormat *fmt,
+                                         unsigned r, unsigned g, unsigned b)
+{
+	return(((r >> fmt->Rloss) << fmt->Rshift) |
+	       ((g >> fmt->Gloss) << fmt->Gshift) |
+	       ((b >> fmt->Bloss) << fmt->Bshift));
+}
+
+/* Write a row of 0xAARRGGBB pixels to the destination.  Copied pixels
+   carry their alpha over, blended ones leave the destination alpha alone.
+ */
+static void SDL_StretchStore(SDL_PixelFormat *fmt, const Uint32 *row,
+                             Uint8 *dstp, int width, int blend)
+{
+	const int bpp = fmt->BytesPerPixel;
+	Uint32 lastcolor = 0;
+	Uint8 lastindex = 0;
+	int i;
+
+	/* (A)RGB8888 destinations that are copied to */
+	if ( (bpp == 4) && !blend && (fmt->Rmask == 0x00FF0000) &&
+	     (fmt->Gmask == 0x0000FF00) && (fmt->Bmask == 0x000000FF) ) {
+		Uint32 mask = fmt->Amask ? 0xFFFFFFFF : 0x00FFFFFF;
+
+#if SSE2_BLITTERS
+		if ( SDL_GetBlitFeatures() & SDL_BLIT_SSE2 ) {
+			SDL_StretchStore8888SSE2((Uint32 *)dstp, row, mask, width);
+			return;
+		}
+#elif NEON_BLITTERS
+		if ( SDL_GetBlitFeatures() & SDL_BLIT_NEON ) {
+			SDL_StretchStore8888NEON((Uint32 *)dstp, row, mask, width);
+			return;
+		}
 #endif
-	last.status = 0;
-	return(0);
+		SDL_StretchStore8888C((Uint32 *)dstp, row, mask, width);
+		return;
+	}
+	/* RGB565 destinations that are copied to */
+	if ( (bpp == 2) && !blend && (fmt->Rmask == 0xF800) &&
+	     (fmt->Gmask == 0x07E0) && (fmt->Bmask == 0x001F) ) {
+#if SSE2_BLITTERS
+		if ( SDL_GetBlitFeatures() & SDL_BLIT_SSE2 ) {
+			SDL_StretchStore565SSE2((Uint16 *)dstp, row, width);
+			return;
+		}
+#elif NEON_BLITTERS
+		if ( SDL_GetBlitFeatures() & SDL_BLIT_NEON ) {
+			SDL_StretchStore565NEON((Uint16 *)dstp, row, width);
+			return;
+		}
+#endif
+		SDL_StretchStore565C((Uint16 *)dstp, row, width);
+		return;
+	}
+
+	for ( i = 0; i < width; ++i, dstp += bpp ) {
+		Uint32 color = row[i];
+		unsigned a = color >> 24;
+		unsigned r = (color >> 16) & 0xFF;
+		unsigned g = (color >> 8) & 0xFF;
+		unsigned b = color & 0xFF;
+		Uint32 pixel = 0;
+
+		if ( blend ) {
+			if ( a == 0 ) {
+				continue;
+			}
+			switch (bpp) {
+			    case 1:
+				pixel = *dstp;
+				break;
+			    case 2:
+				pixel = *(Uint16 *)dstp;
+				break;
+			    case 3:
+				pixel = SDL_READ24(dstp);
+				break;
+			    default:
+				pixel = *(Uint32 *)dstp;
+				break;
+			}
+			if ( a != SDL_ALPHA_OPAQUE ) {
+				unsigned dr, dg, db;
+
+				if ( bpp == 1 ) {
+					const SDL_Color *c =
+						&fmt->palette->colors[pixel];
+					dr = c->r;
+					dg = c->g;
+					db = c->b;
+				} else {
+					dr = ((pixel & fmt->Rmask) >>
+					      fmt->Rshift) << fmt->Rloss;
+					dg = ((pixel & fmt->Gmask) >>
+					      fmt->Gshift) << fmt->Gloss;
+					db = ((pixel & fmt->Bmask) >>
+					      fmt->Bshift) << fmt->Bloss;
+				}
+				r += STRETCH_DIV255(dr * (255 - a));
+				g += STRETCH_DIV255(dg * (255 - a));
+				b += STRETCH_DIV255(db * (255 - a));
+			}
+			pixel &= fmt->Amask;
+		} else {
+			pixel = ((a >> fmt->Aloss) << fmt->Ashift) & fmt->Amask;
+		}
+
+		switch (bpp) {
+		    case 1:
+			color = (r << 16) | (g << 8) | b;
+			if ( (i == 0) || (color != lastcolor) ) {
+				lastcolor = color;
+				lastindex = SDL_FindColor(fmt->palette,
+				                          (Uint8)r, (Uint8)g,
+				                          (Uint8)b);
+			}
+			*dstp = lastindex;
+			break;
+		    case 2:
+			*(Uint16 *)dstp = (Uint16)(pixel |
+			                           SDL_StretchPack(fmt, r, g, b));
+			break;
+		    case 3:
+			pixel |= SDL_StretchPack(fmt, r, g, b);
+			SDL_WRITE24(dstp, pixel);
+			break;
+		    default:
+			*(Uint32 *)dstp = pixel | SDL_StretchPack(fmt, r, g, b);
+			break;
+		}
+	}
 }
 
-#endif /* USE_ASM_STRETCH */
-
-#define DEFINE_COPY_ROW(name, type)			\
-void name(type *src, int src_w, type *dst, int dst_w)	\
-{							\
-	int i;						\
-	int pos, inc;					\
-	type pixel = 0;					\
-							\
-	pos = 0x10000;					\
-	inc = (src_w << 16) / dst_w;			\
-	for ( i=dst_w; i>0; --i ) {			\
-		while ( pos >= 0x10000L ) {		\
-			pixel = *src++;			\
-			pos -= 0x10000L;		\
-		}					\
-		*dst++ = pixel;				\
-		pos += inc;				\
-	}						\
+/* Copy source pixels to the destination columns, for surfaces of the
+   same format.
+ */
+static void SDL_StretchGather(const Uint8 *srcp, Uint8 *dstp,
+                              const int *x0, int width, int bpp)
+{
+	int i;
+
+	switch (bpp) {
+	    case 1:
+		for ( i = 0; i < width; ++i ) {
+			dstp[i] = srcp[x0[i]];
+		}
+		break;
+	    case 2:
+		for ( i = 0; i < width; ++i ) {
+			((Uint16 *)dstp)[i] = ((const Uint16 *)srcp)[x0[i]];
+		}
+		break;
+	    case 3:
+		for ( i = 0; i < width; ++i ) {
+			const Uint8 *p = srcp + x0[i] * 3;
+			dstp[0] = p[0];
+			dstp[1] = p[1];
+			dstp[2] = p[2];
+			dstp += 3;
+		}
+		break;
+	    default:
+		for ( i = 0; i < width; ++i ) {
+			((Uint32 *)dstp)[i] = ((const Uint32 *)srcp)[x0[i]];
+		}
+		break;
+	}
 }
-DEFINE_COPY_ROW(copy_row1, Uint8)
-DEFINE_COPY_ROW(copy_row2, Uint16)
-DEFINE_COPY_ROW(copy_row4, Uint32)
 
-/* The ASM code doesn't handle 24-bpp stretch blits */
-void copy_row3(Uint8 *src, int src_w, Uint8 *dst, int dst_w)
+static int SDL_StretchSameFormat(SDL_PixelFormat *a, SDL_PixelFormat *b)
 {
+	if ( (a->BitsPerPixel != b->BitsPerPixel) ||
+	     (a->BytesPerPixel != b->BytesPerPixel) ) {
+		return(0);
+	}
+	if ( a->BytesPerPixel == 1 ) {
+		return(a->palette == b->palette ||
+		       (a->palette && b->palette &&
+		        a->palette->ncolors == b->palette->ncolors &&
+		        SDL_memcmp(a->palette->colors, b->palette->colors,
+		                   a->palette->ncolors * sizeof(SDL_Color)) == 0));
+	}
+	return((a->Rmask == b->Rmask) && (a->Gmask == b->Gmask) &&
+	       (a->Bmask == b->Bmask) && (a->Amask == b->Amask));
+}
+
+/* Stretch the rectangles, which have been checked */
+static int SDL_StretchRects(SDL_Surface *src, SDL_Rect *srcrect,
+                            SDL_Surface *dst, SDL_Rect *dstrect,
+                            int filter, int blend)
+{
+	static const char *names[] = {
+		"Stretch nearest", "Stretch bilinear", "Stretch integer"
+	};
+	SDL_StretchInfo info;
+	SDL_StretchLerpV lerpv;
+	Uint8 *buffer;
+	Uint8 *dstp;
+	Uint32 *outrow;
+	SDL_BlitTime start = 0;
+	const int src_h = srcrect->h;
+	const int dst_h = dstrect->h;
+	const int dstbpp = dst->format->BytesPerPixel;
+	int raw;
+	int last;
 	int i;
-	int pos, inc;
-	Uint8 pixel[3] = { 0, 0, 0 };
-
-	pos = 0x10000;
-	inc = (src_w << 16) / dst_w;
-	for ( i=dst_w; i>0; --i ) {
-		while ( pos >= 0x10000L ) {
-			pixel[0] = *src++;
-			pixel[1] = *src++;
-			pixel[2] = *src++;
-			pos -= 0x10000L;
+
+	if ( SDL_blit_stats ) {
+		start = SDL_StartBlitStats();
+	}
+
+	info.src = src;
+	info.srcp = (Uint8 *)src->pixels + srcrect->y * src->pitch +
+	            srcrect->x * src->format->BytesPerPixel;
+	info.src_w = srcrect->w;
+	info.dst_w = dstrect->w;
+	info.blend = blend;
+	info.hy[0] = info.hy[1] = -1;
+	info.lerph = SDL_StretchLerpHC;
+	lerpv = SDL_StretchLerpVC;
+#if SSE2_BLITTERS
+	if ( SDL_GetBlitFeatures() & SDL_BLIT_SSE2 ) {
+		info.lerph = SDL_StretchLerpHSSE2;
+		lerpv = SDL_StretchLerpVSSE2;
+	}
+#elif NEON_BLITTERS
+	if ( SDL_GetBlitFeatures() & SDL_BLIT_NEON ) {
+		info.lerph = SDL_StretchLerpHNEON;
+		lerpv = SDL_StretchLerpVNEON;
+	}
+#endif
+	if ( filter != SDL_STRETCH_BILINEAR ) {
+		info.lerph = SDL_StretchNearestH;
+	}
+
+	/* Raw pixels are copied unless the formats or the pixels change */
+	raw = !blend && (filter != SDL_STRETCH_BILINEAR) &&
+	      SDL_StretchSameFormat(src->format, dst->format);
+
+	buffer = (Uint8 *)SDL_malloc((info.src_w + 3 * info.dst_w) *
+	                             sizeof(Uint32) +
+	                             info.dst_w * (2 * sizeof(int) + 1));
+	if ( buffer == NULL ) {
+		SDL_OutOfMemory();
+		return(-1);
+	}
+	info.srcrow = (Uint32 *)buffer;
+	info.hrow[0] = info.srcrow + info.src_w;
+	info.hrow[1] = info.hrow[0] + info.dst_w;
+	outrow = info.hrow[1] + info.dst_w;
+	info.x0 = (int *)(outrow + info.dst_w);
+	info.x1 = info.x0 + info.dst_w;
+	info.fx = (Uint8 *)(info.x1 + info.dst_w);
+
+	for ( i = 0; i < info.dst_w; ++i ) {
+		int frac;
+
+		SDL_StretchStep(i, info.src_w, info.dst_w, filter,
+		                &info.x0[i], &info.x1[i], &frac);
+		info.fx[i] = (Uint8)frac;
+	}
+
+	last = -1;
+	dstp = (Uint8 *)dst->pixels + dstrect->y * dst->pitch +
+	       dstrect->x * dstbpp;
+	for ( i = 0; i < dst_h; ++i, dstp += dst->pitch ) {
+		int y0, y1, fy;
+
+		SDL_StretchStep(i, src_h, dst_h, filter, &y0, &y1, &fy);
+		if ( (y0 == last) && !blend &&
+		     (filter != SDL_STRETCH_BILINEAR) ) {
+			/* The row above again */
+			SDL_memcpy(dstp, dstp - dst->pitch, info.dst_w * dstbpp);
+		} else if ( raw ) {
+			SDL_StretchGather(info.srcp + y0 * src->pitch,
+			                  dstp, info.x0, info.dst_w, dstbpp);
+		} else if ( filter != SDL_STRETCH_BILINEAR ) {
+			/* Nearest: one source row, its columns picked */
+			SDL_StretchStore(dst->format,
+			                 SDL_StretchRow(&info, y0, -1),
+			                 dstp, info.dst_w, blend);
+		} else {
+			Uint32 *row0 = SDL_StretchRow(&info, y0, y1);
+
+			if ( fy ) {
+				Uint32 *row1 = SDL_StretchRow(&info, y1, y0);
+				lerpv(outrow, row0, row1, fy, info.dst_w);
+				row0 = outrow;
+			}
+			SDL_StretchStore(dst->format, row0, dstp,
+			                 info.dst_w, blend);
 		}
-		*dst++ = pixel[0];
-		*dst++ = pixel[1];
-		*dst++ = pixel[2];
-		pos += inc;
+		last = y0;
+	}
+	SDL_free(buffer);
+
+	if ( SDL_blit_stats ) {
+		SDL_AddBlitStats(names[filter], src->format, dst->format,
+		                 dstrect->w, dstrect->h, start);
 	}
+	return(0);
 }
 
-/* Perform a stretch blit between two surfaces of the same format.
-   NOTE:  This function is not safe to call from multiple threads!
-*/
-int SDL_SoftStretch(SDL_Surface *src, SDL_Rect *srcrect,
-                    SDL_Surface *dst, SDL_Rect *dstrect)
+/* Check the rectangles and lock the surfaces for a stretch */
+static int SDL_StretchSurface(SDL_Surface *src, SDL_Rect *srcrect,
+                              SDL_Surface *dst, SDL_Rect *dstrect,
+                              int filter, int blend)
 {
 	int src_locked;
 	int dst_locked;
-	int pos, inc;
-	int dst_width;
-	int dst_maxrow;
-	int src_row, dst_row;
-	Uint8 *srcp = NULL;
-	Uint8 *dstp;
+	int retval;
 	SDL_Rect full_src;
 	SDL_Rect full_dst;
-#ifdef USE_ASM_STRETCH
-	SDL_bool use_asm = SDL_TRUE;
-#ifdef __GNUC__
-	int u1, u2;
-#endif
-#endif /* USE_ASM_STRETCH */
-	const int bpp = dst->format->BytesPerPixel;
 
-	if ( src->format->BitsPerPixel != dst->format->BitsPerPixel ) {
-		SDL_SetError("Only works with same format surfaces");
+	if ( (filter < SDL_STRETCH_NEAREST) || (filter > SDL_STRETCH_INTEGER) ) {
+		SDL_SetError("Unknown stretch filter");
 		return(-1);
 	}
 
@@ -231,12 +788,12 @@ int SDL_SoftStretch(SDL_Surface *src, SDL_Rect *srcrect,
 			SDL_SetError("Invalid source blit rectangle");
 			return(-1);
 		}
+		full_src = *srcrect;
 	} else {
 		full_src.x = 0;
 		full_src.y = 0;
 		full_src.w = src->w;
 		full_src.h = src->h;
-		srcrect = &full_src;
 	}
 	if ( dstrect ) {
 		if ( (dstrect->x < 0) || (dstrect->y < 0) ||
@@ -245,12 +802,33 @@ int SDL_SoftStretch(SDL_Surface *src, SDL_Rect *srcrect,
 			SDL_SetError("Invalid destination blit rectangle");
 			return(-1);
 		}
+		full_dst = *dstrect;
 	} else {
 		full_dst.x = 0;
 		full_dst.y = 0;
 		full_dst.w = dst->w;
 		full_dst.h = dst->h;
-		dstrect = &full_dst;
+	}
+	if ( !full_src.w || !full_src.h || !full_dst.w || !full_dst.h ) {
+		return(0);
+	}
+
+	/* Pixel art is scaled by the largest whole factor that fits, and
+	   centred in the destination rectangle */
+	if ( filter == SDL_STRETCH_INTEGER ) {
+		int scale = full_dst.w / full_src.w;
+
+		if ( scale > full_dst.h / full_src.h ) {
+			scale = full_dst.h / full_src.h;
+		}
+		if ( scale > 0 ) {
+			full_dst.x += (full_dst.w - full_src.w * scale) / 2;
+			full_dst.y += (full_dst.h - full_src.h * scale) / 2;
+			full_dst.w = full_src.w * scale;
+			full_dst.h = full_src.h * scale;
+		} else {
+			filter = SDL_STRETCH_NEAREST;
+		}
 	}
 
 	/* Lock the destination if it's in hardware */
@@ -275,76 +853,8 @@ int SDL_SoftStretch(SDL_Surface *src, SDL_Rect *srcrect,
 		src_locked = 1;
 	}
 
-	/* Set up the data... */
-	pos = 0x10000;
-	inc = (srcrect->h << 16) / dstrect->h;
-	src_row = srcrect->y;
-	dst_row = dstrect->y;
-	dst_width = dstrect->w*bpp;
-
-#ifdef USE_ASM_STRETCH
-	/* Write the opcodes for this stretch */
-	if ( (bpp == 3) ||
-	     (generate_rowbytes(srcrect->w, dstrect->w, bpp) < 0) ) {
-		use_asm = SDL_FALSE;
-	}
-#endif
-
-	/* Perform the stretch blit */
-	for ( dst_maxrow = dst_row+dstrect->h; dst_row<dst_maxrow; ++dst_row ) {
-		dstp = (Uint8 *)dst->pixels + (dst_row*dst->pitch)
-		                            + (dstrect->x*bpp);
-		while ( pos >= 0x10000L ) {
-			srcp = (Uint8 *)src->pixels + (src_row*src->pitch)
-			                            + (srcrect->x*bpp);
-			++src_row;
-			pos -= 0x10000L;
-		}
-#ifdef USE_ASM_STRETCH
-		if (use_asm) {
-#ifdef __GNUC__
-			__asm__ __volatile__ (
-			"call *%4"
-			: "=&D" (u1), "=&S" (u2)
-			: "0" (dstp), "1" (srcp), "r" (copy_row)
-			: "memory" );
-#elif defined(_MSC_VER) || defined(__WATCOMC__)
-		{ void *code = copy_row;
-			__asm {
-				push edi
-				push esi
-	
-				mov edi, dstp
-				mov esi, srcp
-				call dword ptr code
-
-				pop esi
-				pop edi
-			}
-		}
-#else
-#error Need inline assembly for this compiler
-#endif
-		} else
-#endif
-		switch (bpp) {
-		    case 1:
-			copy_row1(srcp, srcrect->w, dstp, dstrect->w);
-			break;
-		    case 2:
-			copy_row2((Uint16 *)srcp, srcrect->w,
-			          (Uint16 *)dstp, dstrect->w);
-			break;
-		    case 3:
-			copy_row3(srcp, srcrect->w, dstp, dstrect->w);
-			break;
-		    case 4:
-			copy_row4((Uint32 *)srcp, srcrect->w,
-			          (Uint32 *)dstp, dstrect->w);
-			break;
-		}
-		pos += inc;
-	}
+	retval = SDL_StretchRects(src, &full_src, dst, &full_dst,
+	                          filter, blend);
 
 	/* We need to unlock the surfaces if they're locked */
 	if ( dst_locked ) {
@@ -353,6 +863,29 @@ int SDL_SoftStretch(SDL_Surface *src, SDL_Rect *srcrect,
 	if ( src_locked ) {
 		SDL_UnlockSurface(src);
 	}
-	return(0);
+	return(retval);
 }
 
+/* Perform a nearest neighbour stretch blit, copying the source pixels */
+int SDL_SoftStretch(SDL_Surface *src, SDL_Rect *srcrect,
+                    SDL_Surface *dst, SDL_Rect *dstrect)
+{
+	return(SDL_StretchSurface(src, srcrect, dst, dstrect,
+	                          SDL_STRETCH_NEAREST, 0));
+}
+
+int SDL_SoftStretchFilter(SDL_Surface *src, SDL_Rect *srcrect,
+                          SDL_Surface *dst, SDL_Rect *dstrect, int filter)
+{
+	int blend = 0;
+
+	if ( src->flags & SDL_SRCCOLORKEY ) {
+		blend = 1;
+	}
+	if ( (src->flags & SDL_SRCALPHA) &&
+	     (src->format->Amask ||
+	      (src->format->alpha != SDL_ALPHA_OPAQUE)) ) {
+		blend = 1;
+	}
+	return(SDL_StretchSurface(src, srcrect, dst, dstrect, filter, blend));
+}
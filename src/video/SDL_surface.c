@@ -435,34 +435,24 @@ int SDL_LowerBlit (SDL_Surface *src, SDL_Rect *srcrect,
 		}
 		do_blit = src->map->hw_blit;
 	} else {
+		if ( src->map->sw_data->rle_blit ) {
+			SDL_CheckRLE(src, 1);
+		}
 		do_blit = src->map->sw_blit;
 	}
 	return(do_blit(src, srcrect, dst, dstrect));
 }
 
 
-int SDL_UpperBlit (SDL_Surface *src, SDL_Rect *srcrect,
-		   SDL_Surface *dst, SDL_Rect *dstrect)
+/*
+ * Clip a blit to the source surface and the destination clip rectangle,
+ * setting 'sr' and the size of 'dstrect'.  Returns 0 if nothing is left.
+ */
+static int SDL_ClipBlit (SDL_Surface *src, SDL_Rect *srcrect,
+			 SDL_Surface *dst, SDL_Rect *dstrect, SDL_Rect *sr)
 {
-        SDL_Rect fulldst;
 	int srcx, srcy, w, h;
 
-	/* Make sure the surfaces aren't locked */
-	if ( ! src || ! dst ) {
-		SDL_SetError("SDL_UpperBlit: passed a NULL surface");
-		return(-1);
-	}
-	if ( src->locked || dst->locked ) {
-		SDL_SetError("Surfaces must not be locked during blit");
-		return(-1);
-	}
-
-	/* If the destination rectangle is NULL, use the entire dest surface */
-	if ( dstrect == NULL ) {
-	        fulldst.x = fulldst.y = 0;
-		dstrect = &fulldst;
-	}
-
 	/* clip the source rectangle to the source surface */
 	if(srcrect) {
 	        int maxw, maxh;
@@ -522,17 +512,155 @@ int SDL_UpperBlit (SDL_Surface *src, SDL_Rect *srcrect,
 	}
 
 	if(w > 0 && h > 0) {
-	        SDL_Rect sr;
-	        sr.x = srcx;
-		sr.y = srcy;
-		sr.w = dstrect->w = w;
-		sr.h = dstrect->h = h;
-		return SDL_LowerBlit(src, &sr, dst, dstrect);
+	        sr->x = srcx;
+		sr->y = srcy;
+		sr->w = dstrect->w = w;
+		sr->h = dstrect->h = h;
+		return 1;
 	}
 	dstrect->w = dstrect->h = 0;
 	return 0;
 }
 
+int SDL_UpperBlit (SDL_Surface *src, SDL_Rect *srcrect,
+		   SDL_Surface *dst, SDL_Rect *dstrect)
+{
+        SDL_Rect fulldst;
+	SDL_Rect sr;
+
+	/* Make sure the surfaces aren't locked */
+	if ( ! src || ! dst ) {
+		SDL_SetError("SDL_UpperBlit: passed a NULL surface");
+		return(-1);
+	}
+	if ( src->locked || dst->locked ) {
+		SDL_SetError("Surfaces must not be locked during blit");
+		return(-1);
+	}
+
+	/* If the destination rectangle is NULL, use the entire dest surface */
+	if ( dstrect == NULL ) {
+	        fulldst.x = fulldst.y = 0;
+		dstrect = &fulldst;
+	}
+
+	if ( SDL_ClipBlit(src, srcrect, dst, dstrect, &sr) ) {
+		return SDL_LowerBlit(src, &sr, dst, dstrect);
+	}
+	return 0;
+}
+
+/*
+ * Order 'n' pairs of source and destination rectangles by destination row
+ * into 'sorted', keeping the order of pairs on the same row.  This is a
+ * counting sort, a comparison sort costs more than blitting small sprites.
+ * The row counts are kept on the blit map from one batch to the next.
+ */
+static int SDL_SortBatchRows (SDL_Surface *src, SDL_Surface *dst,
+			      SDL_Rect *rects, int n, SDL_Rect *sorted)
+{
+	struct private_swaccel *sw = src->map->sw_data;
+	int *rows;
+	int i, y, count;
+
+	if ( sw->batch_maxrows < dst->h+1 ) {
+		rows = (int *)SDL_realloc(sw->batch_rows,
+		                          (dst->h+1)*sizeof(int));
+		if ( rows == NULL ) {
+			SDL_OutOfMemory();
+			return(-1);
+		}
+		sw->batch_rows = rows;
+		sw->batch_maxrows = dst->h+1;
+	}
+	rows = sw->batch_rows;
+	SDL_memset(rows, 0, (dst->h+1)*sizeof(int));
+	for ( i = 0; i < n; ++i ) {
+		++rows[rects[2*i+1].y + 1];
+	}
+	for ( y = 1; y <= dst->h; ++y ) {
+		rows[y] += rows[y-1];
+	}
+	for ( i = 0; i < n; ++i ) {
+		count = rows[rects[2*i+1].y]++;
+		sorted[2*count] = rects[2*i];
+		sorted[2*count+1] = rects[2*i+1];
+	}
+	return(0);
+}
+
+int SDL_BlitSurfaceBatch (SDL_Surface *src, SDL_Rect *srcrects,
+			  SDL_Surface *dst, SDL_Rect *dstpoints,
+			  int n, Uint32 flags)
+{
+	SDL_Rect *rects, *blits;
+	int i, count, retval;
+
+	/* Make sure the surfaces aren't locked */
+	if ( ! src || ! dst || ! dstpoints ) {
+		SDL_SetError("SDL_BlitSurfaceBatch: passed a NULL pointer");
+		return(-1);
+	}
+	if ( src->locked || dst->locked ) {
+		SDL_SetError("Surfaces must not be locked during blit");
+		return(-1);
+	}
+	if ( n <= 0 ) {
+		return(0);
+	}
+
+	/* Check to make sure the blit mapping is valid */
+	if ( (src->map->dst != dst) ||
+             (src->map->dst->format_version != src->map->format_version) ) {
+		if ( SDL_MapSurface(src, dst) < 0 ) {
+			return(-1);
+		}
+	}
+
+	/* Clip everything first, as pairs of source and destination, with
+	   room for sorting them */
+	rects = (SDL_Rect *)SDL_malloc(((flags & SDL_BLITBATCH_SORT) ? 4 : 2)*
+	                               n*sizeof(SDL_Rect));
+	if ( rects == NULL ) {
+		SDL_OutOfMemory();
+		return(-1);
+	}
+	count = 0;
+	for ( i = 0; i < n; ++i ) {
+		SDL_Rect *dr = &rects[2*count+1];
+
+		dr->x = dstpoints[i].x;
+		dr->y = dstpoints[i].y;
+		if ( SDL_ClipBlit(src, srcrects ? &srcrects[i] : NULL,
+		                  dst, dr, &rects[2*count]) ) {
+			++count;
+		}
+	}
+	blits = rects;
+	if ( flags & SDL_BLITBATCH_SORT ) {
+		blits = &rects[2*n];
+		if ( SDL_SortBatchRows(src, dst, rects, count, blits) < 0 ) {
+			SDL_free(rects);
+			return(-1);
+		}
+	}
+
+	if ( (src->flags & SDL_HWACCEL) == SDL_HWACCEL ) {
+		retval = 0;
+		for ( i = 0; i < count && retval == 0; ++i ) {
+			retval = SDL_LowerBlit(src, &blits[2*i],
+			                       dst, &blits[2*i+1]);
+		}
+	} else {
+		if ( src->map->sw_data->rle_blit ) {
+			SDL_CheckRLE(src, count);
+		}
+		retval = SDL_SoftBlitBatch(src, dst, blits, count);
+	}
+	SDL_free(rects);
+	return(retval);
+}
+
 static int SDL_FillRect1(SDL_Surface *dst, SDL_Rect *dstrect, Uint32 color)
 {
 	/* FIXME: We have to worry about packing order.. *sigh* */
@@ -556,6 +684,7 @@ int SDL_FillRect(SDL_Surface *dst, SDL_Rect *dstrect, Uint32 color)
 	SDL_VideoDevice *this  = current_video;
 	int x, y;
 	Uint8 *row;
+	SDL_BlitTime start = 0;
 
 	/* This function doesn't work on surfaces < 8 bpp */
 	if ( dst->format->BitsPerPixel < 8 ) {
@@ -600,6 +729,9 @@ int SDL_FillRect(SDL_Surface *dst, SDL_Rect *dstrect, Uint32 color)
 	if ( SDL_LockSurface(dst) != 0 ) {
 		return(-1);
 	}
+	if ( SDL_blit_stats ) {
+		start = SDL_StartBlitStats();
+	}
 	row = (Uint8 *)dst->pixels+dstrect->y*dst->pitch+
 			dstrect->x*dst->format->BytesPerPixel;
 	if ( dst->format->palette || (color == 0) ) {
@@ -727,6 +859,10 @@ int SDL_FillRect(SDL_Surface *dst, SDL_Rect *dstrect, Uint32 color)
 			break;
 		}
 	}
+	if ( SDL_blit_stats ) {
+		SDL_AddBlitStats("FillRect", NULL, dst->format,
+		                 dstrect->w, dstrect->h, start);
+	}
 	SDL_UnlockSurface(dst);
 
 	/* We're done! */
@@ -734,9 +870,10 @@ int SDL_FillRect(SDL_Surface *dst, SDL_Rect *dstrect, Uint32 color)
 }
 
 /*
- * Lock a surface to directly access the pixels
+ * Lock a surface to directly access the pixels, only for reading them
+ * if 'readonly' is set
  */
-int SDL_LockSurface (SDL_Surface *surface)
+static int SDL_DoLockSurface (SDL_Surface *surface, int readonly)
 {
 	if ( ! surface->locked ) {
 		/* Perform the lock */
@@ -748,11 +885,23 @@ int SDL_LockSurface (SDL_Surface *surface)
 			}
 		}
 		if ( surface->flags & SDL_RLEACCEL ) {
-			SDL_UnRLESurface(surface, 1);
-			surface->flags |= SDL_RLEACCEL;	/* save accel'd state */
+			/* Keep the encoding if the pixels won't change */
+			if ( readonly && (SDL_RLEDecode(surface) == 0) ) {
+				surface->map->sw_data->rle_readonly = 1;
+			} else {
+				SDL_UnRLESurface(surface, 1);
+				surface->flags |= SDL_RLEACCEL;	/* save accel'd state */
+				surface->map->sw_data->rle_readonly = 0;
+			}
 		}
 		/* This needs to be done here in case pixels changes value */
 		surface->pixels = (Uint8 *)surface->pixels + surface->offset;
+	} else if ( !readonly && (surface->flags & SDL_RLEACCEL) &&
+	            surface->map->sw_data->rle_readonly ) {
+		/* The encoding is out of date once the pixels change */
+		SDL_UnRLESurface(surface, 1);
+		surface->flags |= SDL_RLEACCEL;	/* save accel'd state */
+		surface->map->sw_data->rle_readonly = 0;
 	}
 
 	/* Increment the surface lock count, for recursive locks */
@@ -761,6 +910,14 @@ int SDL_LockSurface (SDL_Surface *surface)
 	/* Ready to go.. */
 	return(0);
 }
+int SDL_LockSurface (SDL_Surface *surface)
+{
+	return(SDL_DoLockSurface(surface, 0));
+}
+int SDL_LockSurfaceReadOnly (SDL_Surface *surface)
+{
+	return(SDL_DoLockSurface(surface, 1));
+}
 /*
  * Unlock a previously locked surface
  */
@@ -782,8 +939,13 @@ void SDL_UnlockSurface (SDL_Surface *surface)
 	} else {
 		/* Update RLE encoded surface with new data */
 		if ( (surface->flags & SDL_RLEACCEL) == SDL_RLEACCEL ) {
-		        surface->flags &= ~SDL_RLEACCEL; /* stop lying */
-			SDL_RLESurface(surface);
+			if ( surface->map->sw_data->rle_readonly ) {
+				/* The encoding is still good */
+				surface->map->sw_data->rle_readonly = 0;
+			} else {
+			        surface->flags &= ~SDL_RLEACCEL; /* stop lying */
+				SDL_RLESurface(surface);
+			}
 		}
 	}
 }
@@ -164,6 +164,11 @@ struct SDL_VideoDevice {
 	/* Get the gamma ramp */
 	int (*GetGammaRamp)(_THIS, Uint16 *ramp);
 
+	/* Lookup tables the driver applies while copying to the display,
+	   when there is no hardware gamma ramp.  SDL_SetGammaRamp() keeps
+	   them up to date if SetGammaRamp is NULL (see SDL_present_c.h). */
+	struct SDL_GammaLUT *gamma_lut;
+
 	/* * * */
 	/* OpenGL support */
 
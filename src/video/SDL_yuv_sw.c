@@ -85,7 +85,7 @@
 
 #include "SDL_video.h"
 #include "SDL_cpuinfo.h"
-#include "SDL_stretch_c.h"
+#include "SDL_blit.h"
 #include "SDL_yuvfuncs.h"
 #include "SDL_yuv_sw_c.h"
 
@@ -99,7 +99,6 @@ static struct private_yuvhwfuncs sw_yuvfuncs = {
 
 /* RGB conversion lookup tables */
 struct private_yuvhwdata {
-	SDL_Surface *stretch;
 	SDL_Surface *display;
 	Uint8 *pixels;
 	int *colortab;
@@ -112,6 +111,16 @@ struct private_yuvhwdata {
 	                  unsigned char *lum, unsigned char *cr,
                           unsigned char *cb, unsigned char *out,
                           int rows, int cols, int mod );
+	/* The YUY2 1X converter for the display, for scaled rows */
+	void (*DisplayPacked)(int *colortab, Uint32 *rgb_2_pix,
+	                      unsigned char *lum, unsigned char *cr,
+	                      unsigned char *cb, unsigned char *out,
+	                      int rows, int cols, int mod );
+
+	/* The column tables and row caches of SDL_ScaleYUV(), kept from
+	   one frame to the next */
+	Uint8 *scalebuf;
+	int scalebuflen;
 
 	/* These are just so we don't have to allocate them separately */
 	Uint16 pitches[3];
@@ -132,10 +141,10 @@ extern void ColorRGBDitherYV12MMX1X( int *colortab, Uint32 *rgb_2_pix,
                                      int rows, int cols, int mod );
 #endif 
 
-static void Color16DitherYV12Mod1X( int *colortab, Uint32 *rgb_2_pix,
-                                    unsigned char *lum, unsigned char *cr,
-                                    unsigned char *cb, unsigned char *out,
-                                    int rows, int cols, int mod )
+static void Color16DitherPlanarMod1X( int *colortab, Uint32 *rgb_2_pix,
+                                      unsigned char *lum, unsigned char *cr,
+                                      unsigned char *cb, unsigned char *out,
+                                      int rows, int cols, int mod, int cstep )
 {
     unsigned short* row1;
     unsigned short* row2;
@@ -164,7 +173,7 @@ static void Color16DitherYV12Mod1X( int *colortab, Uint32 *rgb_2_pix,
             crb_g  = 1*768+256 + colortab[ *cr + 1*256 ]
                                + colortab[ *cb + 2*256 ];
             cb_b   = 2*768+256 + colortab[ *cb + 3*256 ];
-            ++cr; ++cb;
+            cr += cstep; cb += cstep;
 
             L = *lum++;
             *row1++ = (unsigned short)(rgb_2_pix[ L + cr_r ] |
@@ -202,10 +211,10 @@ static void Color16DitherYV12Mod1X( int *colortab, Uint32 *rgb_2_pix,
     }
 }
 
-static void Color24DitherYV12Mod1X( int *colortab, Uint32 *rgb_2_pix,
-                                    unsigned char *lum, unsigned char *cr,
-                                    unsigned char *cb, unsigned char *out,
-                                    int rows, int cols, int mod )
+static void Color24DitherPlanarMod1X( int *colortab, Uint32 *rgb_2_pix,
+                                      unsigned char *lum, unsigned char *cr,
+                                      unsigned char *cb, unsigned char *out,
+                                      int rows, int cols, int mod, int cstep )
 {
     unsigned int value;
     unsigned char* row1;
@@ -236,7 +245,7 @@ static void Color24DitherYV12Mod1X( int *colortab, Uint32 *rgb_2_pix,
             crb_g  = 1*768+256 + colortab[ *cr + 1*256 ]
                                + colortab[ *cb + 2*256 ];
             cb_b   = 2*768+256 + colortab[ *cb + 3*256 ];
-            ++cr; ++cb;
+            cr += cstep; cb += cstep;
 
             L = *lum++;
             value = (rgb_2_pix[ L + cr_r ] |
@@ -286,10 +295,10 @@ static void Color24DitherYV12Mod1X( int *colortab, Uint32 *rgb_2_pix,
     }
 }
 
-static void Color32DitherYV12Mod1X( int *colortab, Uint32 *rgb_2_pix,
-                                    unsigned char *lum, unsigned char *cr,
-                                    unsigned char *cb, unsigned char *out,
-                                    int rows, int cols, int mod )
+static void Color32DitherPlanarMod1X( int *colortab, Uint32 *rgb_2_pix,
+                                      unsigned char *lum, unsigned char *cr,
+                                      unsigned char *cb, unsigned char *out,
+                                      int rows, int cols, int mod, int cstep )
 {
     unsigned int* row1;
     unsigned int* row2;
@@ -318,7 +327,7 @@ static void Color32DitherYV12Mod1X( int *colortab, Uint32 *rgb_2_pix,
             crb_g  = 1*768+256 + colortab[ *cr + 1*256 ]
                                + colortab[ *cb + 2*256 ];
             cb_b   = 2*768+256 + colortab[ *cb + 3*256 ];
-            ++cr; ++cb;
+            cr += cstep; cb += cstep;
 
             L = *lum++;
             *row1++ = (rgb_2_pix[ L + cr_r ] |
@@ -361,10 +370,10 @@ static void Color32DitherYV12Mod1X( int *colortab, Uint32 *rgb_2_pix,
  * 16 bits replicated in the upper 16. This means I can write ints and get
  * the horisontal doubling for free (almost).
  */
-static void Color16DitherYV12Mod2X( int *colortab, Uint32 *rgb_2_pix,
-                                    unsigned char *lum, unsigned char *cr,
-                                    unsigned char *cb, unsigned char *out,
-                                    int rows, int cols, int mod )
+static void Color16DitherPlanarMod2X( int *colortab, Uint32 *rgb_2_pix,
+                                      unsigned char *lum, unsigned char *cr,
+                                      unsigned char *cb, unsigned char *out,
+                                      int rows, int cols, int mod, int cstep )
 {
     unsigned int* row1 = (unsigned int*) out;
     const int next_row = cols+(mod/2);
@@ -392,7 +401,7 @@ static void Color16DitherYV12Mod2X( int *colortab, Uint32 *rgb_2_pix,
             crb_g  = 1*768+256 + colortab[ *cr + 1*256 ]
                                + colortab[ *cb + 2*256 ];
             cb_b   = 2*768+256 + colortab[ *cb + 3*256 ];
-            ++cr; ++cb;
+            cr += cstep; cb += cstep;
 
             L = *lum++;
             row1[0] = row1[next_row] = (rgb_2_pix[ L + cr_r ] |
@@ -434,10 +443,10 @@ static void Color16DitherYV12Mod2X( int *colortab, Uint32 *rgb_2_pix,
     }
 }
 
-static void Color24DitherYV12Mod2X( int *colortab, Uint32 *rgb_2_pix,
-                                    unsigned char *lum, unsigned char *cr,
-                                    unsigned char *cb, unsigned char *out,
-                                    int rows, int cols, int mod )
+static void Color24DitherPlanarMod2X( int *colortab, Uint32 *rgb_2_pix,
+                                      unsigned char *lum, unsigned char *cr,
+                                      unsigned char *cb, unsigned char *out,
+                                      int rows, int cols, int mod, int cstep )
 {
     unsigned int value;
     unsigned char* row1 = out;
@@ -466,7 +475,7 @@ static void Color24DitherYV12Mod2X( int *colortab, Uint32 *rgb_2_pix,
             crb_g  = 1*768+256 + colortab[ *cr + 1*256 ]
                                + colortab[ *cb + 2*256 ];
             cb_b   = 2*768+256 + colortab[ *cb + 3*256 ];
-            ++cr; ++cb;
+            cr += cstep; cb += cstep;
 
             L = *lum++;
             value = (rgb_2_pix[ L + cr_r ] |
@@ -532,10 +541,10 @@ static void Color24DitherYV12Mod2X( int *colortab, Uint32 *rgb_2_pix,
     }
 }
 
-static void Color32DitherYV12Mod2X( int *colortab, Uint32 *rgb_2_pix,
-                                    unsigned char *lum, unsigned char *cr,
-                                    unsigned char *cb, unsigned char *out,
-                                    int rows, int cols, int mod )
+static void Color32DitherPlanarMod2X( int *colortab, Uint32 *rgb_2_pix,
+                                      unsigned char *lum, unsigned char *cr,
+                                      unsigned char *cb, unsigned char *out,
+                                      int rows, int cols, int mod, int cstep )
 {
     unsigned int* row1 = (unsigned int*) out;
     const int next_row = cols*2+mod;
@@ -563,7 +572,7 @@ static void Color32DitherYV12Mod2X( int *colortab, Uint32 *rgb_2_pix,
             crb_g  = 1*768+256 + colortab[ *cr + 1*256 ]
                                + colortab[ *cb + 2*256 ];
             cb_b   = 2*768+256 + colortab[ *cb + 3*256 ];
-            ++cr; ++cb;
+            cr += cstep; cb += cstep;
 
             L = *lum++;
             row1[0] = row1[1] = row1[next_row] = row1[next_row+1] =
@@ -609,6 +618,30 @@ static void Color32DitherYV12Mod2X( int *colortab, Uint32 *rgb_2_pix,
     }
 }
 
+/* The planar converters above, for chroma planes of their own (YV12 and
+   IYUV) and for Cb and Cr interleaved in one plane (NV12 and NV21) */
+#define YUV_PLANAR_CONVERTER(name, kernel, cstep) \
+static void name( int *colortab, Uint32 *rgb_2_pix, \
+                  unsigned char *lum, unsigned char *cr, \
+                  unsigned char *cb, unsigned char *out, \
+                  int rows, int cols, int mod ) \
+{ \
+    kernel(colortab, rgb_2_pix, lum, cr, cb, out, rows, cols, mod, cstep); \
+}
+
+YUV_PLANAR_CONVERTER(Color16DitherYV12Mod1X, Color16DitherPlanarMod1X, 1)
+YUV_PLANAR_CONVERTER(Color16DitherYV12Mod2X, Color16DitherPlanarMod2X, 1)
+YUV_PLANAR_CONVERTER(Color24DitherYV12Mod1X, Color24DitherPlanarMod1X, 1)
+YUV_PLANAR_CONVERTER(Color24DitherYV12Mod2X, Color24DitherPlanarMod2X, 1)
+YUV_PLANAR_CONVERTER(Color32DitherYV12Mod1X, Color32DitherPlanarMod1X, 1)
+YUV_PLANAR_CONVERTER(Color32DitherYV12Mod2X, Color32DitherPlanarMod2X, 1)
+YUV_PLANAR_CONVERTER(Color16DitherNV12Mod1X, Color16DitherPlanarMod1X, 2)
+YUV_PLANAR_CONVERTER(Color16DitherNV12Mod2X, Color16DitherPlanarMod2X, 2)
+YUV_PLANAR_CONVERTER(Color24DitherNV12Mod1X, Color24DitherPlanarMod1X, 2)
+YUV_PLANAR_CONVERTER(Color24DitherNV12Mod2X, Color24DitherPlanarMod2X, 2)
+YUV_PLANAR_CONVERTER(Color32DitherNV12Mod1X, Color32DitherPlanarMod1X, 2)
+YUV_PLANAR_CONVERTER(Color32DitherNV12Mod2X, Color32DitherPlanarMod2X, 2)
+
 static void Color16DitherYUY2Mod1X( int *colortab, Uint32 *rgb_2_pix,
                                     unsigned char *lum, unsigned char *cr,
                                     unsigned char *cb, unsigned char *out,
@@ -791,7 +824,7 @@ static void Color16DitherYUY2Mod2X( int *colortab, Uint32 *rgb_2_pix,
             row++;
 
         }
-        row += next_row;
+        row += next_row + (mod/2);
     }
 }
 
@@ -847,7 +880,7 @@ static void Color24DitherYUY2Mod2X( int *colortab, Uint32 *rgb_2_pix,
             row += 2*3;
 
         }
-        row += next_row;
+        row += next_row + mod*3;
     }
 }
 
@@ -863,7 +896,6 @@ static void Color32DitherYUY2Mod2X( int *colortab, Uint32 *rgb_2_pix,
     int crb_g;
     int cb_b;
     int cols_2 = cols / 2;
-    mod+=mod;
     y = rows;
     while( y-- )
     {
@@ -895,7 +927,7 @@ static void Color32DitherYUY2Mod2X( int *colortab, Uint32 *rgb_2_pix,
 
         }
 
-        row += next_row;
+        row += next_row + mod;
     }
 }
 
@@ -922,6 +954,693 @@ static int free_bits_at_bottom( Uint32 a )
     return 1 + free_bits_at_bottom ( a >> 1);
 }
 
+#if SSE2_BLITTERS || NEON_BLITTERS
+
+/*
+ * The SSE2 and NEON converters give exactly what the C ones above give
+ * for 16 and 32 bit pixels with at most 8 bits a channel.  The chroma
+ * terms of the colortab are (int)(k * (c-128)), which single precision
+ * floats reproduce for every c, and the sums are clamped to 0..255 like
+ * the ends of the rgb_2_pix tables clamp them.  The channel masks are
+ * read back from the table entries for 255.  16 pixels are converted at
+ * a time, the pixels left at the end of a row are done from the tables.
+ */
+#define YUV_CR_R	((float)(0.419/0.299))
+#define YUV_CR_G	((float)-(0.299/0.419))
+#define YUV_CB_G	((float)-(0.114/0.331))
+#define YUV_CB_B	((float)(0.587/0.331))
+
+typedef void (*SDL_YUVConvert)(int *colortab, Uint32 *rgb_2_pix,
+                               unsigned char *lum, unsigned char *cr,
+                               unsigned char *cb, unsigned char *out,
+                               int rows, int cols, int mod );
+
+/* Whether the vector converters can write pixels of this format */
+static int YUVVectorFormat( SDL_PixelFormat *format )
+{
+    if ( (format->BytesPerPixel != 2) && (format->BytesPerPixel != 4) ) {
+        return 0;
+    }
+    return (number_of_bits_set(format->Rmask) <= 8) &&
+           (number_of_bits_set(format->Gmask) <= 8) &&
+           (number_of_bits_set(format->Bmask) <= 8);
+}
+
+/* The loss and shift of R, G and B in the pixels of the tables */
+static void YUVChannels( Uint32 *rgb_2_pix, int bpp, int *loss, int *shift )
+{
+    int i;
+
+    for ( i = 0; i < 3; ++i ) {
+        Uint32 mask = rgb_2_pix[i*768 + 511];
+
+        if ( bpp == 2 ) {
+            mask &= 0xFFFF;
+        }
+        loss[i] = 8 - number_of_bits_set(mask);
+        shift[i] = free_bits_at_bottom(mask);
+    }
+}
+
+/* Pairs of pixels at the end of a row, from the tables.  The luma
+   advances 'lstep' bytes a pixel and the chroma 'cstep' bytes a pair,
+   and each pixel is written 'scale' times, also at out+next if next
+   isn't 0. */
+static void YUVTail( int *colortab, Uint32 *rgb_2_pix,
+                     unsigned char *lum, unsigned char *cr,
+                     unsigned char *cb, int lstep, int cstep,
+                     unsigned char *out, int next, int pairs,
+                     int bpp, int scale )
+{
+    int cr_r;
+    int crb_g;
+    int cb_b;
+    int i, j;
+
+    while( pairs-- )
+    {
+        cr_r   = 0*768+256 + colortab[ *cr + 0*256 ];
+        crb_g  = 1*768+256 + colortab[ *cr + 1*256 ]
+                           + colortab[ *cb + 2*256 ];
+        cb_b   = 2*768+256 + colortab[ *cb + 3*256 ];
+        cr += cstep; cb += cstep;
+
+        for ( i = 0; i < 2; ++i ) {
+            register int L = *lum;
+            Uint32 value = (rgb_2_pix[ L + cr_r ] |
+                            rgb_2_pix[ L + crb_g ] |
+                            rgb_2_pix[ L + cb_b ]);
+            lum += lstep;
+
+            for ( j = 0; j < scale; ++j ) {
+                if ( bpp == 2 ) {
+                    *(Uint16 *)out = (Uint16)value;
+                    if ( next ) {
+                        *(Uint16 *)(out + next) = (Uint16)value;
+                    }
+                } else {
+                    *(Uint32 *)out = value;
+                    if ( next ) {
+                        *(Uint32 *)(out + next) = value;
+                    }
+                }
+                out += bpp;
+            }
+        }
+    }
+}
+
+/* The byte offsets of the luma and the chroma in the pairs of pixels of
+   a packed overlay, from the pointers DisplayYUV_SW passes */
+static unsigned char *YUVPackedBase( unsigned char *lum, unsigned char *cr,
+                                 unsigned char *cb, int *offsets )
+{
+    unsigned char *base = lum;
+
+    if ( cr < base ) base = cr;
+    if ( cb < base ) base = cb;
+    offsets[0] = lum - base;
+    offsets[1] = cr - base;
+    offsets[2] = cb - base;
+    return base;
+}
+
+#endif /* SSE2_BLITTERS || NEON_BLITTERS */
+
+#if SSE2_BLITTERS
+SDL_BEGIN_SSE2
+
+typedef struct {
+    __m128i loss[3];
+    __m128i shift[3];
+} YUVShiftsSSE2;
+
+static void YUVShiftsSSE2Init( Uint32 *rgb_2_pix, int bpp, YUVShiftsSSE2 *sh )
+{
+    int loss[3], shift[3];
+    int i;
+
+    YUVChannels(rgb_2_pix, bpp, loss, shift);
+    for ( i = 0; i < 3; ++i ) {
+        sh->loss[i] = _mm_cvtsi32_si128(loss[i]);
+        sh->shift[i] = _mm_cvtsi32_si128(shift[i]);
+    }
+}
+
+/* (int)(k * c) for 8 chroma values less 128 */
+static __inline__ __m128i YUVTermSSE2( __m128 lo, __m128 hi, float k )
+{
+    const __m128 K = _mm_set1_ps(k);
+
+    return _mm_packs_epi32(_mm_cvttps_epi32(_mm_mul_ps(lo, K)),
+                           _mm_cvttps_epi32(_mm_mul_ps(hi, K)));
+}
+
+/* The R, G and B terms of 8 pairs of pixels */
+static __inline__ void YUVChromaSSE2( __m128i cr, __m128i cb,
+                                      __m128i *r, __m128i *g, __m128i *b )
+{
+    const __m128i c128 = _mm_set1_epi16(128);
+    __m128 crl, crh, cbl, cbh;
+
+    cr = _mm_sub_epi16(cr, c128);
+    cb = _mm_sub_epi16(cb, c128);
+    crl = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(cr, cr), 16));
+    crh = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(cr, cr), 16));
+    cbl = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(cb, cb), 16));
+    cbh = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(cb, cb), 16));
+    *r = YUVTermSSE2(crl, crh, YUV_CR_R);
+    *g = _mm_add_epi16(YUVTermSSE2(crl, crh, YUV_CR_G),
+                       YUVTermSSE2(cbl, cbh, YUV_CB_G));
+    *b = YUVTermSSE2(cbl, cbh, YUV_CB_B);
+}
+
+static __inline__ __m128i YUVPack16SSE2( __m128i r, __m128i g, __m128i b,
+                                         const YUVShiftsSSE2 *sh )
+{
+    r = _mm_sll_epi16(_mm_srl_epi16(r, sh->loss[0]), sh->shift[0]);
+    g = _mm_sll_epi16(_mm_srl_epi16(g, sh->loss[1]), sh->shift[1]);
+    b = _mm_sll_epi16(_mm_srl_epi16(b, sh->loss[2]), sh->shift[2]);
+    return _mm_or_si128(_mm_or_si128(r, g), b);
+}
+
+static __inline__ __m128i YUVPack32SSE2( __m128i r, __m128i g, __m128i b,
+                                         const YUVShiftsSSE2 *sh )
+{
+    r = _mm_sll_epi32(_mm_srl_epi32(r, sh->loss[0]), sh->shift[0]);
+    g = _mm_sll_epi32(_mm_srl_epi32(g, sh->loss[1]), sh->shift[1]);
+    b = _mm_sll_epi32(_mm_srl_epi32(b, sh->loss[2]), sh->shift[2]);
+    return _mm_or_si128(_mm_or_si128(r, g), b);
+}
+
+/* Write 16 pixels from their luma in y0 and y1 and the chroma terms of
+   their 8 pairs */
+static __inline__ void YUVStoreSSE2( __m128i y0, __m128i y1,
+                                     __m128i r, __m128i g, __m128i b,
+                                     const YUVShiftsSSE2 *sh,
+                                     unsigned char *out, int next,
+                                     int bpp, int scale )
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i max = _mm_set1_epi16(255);
+    __m128i R0, G0, B0, R1, G1, B1;
+    __m128i pix[8];
+    int i, n;
+
+#define YUV_CLAMP(v)	_mm_min_epi16(_mm_max_epi16(v, zero), max)
+    R0 = YUV_CLAMP(_mm_add_epi16(y0, _mm_unpacklo_epi16(r, r)));
+    R1 = YUV_CLAMP(_mm_add_epi16(y1, _mm_unpackhi_epi16(r, r)));
+    G0 = YUV_CLAMP(_mm_add_epi16(y0, _mm_unpacklo_epi16(g, g)));
+    G1 = YUV_CLAMP(_mm_add_epi16(y1, _mm_unpackhi_epi16(g, g)));
+    B0 = YUV_CLAMP(_mm_add_epi16(y0, _mm_unpacklo_epi16(b, b)));
+    B1 = YUV_CLAMP(_mm_add_epi16(y1, _mm_unpackhi_epi16(b, b)));
+#undef YUV_CLAMP
+
+    if ( bpp == 2 ) {
+        __m128i p0 = YUVPack16SSE2(R0, G0, B0, sh);
+        __m128i p1 = YUVPack16SSE2(R1, G1, B1, sh);
+
+        if ( scale == 2 ) {
+            pix[0] = _mm_unpacklo_epi16(p0, p0);
+            pix[1] = _mm_unpackhi_epi16(p0, p0);
+            pix[2] = _mm_unpacklo_epi16(p1, p1);
+            pix[3] = _mm_unpackhi_epi16(p1, p1);
+            n = 4;
+        } else {
+            pix[0] = p0;
+            pix[1] = p1;
+            n = 2;
+        }
+    } else {
+        __m128i q[4];
+
+        q[0] = YUVPack32SSE2(_mm_unpacklo_epi16(R0, zero),
+                             _mm_unpacklo_epi16(G0, zero),
+                             _mm_unpacklo_epi16(B0, zero), sh);
+        q[1] = YUVPack32SSE2(_mm_unpackhi_epi16(R0, zero),
+                             _mm_unpackhi_epi16(G0, zero),
+                             _mm_unpackhi_epi16(B0, zero), sh);
+        q[2] = YUVPack32SSE2(_mm_unpacklo_epi16(R1, zero),
+                             _mm_unpacklo_epi16(G1, zero),
+                             _mm_unpacklo_epi16(B1, zero), sh);
+        q[3] = YUVPack32SSE2(_mm_unpackhi_epi16(R1, zero),
+                             _mm_unpackhi_epi16(G1, zero),
+                             _mm_unpackhi_epi16(B1, zero), sh);
+        if ( scale == 2 ) {
+            for ( i = 0; i < 4; ++i ) {
+                pix[2*i] = _mm_unpacklo_epi32(q[i], q[i]);
+                pix[2*i+1] = _mm_unpackhi_epi32(q[i], q[i]);
+            }
+            n = 8;
+        } else {
+            for ( i = 0; i < 4; ++i ) {
+                pix[i] = q[i];
+            }
+            n = 4;
+        }
+    }
+    for ( i = 0; i < n; ++i ) {
+        _mm_storeu_si128((__m128i *)out + i, pix[i]);
+        if ( next ) {
+            _mm_storeu_si128((__m128i *)(out + next) + i, pix[i]);
+        }
+    }
+}
+
+/* Planar overlays, with the Cb and Cr interleaved if 'cstep' is 2 */
+static __inline__ void YUVPlanarSSE2( int *colortab, Uint32 *rgb_2_pix,
+                                      unsigned char *lum, unsigned char *cr,
+                                      unsigned char *cb, unsigned char *out,
+                                      int rows, int cols, int mod,
+                                      int bpp, int scale, int cstep )
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i cmask = _mm_set1_epi16(0xFF);
+    const __m128i crshift = _mm_cvtsi32_si128((cr > cb) * 8);
+    const __m128i cbshift = _mm_cvtsi32_si128((cb > cr) * 8);
+    unsigned char *chroma = (cr < cb) ? cr : cb;
+    const int pitch = (cols*scale + mod) * bpp;
+    const int next = (scale == 2) ? pitch : 0;
+    const int vcols = cols & ~15;
+    YUVShiftsSSE2 sh;
+    int x, y;
+
+    YUVShiftsSSE2Init(rgb_2_pix, bpp, &sh);
+
+    y = rows / 2;
+    while( y-- )
+    {
+        unsigned char *lum2 = lum + cols;
+        unsigned char *row1 = out;
+        unsigned char *row2 = out + scale*pitch;
+
+        for ( x = 0; x < vcols; x += 16 ) {
+            __m128i r, g, b, l;
+
+            if ( cstep == 2 ) {
+                __m128i c = _mm_loadu_si128((__m128i *)(chroma + x));
+
+                YUVChromaSSE2(_mm_and_si128(_mm_srl_epi16(c, crshift), cmask),
+                              _mm_and_si128(_mm_srl_epi16(c, cbshift), cmask),
+                              &r, &g, &b);
+            } else {
+                YUVChromaSSE2(
+                    _mm_unpacklo_epi8(_mm_loadl_epi64((__m128i *)(cr + x/2)), zero),
+                    _mm_unpacklo_epi8(_mm_loadl_epi64((__m128i *)(cb + x/2)), zero),
+                    &r, &g, &b);
+            }
+            l = _mm_loadu_si128((__m128i *)(lum + x));
+            YUVStoreSSE2(_mm_unpacklo_epi8(l, zero),
+                         _mm_unpackhi_epi8(l, zero), r, g, b, &sh,
+                         row1 + x*scale*bpp, next, bpp, scale);
+            l = _mm_loadu_si128((__m128i *)(lum2 + x));
+            YUVStoreSSE2(_mm_unpacklo_epi8(l, zero),
+                         _mm_unpackhi_epi8(l, zero), r, g, b, &sh,
+                         row2 + x*scale*bpp, next, bpp, scale);
+        }
+        YUVTail(colortab, rgb_2_pix, lum + x,
+                cr + x/2*cstep, cb + x/2*cstep, 1, cstep,
+                row1 + x*scale*bpp, next, (cols - x) / 2, bpp, scale);
+        YUVTail(colortab, rgb_2_pix, lum2 + x,
+                cr + x/2*cstep, cb + x/2*cstep, 1, cstep,
+                row2 + x*scale*bpp, next, (cols - x) / 2, bpp, scale);
+
+        lum += 2*cols;
+        cr += cols/2*cstep;
+        cb += cols/2*cstep;
+        chroma += cols/2*cstep;
+        out += 2*scale*pitch;
+    }
+}
+
+static __inline__ void YUVPackedSSE2( int *colortab, Uint32 *rgb_2_pix,
+                                      unsigned char *lum, unsigned char *cr,
+                                      unsigned char *cb, unsigned char *out,
+                                      int rows, int cols, int mod,
+                                      int bpp, int scale, int cstep )
+{
+    const __m128i lmask = _mm_set1_epi16(0xFF);
+    const __m128i cmask = _mm_set1_epi32(0xFF);
+    const int pitch = (cols*scale + mod) * bpp;
+    const int next = (scale == 2) ? pitch : 0;
+    const int vcols = cols & ~15;
+    __m128i lshift, crshift, cbshift;
+    YUVShiftsSSE2 sh;
+    unsigned char *base;
+    int offsets[3];
+    int x, y;
+
+    YUVShiftsSSE2Init(rgb_2_pix, bpp, &sh);
+    base = YUVPackedBase(lum, cr, cb, offsets);
+    lshift = _mm_cvtsi32_si128(offsets[0] * 8);
+    crshift = _mm_cvtsi32_si128(offsets[1] * 8);
+    cbshift = _mm_cvtsi32_si128(offsets[2] * 8);
+
+    y = rows;
+    while( y-- )
+    {
+        for ( x = 0; x < vcols; x += 16 ) {
+            __m128i a = _mm_loadu_si128((__m128i *)(base + 2*x));
+            __m128i c = _mm_loadu_si128((__m128i *)(base + 2*x + 16));
+            __m128i r, g, b;
+
+            YUVChromaSSE2(
+                _mm_packs_epi32(_mm_and_si128(_mm_srl_epi32(a, crshift), cmask),
+                                _mm_and_si128(_mm_srl_epi32(c, crshift), cmask)),
+                _mm_packs_epi32(_mm_and_si128(_mm_srl_epi32(a, cbshift), cmask),
+                                _mm_and_si128(_mm_srl_epi32(c, cbshift), cmask)),
+                &r, &g, &b);
+            YUVStoreSSE2(_mm_and_si128(_mm_srl_epi16(a, lshift), lmask),
+                         _mm_and_si128(_mm_srl_epi16(c, lshift), lmask),
+                         r, g, b, &sh, out + x*scale*bpp, next, bpp, scale);
+        }
+        YUVTail(colortab, rgb_2_pix, lum + 2*x, cr + 2*x, cb + 2*x, 2, cstep,
+                out + x*scale*bpp, next, (cols - x) / 2, bpp, scale);
+
+        lum += 2*cols;
+        cr += 2*cols;
+        cb += 2*cols;
+        base += 2*cols;
+        out += scale*pitch;
+    }
+}
+
+#define YUV_SSE2_CONVERTER(name, kernel, bpp, scale, cstep) \
+static void name( int *colortab, Uint32 *rgb_2_pix, \
+                  unsigned char *lum, unsigned char *cr, \
+                  unsigned char *cb, unsigned char *out, \
+                  int rows, int cols, int mod ) \
+{ \
+    kernel(colortab, rgb_2_pix, lum, cr, cb, out, rows, cols, mod, \
+           bpp, scale, cstep); \
+}
+
+YUV_SSE2_CONVERTER(Color16DitherYV12SSE2Mod1X, YUVPlanarSSE2, 2, 1, 1)
+YUV_SSE2_CONVERTER(Color16DitherYV12SSE2Mod2X, YUVPlanarSSE2, 2, 2, 1)
+YUV_SSE2_CONVERTER(Color32DitherYV12SSE2Mod1X, YUVPlanarSSE2, 4, 1, 1)
+YUV_SSE2_CONVERTER(Color32DitherYV12SSE2Mod2X, YUVPlanarSSE2, 4, 2, 1)
+YUV_SSE2_CONVERTER(Color16DitherNV12SSE2Mod1X, YUVPlanarSSE2, 2, 1, 2)
+YUV_SSE2_CONVERTER(Color16DitherNV12SSE2Mod2X, YUVPlanarSSE2, 2, 2, 2)
+YUV_SSE2_CONVERTER(Color32DitherNV12SSE2Mod1X, YUVPlanarSSE2, 4, 1, 2)
+YUV_SSE2_CONVERTER(Color32DitherNV12SSE2Mod2X, YUVPlanarSSE2, 4, 2, 2)
+YUV_SSE2_CONVERTER(Color16DitherYUY2SSE2Mod1X, YUVPackedSSE2, 2, 1, 4)
+YUV_SSE2_CONVERTER(Color16DitherYUY2SSE2Mod2X, YUVPackedSSE2, 2, 2, 4)
+YUV_SSE2_CONVERTER(Color32DitherYUY2SSE2Mod1X, YUVPackedSSE2, 4, 1, 4)
+YUV_SSE2_CONVERTER(Color32DitherYUY2SSE2Mod2X, YUVPackedSSE2, 4, 2, 4)
+
+/* [layout][32 bit][2x], the layouts are YV12, YUY2 and NV12 */
+static const SDL_YUVConvert yuv_sse2[3][2][2] = {
+    { { Color16DitherYV12SSE2Mod1X, Color16DitherYV12SSE2Mod2X },
+      { Color32DitherYV12SSE2Mod1X, Color32DitherYV12SSE2Mod2X } },
+    { { Color16DitherYUY2SSE2Mod1X, Color16DitherYUY2SSE2Mod2X },
+      { Color32DitherYUY2SSE2Mod1X, Color32DitherYUY2SSE2Mod2X } },
+    { { Color16DitherNV12SSE2Mod1X, Color16DitherNV12SSE2Mod2X },
+      { Color32DitherNV12SSE2Mod1X, Color32DitherNV12SSE2Mod2X } }
+};
+
+SDL_END_TARGET
+#endif /* SSE2_BLITTERS */
+
+#if NEON_BLITTERS
+SDL_BEGIN_NEON
+
+typedef struct {
+    int16x8_t loss[3];		/* Negative, for right shifts */
+    int16x8_t shift[3];
+    int32x4_t loss32[3];
+    int32x4_t shift32[3];
+} YUVShiftsNEON;
+
+static void YUVShiftsNEONInit( Uint32 *rgb_2_pix, int bpp, YUVShiftsNEON *sh )
+{
+    int loss[3], shift[3];
+    int i;
+
+    YUVChannels(rgb_2_pix, bpp, loss, shift);
+    for ( i = 0; i < 3; ++i ) {
+        sh->loss[i] = vdupq_n_s16(-loss[i]);
+        sh->shift[i] = vdupq_n_s16(shift[i]);
+        sh->loss32[i] = vdupq_n_s32(-loss[i]);
+        sh->shift32[i] = vdupq_n_s32(shift[i]);
+    }
+}
+
+/* (int)(k * c) for 8 chroma values less 128 */
+static __inline__ int16x8_t YUVTermNEON( float32x4_t lo, float32x4_t hi, float k )
+{
+    return vcombine_s16(vmovn_s32(vcvtq_s32_f32(vmulq_n_f32(lo, k))),
+                        vmovn_s32(vcvtq_s32_f32(vmulq_n_f32(hi, k))));
+}
+
+/* The R, G and B terms of 8 pairs of pixels */
+static __inline__ void YUVChromaNEON( uint8x8_t cr, uint8x8_t cb,
+                                      int16x8_t *r, int16x8_t *g, int16x8_t *b )
+{
+    const int16x8_t c128 = vdupq_n_s16(128);
+    int16x8_t crs = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(cr)), c128);
+    int16x8_t cbs = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(cb)), c128);
+    float32x4_t crl = vcvtq_f32_s32(vmovl_s16(vget_low_s16(crs)));
+    float32x4_t crh = vcvtq_f32_s32(vmovl_s16(vget_high_s16(crs)));
+    float32x4_t cbl = vcvtq_f32_s32(vmovl_s16(vget_low_s16(cbs)));
+    float32x4_t cbh = vcvtq_f32_s32(vmovl_s16(vget_high_s16(cbs)));
+
+    *r = YUVTermNEON(crl, crh, YUV_CR_R);
+    *g = vaddq_s16(YUVTermNEON(crl, crh, YUV_CR_G),
+                   YUVTermNEON(cbl, cbh, YUV_CB_G));
+    *b = YUVTermNEON(cbl, cbh, YUV_CB_B);
+}
+
+static __inline__ uint16x8_t YUVPack16NEON( uint16x8_t r, uint16x8_t g,
+                                            uint16x8_t b,
+                                            const YUVShiftsNEON *sh )
+{
+    r = vshlq_u16(vshlq_u16(r, sh->loss[0]), sh->shift[0]);
+    g = vshlq_u16(vshlq_u16(g, sh->loss[1]), sh->shift[1]);
+    b = vshlq_u16(vshlq_u16(b, sh->loss[2]), sh->shift[2]);
+    return vorrq_u16(vorrq_u16(r, g), b);
+}
+
+static __inline__ uint32x4_t YUVPack32NEON( uint16x4_t r, uint16x4_t g,
+                                            uint16x4_t b,
+                                            const YUVShiftsNEON *sh )
+{
+    uint32x4_t R = vshlq_u32(vshlq_u32(vmovl_u16(r), sh->loss32[0]), sh->shift32[0]);
+    uint32x4_t G = vshlq_u32(vshlq_u32(vmovl_u16(g), sh->loss32[1]), sh->shift32[1]);
+    uint32x4_t B = vshlq_u32(vshlq_u32(vmovl_u16(b), sh->loss32[2]), sh->shift32[2]);
+    return vorrq_u32(vorrq_u32(R, G), B);
+}
+
+static __inline__ void YUVStore16NEON( unsigned char *out, int next,
+                                       uint16x8_t p )
+{
+    vst1q_u16((Uint16 *)out, p);
+    if ( next ) {
+        vst1q_u16((Uint16 *)(out + next), p);
+    }
+}
+
+static __inline__ void YUVStore32NEON( unsigned char *out, int next,
+                                       uint32x4_t p )
+{
+    vst1q_u32((Uint32 *)out, p);
+    if ( next ) {
+        vst1q_u32((Uint32 *)(out + next), p);
+    }
+}
+
+/* Write 16 pixels from their luma and the chroma terms of their 8 pairs */
+static __inline__ void YUVStoreNEON( uint8x16_t l,
+                                     int16x8_t r, int16x8_t g, int16x8_t b,
+                                     const YUVShiftsNEON *sh,
+                                     unsigned char *out, int next,
+                                     int bpp, int scale )
+{
+    int16x8_t y0 = vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(l)));
+    int16x8_t y1 = vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(l)));
+    int16x8x2_t rr = vzipq_s16(r, r);
+    int16x8x2_t gg = vzipq_s16(g, g);
+    int16x8x2_t bb = vzipq_s16(b, b);
+    uint16x8_t R[2], G[2], B[2];
+    int i;
+
+    R[0] = vmovl_u8(vqmovun_s16(vaddq_s16(y0, rr.val[0])));
+    R[1] = vmovl_u8(vqmovun_s16(vaddq_s16(y1, rr.val[1])));
+    G[0] = vmovl_u8(vqmovun_s16(vaddq_s16(y0, gg.val[0])));
+    G[1] = vmovl_u8(vqmovun_s16(vaddq_s16(y1, gg.val[1])));
+    B[0] = vmovl_u8(vqmovun_s16(vaddq_s16(y0, bb.val[0])));
+    B[1] = vmovl_u8(vqmovun_s16(vaddq_s16(y1, bb.val[1])));
+
+    for ( i = 0; i < 2; ++i ) {
+        if ( bpp == 2 ) {
+            uint16x8_t p = YUVPack16NEON(R[i], G[i], B[i], sh);
+
+            if ( scale == 2 ) {
+                uint16x8x2_t d = vzipq_u16(p, p);
+
+                YUVStore16NEON(out, next, d.val[0]);
+                YUVStore16NEON(out + 16, next, d.val[1]);
+                out += 32;
+            } else {
+                YUVStore16NEON(out, next, p);
+                out += 16;
+            }
+        } else {
+            uint32x4_t lo = YUVPack32NEON(vget_low_u16(R[i]),
+                                          vget_low_u16(G[i]),
+                                          vget_low_u16(B[i]), sh);
+            uint32x4_t hi = YUVPack32NEON(vget_high_u16(R[i]),
+                                          vget_high_u16(G[i]),
+                                          vget_high_u16(B[i]), sh);
+
+            if ( scale == 2 ) {
+                uint32x4x2_t d = vzipq_u32(lo, lo);
+
+                YUVStore32NEON(out, next, d.val[0]);
+                YUVStore32NEON(out + 16, next, d.val[1]);
+                d = vzipq_u32(hi, hi);
+                YUVStore32NEON(out + 32, next, d.val[0]);
+                YUVStore32NEON(out + 48, next, d.val[1]);
+                out += 64;
+            } else {
+                YUVStore32NEON(out, next, lo);
+                YUVStore32NEON(out + 16, next, hi);
+                out += 32;
+            }
+        }
+    }
+}
+
+/* Planar overlays, with the Cb and Cr interleaved if 'cstep' is 2 */
+static __inline__ void YUVPlanarNEON( int *colortab, Uint32 *rgb_2_pix,
+                                      unsigned char *lum, unsigned char *cr,
+                                      unsigned char *cb, unsigned char *out,
+                                      int rows, int cols, int mod,
+                                      int bpp, int scale, int cstep )
+{
+    unsigned char *chroma = (cr < cb) ? cr : cb;
+    const int pitch = (cols*scale + mod) * bpp;
+    const int next = (scale == 2) ? pitch : 0;
+    const int vcols = cols & ~15;
+    YUVShiftsNEON sh;
+    int x, y;
+
+    YUVShiftsNEONInit(rgb_2_pix, bpp, &sh);
+
+    y = rows / 2;
+    while( y-- )
+    {
+        unsigned char *lum2 = lum + cols;
+        unsigned char *row1 = out;
+        unsigned char *row2 = out + scale*pitch;
+
+        for ( x = 0; x < vcols; x += 16 ) {
+            int16x8_t r, g, b;
+
+            if ( cstep == 2 ) {
+                uint8x8x2_t c = vld2_u8(chroma + x);
+
+                YUVChromaNEON(c.val[cr > cb], c.val[cb > cr], &r, &g, &b);
+            } else {
+                YUVChromaNEON(vld1_u8(cr + x/2), vld1_u8(cb + x/2),
+                              &r, &g, &b);
+            }
+            YUVStoreNEON(vld1q_u8(lum + x), r, g, b, &sh,
+                         row1 + x*scale*bpp, next, bpp, scale);
+            YUVStoreNEON(vld1q_u8(lum2 + x), r, g, b, &sh,
+                         row2 + x*scale*bpp, next, bpp, scale);
+        }
+        YUVTail(colortab, rgb_2_pix, lum + x,
+                cr + x/2*cstep, cb + x/2*cstep, 1, cstep,
+                row1 + x*scale*bpp, next, (cols - x) / 2, bpp, scale);
+        YUVTail(colortab, rgb_2_pix, lum2 + x,
+                cr + x/2*cstep, cb + x/2*cstep, 1, cstep,
+                row2 + x*scale*bpp, next, (cols - x) / 2, bpp, scale);
+
+        lum += 2*cols;
+        cr += cols/2*cstep;
+        cb += cols/2*cstep;
+        chroma += cols/2*cstep;
+        out += 2*scale*pitch;
+    }
+}
+
+static __inline__ void YUVPackedNEON( int *colortab, Uint32 *rgb_2_pix,
+                                      unsigned char *lum, unsigned char *cr,
+                                      unsigned char *cb, unsigned char *out,
+                                      int rows, int cols, int mod,
+                                      int bpp, int scale, int cstep )
+{
+    const int pitch = (cols*scale + mod) * bpp;
+    const int next = (scale == 2) ? pitch : 0;
+    const int vcols = cols & ~15;
+    YUVShiftsNEON sh;
+    unsigned char *base;
+    int offsets[3];
+    int x, y;
+
+    YUVShiftsNEONInit(rgb_2_pix, bpp, &sh);
+    base = YUVPackedBase(lum, cr, cb, offsets);
+
+    y = rows;
+    while( y-- )
+    {
+        for ( x = 0; x < vcols; x += 16 ) {
+            /* Byte i of each pair of pixels in val[i] */
+            uint8x8x4_t v = vld4_u8(base + 2*x);
+            uint8x8x2_t l = vzip_u8(v.val[offsets[0]], v.val[offsets[0] + 2]);
+            int16x8_t r, g, b;
+
+            YUVChromaNEON(v.val[offsets[1]], v.val[offsets[2]], &r, &g, &b);
+            YUVStoreNEON(vcombine_u8(l.val[0], l.val[1]), r, g, b, &sh,
+                         out + x*scale*bpp, next, bpp, scale);
+        }
+        YUVTail(colortab, rgb_2_pix, lum + 2*x, cr + 2*x, cb + 2*x, 2, cstep,
+                out + x*scale*bpp, next, (cols - x) / 2, bpp, scale);
+
+        lum += 2*cols;
+        cr += 2*cols;
+        cb += 2*cols;
+        base += 2*cols;
+        out += scale*pitch;
+    }
+}
+
+#define YUV_NEON_CONVERTER(name, kernel, bpp, scale, cstep) \
+static void name( int *colortab, Uint32 *rgb_2_pix, \
+                  unsigned char *lum, unsigned char *cr, \
+                  unsigned char *cb, unsigned char *out, \
+                  int rows, int cols, int mod ) \
+{ \
+    kernel(colortab, rgb_2_pix, lum, cr, cb, out, rows, cols, mod, \
+           bpp, scale, cstep); \
+}
+
+YUV_NEON_CONVERTER(Color16DitherYV12NEONMod1X, YUVPlanarNEON, 2, 1, 1)
+YUV_NEON_CONVERTER(Color16DitherYV12NEONMod2X, YUVPlanarNEON, 2, 2, 1)
+YUV_NEON_CONVERTER(Color32DitherYV12NEONMod1X, YUVPlanarNEON, 4, 1, 1)
+YUV_NEON_CONVERTER(Color32DitherYV12NEONMod2X, YUVPlanarNEON, 4, 2, 1)
+YUV_NEON_CONVERTER(Color16DitherNV12NEONMod1X, YUVPlanarNEON, 2, 1, 2)
+YUV_NEON_CONVERTER(Color16DitherNV12NEONMod2X, YUVPlanarNEON, 2, 2, 2)
+YUV_NEON_CONVERTER(Color32DitherNV12NEONMod1X, YUVPlanarNEON, 4, 1, 2)
+YUV_NEON_CONVERTER(Color32DitherNV12NEONMod2X, YUVPlanarNEON, 4, 2, 2)
+YUV_NEON_CONVERTER(Color16DitherYUY2NEONMod1X, YUVPackedNEON, 2, 1, 4)
+YUV_NEON_CONVERTER(Color16DitherYUY2NEONMod2X, YUVPackedNEON, 2, 2, 4)
+YUV_NEON_CONVERTER(Color32DitherYUY2NEONMod1X, YUVPackedNEON, 4, 1, 4)
+YUV_NEON_CONVERTER(Color32DitherYUY2NEONMod2X, YUVPackedNEON, 4, 2, 4)
+
+/* [layout][32 bit][2x], the layouts are YV12, YUY2 and NV12 */
+static const SDL_YUVConvert yuv_neon[3][2][2] = {
+    { { Color16DitherYV12NEONMod1X, Color16DitherYV12NEONMod2X },
+      { Color32DitherYV12NEONMod1X, Color32DitherYV12NEONMod2X } },
+    { { Color16DitherYUY2NEONMod1X, Color16DitherYUY2NEONMod2X },
+      { Color32DitherYUY2NEONMod1X, Color32DitherYUY2NEONMod2X } },
+    { { Color16DitherNV12NEONMod1X, Color16DitherNV12NEONMod2X },
+      { Color32DitherNV12NEONMod1X, Color32DitherNV12NEONMod2X } }
+};
+
+SDL_END_TARGET
+#endif /* NEON_BLITTERS */
+
 
 SDL_Overlay *SDL_CreateYUV_SW(_THIS, int width, int height, Uint32 format, SDL_Surface *display)
 {
@@ -953,6 +1672,8 @@ SDL_Overlay *SDL_CreateYUV_SW(_THIS, int width, int height, Uint32 format, SDL_S
 	    case SDL_YUY2_OVERLAY:
 	    case SDL_UYVY_OVERLAY:
 	    case SDL_YVYU_OVERLAY:
+	    case SDL_NV12_OVERLAY:
+	    case SDL_NV21_OVERLAY:
 		break;
 	    default:
 		SDL_SetError("Unsupported YUV format");
@@ -983,8 +1704,9 @@ SDL_Overlay *SDL_CreateYUV_SW(_THIS, int width, int height, Uint32 format, SDL_S
 		SDL_FreeYUVOverlay(overlay);
 		return(NULL);
 	}
-	swdata->stretch = NULL;
 	swdata->display = display;
+	swdata->scalebuf = NULL;
+	swdata->scalebuflen = 0;
 	swdata->pixels = (Uint8 *) SDL_malloc(width*height*2);
 	swdata->colortab = (int *)SDL_malloc(4*256*sizeof(int));
 	Cr_r_tab = &swdata->colortab[0*256];
@@ -1117,10 +1839,71 @@ SDL_Overlay *SDL_CreateYUV_SW(_THIS, int width, int height, Uint32 format, SDL_S
 			swdata->Display2X = Color32DitherYUY2Mod2X;
 		}
 		break;
+	    case SDL_NV12_OVERLAY:
+	    case SDL_NV21_OVERLAY:
+		if ( display->format->BytesPerPixel == 2 ) {
+			swdata->Display1X = Color16DitherNV12Mod1X;
+			swdata->Display2X = Color16DitherNV12Mod2X;
+		}
+		if ( display->format->BytesPerPixel == 3 ) {
+			swdata->Display1X = Color24DitherNV12Mod1X;
+			swdata->Display2X = Color24DitherNV12Mod2X;
+		}
+		if ( display->format->BytesPerPixel == 4 ) {
+			swdata->Display1X = Color32DitherNV12Mod1X;
+			swdata->Display2X = Color32DitherNV12Mod2X;
+		}
+		break;
 	    default:
 		/* We should never get here (caught above) */
 		break;
 	}
+	switch (display->format->BytesPerPixel) {
+	    case 2:
+		swdata->DisplayPacked = Color16DitherYUY2Mod1X;
+		break;
+	    case 3:
+		swdata->DisplayPacked = Color24DitherYUY2Mod1X;
+		break;
+	    default:
+		swdata->DisplayPacked = Color32DitherYUY2Mod1X;
+		break;
+	}
+#if SSE2_BLITTERS || NEON_BLITTERS
+	/* The vector converters are used over the C and MMX ones when they
+	   can write the display format */
+	if ( YUVVectorFormat(display->format) ) {
+		int layout;
+		int bpp32 = (display->format->BytesPerPixel == 4);
+
+		switch (format) {
+		    case SDL_YV12_OVERLAY:
+		    case SDL_IYUV_OVERLAY:
+			layout = 0;
+			break;
+		    case SDL_NV12_OVERLAY:
+		    case SDL_NV21_OVERLAY:
+			layout = 2;
+			break;
+		    default:
+			layout = 1;
+			break;
+		}
+#if SSE2_BLITTERS
+		if ( SDL_GetBlitFeatures() & SDL_BLIT_SSE2 ) {
+			swdata->Display1X = yuv_sse2[layout][bpp32][0];
+			swdata->Display2X = yuv_sse2[layout][bpp32][1];
+			swdata->DisplayPacked = yuv_sse2[1][bpp32][0];
+		}
+#else
+		if ( SDL_GetBlitFeatures() & SDL_BLIT_NEON ) {
+			swdata->Display1X = yuv_neon[layout][bpp32][0];
+			swdata->Display2X = yuv_neon[layout][bpp32][1];
+			swdata->DisplayPacked = yuv_neon[1][bpp32][0];
+		}
+#endif
+	}
+#endif
 
 	/* Find the pitch and offset values for the overlay */
 	overlay->pitches = swdata->pitches;
@@ -1145,6 +1928,15 @@ SDL_Overlay *SDL_CreateYUV_SW(_THIS, int width, int height, Uint32 format, SDL_S
 	        overlay->pixels[0] = swdata->pixels;
 		overlay->planes = 1;
 		break;
+	    case SDL_NV12_OVERLAY:
+	    case SDL_NV21_OVERLAY:
+		overlay->pitches[0] = overlay->w;
+		overlay->pitches[1] = overlay->w;
+	        overlay->pixels[0] = swdata->pixels;
+	        overlay->pixels[1] = overlay->pixels[0] +
+		                     overlay->pitches[0] * overlay->h;
+		overlay->planes = 2;
+		break;
 	    default:
 		/* We should never get here (caught above) */
 		break;
@@ -1164,10 +1956,401 @@ void SDL_UnlockYUV_SW(_THIS, SDL_Overlay *overlay)
 	return;
 }
 
+/* The rows of an overlay converted by each thread, see SDL_ThreadedBands() */
+typedef struct {
+	struct private_yuvhwdata *swdata;
+	void (*convert)(int *colortab, Uint32 *rgb_2_pix,
+	                unsigned char *lum, unsigned char *cr,
+	                unsigned char *cb, unsigned char *out,
+	                int rows, int cols, int mod );
+	Uint8 *lum, *Cr, *Cb;
+	Uint8 *dstp;
+	int planar;
+	int cols;
+	int chromapitch;	/* Of the planar ones */
+	int mod;
+	int dstpitch;	/* Bytes written for each row of the overlay */
+} SDL_YUVBands;
+
+static void SDL_ConvertYUVBand(void *data, int band, int y, int rows)
+{
+	SDL_YUVBands *bands = (SDL_YUVBands *)data;
+	int lumoff, chromaoff;
+
+	if ( bands->planar ) {
+		lumoff = y * bands->cols;
+		chromaoff = (y / 2) * bands->chromapitch;
+	} else {
+		lumoff = chromaoff = y * bands->cols * 2;
+	}
+	bands->convert(bands->swdata->colortab, bands->swdata->rgb_2_pix,
+	               bands->lum + lumoff,
+	               bands->Cr + chromaoff, bands->Cb + chromaoff,
+	               bands->dstp + y * bands->dstpitch,
+	               rows, bands->cols, bands->mod);
+}
+
+/* Other sizes, and clipped overlays, are scaled with a bilinear filter
+   and converted in one pass.  Each row of the destination is filtered
+   from the overlay into a row of YUY2 pixels, which the packed 1X
+   converter for the display writes straight out.  The chroma samples
+   sit between the luma samples they are shared by.
+*/
+
+/* One plane of the overlay, and the source samples it is filtered from */
+typedef struct {
+	Uint8 *pixels;		/* Sample 0 of row 0 */
+	int pitch;
+	int step;		/* Bytes from one sample to the next */
+	int *x0;		/* Left source sample of each filtered one */
+	Uint8 *fx;		/* Weight of the sample after x0 in 1/256ths */
+} SDL_YUVPlane;
+
+/* The last two source rows filtered across, as the luma (even bytes) or
+   the chroma (odd bytes) of a row of YUY2 pixels */
+typedef struct {
+	Uint8 *rows[2];
+	int ry[2];
+} SDL_YUVRows;
+
+/* Filter rows of YUY2 pixels down, the luma by 'fy' and the chroma by
+   'fcy', for 'n' bytes */
+typedef void (*SDL_YUVLerpV)(Uint8 *dst,
+                             const Uint8 *l0, const Uint8 *l1,
+                             const Uint8 *c0, const Uint8 *c1,
+                             int fy, int fcy, int n);
+
+/* A scaled display, shared by the threads */
+typedef struct {
+	struct private_yuvhwdata *swdata;
+	SDL_YUVPlane planes[3];	/* Y, Cr and Cb */
+	SDL_YUVLerpV lerpv;
+	int planar;		/* The chroma has half the rows */
+	int y, h;		/* Source rows */
+	int firstchroma, lastchroma;
+	int dst_w, dst_h;
+	int pairs;		/* Pairs of destination pixels, rounded up */
+	Uint8 *rowcache;	/* 5 rows of 'pairs' YUY2 pixels for each band */
+	Uint8 *dstp;
+	int dstpitch;
+	int bpp;
+} SDL_YUVScale;
+
+/* Sample 'pos' (16.16) between the samples 'first' and 'last' */
+static void SDL_YUVStep(int pos, int first, int last,
+                        int *i0, int *i1, Uint8 *frac)
+{
+	if ( pos < (first << 16) ) {
+		pos = first << 16;
+	}
+	*i0 = pos >> 16;
+	*frac = (Uint8)(pos >> 8);
+	if ( *i0 >= last ) {
+		*i0 = last;
+		*frac = 0;
+	}
+	*i1 = *i0 + (*frac != 0);
+}
+
+static __inline__ Uint8 SDL_YUVLerp(unsigned a, unsigned b, unsigned f)
+{
+	return (Uint8)((a * (256 - f) + b * f + 128) >> 8);
+}
+
+/* Filter 'n' samples of row 'y' of a plane across, into every 'step'
+   bytes of 'dst' */
+static void SDL_YUVLerpH(SDL_YUVPlane *plane, int y, Uint8 *dst, int step,
+                         int n)
+{
+	const Uint8 *src = plane->pixels + y * plane->pitch;
+	int i;
+
+	for ( i = 0; i < n; ++i ) {
+		const Uint8 *p = src + plane->x0[i] * plane->step;
+
+		if ( plane->fx[i] ) {
+			*dst = SDL_YUVLerp(p[0], p[plane->step], plane->fx[i]);
+		} else {
+			*dst = p[0];
+		}
+		dst += step;
+	}
+}
+
+/* Source row 'y' filtered across, 'keep' is a row that is still needed
+   and mustn't be thrown out of the cache */
+static Uint8 *SDL_YUVRow(SDL_YUVScale *scale, SDL_YUVRows *cache,
+                         int chroma, int y, int keep)
+{
+	Uint8 *row;
+	int k;
+
+	if ( cache->ry[0] == y ) {
+		return(cache->rows[0]);
+	}
+	if ( cache->ry[1] == y ) {
+		return(cache->rows[1]);
+	}
+	k = (cache->ry[0] == keep);
+	row = cache->rows[k];
+	if ( chroma ) {
+		SDL_YUVLerpH(&scale->planes[1], y, row + 3, 4, scale->pairs);
+		SDL_YUVLerpH(&scale->planes[2], y, row + 1, 4, scale->pairs);
+	} else {
+		SDL_YUVLerpH(&scale->planes[0], y, row, 2, scale->dst_w);
+	}
+	cache->ry[k] = y;
+	return(row);
+}
+
+static void SDL_YUVLerpVC(Uint8 *dst, const Uint8 *l0, const Uint8 *l1,
+                          const Uint8 *c0, const Uint8 *c1,
+                          int fy, int fcy, int n)
+{
+	int i;
+
+	for ( i = 0; i < n; i += 2 ) {
+		dst[i] = SDL_YUVLerp(l0[i], l1[i], fy);
+		dst[i+1] = SDL_YUVLerp(c0[i+1], c1[i+1], fcy);
+	}
+}
+
+#if SSE2_BLITTERS
+SDL_BEGIN_SSE2
+
+static void SDL_YUVLerpVSSE2(Uint8 *dst, const Uint8 *l0, const Uint8 *l1,
+                             const Uint8 *c0, const Uint8 *c1,
+                             int fy, int fcy, int n)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i lmask = _mm_set1_epi16(0x00FF);
+	const __m128i f = _mm_set1_epi32((fcy << 16) | fy);
+	const __m128i inv = _mm_sub_epi16(_mm_set1_epi16(256), f);
+	const __m128i round = _mm_set1_epi16(128);
+	int i;
+
+	for ( i = 0; i + 16 <= n; i += 16 ) {
+		__m128i a = _mm_or_si128(
+			_mm_and_si128(_mm_loadu_si128((const __m128i *)(l0 + i)), lmask),
+			_mm_andnot_si128(lmask, _mm_loadu_si128((const __m128i *)(c0 + i))));
+		__m128i b = _mm_or_si128(
+			_mm_and_si128(_mm_loadu_si128((const __m128i *)(l1 + i)), lmask),
+			_mm_andnot_si128(lmask, _mm_loadu_si128((const __m128i *)(c1 + i))));
+		__m128i lo = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(
+			_mm_mullo_epi16(_mm_unpacklo_epi8(a, zero), inv),
+			_mm_mullo_epi16(_mm_unpacklo_epi8(b, zero), f)), round), 8);
+		__m128i hi = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(
+			_mm_mullo_epi16(_mm_unpackhi_epi8(a, zero), inv),
+			_mm_mullo_epi16(_mm_unpackhi_epi8(b, zero), f)), round), 8);
+
+		_mm_storeu_si128((__m128i *)(dst + i), _mm_packus_epi16(lo, hi));
+	}
+	SDL_YUVLerpVC(dst + i, l0 + i, l1 + i, c0 + i, c1 + i, fy, fcy, n - i);
+}
+
+SDL_END_TARGET
+#endif /* SSE2_BLITTERS */
+
+#if NEON_BLITTERS
+SDL_BEGIN_NEON
+
+static void SDL_YUVLerpVNEON(Uint8 *dst, const Uint8 *l0, const Uint8 *l1,
+                             const Uint8 *c0, const Uint8 *c1,
+                             int fy, int fcy, int n)
+{
+	static const Uint8 even[8] = { 0xFF, 0, 0xFF, 0, 0xFF, 0, 0xFF, 0 };
+	const uint8x8_t lmask = vld1_u8(even);
+	Uint16 weights[8];
+	uint16x8_t f, inv;
+	int i;
+
+	for ( i = 0; i < 8; i += 2 ) {
+		weights[i] = (Uint16)fy;
+		weights[i+1] = (Uint16)fcy;
+	}
+	f = vld1q_u16(weights);
+	inv = vsubq_u16(vdupq_n_u16(256), f);
+	for ( i = 0; i + 8 <= n; i += 8 ) {
+		uint8x8_t a = vbsl_u8(lmask, vld1_u8(l0 + i), vld1_u8(c0 + i));
+		uint8x8_t b = vbsl_u8(lmask, vld1_u8(l1 + i), vld1_u8(c1 + i));
+
+		vst1_u8(dst + i, vrshrn_n_u16(vmlaq_u16(vmulq_u16(vmovl_u8(a), inv),
+		                                        vmovl_u8(b), f), 8));
+	}
+	SDL_YUVLerpVC(dst + i, l0 + i, l1 + i, c0 + i, c1 + i, fy, fcy, n - i);
+}
+
+SDL_END_TARGET
+#endif /* NEON_BLITTERS */
+
+static void SDL_ScaleYUVBand(void *data, int band, int y, int rows)
+{
+	SDL_YUVScale *scale = (SDL_YUVScale *)data;
+	struct private_yuvhwdata *swdata = scale->swdata;
+	const int incy = (scale->h << 16) / scale->dst_h;
+	const int even = scale->dst_w & ~1;
+	const int bytes = scale->pairs * 4;
+	SDL_YUVRows luma, chroma;
+	Uint8 *yuy2, *out;
+	Uint8 last[8];
+
+	/* The filtered rows are kept for each band */
+	yuy2 = scale->rowcache + band * 5 * bytes;
+	SDL_memset(yuy2, 0, 5 * bytes);
+	luma.rows[0] = yuy2 + bytes;
+	luma.rows[1] = yuy2 + 2 * bytes;
+	chroma.rows[0] = yuy2 + 3 * bytes;
+	chroma.rows[1] = yuy2 + 4 * bytes;
+	luma.ry[0] = luma.ry[1] = chroma.ry[0] = chroma.ry[1] = -1;
+
+	out = scale->dstp + y * scale->dstpitch;
+	while ( rows-- ) {
+		int pos = (scale->y << 16) + y * incy + incy / 2;
+		int cpos = scale->planar ? pos / 2 : pos;
+		const Uint8 *l0, *l1, *c0, *c1;
+		int y0, y1, c0y, c1y;
+		Uint8 fy, fcy;
+
+		SDL_YUVStep(pos - 0x8000, scale->y, scale->y + scale->h - 1,
+		            &y0, &y1, &fy);
+		SDL_YUVStep(cpos - 0x8000, scale->firstchroma,
+		            scale->lastchroma, &c0y, &c1y, &fcy);
+		l0 = SDL_YUVRow(scale, &luma, 0, y0, y1);
+		l1 = SDL_YUVRow(scale, &luma, 0, y1, y0);
+		c0 = SDL_YUVRow(scale, &chroma, 1, c0y, c1y);
+		c1 = SDL_YUVRow(scale, &chroma, 1, c1y, c0y);
+		scale->lerpv(yuy2, l0, l1, c0, c1, fy, fcy, bytes);
+
+		swdata->DisplayPacked(swdata->colortab, swdata->rgb_2_pix,
+		                      yuy2, yuy2 + 3, yuy2 + 1, out,
+		                      1, even, 0);
+		if ( even < scale->dst_w ) {
+			/* The odd last pixel is paired with a copy of itself */
+			Uint8 *pair = yuy2 + even * 2;
+
+			pair[2] = pair[0];
+			swdata->DisplayPacked(swdata->colortab,
+			                      swdata->rgb_2_pix,
+			                      pair, pair + 3, pair + 1, last,
+			                      1, 2, 0);
+			SDL_memcpy(out + even * scale->bpp, last, scale->bpp);
+		}
+		out += scale->dstpitch;
+		++y;
+	}
+}
+
+static int SDL_ScaleYUV(struct private_yuvhwdata *swdata,
+                        SDL_Overlay *overlay, Uint8 *lum, Uint8 *Cr, Uint8 *Cb,
+                        SDL_Rect *src, SDL_Rect *dst,
+                        Uint8 *dstp, int dstpitch, int bpp)
+{
+	const int inc = (src->w << 16) / dst->w;
+	const int lastcol = src->x + src->w - 1;
+	int lastchroma = (lastcol / 2 < overlay->w / 2 - 1) ?
+	                 lastcol / 2 : overlay->w / 2 - 1;
+	SDL_YUVScale scale;
+	int *x0;
+	Uint8 *fx;
+	int rowbytes, len;
+	int x1, i;
+
+	if ( lastchroma < 0 ) {
+		lastchroma = 0;
+	}
+	scale.swdata = swdata;
+	scale.planar = (overlay->planes > 1);
+	scale.y = src->y;
+	scale.h = src->h;
+	scale.dst_w = dst->w;
+	scale.dst_h = dst->h;
+	scale.pairs = (dst->w + 1) / 2;
+	scale.dstp = dstp;
+	scale.dstpitch = dstpitch;
+	scale.bpp = bpp;
+	if ( scale.planar ) {
+		scale.firstchroma = src->y / 2;
+		scale.lastchroma = (src->y + src->h - 1) / 2;
+		if ( scale.lastchroma > overlay->h / 2 - 1 ) {
+			scale.lastchroma = overlay->h / 2 - 1;
+		}
+		if ( scale.lastchroma < 0 ) {
+			scale.lastchroma = 0;
+		}
+	} else {
+		scale.firstchroma = src->y;
+		scale.lastchroma = src->y + src->h - 1;
+	}
+	scale.lerpv = SDL_YUVLerpVC;
+#if SSE2_BLITTERS
+	if ( SDL_GetBlitFeatures() & SDL_BLIT_SSE2 ) {
+		scale.lerpv = SDL_YUVLerpVSSE2;
+	}
+#elif NEON_BLITTERS
+	if ( SDL_GetBlitFeatures() & SDL_BLIT_NEON ) {
+		scale.lerpv = SDL_YUVLerpVNEON;
+	}
+#endif
+
+	/* The row caches of the bands, then the columns sampled, which are
+	   the same for every row */
+	rowbytes = SDL_MAX_BANDS * 5 * scale.pairs * 4;
+	len = rowbytes + (dst->w + scale.pairs) * (sizeof(int) + 1);
+	if ( swdata->scalebuflen < len ) {
+		Uint8 *buf = (Uint8 *)SDL_realloc(swdata->scalebuf, len);
+		if ( ! buf ) {
+			SDL_OutOfMemory();
+			return(-1);
+		}
+		swdata->scalebuf = buf;
+		swdata->scalebuflen = len;
+	}
+	scale.rowcache = swdata->scalebuf;
+	x0 = (int *)(swdata->scalebuf + rowbytes);
+	fx = (Uint8 *)(x0 + dst->w + scale.pairs);
+	for ( i = 0; i < dst->w; ++i ) {
+		SDL_YUVStep((src->x << 16) + i * inc + inc / 2 - 0x8000,
+		            src->x, lastcol, &x0[i], &x1, &fx[i]);
+	}
+	for ( i = 0; i < scale.pairs; ++i ) {
+		SDL_YUVStep(((src->x << 16) + (2 * i + 1) * inc) / 2 - 0x8000,
+		            src->x / 2, lastchroma,
+		            &x0[dst->w + i], &x1, &fx[dst->w + i]);
+	}
+
+	scale.planes[0].pixels = lum;
+	scale.planes[0].x0 = x0;
+	scale.planes[0].fx = fx;
+	scale.planes[1].pixels = Cr;
+	scale.planes[2].pixels = Cb;
+	for ( i = 1; i < 3; ++i ) {
+		scale.planes[i].x0 = x0 + dst->w;
+		scale.planes[i].fx = fx + dst->w;
+	}
+	if ( scale.planar ) {
+		scale.planes[0].pitch = overlay->pitches[0];
+		scale.planes[0].step = 1;
+		scale.planes[1].pitch = scale.planes[2].pitch =
+			overlay->pitches[1];
+		scale.planes[1].step = scale.planes[2].step =
+			(overlay->planes == 2) ? 2 : 1;
+	} else {
+		scale.planes[0].pitch = overlay->pitches[0];
+		scale.planes[0].step = 2;
+		scale.planes[1].pitch = scale.planes[2].pitch =
+			overlay->pitches[0];
+		scale.planes[1].step = scale.planes[2].step = 4;
+	}
+
+	SDL_ThreadedBands(SDL_ScaleYUVBand, &scale, dst->w, dst->h, 1);
+	return(0);
+}
+
 int SDL_DisplayYUV_SW(_THIS, SDL_Overlay *overlay, SDL_Rect *src, SDL_Rect *dst)
 {
+	SDL_YUVBands bands;
 	struct private_yuvhwdata *swdata;
-	int stretch;
+	int scale;
 	int scale_2x;
 	SDL_Surface *display;
 	Uint8 *lum, *Cr, *Cb;
@@ -1175,41 +2358,23 @@ int SDL_DisplayYUV_SW(_THIS, SDL_Overlay *overlay, SDL_Rect *src, SDL_Rect *dst)
 	int mod;
 
 	swdata = overlay->hwdata;
-	stretch = 0;
+	display = swdata->display;
+	scale = 0;
 	scale_2x = 0;
 	if ( src->x || src->y || src->w < overlay->w || src->h < overlay->h ) {
-		/* The source rectangle has been clipped.
-		   Using a scratch surface is easier than adding clipped
-		   source support to all the blitters, plus that would
-		   slow them down in the general unclipped case.
+		/* The source rectangle has been clipped, which only the
+		   scaler handles, so as not to slow down the converters
+		   in the general unclipped case.
 		*/
-		stretch = 1;
+		scale = 1;
 	} else if ( (src->w != dst->w) || (src->h != dst->h) ) {
 		if ( (dst->w == 2*src->w) &&
 		     (dst->h == 2*src->h) ) {
 			scale_2x = 1;
 		} else {
-			stretch = 1;
+			scale = 1;
 		}
 	}
-	if ( stretch ) {
-		if ( ! swdata->stretch ) {
-			display = swdata->display;
-			swdata->stretch = SDL_CreateRGBSurface(
-				SDL_SWSURFACE,
-				overlay->w, overlay->h,
-				display->format->BitsPerPixel,
-				display->format->Rmask,
-				display->format->Gmask,
-				display->format->Bmask, 0);
-			if ( ! swdata->stretch ) {
-				return(-1);
-			}
-		}
-		display = swdata->stretch;
-	} else {
-		display = swdata->display;
-	}
 	switch (overlay->format) {
 	    case SDL_YV12_OVERLAY:
 		lum = overlay->pixels[0];
@@ -1236,6 +2401,16 @@ int SDL_DisplayYUV_SW(_THIS, SDL_Overlay *overlay, SDL_Rect *src, SDL_Rect *dst)
 		Cr = lum + 1;
 		Cb = lum + 3;
 		break;
+	    case SDL_NV12_OVERLAY:
+		lum = overlay->pixels[0];
+		Cr = overlay->pixels[1] + 1;
+		Cb = overlay->pixels[1];
+		break;
+	    case SDL_NV21_OVERLAY:
+		lum = overlay->pixels[0];
+		Cr = overlay->pixels[1];
+		Cb = overlay->pixels[1] + 1;
+		break;
 	    default:
 		SDL_SetError("Unsupported YUV format in blit");
 		return(-1);
@@ -1245,31 +2420,49 @@ int SDL_DisplayYUV_SW(_THIS, SDL_Overlay *overlay, SDL_Rect *src, SDL_Rect *dst)
 			return(-1);
 		}
 	}
-	if ( stretch ) {
-		dstp = (Uint8 *)swdata->stretch->pixels;
-	} else {
-		dstp = (Uint8 *)display->pixels
-			+ dst->x * display->format->BytesPerPixel
-			+ dst->y * display->pitch;
-	}
+	dstp = (Uint8 *)display->pixels
+		+ dst->x * display->format->BytesPerPixel
+		+ dst->y * display->pitch;
 	mod = (display->pitch / display->format->BytesPerPixel);
 
-	if ( scale_2x ) {
-		mod -= (overlay->w * 2);
-		swdata->Display2X(swdata->colortab, swdata->rgb_2_pix,
-		                  lum, Cr, Cb, dstp, overlay->h, overlay->w, mod);
+	if ( scale ) {
+		if ( SDL_ScaleYUV(swdata, overlay, lum, Cr, Cb, src, dst,
+		                  dstp, display->pitch,
+		                  display->format->BytesPerPixel) < 0 ) {
+			if ( SDL_MUSTLOCK(display) ) {
+				SDL_UnlockSurface(display);
+			}
+			return(-1);
+		}
 	} else {
-		mod -= overlay->w;
-		swdata->Display1X(swdata->colortab, swdata->rgb_2_pix,
-		                  lum, Cr, Cb, dstp, overlay->h, overlay->w, mod);
+		/* Large overlays are converted in bands of rows by several
+		   threads, the planar ones in pairs of rows that share their
+		   chroma.  The width only tells SDL_ThreadedBands() how many
+		   pixels are written. */
+		bands.swdata = swdata;
+		bands.lum = lum;
+		bands.Cr = Cr;
+		bands.Cb = Cb;
+		bands.dstp = dstp;
+		bands.planar = (overlay->planes > 1);
+		bands.cols = overlay->w;
+		bands.chromapitch = overlay->pitches[1];
+		if ( scale_2x ) {
+			bands.convert = swdata->Display2X;
+			bands.mod = mod - (overlay->w * 2);
+			bands.dstpitch = 2 * display->pitch;
+		} else {
+			bands.convert = swdata->Display1X;
+			bands.mod = mod - overlay->w;
+			bands.dstpitch = display->pitch;
+		}
+		SDL_ThreadedBands(SDL_ConvertYUVBand, &bands,
+		                  scale_2x ? 4 * overlay->w : overlay->w,
+		                  overlay->h, bands.planar ? 2 : 1);
 	}
 	if ( SDL_MUSTLOCK(display) ) {
 		SDL_UnlockSurface(display);
 	}
-	if ( stretch ) {
-		display = swdata->display;
-		SDL_SoftStretch(swdata->stretch, src, display, dst);
-	}
 	SDL_UpdateRects(display, 1, dst);
 
 	return(0);
@@ -1281,9 +2474,6 @@ void SDL_FreeYUV_SW(_THIS, SDL_Overlay *overlay)
 
 	swdata = overlay->hwdata;
 	if ( swdata ) {
-		if ( swdata->stretch ) {
-			SDL_FreeSurface(swdata->stretch);
-		}
 		if ( swdata->pixels ) {
 			SDL_free(swdata->pixels);
 		}
@@ -1293,6 +2483,9 @@ void SDL_FreeYUV_SW(_THIS, SDL_Overlay *overlay)
 		if ( swdata->rgb_2_pix ) {
 			SDL_free(swdata->rgb_2_pix);
 		}
+		if ( swdata->scalebuf ) {
+			SDL_free(swdata->scalebuf);
+		}
 		SDL_free(swdata);
 		overlay->hwdata = NULL;
 	}
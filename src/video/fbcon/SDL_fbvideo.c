@@ -40,6 +40,7 @@
 #include "SDL_mouse.h"
 #include "../SDL_sysvideo.h"
 #include "../SDL_pixels_c.h"
+#include "../SDL_rotate_c.h"
 #include "../../events/SDL_events_c.h"
 #include "SDL_fbvideo.h"
 #include "SDL_fbmouse_c.h"
@@ -133,8 +134,6 @@ enum {
 	FBCON_ROTATE_CW = 270
 };
 
-#define min(a,b) ((a)<(b)?(a):(b))
-
 /* Initialization/Query functions */
 static int FB_VideoInit(_THIS, SDL_PixelFormat *vformat);
 static SDL_Rect **FB_ListModes(_THIS, SDL_PixelFormat *format, Uint32 flags);
@@ -161,10 +160,6 @@ static void FB_SavePalette(_THIS, struct fb_fix_screeninfo *finfo,
                                   struct fb_var_screeninfo *vinfo);
 static void FB_RestorePalette(_THIS);
 
-/* Shadow buffer functions */
-static FB_bitBlit FB_blit16;
-static FB_bitBlit FB_blit16blocked;
-
 static int SDL_getpagesize(void)
 {
 #ifdef HAVE_GETPAGESIZE
@@ -1112,21 +1107,16 @@ static SDL_Surface *FB_SetVideoMode(_THIS, SDL_Surface *current,
 	/* Save hardware palette, if needed */
 	FB_SavePalette(this, &finfo, &vinfo);
 
-	if (shadow_fb) {
-		if (vinfo.bits_per_pixel == 16) {
-			blitFunc = (rotate == FBCON_ROTATE_NONE ||
-					rotate == FBCON_ROTATE_UD) ?
-				FB_blit16 : FB_blit16blocked;
-		} else {
+	if (shadow_fb && (vinfo.bits_per_pixel < 8 ||
+			vinfo.bits_per_pixel > 32)) {
 #ifdef FBCON_DEBUG
-			fprintf(stderr, "Init vinfo:\n");
-			print_vinfo(&vinfo);
+		fprintf(stderr, "Init vinfo:\n");
+		print_vinfo(&vinfo);
 #endif
-			SDL_SetError("Using software buffer, but no blitter "
-					"function is available for %d bpp.",
-					vinfo.bits_per_pixel);
-			return(NULL);
-		}
+		SDL_SetError("Using software buffer, but no blitter "
+				"function is available for %d bpp.",
+				vinfo.bits_per_pixel);
+		return(NULL);
 	}
 
 	/* Set up the new mode framebuffer */
@@ -1182,6 +1172,14 @@ static SDL_Surface *FB_SetVideoMode(_THIS, SDL_Surface *current,
 	/* Set the update rectangle function */
 	this->UpdateRects = FB_DirectUpdate;
 
+	/* Gamma ramps are emulated while copying the shadow to the screen,
+	   8-bit modes have theirs applied to the palette */
+	this->gamma_lut = NULL;
+	if (shadow_fb && (vinfo.bits_per_pixel > 8)) {
+		SDL_BuildGammaLUT(&shadow_gamma, this->gamma);
+		this->gamma_lut = &shadow_gamma;
+	}
+
 	/* We're done */
 	return(current);
 }
@@ -1442,62 +1440,12 @@ static int FB_FlipHWSurface(_THIS, SDL_Surface *surface)
 	return(0);
 }
 
-static void FB_blit16(Uint8 *byte_src_pos, int src_right_delta, int src_down_delta,
-		Uint8 *byte_dst_pos, int dst_linebytes, int width, int height)
-{
-	int w;
-	Uint16 *src_pos = (Uint16 *)byte_src_pos;
-	Uint16 *dst_pos = (Uint16 *)byte_dst_pos;
-
-	while (height) {
-		Uint16 *src = src_pos;
-		Uint16 *dst = dst_pos;
-		for (w = width; w != 0; w--) {
-			*dst = *src;
-			src += src_right_delta;
-			dst++;
-		}
-		dst_pos = (Uint16 *)((Uint8 *)dst_pos + dst_linebytes);
-		src_pos += src_down_delta;
-		height--;
-	}
-}
-
-#define BLOCKSIZE_W 32
-#define BLOCKSIZE_H 32
-
-static void FB_blit16blocked(Uint8 *byte_src_pos, int src_right_delta, int src_down_delta, 
-		Uint8 *byte_dst_pos, int dst_linebytes, int width, int height)
-{
-	int w;
-	Uint16 *src_pos = (Uint16 *)byte_src_pos;
-	Uint16 *dst_pos = (Uint16 *)byte_dst_pos;
-
-	while (height > 0) {
-		Uint16 *src = src_pos;
-		Uint16 *dst = dst_pos;
-		for (w = width; w > 0; w -= BLOCKSIZE_W) {
-			FB_blit16((Uint8 *)src,
-					src_right_delta,
-					src_down_delta,
-					(Uint8 *)dst,
-					dst_linebytes,
-					min(w, BLOCKSIZE_W),
-					min(height, BLOCKSIZE_H));
-			src += src_right_delta * BLOCKSIZE_W;
-			dst += BLOCKSIZE_W;
-		}
-		dst_pos = (Uint16 *)((Uint8 *)dst_pos + dst_linebytes * BLOCKSIZE_H);
-		src_pos += src_down_delta * BLOCKSIZE_H;
-		height -= BLOCKSIZE_H;
-	}
-}
-
 static void FB_DirectUpdate(_THIS, int numrects, SDL_Rect *rects)
 {
-	int width = cache_vinfo.xres;
-	int height = cache_vinfo.yres;
 	int bytes_per_pixel = (cache_vinfo.bits_per_pixel + 7) / 8;
+	int pitch = cache_vinfo.xres * bytes_per_pixel;
+	const SDL_GammaLUT *lut = NULL;
+	int rotation;
 	int i;
 
 	if (!shadow_fb) {
@@ -1505,105 +1453,35 @@ static void FB_DirectUpdate(_THIS, int numrects, SDL_Rect *rects)
 		return;
 	}
 
-	if (cache_vinfo.bits_per_pixel != 16) {
-		SDL_SetError("Shadow copy only implemented for 16 bpp");
-		return;
+	switch (rotate) {
+		case FBCON_ROTATE_NONE:
+			rotation = SDL_PRESENT_ROTATE_0;
+			break;
+		case FBCON_ROTATE_CCW:
+			rotation = SDL_PRESENT_ROTATE_270;
+			break;
+		case FBCON_ROTATE_UD:
+			rotation = SDL_PRESENT_ROTATE_180;
+			break;
+		case FBCON_ROTATE_CW:
+			rotation = SDL_PRESENT_ROTATE_90;
+			break;
+		default:
+			SDL_SetError("Unknown rotation");
+			return;
 	}
 
-	for (i = 0; i < numrects; i++) {
-		int x1, y1, x2, y2;
-		int scr_x1, scr_y1, scr_x2, scr_y2;
-		int sha_x1, sha_y1;
-		int shadow_right_delta;  /* Address change when moving right in dest */
-		int shadow_down_delta;   /* Address change when moving down in dest */
-		char *src_start;
-		char *dst_start;
-
-		x1 = rects[i].x; 
-		y1 = rects[i].y;
-		x2 = x1 + rects[i].w; 
-		y2 = y1 + rects[i].h;
-
-		if (x1 < 0) {
-			x1 = 0;
-		} else if (x1 > width) {
-			x1 = width;
-		}
-		if (x2 < 0) {
-			x2 = 0;
-		} else if (x2 > width) {
-			x2 = width;
-		}
-		if (y1 < 0) {
-			y1 = 0;
-		} else if (y1 > height) {
-			y1 = height;
-		}
-		if (y2 < 0) {
-			y2 = 0;
-		} else if (y2 > height) {
-			y2 = height;
-		}
-		if (x2 <= x1 || y2 <= y1) {
-			continue;
-		}
-
-		switch (rotate) {
-			case FBCON_ROTATE_NONE:
-				sha_x1 = scr_x1 = x1;
-				sha_y1 = scr_y1 = y1;
-				scr_x2 = x2;
-				scr_y2 = y2;
-				shadow_right_delta = 1;
-				shadow_down_delta = width;
-				break;
-			case FBCON_ROTATE_CCW:
-				scr_x1 = y1;
-				scr_y1 = width - x2;
-				scr_x2 = y2;
-				scr_y2 = width - x1;
-				sha_x1 = x2 - 1;
-				sha_y1 = y1;
-				shadow_right_delta = width;
-				shadow_down_delta = -1;
-				break;
-			case FBCON_ROTATE_UD:
-				scr_x1 = width - x2;
-				scr_y1 = height - y2;
-				scr_x2 = width - x1;
-				scr_y2 = height - y1;
-				sha_x1 = x2 - 1;
-				sha_y1 = y2 - 1;
-				shadow_right_delta = -1;
-				shadow_down_delta = -width;
-				break;
-			case FBCON_ROTATE_CW:
-				scr_x1 = height - y2;
-				scr_y1 = x1;
-				scr_x2 = height - y1;
-				scr_y2 = x2;
-				sha_x1 = x1;
-				sha_y1 = y2 - 1;
-				shadow_right_delta = -width;
-				shadow_down_delta = 1;
-				break;
-			default:
-				SDL_SetError("Unknown rotation");
-				return;
-		}
+	/* The gamma ramp is applied while copying to video memory */
+	if (this->gamma_lut && !this->gamma_lut->identity) {
+		lut = this->gamma_lut;
+	}
 
-		src_start = shadow_mem +
-			(sha_y1 * width + sha_x1) * bytes_per_pixel;
-		dst_start = mapped_mem + mapped_offset + scr_y1 * physlinebytes + 
-			scr_x1 * bytes_per_pixel;
-
-		blitFunc((Uint8 *) src_start,
-				shadow_right_delta, 
-				shadow_down_delta, 
-				(Uint8 *) dst_start,
-				physlinebytes,
-				scr_x2 - scr_x1,
-				scr_y2 - scr_y1);
+	for (i = 0; i < numrects; i++) {
+		SDL_GammaRotateRect(lut, this->screen->format,
+				shadow_mem, pitch,
+				mapped_mem + mapped_offset, physlinebytes,
+				cache_vinfo.xres, cache_vinfo.yres,
+				&rects[i], rotation);
 	}
 }
 
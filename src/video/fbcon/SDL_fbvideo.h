@@ -31,6 +31,7 @@
 #include "SDL_mouse.h"
 #include "SDL_mutex.h"
 #include "../SDL_sysvideo.h"
+#include "../SDL_present_c.h"
 #if SDL_INPUT_TSLIB
 #include "tslib.h"
 #endif
@@ -38,15 +39,6 @@
 /* Hidden "this" pointer for the video functions */
 #define _THIS	SDL_VideoDevice *this
 
-typedef void FB_bitBlit(
-		Uint8 *src_pos,
-		int src_right_delta,	/* pixels, not bytes */
-		int src_down_delta,		/* pixels, not bytes */
-		Uint8 *dst_pos,
-		int dst_linebytes,
-		int width,
-		int height);
-
 /* This is the structure we use to keep track of video memory */
 typedef struct vidmem_bucket {
 	struct vidmem_bucket *prev;
@@ -86,8 +78,8 @@ struct SDL_PrivateVideoData {
 	char *flip_address[2];
 	int rotate;
 	int shadow_fb;				/* Tells whether a shadow is being used. */
-	FB_bitBlit *blitFunc;
 	int physlinebytes;			/* Length of a line in bytes in physical fb */
+	SDL_GammaLUT gamma;			/* Software gamma, applied to the shadow */
 
 #define NUM_MODELISTS	4		/* 8, 16, 24, and 32 bits-per-pixel */
 	int SDL_nummodes[NUM_MODELISTS];
@@ -132,8 +124,8 @@ struct SDL_PrivateVideoData {
 #define flip_address		(this->hidden->flip_address)
 #define rotate			(this->hidden->rotate)
 #define shadow_fb		(this->hidden->shadow_fb)
-#define blitFunc		(this->hidden->blitFunc)
 #define physlinebytes		(this->hidden->physlinebytes)
+#define shadow_gamma		(this->hidden->gamma)
 #define SDL_nummodes		(this->hidden->SDL_nummodes)
 #define SDL_modelist		(this->hidden->SDL_modelist)
 #define surfaces		(this->hidden->surfaces)
@@ -102,7 +102,7 @@ void SDL_ChannelExists(const char *channelName)
 
 SDL_QWin::SDL_QWin(const QSize& size)
   : QWidget(0, "SDL_main", WType_TopLevel | WStyle_Customize | WStyle_NoBorder),
-		my_image(0),
+		my_image(0), my_rotbuf(0), my_rotbuf_size(0), my_gamma(0),
     my_inhibit_resize(false), my_mouse_pos(-1, -1), my_flags(0),
     my_locked(0), my_special(false),
     cur_mouse_button(EZX_LEFT_BUTTON),
@@ -143,6 +143,7 @@ SDL_QWin::~SDL_QWin() {
   if(my_image) {
     delete my_image;
   }
+  SDL_free(my_rotbuf);
 
   if(vmem != (char *)-1){
     munmap(vmem, vmem_length);
@@ -274,8 +275,64 @@ void SDL_QWin::mouseReleaseEvent(QMouseEvent *e) {
   my_mouse_pos = QPoint(-1, -1);
 }
 
+// The image is turned clockwise by this much on the framebuffer
+int SDL_QWin::imageRotation() const {
+  if(my_image->width() == height()) {
+    if (screenRotation == SDL_QT_ROTATION_90)
+      return SDL_PRESENT_ROTATE_270;
+    else if (screenRotation == SDL_QT_ROTATION_270)
+      return SDL_PRESENT_ROTATE_90;
+  }
+  return SDL_PRESENT_ROTATE_0;
+}
+
+// 18 bpp - really 3 bytes per pixel
+static inline void convert565to666(const uchar *src, uchar *dst, int width)
+{
+  while(width--){
+    unsigned short tmp = ((unsigned short)(src[1] & 0xf8)) << 2;
+    dst[0] = src[0] << 1;
+    dst[1] = ((src[0] & 0x80) >> 7) | ((src[1] & 0x7) << 1) | (tmp & 0xff);
+    dst[2] = (tmp & 0x300) >> 8;
+    src += 2;
+    dst += 3;
+  }
+}
+
+// Same, through the gamma tables: each 565 field maps straight to its
+// part of the 18 bit pixel
+struct Gamma666 {
+  Uint32 red[32], green[64], blue[32];
+};
+
+static void buildGamma666(const SDL_GammaLUT *lut, Gamma666 *t)
+{
+  int i;
+  for(i = 0; i < 32; i++){
+    t->red[i] = (Uint32)(lut->r[(i << 3) | (i >> 2)] >> 2) << 12;
+    t->blue[i] = (Uint32)(lut->b[(i << 3) | (i >> 2)] >> 2);
+  }
+  for(i = 0; i < 64; i++)
+    t->green[i] = (Uint32)(lut->g[(i << 2) | (i >> 4)] >> 2) << 6;
+}
+
+static inline void convert565to666Gamma(const uchar *src, uchar *dst, int width,
+                                        const Gamma666 *t)
+{
+  while(width--){
+    unsigned int p = src[0] | (src[1] << 8);
+    Uint32 v = t->red[p >> 11] | t->green[(p >> 5) & 0x3f] | t->blue[p & 0x1f];
+    dst[0] = (uchar)v;
+    dst[1] = (uchar)(v >> 8);
+    dst[2] = (uchar)(v >> 16);
+    src += 2;
+    dst += 3;
+  }
+}
+
 void SDL_QWin::repaintRect(const QRect& rect) {
-  if(!rect.width() || !rect.height() /*|| !isVisible()*/) {
+  QRect rs = rect & my_image->rect();
+  if(rs.isEmpty() /*|| !isVisible()*/) {
     return;
   }
   
@@ -283,132 +340,68 @@ void SDL_QWin::repaintRect(const QRect& rect) {
   /* so any other - back off */
   if(QPixmap::defaultDepth() != 18) return;
 
-#if 1
-  // 18 bpp - really 3 bytes per pixel
-  if(screenRotation == SDL_QT_ROTATION_90){
-    QRect rs = my_image->rect();
-    QRect rd;
-
-    int id, jd;
-
-    if(rect.y() + rect.height() > 240){
-      rs.setRect(rect.y(), 240 - rect.width() - rect.x(), rect.height(), rect.width());
-      rd = rect;
-      jd = rect.y() + rect.height() - 1;
-      id = rect.x();
-    }
-    else{
-      rs = rect;
-      rd.setRect(rect.y(), 320 - rect.width() - rect.x(), rect.height(), rect.width());
-      jd = 319 - rect.x();
-      id = rect.y();
-    }
-
-    //printf("rs: %d %d %d %d\n", rs.x(), rs.y(), rs.width(), rs.height());
-    //printf("rd: %d %d %d %d\n", rd.x(), rd.y(), rd.width(), rd.height());
-    //printf("id: %d, jd: %d\n", id, jd);
-
-    int ii = id, jj;
-    uchar *src0 = (uchar *)my_image->bits();
-    uchar *dst0 = (uchar *)vmem;
-    uchar *dst, *src;
-
-    src += rs.y() * my_image->bytesPerLine() + rs.x() * 2;
-
-    int is_lim = rs.y() + rs.height();
-    int dst_offset = jd * 720 + id * 3;
-    int src_offset = rs.y() * my_image->bytesPerLine() + rs.x() * 2;
-
-    for(int ii = rs.y(); ii < is_lim;
-        dst_offset += 3, src_offset += my_image->bytesPerLine(), ii++){
-      dst = dst0 + dst_offset;
-      src = src0 + src_offset;
-      for(int j = 0; j < rs.width(); j++){
-        unsigned short tmp = ((unsigned short)(src[1] & 0xf8)) << 2;
-        dst[0] = src[0] << 1;
-        dst[1] = ((src[0] & 0x80) >> 7) | ((src[1] & 0x7) << 1) | (tmp & 0xff);
-        dst[2] = (tmp & 0x300) >> 8;
-        dst -= 720;
-        src += 2;
-      }
+  const uchar *src = (const uchar *)my_image->bits();
+  int src_pitch = my_image->bytesPerLine();
+  int rotation = imageRotation();
+  SDL_Rect area, rd, all;
+
+  area.x = rs.x();
+  area.y = rs.y();
+  area.w = rs.width();
+  area.h = rs.height();
+  SDL_RotatedRect(my_image->width(), my_image->height(), &area, rotation, &rd);
+
+  if(rotation != SDL_PRESENT_ROTATE_0) {
+    // Rotate into a 16 bpp buffer first, so that the conversion below
+    // walks both sides in order
+    int size = rd.w * rd.h * 2;
+    if(size > my_rotbuf_size){
+      uchar *buf = (uchar *)SDL_realloc(my_rotbuf, size);
+      if(!buf) return;
+      my_rotbuf = buf;
+      my_rotbuf_size = size;
     }
-    //printf("done\n");
+    all.x = 0;
+    all.y = 0;
+    all.w = area.w;
+    all.h = area.h;
+    SDL_RotateRect(src + area.y * src_pitch + area.x * 2, src_pitch,
+                   my_rotbuf, rd.w * 2, 2, area.w, area.h, &all, rotation);
+    src = my_rotbuf;
+    src_pitch = rd.w * 2;
   }
-  else if(screenRotation == SDL_QT_ROTATION_270){
-    QRect rs = my_image->rect();
-    QRect rd;
-
-    int id, jd;
-
-    if(rect.y() + rect.height() > 240){
-      rs.setRect(rect.y(), 240 - rect.width() - rect.x(), rect.height(), rect.width());
-      rd = rect;
-      jd = rect.y();
-      id = rect.x() + rect.width() - 1;
-    }
-    else{
-      rs = rect;
-      rd.setRect(rect.y(), 320 - rect.width() - rect.x(), rect.height(), rect.width());
-      jd = rect.x();
-      id = 239 - rect.y();
-    }
-
-    int ii = id, jj;
-    uchar *src0 = (uchar *)my_image->bits();
-    uchar *dst0 = (uchar *)vmem;
-    uchar *dst, *src;
-
-    src += rs.y() * my_image->bytesPerLine() + rs.x() * 2;
-
-    int is_lim = rs.y() + rs.height();
-    int dst_offset = jd * 720 + id * 3;
-    int src_offset = rs.y() * my_image->bytesPerLine() + rs.x() * 2;
-
-    for(int ii = rs.y(); ii < is_lim;
-        dst_offset -= 3, src_offset += my_image->bytesPerLine(), ii++){
-      dst = dst0 + dst_offset;
-      src = src0 + src_offset;
-      for(int j = 0; j < rs.width(); j++){
-        unsigned short tmp = ((unsigned short)(src[1] & 0xf8)) << 2;
-        dst[0] = src[0] << 1;
-        dst[1] = ((src[0] & 0x80) >> 7) | ((src[1] & 0x7) << 1) | (tmp & 0xff);
-        dst[2] = (tmp & 0x300) >> 8;
-        dst += 720;
-        src += 2;
-      }
-    }
+  else {
+    src += rd.y * src_pitch + rd.x * 2;
   }
-  else
-#endif
-  {
-    uchar *src0 = (uchar *)my_image->bits();
-    uchar *dst0 = (uchar *)vmem;
-    uchar *dst, *src;
-    
-    int is_lim = rect.y() + rect.height();
-    int s_offset = rect.y() * my_image->bytesPerLine() + rect.x() * 2;
-    int offset = rect.y() * 720 + rect.x() * 3;
-
-    for(int ii = rect.y(); ii < is_lim; ii++, offset += 720,
-                s_offset += my_image->bytesPerLine()){
-      dst = dst0 + offset;
-      src = src0 + s_offset;
-      for(int j = 0; j < rect.width(); j++){      
-        unsigned short tmp = ((unsigned short)(src[1] & 0xf8)) << 2;
-        dst[0] = src[0] << 1;
-        dst[1] = ((src[0] & 0x80) >> 7) | ((src[1] & 0x7) << 1) | (tmp & 0xff);
-        dst[2] = (tmp & 0x300) >> 8;
-        src += 2;
-        dst += 3;
-      }
-    }
+
+  int dst_pitch = width() * 3;
+  uchar *dst = (uchar *)vmem + rd.y * dst_pitch + rd.x * 3;
+  bool gamma = my_gamma && !my_gamma->identity;
+  Gamma666 gammaTables;
+  if(gamma)
+    buildGamma666(my_gamma, &gammaTables);
+  for(int ii = 0; ii < rd.h; ii++){
+    if(gamma)
+      convert565to666Gamma(src, dst, rd.w, &gammaTables);
+    else
+      convert565to666(src, dst, rd.w);
+    src += src_pitch;
+    dst += dst_pitch;
   }
 }
 
 // This paints the current buffer to the screen, when desired. 
 void SDL_QWin::paintEvent(QPaintEvent *ev) {  
   if(my_image) {
-    repaintRect(ev->rect());
+    // Paint events are in screen coordinates
+    int inverse = (4 - imageRotation()) & 3;
+    SDL_Rect area, rs;
+    area.x = ev->rect().x();
+    area.y = ev->rect().y();
+    area.w = ev->rect().width();
+    area.h = ev->rect().height();
+    SDL_RotatedRect(width(), height(), &area, inverse, &rs);
+    repaintRect(QRect(rs.x, rs.y, rs.w, rs.h));
   }
 }  
 
@@ -35,6 +35,7 @@
 
 extern "C" {
 #include "../../events/SDL_events_c.h"
+#include "../SDL_rotate_c.h"
 };
 
 typedef enum { 
@@ -83,6 +84,9 @@ class SDL_QWin : public QWidget
   void setMousePos(const QPoint& newpos);
 
   void repaintRect(const QRect& rect);
+  int imageRotation() const;
+  /* Gamma tables to apply when painting, may be changed in place */
+  void setGamma(const SDL_GammaLUT *lut) { my_gamma = lut; }
   bool isOK()
   { return fbdev != -1 && vmem != (char *)-1; }
   
@@ -120,6 +124,9 @@ class SDL_QWin : public QWidget
   char *vmem;
   size_t vmem_length;
   QImage *my_image;
+  uchar *my_rotbuf;
+  int my_rotbuf_size;
+  const SDL_GammaLUT *my_gamma;
   bool my_inhibit_resize;
   QPoint my_offset;
   QPoint my_mouse_pos;
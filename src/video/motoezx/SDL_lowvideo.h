@@ -26,6 +26,7 @@
 
 #include "SDL_mouse.h"
 #include "../SDL_sysvideo.h"
+#include "../SDL_present_c.h"
 
 /* Hidden "this" pointer for the video functions */
 #define _THIS	SDL_VideoDevice *_this
@@ -40,6 +41,9 @@ struct SDL_PrivateVideoData {
   int SDL_nummodes[NUM_MODELISTS];
   SDL_Rect **SDL_modelist[NUM_MODELISTS];
 
+  /* Software gamma, applied by the 18 bpp conversion */
+  SDL_GammaLUT gamma;
+
   /* A completely clear cursor */
   WMcursor *BlankCursor;
 
@@ -56,6 +60,7 @@ struct SDL_PrivateVideoData {
 #define saved_mode	(_this->hidden->saved_mode)
 #define SDL_nummodes	(_this->hidden->SDL_nummodes)
 #define SDL_modelist	(_this->hidden->SDL_modelist)
+#define QT_gamma	(_this->hidden->gamma)
 #define SDL_BlankCursor	(_this->hidden->BlankCursor)
 #define last_buttons	(_this->hidden->last_buttons)
 #define last_point	(_this->hidden->last_point)
@@ -105,6 +105,7 @@ extern "C" {
       return(0);
     }
     SDL_memset(device->hidden, 0, (sizeof *device->hidden));
+    SDL_BuildGammaLUT(&device->hidden->gamma, NULL);
 
     /* Set the function pointers */
     device->VideoInit = QT_VideoInit;
@@ -134,6 +135,7 @@ extern "C" {
     device->WarpWMCursor = QT_WarpWMCursor;
     device->InitOSKeymap = QT_InitOSKeymap;
     device->PumpEvents = QT_PumpEvents;
+    device->gamma_lut = &device->hidden->gamma;
 
     device->free = QT_DeleteDevice;
     device->ToggleFullScreen = QT_ToggleFullScreen;
@@ -243,6 +245,7 @@ extern "C" {
       SDL_Win = 0;
       return -1;
     }
+    SDL_Win->setGamma(&QT_gamma);
     qApp->setMainWidget(SDL_Win);
     SDL_Win->show();
     //SDL_Win->hide();
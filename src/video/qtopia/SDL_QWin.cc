@@ -29,6 +29,7 @@ screenRotationT screenRotation = SDL_QT_NO_ROTATION;
 
 SDL_QWin::SDL_QWin(const QSize& size)
   : QWidget(0, "SDL_main"), my_painter(0), my_image(0),
+    my_gamma(0), my_gamma_format(0), my_gamma_image(0),
     my_inhibit_resize(false), my_mouse_pos(-1,-1), my_flags(0),
     my_has_fullscreen(false), my_locked(0)
 {
@@ -40,6 +41,7 @@ SDL_QWin::~SDL_QWin() {
   if(my_image) {
     delete my_image;
   }
+  delete my_gamma_image;
 }
 
 void SDL_QWin::setImage(QImage *image) {
@@ -47,6 +49,8 @@ void SDL_QWin::setImage(QImage *image) {
     delete my_image;
   }
   my_image = image;
+  delete my_gamma_image;
+  my_gamma_image = 0;
   //  setFixedSize(image->size());
 }
 
@@ -125,234 +129,86 @@ void SDL_QWin::mouseReleaseEvent(QMouseEvent *e) {
   my_mouse_pos = QPoint(-1, -1);
 }
 
-static inline void
-gs_fastRotateBlit_3 ( unsigned short *fb,
-		      unsigned short *bits,
-		      const QRect& rect )
-{
-  // FIXME: this only works correctly for 240x320 displays
-  int startx, starty;
-  int width, height;
-  
-  startx = rect.left() >> 1;
-  starty = rect.top() >> 1;
-  width  = ((rect.right() - rect.left()) >> 1) + 2;
-  height = ((rect.bottom() - rect.top()) >> 1) + 2;
-
-  if((startx+width) > 120) {
-    width = 120 - startx; // avoid horizontal overflow
+// The image to paint rect from: my_image, or a copy of the rect made
+// through the gamma tables
+QImage *SDL_QWin::gammaImage(const QRect& rect) {
+  if(!my_gamma || my_gamma->identity || my_image->depth() < 16) {
+    return my_image;
   }
-  if((starty+height) > 160) { 
-    height = 160 - starty; // avoid vertical overflow
-  }
-
-  ulong *sp1, *sp2, *dp1, *dp2;
-  ulong stop, sbot, dtop, dbot;    
-  
-  sp1 = (ulong*)bits + startx + starty*240;
-  sp2 = sp1 + 120;
-  dp1 = (ulong *)fb + (159 - starty) + startx*320;
-  dp2 = dp1 + 160;
-  int rowadd = (-320*width) - 1;
-  int rowadd2 = 240 - width;
-  // transfer in cells of 2x2 pixels in words
-  for (int y=0; y<height; y++) {
-    for (int x=0; x<width; x++) {
-      // read source pixels
-      stop = *sp1;
-      sbot = *sp2;
-      // rotate pixels
-      dtop = (sbot & 0xffff) + ((stop & 0xffff)<<16);
-      dbot = ((sbot & 0xffff0000)>>16) + (stop & 0xffff0000);
-      // write to framebuffer
-      *dp1 = dtop;
-      *dp2 = dbot;
-      // update source ptrs
-      sp1++; sp2++;
-      // update dest ptrs - 2 pix at a time
-      dp1 += 320;
-      dp2 += 320;
+  if(!my_gamma_image || my_gamma_image->size() != my_image->size()) {
+    delete my_gamma_image;
+    my_gamma_image = new QImage(my_image->width(), my_image->height(),
+				my_image->depth());
+    if(my_gamma_image->isNull()) {
+      delete my_gamma_image;
+      my_gamma_image = 0;
+      return my_image;
     }
-    // adjust src ptrs - skip a row as we work in pairs
-    sp1 += rowadd2;
-    sp2 += rowadd2;
-    // adjust dest ptrs for rotation
-    dp1 += rowadd;
-    dp2 += rowadd;
   }
+  QRect r = rect & my_image->rect();
+  int bpp = my_image->depth() / 8;
+  SDL_GammaCopy(my_gamma, my_gamma_format,
+		my_image->bits() + r.y() * my_image->bytesPerLine() + r.x() * bpp,
+		my_image->bytesPerLine(),
+		my_gamma_image->bits() + r.y() * my_gamma_image->bytesPerLine() +
+		r.x() * bpp,
+		my_gamma_image->bytesPerLine(), r.width(), r.height());
+  return my_gamma_image;
 }
 
-static inline void
-gs_fastRotateBlit_1 ( unsigned short *fb,
-		      unsigned short *bits,
-		      const QRect& rect ) {
-  // FIXME: this only works correctly for 240x320 displays
-  int startx, starty;
-  int width, height;
-
-  startx = rect.left() >> 1;
-  starty = rect.top() >> 1;
-  width  = ((rect.right() - rect.left()) >> 1) + 2;
-  height = ((rect.bottom() - rect.top()) >> 1) + 2;
-
-  if((startx+width) > 120) {
-    width = 120 - startx; // avoid horizontal overflow
+// Copy straight to the framebuffer, which may be mounted rotated
+bool SDL_QWin::repaintDirect(QImage *image, const QRect& rect) {
+  int rotation;
+  switch(my_painter->transformOrientation()) {
+  case 0: // desktop, SL-A300 etc
+    rotation = SDL_PRESENT_ROTATE_0;
+    break;
+  case 1: // ipaq 3800...
+    rotation = SDL_PRESENT_ROTATE_270;
+    break;
+  case 2:
+    rotation = SDL_PRESENT_ROTATE_180;
+    break;
+  case 3: // Sharp Zaurus SL-5500 etc
+    rotation = SDL_PRESENT_ROTATE_90;
+    break;
+  default:
+    return false;
   }
-  if((starty+height) > 160) { 
-    height = 160 - starty; // avoid vertical overflow
-  }
-
-  ulong *sp1, *sp2, *dp1, *dp2;
-  ulong stop, sbot, dtop, dbot;    
-  fb += 320*239; // Move "fb" to top left corner
-  sp1 = (ulong*)bits + startx + starty*240;
-  sp2 = sp1 + 120;
-  dp1 = (ulong*)fb - startx * 320 - starty;
-  dp2 = dp1 - 160;
-  int rowadd = (320*width) + 1;
-  int rowadd2 = 240 - width;
-  // transfer in cells of 2x2 pixels in words
-  for (int y=0; y<height; y++) {
-    for (int x=0; x<width; x++) {
-      // read
-      stop = *sp1;
-      sbot = *sp2;
-      // rotate
-      dtop = (stop & 0xffff) + ((sbot & 0xffff)<<16);
-      dbot = ((stop & 0xffff0000)>>16) + (sbot & 0xffff0000);
-      // write
-      *dp1 = dtop;
-      *dp2 = dbot;
-      // update source ptrs
-      sp1++; sp2++;
-      // update dest ptrs - 2 pix at a time
-      dp1 -= 320;
-      dp2 -= 320;
-    }
-    // adjust src ptrs - skip a row as we work in pairs
-    sp1 += rowadd2;
-    sp2 += rowadd2;
-    // adjust dest ptrs for rotation
-    dp1 += rowadd;
-    dp2 += rowadd;
+  if(image->width() != width()) {
+    // landscape mode, the image is turned on top of the display rotation
+    if (screenRotation == SDL_QT_ROTATION_90)
+      rotation += SDL_PRESENT_ROTATE_270;
+    else if (screenRotation == SDL_QT_ROTATION_270)
+      rotation += SDL_PRESENT_ROTATE_90;
+    rotation &= 3;
   }
-}
 
-// desktop, SL-A300 etc
-bool SDL_QWin::repaintRotation0(const QRect& rect) {
-  if(my_image->width() == width()) {
-    uchar *fb = (uchar*)my_painter->frameBuffer();
-    uchar *buf = (uchar*)my_image->bits();
-    if(rect == my_image->rect()) {
-      SDL_memcpy(fb, buf, width()*height()*2);
-    } else {
-      int h = rect.height();
-      int wd = rect.width()<<1;
-      int fblineadd = my_painter->lineStep();
-      int buflineadd = my_image->bytesPerLine();
-      fb  += (rect.left()<<1) + rect.top() * my_painter->lineStep();
-      buf += (rect.left()<<1) + rect.top() * my_image->bytesPerLine();
-      while(h--) {
-	SDL_memcpy(fb, buf, wd);
-	fb += fblineadd;
-	buf += buflineadd;
-      }
-    }
-  } else {
-    return false; // FIXME: Landscape
-  }
+  QRect r = rect & image->rect();
+  SDL_Rect area;
+  area.x = r.x();
+  area.y = r.y();
+  area.w = r.width();
+  area.h = r.height();
+  SDL_RotateRect(image->bits(), image->bytesPerLine(),
+		 my_painter->frameBuffer(), my_painter->lineStep(), 2,
+		 image->width(), image->height(), &area, rotation);
 #ifdef __i386__
   my_painter->fillRect( rect, QBrush( Qt::NoBrush ) );
 #endif
   return true;
 }
 
-  
-// Sharp Zaurus SL-5500 etc 
-bool SDL_QWin::repaintRotation3(const QRect& rect) {
-  if(my_image->width() == width()) {
-    ushort *fb = (ushort*)my_painter->frameBuffer();
-    ushort *buf = (ushort*)my_image->bits();
-    gs_fastRotateBlit_3(fb, buf, rect);
-  } else {
-    // landscape mode
-    if (screenRotation == SDL_QT_ROTATION_90) {
-      uchar *fb = (uchar*)my_painter->frameBuffer();
-      uchar *buf = (uchar*)my_image->bits();
-      if(rect == my_image->rect()) {
-	SDL_memcpy(fb, buf, width()*height()*2);
-      } else {
-	int h = rect.height();
-	int wd = rect.width()<<1;
-	int fblineadd = my_painter->lineStep();
-	int buflineadd = my_image->bytesPerLine();
-	fb  += (rect.left()<<1) + rect.top() * my_painter->lineStep();
-	buf += (rect.left()<<1) + rect.top() * my_image->bytesPerLine();
-	while(h--) {
-	  SDL_memcpy(fb, buf, wd);
-	  fb += fblineadd;
-	  buf += buflineadd;
-	}
-      }
-    } else if (screenRotation == SDL_QT_ROTATION_270) {
-      int h = rect.height();
-      int wd = rect.width();
-      int fblineadd = my_painter->lineStep() - (rect.width() << 1);
-      int buflineadd = my_image->bytesPerLine() - (rect.width() << 1);
-      int w;
-
-      uchar *fb = (uchar*)my_painter->frameBuffer();
-      uchar *buf = (uchar*)my_image->bits();
-        
-      fb += ((my_painter->width() - (rect.top() + rect.height())) * 
-	     my_painter->lineStep()) + ((my_painter->height() - ((rect.left() + 
-								  rect.width()))) << 1);
-
-      buf += my_image->bytesPerLine() * (rect.top() + rect.height()) -
-	(((my_image->width() - (rect.left() + rect.width())) << 1) + 2);
-
-      while(h--) {
-	w = wd;
-	while(w--) *((unsigned short*)fb)++ = *((unsigned short*)buf)--;
-	fb += fblineadd;
-	buf -= buflineadd;
-      }
-    }
-  }
-  return true;
-}
-
-// ipaq 3800...
-bool SDL_QWin::repaintRotation1(const QRect& rect) {
-  if(my_image->width() == width()) {
-    ushort *fb = (ushort*)my_painter->frameBuffer();
-    ushort *buf = (ushort*)my_image->bits();
-    gs_fastRotateBlit_1(fb, buf, rect);
-  } else {
-    return false; // FIXME: landscape mode
-  }
-  return true;
-}
-
 void SDL_QWin::repaintRect(const QRect& rect) {
   if(!my_painter || !rect.width() || !rect.height()) {
     return;
   }
   
+  QImage *image = gammaImage(rect);
   if(QPixmap::defaultDepth() == 16) {
-    switch(my_painter->transformOrientation()) {
-    case 3:
-      if(repaintRotation3(rect)) { return;  }
-      break;
-    case 1:
-      if(repaintRotation1(rect)) { return;  }
-      break;
-    case 0:
-      if(repaintRotation0(rect)) { return;  }
-      break;
-    }
-  } 
-  my_painter->drawImage(rect.topLeft(), *my_image, rect);
+    if(repaintDirect(image, rect)) { return; }
+  }
+  my_painter->drawImage(rect.topLeft(), *image, rect);
 }
 
 // This paints the current buffer to the screen, when desired. 
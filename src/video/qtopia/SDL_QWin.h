@@ -36,6 +36,8 @@
 
 extern "C" {
 #include "../../events/SDL_events_c.h"
+#include "../SDL_rotate_c.h"
+#include "../SDL_present_c.h"
 };
 
 typedef enum { 
@@ -60,6 +62,11 @@ class SDL_QWin : public QWidget
     my_inhibit_resize = true;
   }
   void setImage(QImage *image);
+  /* Paint the image through the gamma tables, NULL for none */
+  void setGamma(const SDL_GammaLUT *lut, const SDL_PixelFormat *format) {
+    my_gamma = lut;
+    my_gamma_format = format;
+  }
   void setOffset(int x, int y) {
     my_offset = QPoint(x, y);
   }
@@ -93,12 +100,14 @@ class SDL_QWin : public QWidget
   void keyPressEvent(QKeyEvent *e)   { QueueKey(e, 1); }
   void keyReleaseEvent(QKeyEvent *e) { QueueKey(e, 0); }
  private:
-  bool repaintRotation0(const QRect& rect);
-  bool repaintRotation1(const QRect& rect);
-  bool repaintRotation3(const QRect& rect);
+  bool repaintDirect(QImage *image, const QRect& rect);
+  QImage *gammaImage(const QRect& rect);
   void enableFullscreen();
   QDirectPainter *my_painter;
   QImage *my_image;
+  const SDL_GammaLUT *my_gamma;
+  const SDL_PixelFormat *my_gamma_format;
+  QImage *my_gamma_image;
   bool my_inhibit_resize;
   QPoint my_offset;
   QPoint my_mouse_pos;
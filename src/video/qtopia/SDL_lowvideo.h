@@ -26,6 +26,7 @@
 
 #include "SDL_mouse.h"
 #include "../SDL_sysvideo.h"
+#include "../SDL_present_c.h"
 
 /* Hidden "this" pointer for the video functions */
 #define _THIS	SDL_VideoDevice *_this
@@ -40,6 +41,9 @@ struct SDL_PrivateVideoData {
   int SDL_nummodes[NUM_MODELISTS];
   SDL_Rect **SDL_modelist[NUM_MODELISTS];
 
+  /* Software gamma, applied by the window */
+  SDL_GammaLUT gamma;
+
   /* A completely clear cursor */
   WMcursor *BlankCursor;
 
@@ -60,6 +64,7 @@ struct SDL_PrivateVideoData {
 #define last_buttons	(_this->hidden->last_buttons)
 #define last_point	(_this->hidden->last_point)
 #define key_flip	(_this->hidden->key_flip)
+#define QT_gamma	(_this->hidden->gamma)
 #define keyinfo		(_this->hidden->keyinfo)
 
 #endif /* _SDL_lowvideo_h */
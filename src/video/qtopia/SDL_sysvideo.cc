@@ -310,6 +310,10 @@ extern "C" {
     current->pitch = qimage->bytesPerLine();
     current->pixels = (void *)qimage->bits();
     SDL_Win->setImage(qimage);
+    /* Gamma ramps are emulated while painting */
+    SDL_BuildGammaLUT(&QT_gamma, _this->gamma);
+    SDL_Win->setGamma(&QT_gamma, current->format);
+    _this->gamma_lut = &QT_gamma;
     _this->UpdateRects = QT_NormalUpdate;
     SDL_Win->setFullscreen(true);
     /* We're done */
@@ -0,0 +1,224 @@
+/*
+    SDL - Simple DirectMedia Layer
+    Copyright (C) 1997-2006 Sam Lantinga
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+    Sam Lantinga
+    slouken@libsdl.org
+*/
+#include "SDL_config.h"
+
+#include "SDL_QTouchMap.h"
+
+#include <QFile>
+#include <QHash>
+#include <QStringList>
+#include <QTextStream>
+#include <QtDebug>
+
+/* Size of the lookup grid, per side */
+#define QT_TOUCH_BUCKETS 8
+
+SDL_QTouchMap::SDL_QTouchMap()
+{
+}
+
+static SDLMod modifierFromName(const QString &name)
+{
+  if(name == "shift")
+    return (SDLMod)KMOD_SHIFT;
+  if(name == "ctrl")
+    return (SDLMod)KMOD_CTRL;
+  if(name == "alt")
+    return (SDLMod)KMOD_ALT;
+  if(name == "meta")
+    return (SDLMod)KMOD_META;
+  return KMOD_NONE;
+}
+
+bool SDL_QTouchMap::parseKey(const QString &text, SDL_keysym *key) const
+{
+  static QHash<QString, int> names;
+
+  if(names.isEmpty()) {
+    for(int i = SDLK_FIRST; i < SDLK_LAST; ++i) {
+      QString name = QString(SDL_GetKeyName((SDLKey)i)).replace(' ', '_');
+      if(name != "unknown_key")
+        names.insert(name, i);
+    }
+  }
+
+  QStringList parts = text.toLower().split('+');
+  QString keyName = parts.takeLast();
+  int mod = KMOD_NONE;
+  foreach(QString part, parts) {
+    SDLMod m = modifierFromName(part);
+    if(m == KMOD_NONE)
+      return false;
+    mod |= m;
+  }
+
+  bool isNumber;
+  int sym = keyName.toInt(&isNumber);
+  if(!isNumber) {
+    if(!names.contains(keyName))
+      return false;
+    sym = names.value(keyName);
+  }
+  if(sym <= SDLK_FIRST || sym >= SDLK_LAST)
+    return false;
+
+  key->sym = (SDLKey)sym;
+  key->mod = (SDLMod)mod;
+  key->scancode = 0;
+  key->unicode = 0;
+  return true;
+}
+
+bool SDL_QTouchMap::parseCoord(const QString &text, Coord *coord) const
+{
+  bool ok;
+
+  coord->pixels = 0;
+  coord->percent = 0;
+  if(text.endsWith('%'))
+    coord->percent = text.left(text.length() - 1).toFloat(&ok);
+  else
+    coord->pixels = text.toFloat(&ok);
+  return ok;
+}
+
+bool SDL_QTouchMap::load(const QString &fileName)
+{
+  QFile file(fileName);
+  if(!file.open(QFile::ReadOnly | QFile::Text)) {
+    qWarning() << "failed to open keymap" << file.errorString();
+    return false;
+  }
+
+  QTextStream in(&file);
+  int lineNumber = 0;
+  while(!in.atEnd()) {
+    QStringList f = in.readLine().simplified().split(' ', QString::SkipEmptyParts);
+    ++lineNumber;
+    if(f.isEmpty() || f[0].startsWith('#'))
+      continue;
+
+    Zone zone;
+    bool ok = false;
+    if(f[0] == "rect" && f.size() == 6) {
+      ok = parseCoord(f[1], &zone.x) && parseCoord(f[2], &zone.y) &&
+           parseCoord(f[3], &zone.w) && parseCoord(f[4], &zone.h) &&
+           parseKey(f[5], &zone.key);
+      if(ok)
+        zones.append(zone);
+    } else if(f[0] == "grid" && f.size() > 7) {
+      int columns = f[1].toInt();
+      int rows = f[2].toInt();
+      Coord x, y, w, h;
+      QVector<Zone> cells;   /* installed once the whole grid is valid */
+      ok = columns > 0 && rows > 0 && f.size() == 7 + columns * rows &&
+           parseCoord(f[3], &x) && parseCoord(f[4], &y) &&
+           parseCoord(f[5], &w) && parseCoord(f[6], &h);
+      for(int i = 0; ok && i < columns * rows; ++i) {
+        const QString &name = f[7 + i];
+        if(name == "-")
+          continue;
+        if(!parseKey(name, &zone.key)) {
+          ok = false;
+          break;
+        }
+        int c = i % columns, r = i / columns;
+        zone.x.pixels = x.pixels + w.pixels * c / columns;
+        zone.x.percent = x.percent + w.percent * c / columns;
+        zone.y.pixels = y.pixels + h.pixels * r / rows;
+        zone.y.percent = y.percent + h.percent * r / rows;
+        zone.w.pixels = w.pixels / columns;
+        zone.w.percent = w.percent / columns;
+        zone.h.pixels = h.pixels / rows;
+        zone.h.percent = h.percent / rows;
+        cells.append(zone);
+      }
+      if(ok)
+        zones += cells;
+    }
+    if(!ok)
+      qWarning() << fileName << ":" << lineNumber << ": invalid zone";
+  }
+  compiledSize = QSize();
+  return true;
+}
+
+static inline int resolve(float pixels, float percent, int total)
+{
+  return (int)(pixels + percent * total / 100.0f + 0.5f);
+}
+
+void SDL_QTouchMap::compile(const QSize &size)
+{
+  const int buckets = QT_TOUCH_BUCKETS * QT_TOUCH_BUCKETS;
+  QVector<QVector<int> > lists(buckets);
+  QRect window(QPoint(0, 0), size);
+  int i, bx, by;
+
+  for(i = 0; i < zones.size(); ++i) {
+    Zone &z = zones[i];
+    int x0 = resolve(z.x.pixels, z.x.percent, size.width());
+    int y0 = resolve(z.y.pixels, z.y.percent, size.height());
+    int x1 = resolve(z.x.pixels + z.w.pixels, z.x.percent + z.w.percent, size.width());
+    int y1 = resolve(z.y.pixels + z.h.pixels, z.y.percent + z.h.percent, size.height());
+    z.rect = QRect(x0, y0, x1 - x0, y1 - y0) & window;
+    if(z.rect.isEmpty())
+      continue;
+    int bx0 = z.rect.left() * QT_TOUCH_BUCKETS / size.width();
+    int bx1 = z.rect.right() * QT_TOUCH_BUCKETS / size.width();
+    int by0 = z.rect.top() * QT_TOUCH_BUCKETS / size.height();
+    int by1 = z.rect.bottom() * QT_TOUCH_BUCKETS / size.height();
+    for(by = by0; by <= by1; ++by)
+      for(bx = bx0; bx <= bx1; ++bx)
+        lists[by * QT_TOUCH_BUCKETS + bx].append(i);
+  }
+
+  bucketStart.resize(buckets + 1);
+  bucketZones.clear();
+  for(i = 0; i < buckets; ++i) {
+    bucketStart[i] = bucketZones.size();
+    bucketZones += lists[i];
+  }
+  bucketStart[buckets] = bucketZones.size();
+  compiledSize = size;
+}
+
+int SDL_QTouchMap::lookup(const QPoint &pos, const QSize &size, SDL_keysym *keys)
+{
+  int count = 0;
+
+  if(zones.isEmpty() || size.isEmpty() ||
+     pos.x() < 0 || pos.y() < 0 ||
+     pos.x() >= size.width() || pos.y() >= size.height())
+    return 0;
+  if(size != compiledSize)
+    compile(size);
+
+  int bucket = (pos.y() * QT_TOUCH_BUCKETS / size.height()) * QT_TOUCH_BUCKETS +
+               pos.x() * QT_TOUCH_BUCKETS / size.width();
+  for(int i = bucketStart[bucket]; i < bucketStart[bucket + 1]; ++i) {
+    const Zone &z = zones[bucketZones[i]];
+    if(z.rect.contains(pos) && count < MaxKeys)
+      keys[count++] = z.key;
+  }
+  return count;
+}
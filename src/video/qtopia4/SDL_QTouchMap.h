@@ -0,0 +1,104 @@
+/*
+    SDL - Simple DirectMedia Layer
+    Copyright (C) 1997-2006 Sam Lantinga
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+    Sam Lantinga
+    slouken@libsdl.org
+*/
+#ifndef _SDL_QTouchMap_h
+#define _SDL_QTouchMap_h
+
+#include "SDL_config.h"
+
+#include <QPoint>
+#include <QRect>
+#include <QSize>
+#include <QString>
+#include <QVector>
+
+#include "SDL_keyboard.h"
+
+/**
+ * Key emulation for touch screens, read from the file named by
+ * SDL_QT_KEYMAP. Each line describes zones of the window:
+ *
+ *   rect <x> <y> <w> <h> <key>
+ *   grid <columns> <rows> <x> <y> <w> <h> <key>...
+ *
+ * Coordinates are pixels, or percent of the window size when followed
+ * by '%'. A grid lists the keys of its cells row by row, '-' leaves a
+ * cell empty. Keys are SDL key names with '_' for spaces ("up",
+ * "left_ctrl", "a") or key numbers, optionally prefixed by modifiers
+ * ("shift+a", "ctrl+alt+delete"). Lines starting with '#' are comments.
+ *
+ * A tap presses the keys of every zone it falls into, so overlapping
+ * zones give key combinations (e.g. diagonals).
+ */
+class SDL_QTouchMap {
+public:
+  enum {
+    MaxKeys = 4     /* most keys pressed by one tap */
+  };
+
+  SDL_QTouchMap();
+
+  /**
+   * Read the zones in \a fileName. Invalid lines are reported and
+   * skipped. Returns false if the file can't be read.
+   * Needs the SDL keyboard to be initialized for the key names.
+   */
+  bool load(const QString &fileName);
+
+  inline bool isEmpty() const {
+    return zones.isEmpty();
+  }
+
+  /**
+   * Store the keys for a tap at \a pos in a window of \a size in
+   * \a keys (at most MaxKeys) and return how many there are.
+   */
+  int lookup(const QPoint &pos, const QSize &size, SDL_keysym *keys);
+
+private:
+  /* pixels + percent of the window size */
+  struct Coord {
+    float pixels;
+    float percent;
+  };
+
+  struct Zone {
+    Coord x, y, w, h;
+    SDL_keysym key;
+    QRect rect;       /* for compiledSize */
+  };
+
+  bool parseCoord(const QString &text, Coord *coord) const;
+  bool parseKey(const QString &text, SDL_keysym *key) const;
+  void compile(const QSize &size);
+
+  QVector<Zone> zones;
+
+  /**
+   * The window is divided into Buckets x Buckets cells, each listing the
+   * zones overlapping it: bucketZones[bucketStart[i]..bucketStart[i+1]).
+   */
+  QSize compiledSize;
+  QVector<int> bucketStart;
+  QVector<int> bucketZones;
+};
+
+#endif /* _SDL_QTouchMap_h */
@@ -34,6 +34,7 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <stdlib.h>
+#include <limits.h>
 
 #include <QObject>
 #include <QPainter>
@@ -43,13 +44,20 @@
 #include <QSoftMenuBar>
 #include <QDesktopWidget>
 #include <QApplication>
+#include <QVector>
 #include <QtopiaApplication>
 
 #include <QtDebug>
 
 SDL_QWin::SDL_QWin(QWidget * parent, Qt::WindowFlags f)
   : QMainWindow(parent, f), 
-  rotationMode(NoRotation), backBuffer(NULL), useRightMouseButton(false),
+  rotationMode(NoRotation), backBuffer(NULL), backBufferData(NULL),
+  present(NULL),
+  directMode(false), directActive(false), directLocked(false),
+  directPainter(NULL), gamma(NULL), gammaFormat(NULL), gammaBuffer(NULL),
+  flipCount(0), drawIndex(0), queuedIndex(-1), presentingIndex(-1),
+  flipQuit(false), flipThread(NULL), flipLock(NULL), flipCond(NULL),
+  useRightMouseButton(false),
   keyboardShown(false), redrawEnabled(true), scriptEngine(this), scriptFun(),
   windowDeactivated(false)
 {
@@ -75,24 +83,427 @@ SDL_QWin::SDL_QWin(QWidget * parent, Qt::WindowFlags f)
       }
   }
   
-  pressedKey.sym = SDLK_UNKNOWN;
+  touchMapFile = getenv("SDL_QT_KEYMAP");
+  pressedKeyCount = 0;
+
+  // Longest time (ms) one event pump may spend in Qt, 0 for no limit
+  const char *pumpTimeEnv = getenv("SDL_QT_PUMP_TIME");
+  pumpTime = pumpTimeEnv ? atoi(pumpTimeEnv) : 0;
 }
 
 SDL_QWin::~SDL_QWin() {
+  stopFlipping();
+  delete directPainter;
   delete backBuffer;
+  delete gammaBuffer;
+  SDL_free(backBufferData);
 }
 
-void SDL_QWin::setBackBuffer(SDL_QWin::Rotation new_rotation, QImage *new_buffer) {
+void SDL_QWin::setBackBuffer(SDL_QWin::Rotation new_rotation, QImage *new_buffer,
+                             uchar *new_data) {
+  stopFlipping();
   rotationMode = new_rotation;
   delete backBuffer;
+  SDL_free(backBufferData);
   backBuffer = new_buffer;
+  backBufferData = new_data;
+  present = NULL;
+  gamma = NULL;
+  delete gammaBuffer;
+  gammaBuffer = NULL;
+  directMode = false;
+  directActive = false;
+  delete directPainter;
+  directPainter = NULL;
+}
+
+bool SDL_QWin::setFlipBuffers(QImage **buffers, int count)
+{
+  int i;
+
+  stopFlipping();
+  delete backBuffer;
+  SDL_free(backBufferData);
+  backBufferData = NULL;
+  delete gammaBuffer;
+  gammaBuffer = NULL;
+
+  flipLock = SDL_CreateMutex();
+  flipCond = SDL_CreateCond();
+  flipQuit = false;
+  drawIndex = 0;
+  queuedIndex = -1;
+  presentingIndex = -1;
+  for(i = 0; i < count; ++i)
+    flipBuffers[i] = buffers[i];
+  flipCount = count;
+  backBuffer = flipBuffers[0];
+  if(flipLock && flipCond)
+    flipThread = SDL_CreateThread(presentThread, this);
+  if(flipThread == NULL) {
+    stopFlipping();
+    return false;
+  }
+  return true;
+}
+
+void SDL_QWin::stopFlipping()
+{
+  int i;
+
+  if(flipCount == 0)
+    return;
+
+  if(flipThread) {
+    SDL_LockMutex(flipLock);
+    flipQuit = true;
+    SDL_CondBroadcast(flipCond);
+    SDL_UnlockMutex(flipLock);
+    SDL_WaitThread(flipThread, NULL);
+    flipThread = NULL;
+  }
+  if(flipCond) {
+    SDL_DestroyCond(flipCond);
+    flipCond = NULL;
+  }
+  if(flipLock) {
+    SDL_DestroyMutex(flipLock);
+    flipLock = NULL;
+  }
+  for(i = 0; i < flipCount; ++i)
+    delete flipBuffers[i];
+  flipCount = 0;
+  backBuffer = NULL;
+}
+
+/* The present thread may only touch the screen, widgets belong to the
+   GUI thread. Anything else is done synchronously by flip(). */
+bool SDL_QWin::canPresentAsync() const
+{
+  return redrawEnabled && !keyboardShown && !windowDeactivated && isVisible();
+}
+
+/* Wait until the present thread has nothing queued or in progress */
+void SDL_QWin::waitFlipIdle()
+{
+  SDL_LockMutex(flipLock);
+  while(queuedIndex >= 0 || presentingIndex >= 0)
+    SDL_CondWait(flipCond, flipLock);
+  SDL_UnlockMutex(flipLock);
+}
+
+uchar *SDL_QWin::flip()
+{
+  int next = (drawIndex + 1) % flipCount;
+
+  if(!canPresentAsync()) {
+    waitFlipIdle();
+    backBuffer = flipBuffers[drawIndex];
+    flushRegion(QRegion(backBuffer->rect()));
+  } else {
+    /* The gamma buffer only changes while the present thread is idle */
+    if(gammaActive() && gammaBuffer == NULL &&
+       !canBlitGamma(flipBuffers[drawIndex])) {
+      waitFlipIdle();
+      prepareGamma();
+    }
+    SDL_LockMutex(flipLock);
+    /* With two buffers the next one may still be on its way out */
+    while(queuedIndex >= 0 || presentingIndex == next)
+      SDL_CondWait(flipCond, flipLock);
+    backBuffer = flipBuffers[drawIndex];
+    queuedIndex = drawIndex;
+    queuedOrigin = pos();
+    queuedClip = QRegion(geometry());
+    /* The tables may change before the frame is on the screen */
+    if(gammaActive() && (gammaBuffer || canBlitGamma(flipBuffers[drawIndex])))
+      queuedGamma = *gamma;
+    else
+      queuedGamma.identity = 1;
+    SDL_CondBroadcast(flipCond);
+    SDL_UnlockMutex(flipLock);
+  }
+  drawIndex = next;
+  return flipBuffers[drawIndex]->bits();
+}
+
+int SDL_QWin::presentThread(void *data)
+{
+  ((SDL_QWin *)data)->presentLoop();
+  return 0;
+}
+
+void SDL_QWin::presentLoop()
+{
+  QPoint origin;
+  QRegion clip;
+  SDL_GammaLUT lut;
+  const QImage *image;
+  bool direct;
+
+  SDL_LockMutex(flipLock);
+  for(;;) {
+    while(queuedIndex < 0 && !flipQuit)
+      SDL_CondWait(flipCond, flipLock);
+    if(flipQuit)
+      break;
+    presentingIndex = queuedIndex;
+    queuedIndex = -1;
+    origin = queuedOrigin;
+    clip = queuedClip;
+    lut = queuedGamma;
+    SDL_CondBroadcast(flipCond);
+    SDL_UnlockMutex(flipLock);
+
+    image = flipBuffers[presentingIndex];
+    direct = !lut.identity && canBlitGamma(image);
+    if(!direct)
+      image = gammaImage(image, QRegion(image->rect()), &lut);
+
+    /* The screen is shared with the server and other clients, and this
+       isn't the GUI thread: hold the framebuffer lock while drawing */
+    QDirectPainter::lock();
+    if(direct)
+      blitGamma(image, origin, clip, &lut);
+    else
+      QScreen::instance()->blit(*image, origin, clip);
+    QDirectPainter::unlock();
+
+    SDL_LockMutex(flipLock);
+    presentingIndex = -1;
+    SDL_CondBroadcast(flipCond);
+  }
+  SDL_UnlockMutex(flipLock);
+}
+
+void SDL_QWin::setPresent(const SDL_PresentInfo *info)
+{
+  present = info;
+}
+
+void SDL_QWin::setGamma(const SDL_GammaLUT *lut, const SDL_PixelFormat *format)
+{
+  gamma = lut;
+  gammaFormat = format;
+}
+
+/* Make sure there is a gamma buffer matching the SDL buffer, returns
+   false if it couldn't be allocated */
+bool SDL_QWin::prepareGamma()
+{
+  if(gammaBuffer && gammaBuffer->size() == backBuffer->size() &&
+     gammaBuffer->format() == backBuffer->format())
+    return true;
+  delete gammaBuffer;
+  gammaBuffer = new QImage(backBuffer->size(), backBuffer->format());
+  if(gammaBuffer->isNull()) {
+    delete gammaBuffer;
+    gammaBuffer = NULL;
+    return false;
+  }
+  return true;
+}
+
+/* The image to show for \a region of \a buffer: the buffer itself, or
+   the gamma buffer with the region copied in through \a lut */
+const QImage *SDL_QWin::gammaImage(const QImage *buffer, const QRegion &region,
+                                   const SDL_GammaLUT *lut)
+{
+  int i, bpp;
+
+  if(lut == NULL || lut->identity || gammaBuffer == NULL)
+    return buffer;
+
+  bpp = buffer->depth() / 8;
+  QVector<QRect> rects = region.rects();
+  for(i = 0; i < rects.size(); ++i) {
+    QRect r = rects[i] & buffer->rect();
+    if(r.isEmpty())
+      continue;
+    SDL_GammaCopy(lut, gammaFormat,
+                  buffer->bits() + r.y() * buffer->bytesPerLine() + r.x() * bpp,
+                  buffer->bytesPerLine(),
+                  gammaBuffer->bits() + r.y() * gammaBuffer->bytesPerLine() +
+                  r.x() * bpp,
+                  gammaBuffer->bytesPerLine(), r.width(), r.height());
+  }
+  return gammaBuffer;
+}
+
+/* Whether blitGamma() can write \a buffer to the framebuffer, saving the
+   copy through the gamma buffer */
+bool SDL_QWin::canBlitGamma(const QImage *buffer) const
+{
+  QScreen *screen = QScreen::instance();
+
+  if(screen == NULL || screen->isTransformed())
+    return false;
+  return (QDirectPainter::frameBuffer() != NULL &&
+          buffer->depth() == QDirectPainter::screenDepth());
+}
+
+/* Show \a buffer at \a origin within \a clip (screen coordinates),
+   putting it through \a lut on its way into the framebuffer. The caller
+   holds QDirectPainter::lock(). */
+void SDL_QWin::blitGamma(const QImage *buffer, const QPoint &origin,
+                         const QRegion &clip, const SDL_GammaLUT *lut)
+{
+  QScreen *screen = QScreen::instance();
+  QRect screenRect(0, 0, QDirectPainter::screenWidth(),
+                   QDirectPainter::screenHeight());
+  QRegion region = clip & QRect(origin, buffer->size()) & screenRect;
+  int i, bpp, linestep;
+
+  bpp = buffer->depth() / 8;
+  linestep = QDirectPainter::linestep();
+  QVector<QRect> rects = region.rects();
+  for(i = 0; i < rects.size(); ++i) {
+    const QRect &r = rects[i];
+    SDL_GammaCopy(lut, gammaFormat,
+                  buffer->bits() + (r.y() - origin.y()) * buffer->bytesPerLine() +
+                  (r.x() - origin.x()) * bpp,
+                  buffer->bytesPerLine(),
+                  QDirectPainter::frameBuffer() + r.y() * linestep + r.x() * bpp,
+                  linestep, r.width(), r.height());
+  }
+  screen->setDirty(region.boundingRect());
+}
+
+QPoint SDL_QWin::toSDL(const QPoint &pos) const
+{
+  int x = pos.x(), y = pos.y();
+
+  if(present)
+    SDL_PresentMapPoint(present, &x, &y);
+  return QPoint(x, y);
+}
+
+bool SDL_QWin::directModeAvailable(const QImage *buffer)
+{
+  QScreen *screen = QScreen::instance();
+
+  if(screen == NULL || screen->isTransformed())
+    return false;
+  if(QDirectPainter::frameBuffer() == NULL)
+    return false;
+  return (buffer->depth() == QDirectPainter::screenDepth() &&
+          buffer->bytesPerLine() == QDirectPainter::linestep() &&
+          buffer->width() <= QDirectPainter::screenWidth() &&
+          buffer->height() <= QDirectPainter::screenHeight());
+}
+
+void SDL_QWin::setDirectMode(bool enable)
+{
+  leaveDirect();
+  directMode = enable && backBuffer && directModeAvailable(backBuffer);
+  if(directMode && directPainter == NULL)
+    directPainter = new QDirectPainter(this, QDirectPainter::ReservedSynchronous);
+}
+
+/* Anything drawn over our window (soft menu, input method, other apps)
+   would be overwritten by direct drawing, so use the back buffer then. */
+bool SDL_QWin::canDrawDirect() const
+{
+  if(!directMode || !redrawEnabled || keyboardShown || windowDeactivated)
+    return false;
+  /* The framebuffer would show the pixels without the gamma tables */
+  if(gammaActive())
+    return false;
+  if(!isVisible() || !isActiveWindow())
+    return false;
+  QRect g = geometry();
+  return (g.x() >= 0 && g.y() >= 0 &&
+          g.x() + backBuffer->width() <= QDirectPainter::screenWidth() &&
+          g.y() + backBuffer->height() <= QDirectPainter::screenHeight());
+}
+
+uchar *SDL_QWin::directPixels() const
+{
+  return QDirectPainter::frameBuffer() +
+         directRect.y() * QDirectPainter::linestep() +
+         directRect.x() * (backBuffer->depth() / 8);
+}
+
+/* Reserve the window area, so popups and other windows stay clipped out
+   of it while we draw there, and bring it up to date */
+bool SDL_QWin::enterDirect()
+{
+  directRect = geometry();
+  directPainter->setRegion(QRegion(directRect));
+  if(directPainter->allocatedRegion() != QRegion(directRect)) {
+    directPainter->setRegion(QRegion());
+    return false;
+  }
+  QScreen::instance()->blit(*backBuffer, directRect.topLeft(),
+                            QRegion(directRect));
+  directActive = true;
+  return true;
+}
+
+/* Copy the framebuffer back into the back buffer, so apps that only
+   update dirty rects keep a complete picture, then give the reserved
+   area back. Nothing can have been drawn over it until then. */
+void SDL_QWin::leaveDirect()
+{
+  int y, len;
+
+  if(!directActive)
+    return;
+
+  QDirectPainter::lock();
+  uchar *src = directPixels();
+  len = backBuffer->width() * (backBuffer->depth() / 8);
+  for(y = 0; y < backBuffer->height(); ++y)
+    memcpy(backBuffer->scanLine(y), src + y * QDirectPainter::linestep(), len);
+  QDirectPainter::unlock();
+  directPainter->setRegion(QRegion());
+  directActive = false;
+}
+
+uchar *SDL_QWin::lockBuffer()
+{
+  if(flipCount)
+    return flipBuffers[drawIndex]->bits();
+
+  bool wantDirect = canDrawDirect();
+
+  /* A moved window gets its new area reserved */
+  if(directActive && geometry() != directRect)
+    leaveDirect();
+
+  if(wantDirect != directActive) {
+    if(debug)
+      qDebug() << "switching to" << (wantDirect ? "framebuffer" : "back buffer");
+
+    if(wantDirect)
+      enterDirect();
+    else
+      leaveDirect();
+  }
+
+  if(directActive) {
+    QDirectPainter::lock();
+    directLocked = true;
+    return directPixels();
+  }
+  return backBuffer->bits();
+}
+
+void SDL_QWin::unlockBuffer()
+{
+  if(directLocked) {
+    QDirectPainter::unlock();
+    directLocked = false;
+  }
 }
 
 void SDL_QWin::toggleKeyboard()
 {
     keyboardShown = !keyboardShown;
-    if(keyboardShown)
+    if(keyboardShown) {
+        leaveDirect();
         QtopiaApplication::showInputMethod();
+    }
     else
         QtopiaApplication::hideInputMethod();
 }
@@ -104,6 +515,7 @@ void SDL_QWin::enableRedraw()
 
 void SDL_QWin::disableRedraw()
 {
+    leaveDirect();
     redrawEnabled = false;
 }
 
@@ -121,6 +533,7 @@ bool SDL_QWin::event(QEvent *event)
     // Needed for QtMoko fullscreen
     if(event->type() == QEvent::WindowDeactivate)
     {
+        leaveDirect();
         windowDeactivated = true;
         lower();
         QMenu *menu = QSoftMenuBar::menuFor(this);
@@ -161,9 +574,108 @@ void SDL_QWin::resume() { // FIXME: not used
 }
 
 void SDL_QWin::closeEvent(QCloseEvent *e) {
+  flushInput();
   SDL_PrivateQuit();
 }
 
+void SDL_QWin::queueMotion(Uint8 state, int relative, const QPoint &pos)
+{
+  if(!pendingInput.isEmpty()) {
+    PendingInput &last = pendingInput.last();
+    if(last.type == PendingInput::Motion && last.state == state &&
+       last.relative == relative) {
+      if(relative)
+        last.pos += pos;
+      else
+        last.pos = pos;
+      return;
+    }
+  }
+
+  PendingInput input;
+  input.type = PendingInput::Motion;
+  input.state = state;
+  input.relative = relative;
+  input.pos = pos;
+  pendingInput.append(input);
+}
+
+void SDL_QWin::queueButton(Uint8 state, Uint8 button, const QPoint &pos)
+{
+  PendingInput input;
+  input.type = PendingInput::Button;
+  input.state = state;
+  input.button = button;
+  input.pos = pos;
+  pendingInput.append(input);
+}
+
+void SDL_QWin::queueKey(Uint8 state, const SDL_keysym &key)
+{
+  PendingInput input;
+  input.type = PendingInput::Key;
+  input.state = state;
+  input.key = key;
+  pendingInput.append(input);
+}
+
+/**
+ * SDL_PrivateKeyboard() takes the modifier state from the keys it has seen
+ * go down, not from keysym.mod: emulated keys with modifiers are wrapped
+ * in presses and releases of the left modifier keys.
+ */
+void SDL_QWin::queueModifierKeys(Uint8 state, SDLMod mod)
+{
+  static const struct {
+    int mod;
+    SDLKey sym;
+  } modifiers[] = {
+    { KMOD_SHIFT, SDLK_LSHIFT },
+    { KMOD_CTRL, SDLK_LCTRL },
+    { KMOD_ALT, SDLK_LALT },
+    { KMOD_META, SDLK_LMETA },
+  };
+  const int count = sizeof(modifiers) / sizeof(modifiers[0]);
+
+  for(int i = 0; i < count; ++i) {
+    /* Released in the opposite order */
+    int m = (state == SDL_PRESSED) ? i : count - 1 - i;
+    if(!(mod & modifiers[m].mod))
+      continue;
+
+    SDL_keysym key;
+    key.sym = modifiers[m].sym;
+    key.scancode = 0;
+    key.unicode = 0;
+    key.mod = KMOD_NONE;
+    queueKey(state, key);
+  }
+}
+
+void SDL_QWin::flushInput()
+{
+  if(pendingInput.isEmpty())
+    return;
+
+  SDL_LockEventQueue();
+  for(int i = 0; i < pendingInput.size(); ++i) {
+    PendingInput &input = pendingInput[i];
+    switch(input.type) {
+    case PendingInput::Motion:
+      SDL_PrivateMouseMotion(input.state, input.relative, input.pos.x(), input.pos.y());
+      break;
+    case PendingInput::Button:
+      SDL_PrivateMouseButton(input.state, input.button, input.pos.x(), input.pos.y());
+      break;
+    case PendingInput::Key:
+      SDL_PrivateKeyboard(input.state, &input.key);
+      break;
+    }
+  }
+  SDL_UnlockEventQueue();
+  pendingInput.clear();
+}
+
 void SDL_QWin::mouseMoveEvent(QMouseEvent *e) {
   int sdlstate = 0;
   if (pressedButton == Qt::LeftButton) {
@@ -172,8 +684,42 @@ void SDL_QWin::mouseMoveEvent(QMouseEvent *e) {
     sdlstate |= SDL_BUTTON_RMASK;
   }
   
-  mousePosition = e->globalPos();
-  SDL_PrivateMouseMotion(sdlstate, 0, mousePosition.x(), mousePosition.y());
+  mousePosition = toSDL(e->globalPos());
+  queueMotion(sdlstate, 0, mousePosition);
+}
+
+/**
+ * Find the keys a tap at \a pos emulates. The touch keymap is tried first,
+ * the script only gets the taps the keymap doesn't cover.
+ */
+int SDL_QWin::tapKeys(const QPoint &pos, SDL_keysym *keys)
+{
+  // Key names are only known once the SDL keyboard is up
+  if(!touchMapFile.isEmpty()) {
+    if(debug)
+      qDebug() << "using keymap file" << touchMapFile;
+    touchMap.load(touchMapFile);
+    touchMapFile = QString();
+  }
+
+  int count = touchMap.lookup(pos, size(), keys);
+  if(count || !scriptFun.isValid())
+    return count;
+
+  QScriptValueList args;
+  args << pos.x() << pos.y() << width() << height();
+  if(debug)
+    qDebug() << "calling script x=" << pos.x() << ", y=" << pos.y() << ", w=" << width() << ", h=" << height();
+
+  QScriptValue scriptRes = scriptFun.call(QScriptValue(), args);
+  if(!scriptRes.toBool())
+    return 0;
+
+  keys[0].sym = (SDLKey) scriptEngine.globalObject().property("sym").toInt32();
+  keys[0].scancode = (Uint8)(scriptEngine.globalObject().property("scancode").toInt32());
+  keys[0].unicode = 0;
+  keys[0].mod = (SDLMod)(scriptEngine.globalObject().property("mod").toInt32());
+  return 1;
 }
 
 void SDL_QWin::mousePressEvent(QMouseEvent *e) {
@@ -183,65 +729,164 @@ void SDL_QWin::mousePressEvent(QMouseEvent *e) {
       return;
   }
     
-  // Emulate keys using mouse press and javascipt
-  if(scriptFun.isValid()) {
-    QScriptValueList args;
-    args << e->x() << e->y() << width() << height();
-    if(debug)
-        qDebug() << "calling script x=" << e->x() << ", y=" << e->y() << ", w=" << width() << ", h=" << height();
-    
-    QScriptValue scriptRes = scriptFun.call(QScriptValue(), args);
-    if(scriptRes.toBool()) {
-        
-        pressedKey.sym = (SDLKey) scriptEngine.globalObject().property("sym").toInt32();
-        pressedKey.scancode = (Uint8)(scriptEngine.globalObject().property("scancode").toInt32());
-        pressedKey.unicode = 0;
-        pressedKey.mod = (SDLMod)(scriptEngine.globalObject().property("mod").toInt32());
-        
-        if(debug)
-            qDebug() << "emualting key sym=" << pressedKey.sym << ", scancode=" << pressedKey.scancode << ", mod=" << pressedKey.mod;
-       
-        SDL_PrivateKeyboard(SDL_PRESSED, &pressedKey);
+  // Emulate keys using mouse press
+  pressedKeyCount = tapKeys(e->pos(), pressedKeys);
+  if(pressedKeyCount) {
+    for(int i = 0; i < pressedKeyCount; ++i) {
+      if(debug)
+        qDebug() << "emulating key sym=" << pressedKeys[i].sym << ", scancode=" << pressedKeys[i].scancode << ", mod=" << pressedKeys[i].mod;
+      queueModifierKeys(SDL_PRESSED, pressedKeys[i].mod);
+      queueKey(SDL_PRESSED, pressedKeys[i]);
     }
+    return;
   }
-    
+
   mouseMoveEvent(e);
   if (useRightMouseButton)
     pressedButton = Qt::RightButton;
   else
     pressedButton = e->button();
 
-  mousePosition = e->globalPos();
-  SDL_PrivateMouseButton(SDL_PRESSED, (pressedButton==Qt::LeftButton)?SDL_BUTTON_LEFT:SDL_BUTTON_RIGHT,
-     mousePosition.x(), mousePosition.y());
+  mousePosition = toSDL(e->globalPos());
+  queueButton(SDL_PRESSED, (pressedButton==Qt::LeftButton)?SDL_BUTTON_LEFT:SDL_BUTTON_RIGHT,
+     mousePosition);
 }
 
 void SDL_QWin::mouseReleaseEvent(QMouseEvent *e) {
 
-    if(pressedKey.sym != SDLK_UNKNOWN)
+    if(pressedKeyCount)
     {
-        SDL_PrivateKeyboard(SDL_RELEASED, &pressedKey);
+        while(pressedKeyCount) {
+            const SDL_keysym &key = pressedKeys[--pressedKeyCount];
+            queueKey(SDL_RELEASED, key);
+            queueModifierKeys(SDL_RELEASED, key.mod);
+        }
         return;
     }
     
-  mousePosition = e->globalPos();
-  SDL_PrivateMouseButton(SDL_RELEASED, (pressedButton==Qt::LeftButton)?SDL_BUTTON_LEFT:SDL_BUTTON_RIGHT,
-     mousePosition.x(), mousePosition.y());
+  mousePosition = toSDL(e->globalPos());
+  queueButton(SDL_RELEASED, (pressedButton==Qt::LeftButton)?SDL_BUTTON_LEFT:SDL_BUTTON_RIGHT,
+     mousePosition);
+}
+
+/* Fixed cost of one extra screen blit, expressed in pixels. Two damage
+   rects are merged when copying the gap between them is cheaper than that. */
+#define QT_BLIT_SETUP_COST      (32*32)
+/* Flush the whole window once the damage covers this much of it (percent) */
+#define QT_FULL_BLIT_PERCENT    60
+/* Never issue more screen blits than this per flush */
+#define QT_MAX_DAMAGE_RECTS     8
+/* Regions with more rects than this are flushed by their bounding rect */
+#define QT_MAX_MERGE_RECTS      64
+
+static inline int rectArea(const QRect &r)
+{
+    return r.width() * r.height();
+}
+
+/**
+ * Reduce \a region to a few rectangles inside \a bounds. Pairs of rects are
+ * merged greedily while the extra area copied stays below the blit setup cost
+ * (or while there are too many rects). Returns true in \a full when it is
+ * cheaper to just flush everything.
+ */
+static QRegion mergeDamage(const QRegion &region, const QRect &bounds, bool *full)
+{
+    QVector<QRect> rects;
+    int i, j, area;
+
+    *full = false;
+    if(region.rects().size() > QT_MAX_MERGE_RECTS) {
+        rects.append(region.boundingRect() & bounds);
+    } else {
+        foreach(QRect r, region.rects()) {
+            r &= bounds;
+            if(!r.isEmpty())
+                rects.append(r);
+        }
+    }
+
+    while(rects.size() > 1) {
+        int best_i = 0, best_j = 1;
+        int best_cost = INT_MAX;
+        for(i = 0; i < rects.size(); ++i) {
+            for(j = i + 1; j < rects.size(); ++j) {
+                int cost = rectArea(rects[i] | rects[j]) -
+                           rectArea(rects[i]) - rectArea(rects[j]);
+                if(cost < best_cost) {
+                    best_cost = cost;
+                    best_i = i;
+                    best_j = j;
+                }
+            }
+        }
+        if(best_cost > QT_BLIT_SETUP_COST && rects.size() <= QT_MAX_DAMAGE_RECTS)
+            break;
+        rects[best_i] |= rects[best_j];
+        rects.remove(best_j);
+    }
+
+    QRegion damage;
+    area = 0;
+    for(i = 0; i < rects.size(); ++i) {
+        if(rects[i].isEmpty())
+            continue;
+        damage += rects[i];
+        area += rectArea(rects[i]);
+    }
+    if(area * 100 >= rectArea(bounds) * QT_FULL_BLIT_PERCENT)
+        *full = true;
+    return damage;
 }
 
 void SDL_QWin::flushRegion(const QRegion &region) {
 
-    if(backBuffer == NULL)
+    if(backBuffer == NULL || directActive)
         return;
+
+    /* Don't race the present thread for the screen */
+    if(flipCount)
+        waitFlipIdle();
+
+    const SDL_GammaLUT *lut = NULL;
     
     if(keyboardShown || windowDeactivated) {
+        if(gammaActive() && prepareGamma())
+            lut = gamma;
+        const QImage *image = gammaImage(backBuffer, QRegion(backBuffer->rect()), lut);
         QPainter p(this);
-        p.drawImage(geometry(), *backBuffer, backBuffer->rect());
+        p.drawImage(geometry(), *image, image->rect());
         return;
     }
     
-    if(redrawEnabled)
-        QScreen::instance()->blit(*backBuffer, pos(), QRegion(geometry()));
+    if(!redrawEnabled)
+        return;
+
+    bool full;
+    QRegion damage = mergeDamage(region, backBuffer->rect(), &full);
+    if(damage.isEmpty())
+        return;
+
+    if(debug)
+        qDebug() << "flushRegion" << damage.rects().size() << "rects, full=" << full;
+
+    QRegion clip = full ? QRegion(geometry()) :
+                          damage.translated(pos()) & geometry();
+
+    /* The tables go on in the copy to the framebuffer when it is there */
+    if(gammaActive() && canBlitGamma(backBuffer)) {
+        QDirectPainter::lock();
+        blitGamma(backBuffer, pos(), clip, gamma);
+        QDirectPainter::unlock();
+        return;
+    }
+
+    if(gammaActive() && prepareGamma())
+        lut = gamma;
+    const QImage *image = gammaImage(backBuffer,
+                                     full ? QRegion(backBuffer->rect()) : damage,
+                                     lut);
+    QScreen::instance()->blit(*image, pos(), clip);
 }
 
 // This paints the current buffer to the screen, when desired.
@@ -507,7 +1152,7 @@ void SDL_QWin::keyEvent(bool pressed, QKeyEvent *e) {
     qDebug() << "SDL_QWin::keyEvent pressed=" << pressed << ", e->key()=" << e->key() << ",e->text()=" << e->text() << "k.sym=" << k.sym << ", k.scancode=" << k.scancode << ", k.mod=" << k.mod;
   
   if (pressed)
-    SDL_PrivateKeyboard(SDL_PRESSED, &k);
+    queueKey(SDL_PRESSED, k);
   else
-    SDL_PrivateKeyboard(SDL_RELEASED, &k);
+    queueKey(SDL_RELEASED, k);
 }
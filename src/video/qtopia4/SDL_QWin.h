@@ -29,12 +29,17 @@
 #include <QMainWindow>
 #include <QDirectPainter>
 #include <QMatrix>
+#include <QVector>
 #include <QtScript/QScriptEngine>
 
 #include "SDL_events.h"
+#include "SDL_QTouchMap.h"
+#include "SDL_thread.h"
+#include "SDL_mutex.h"
 
 extern "C" {
 #include "../../events/SDL_events_c.h"
+#include "../SDL_present_c.h"
 };
 
 class SDL_QWin : public QMainWindow {
@@ -54,18 +59,90 @@ public:
    * Instruct window to use \a buffer as framebuffer and assume 
    * that screen is rotated according to \a rotation
    */
-  void setBackBuffer(Rotation rotation, QImage *buffer);
+  void setBackBuffer(Rotation rotation, QImage *buffer, uchar *data = 0);
+
+  /**
+   * Let SDL draw straight into the framebuffer whenever nothing covers
+   * the window. The back buffer is only used while we can't. While
+   * drawing directly the window area is reserved, so nothing can be
+   * drawn over it.
+   */
+  void setDirectMode(bool enable);
+
+  /**
+   * Return true if the framebuffer can be addressed directly with
+   * \a buffer layout (same depth and pitch, no screen transformation).
+   */
+  static bool directModeAvailable(const QImage *buffer);
+
+  /**
+   * Return pixels SDL should draw into until unlockBuffer() is called.
+   * Switches between framebuffer and back buffer as the window gets
+   * covered/uncovered, copying the contents over.
+   */
+  uchar *lockBuffer();
+  void unlockBuffer();
+
+  /**
+   * True when the last locked pixels went straight to the screen.
+   */
+  inline bool isDirect() const {
+    return directActive;
+  }
   
+  enum {
+    MaxFlipBuffers = 3
+  };
+
+  /**
+   * Cycle through \a count (2 or 3) buffers on flip(). Finished buffers
+   * are put on the screen by a separate thread, so the next frame can be
+   * drawn meanwhile. Takes ownership of the buffers, reset by
+   * setBackBuffer(). Returns false if the thread couldn't be started.
+   */
+  bool setFlipBuffers(QImage **buffers, int count);
+
+  /**
+   * Queue the buffer SDL has drawn into for presentation and return the
+   * pixels of the next one. Only blocks while all buffers are in use.
+   */
+  uchar *flip();
+
+  inline bool isFlipping() const {
+    return flipCount > 0;
+  }
+
   /**
    * Update screen contents from SDL buffer.
    * NOTE: \a region contains coordinates in SDL system (no rotation applied)
    */
   void flushRegion(const QRegion& region);
 
+  /**
+   * The SDL surface is shown scaled/rotated through \a info, map mouse
+   * positions accordingly. Reset by setBackBuffer().
+   */
+  void setPresent(const SDL_PresentInfo *info);
+
+  /**
+   * Put the SDL buffer through \a lut (for pixels in \a format) on its
+   * way to the screen, in modes without a present stage. The tables are
+   * read on every update, so they may be changed in place. Drawing
+   * straight into the framebuffer stops while they aren't the identity.
+   * Reset by setBackBuffer().
+   */
+  void setGamma(const SDL_GammaLUT *lut, const SDL_PixelFormat *format);
+
   inline QPoint getMousePosition() const {
     return mousePosition;
   }
 
+  /**
+   * Pass the input received since the last call on to the SDL event
+   * queue, locking it only once. Called after each event pump.
+   */
+  void flushInput();
+
 public slots:
    void showOnFullScreen();
    void toggleKeyboard();
@@ -88,10 +165,67 @@ private:
   void init();
   void suspend();
   void resume();
+  QPoint toSDL(const QPoint &pos) const;
+  int tapKeys(const QPoint &pos, SDL_keysym *keys);
+  bool canDrawDirect() const;
+  bool enterDirect();
+  void leaveDirect();
+  uchar *directPixels() const;
+  bool canPresentAsync() const;
+  void waitFlipIdle();
+  void stopFlipping();
+  void presentLoop();
+  static int presentThread(void *data);
+  void queueMotion(Uint8 state, int relative, const QPoint &pos);
+  void queueButton(Uint8 state, Uint8 button, const QPoint &pos);
+  void queueKey(Uint8 state, const SDL_keysym &key);
+  void queueModifierKeys(Uint8 state, SDLMod mod);
+  inline bool gammaActive() const {
+    return gamma && !gamma->identity;
+  }
+  bool prepareGamma();
+  const QImage *gammaImage(const QImage *buffer, const QRegion &region,
+                           const SDL_GammaLUT *lut);
+  bool canBlitGamma(const QImage *buffer) const;
+  void blitGamma(const QImage *buffer, const QPoint &origin,
+                 const QRegion &clip, const SDL_GammaLUT *lut);
 
   QImage *backBuffer;
+  uchar *backBufferData;
+  const SDL_PresentInfo *present;
+  bool directMode;
+  bool directActive;
+  bool directLocked;
+  QDirectPainter *directPainter;
+  QRect directRect;	/* Screen area reserved while directActive */
   Rotation rotationMode;
 
+  /**
+   * Software gamma: the tables, and the buffer the SDL buffer is copied
+   * into through them when they can't be applied on the way into the
+   * framebuffer (QPainter drawing, transformed screens)
+   */
+  const SDL_GammaLUT *gamma;
+  const SDL_PixelFormat *gammaFormat;
+  QImage *gammaBuffer;
+
+  /**
+   * Page flipping state, shared with the present thread under flipLock.
+   * backBuffer points to the last flipped buffer, for repaints.
+   */
+  QImage *flipBuffers[MaxFlipBuffers];
+  int flipCount;
+  int drawIndex;
+  int queuedIndex;
+  int presentingIndex;
+  bool flipQuit;
+  QPoint queuedOrigin;
+  QRegion queuedClip;
+  SDL_GammaLUT queuedGamma;
+  SDL_Thread *flipThread;
+  SDL_mutex *flipLock;
+  SDL_cond *flipCond;
+
   /**
    * When modifier key is pressed, treat left mouse button as right.
    * This way, we need to remember which key was pressed while moving pointer.
@@ -103,12 +237,30 @@ private:
    * SDL needs to know current mouse position sometimes
    */
   QPoint mousePosition;
+
+  /**
+   * Input waiting for flushInput(), in arrival order. Consecutive motion
+   * with the same button state is merged into a single entry.
+   */
+  struct PendingInput {
+    enum Type { Motion, Button, Key } type;
+    Uint8 state;
+    Uint8 button;
+    int relative;
+    QPoint pos;
+    SDL_keysym key;
+  };
+  QVector<PendingInput> pendingInput;
 public:
   bool debug;
   bool keyboardShown;
   bool redrawEnabled;
   bool windowDeactivated;
-  SDL_keysym pressedKey;
+  int pumpTime;
+  SDL_keysym pressedKeys[SDL_QTouchMap::MaxKeys];
+  int pressedKeyCount;
+  QString touchMapFile;
+  SDL_QTouchMap touchMap;
   QScriptEngine scriptEngine;
   QScriptValue scriptFun;
   };
@@ -26,10 +26,12 @@
 
 #include "SDL_mouse.h"
 #include "../SDL_sysvideo.h"
+#include "../SDL_present_c.h"
 
 /* Hidden "this" pointer for the video functions */
 #define _THIS	SDL_VideoDevice *_this
 #include <QObject>
+#include <QSize>
 /* Private display data */
 struct SDL_PrivateVideoData {
   /* The main window */
@@ -40,6 +42,18 @@ struct SDL_PrivateVideoData {
   int SDL_nummodes[NUM_MODELISTS];
   SDL_Rect **SDL_modelist[NUM_MODELISTS];
 
+  /* The size of the whole screen */
+  QSize desktop_size;
+
+  /* Rotated/scaled modes: the SDL surface pixels and the screen sized
+     surface they are presented to (NULL when not presenting) */
+  void *logical_pixels;
+  SDL_Surface *physical;
+  SDL_PresentInfo present;
+
+  /* Software gamma, applied by the present stage or the window */
+  SDL_GammaLUT gamma;
+
   /* A completely clear cursor */
   WMcursor *BlankCursor;
 
@@ -56,6 +70,11 @@ struct SDL_PrivateVideoData {
 #define saved_mode	(_this->hidden->saved_mode)
 #define SDL_nummodes	(_this->hidden->SDL_nummodes)
 #define SDL_modelist	(_this->hidden->SDL_modelist)
+#define QT_desktop_size	(_this->hidden->desktop_size)
+#define QT_logical_pixels	(_this->hidden->logical_pixels)
+#define QT_physical	(_this->hidden->physical)
+#define QT_present	(_this->hidden->present)
+#define QT_gamma	(_this->hidden->gamma)
 #define SDL_BlankCursor	(_this->hidden->BlankCursor)
 #define last_buttons	(_this->hidden->last_buttons)
 #define last_point	(_this->hidden->last_point)
@@ -37,7 +37,14 @@ extern "C" {
     if (!qApp) {
       return;
     }
-    qApp->processEvents();
+    if (SDL_Win && SDL_Win->pumpTime > 0) {
+      qApp->processEvents(QEventLoop::AllEvents, SDL_Win->pumpTime);
+    } else {
+      qApp->processEvents();
+    }
+    if (SDL_Win) {
+      SDL_Win->flushInput();
+    }
   }
 
   void QT_InitOSKeymap(_THIS) {}
@@ -28,7 +28,6 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
-#include <linux/fb.h>
 
 #include <qtopiaapplication.h>
 #include <QObject>
@@ -37,6 +36,9 @@
 #include <QSoftMenuBar>
 #include <QDesktopWidget>
 #include <QtopiaApplication>
+#include <QScreen>
+#include <QList>
+#include <QtAlgorithms>
 #include "SDL_timer.h"
 #include "SDL_QWin.h"
 
@@ -49,6 +51,7 @@ extern "C" {
 #include "SDL_sysmouse_c.h"
 #include "SDL_syswm_c.h"
 #include "SDL_lowvideo.h"
+#include "../SDL_present_c.h"
 
   //#define EZX_DEBUG
 #define QT_HIDDEN_SIZE	32	/* starting hidden window size */
@@ -59,6 +62,22 @@ extern "C" {
   0: Screen is 90 rotated*/
 #define SDL_QT_ROTATION_ENV_NAME "SDL_QT_INVERT_ROTATION"
 
+  /* Name of the environment variable used to let SDL draw straight into
+     the framebuffer (the QImage back buffer is then only used while the
+     window is covered by a menu or the input method) */
+#define SDL_QT_DIRECT_ENV_NAME "SDL_QT_DIRECT"
+
+  /* Name of the environment variable used to choose the number of buffers
+     SDL_Flip() cycles through with SDL_DOUBLEBUF: 2 or 3 (default) */
+#define SDL_QT_BUFFERS_ENV_NAME "SDL_QT_BUFFERS"
+
+  /* Name of the environment variable used to scale the SDL surface to the
+     screen. Possible values:
+     nearest : Scale to fit, nearest neighbour
+     integer : Scale by the largest whole factor that fits
+     bilinear: Scale to fit, bilinear filtering */
+#define SDL_QT_SCALE_ENV_NAME "SDL_QT_SCALE"
+
   /* Initialization/Query functions */
   static int QT_VideoInit(_THIS, SDL_PixelFormat *vformat);
   static SDL_Rect **QT_ListModes(_THIS, SDL_PixelFormat *format, Uint32 flags);
@@ -72,6 +91,7 @@ extern "C" {
   static int QT_LockHWSurface(_THIS, SDL_Surface *surface);
   static void QT_UnlockHWSurface(_THIS, SDL_Surface *surface);
   static void QT_FreeHWSurface(_THIS, SDL_Surface *surface);
+  static int QT_FlipHWSurface(_THIS, SDL_Surface *surface);
 
   static int QT_ToggleFullScreen(_THIS, int fullscreen);
 
@@ -123,7 +143,7 @@ extern "C" {
     device->SetHWAlpha = NULL;
     device->LockHWSurface = QT_LockHWSurface;
     device->UnlockHWSurface = QT_UnlockHWSurface;
-    device->FlipHWSurface = NULL;
+    device->FlipHWSurface = QT_FlipHWSurface;
     device->FreeHWSurface = QT_FreeHWSurface;
     device->SetIcon = NULL;
     device->SetCaption = QT_SetWMCaption;
@@ -141,7 +161,7 @@ extern "C" {
     device->ToggleFullScreen = QT_ToggleFullScreen;
 
     /* Set the driver flags */
-    device->handles_any_size = 0;
+    device->handles_any_size = 1;
 
     return device;
   }
@@ -198,6 +218,73 @@ extern "C" {
     return(0);
   }
   
+  /* Depths QScreen::blit can present without an SDL shadow surface */
+#define QT_NUM_DEPTHS 2
+  static const int QT_depths[QT_NUM_DEPTHS] = { 16, 32 };
+
+  static int QT_SupportedDepth(int bpp) {
+    for ( int i = 0; i < QT_NUM_DEPTHS; ++i ) {
+      if ( QT_depths[i] == bpp ) {
+        return(1);
+      }
+    }
+    return(0);
+  }
+
+  /* Use 16 bpp only when the screen really is RGB565, so that
+     QScreen::blit is a plain copy */
+  static int QT_NativeBitsPerPixel(void) {
+    QScreen *screen = QScreen::instance();
+
+    if ( screen && screen->depth() == 16 &&
+         (screen->pixelFormat() == QImage::Format_RGB16 ||
+          screen->pixelFormat() == QImage::Format_Invalid) ) {
+      return(16);
+    }
+    return(32);
+  }
+
+  static QImage::Format QT_ImageFormat(int bpp) {
+    return (bpp == 16) ? QImage::Format_RGB16 : QImage::Format_RGB32;
+  }
+
+  static void QT_SetFormatMasks(int bpp, Uint32 *Rmask, Uint32 *Gmask,
+                                Uint32 *Bmask) {
+    if ( bpp == 16 ) {
+      *Rmask = 0xF800;
+      *Gmask = 0x07E0;
+      *Bmask = 0x001F;
+    } else {
+      *Rmask = 0x00FF0000;
+      *Gmask = 0x0000FF00;
+      *Bmask = 0x000000FF;
+    }
+  }
+
+  /* Common game resolutions offered in addition to the screen size */
+  static const struct {
+    int w, h;
+  } QT_mode_sizes[] = {
+    { 800, 600 },
+    { 640, 480 },
+    { 480, 320 },
+    { 400, 300 },
+    { 320, 240 },
+  };
+#define QT_NUM_MODE_SIZES (sizeof(QT_mode_sizes)/sizeof(QT_mode_sizes[0]))
+
+  static inline QSize QT_Transposed(const QSize &size) {
+    return QSize(size.height(), size.width());
+  }
+
+  /* SDL wants the mode list sorted largest first */
+  static bool QT_ModeGreaterThan(const QSize &a, const QSize &b) {
+    if ( a.width() * a.height() != b.width() * b.height() ) {
+      return a.width() * a.height() > b.width() * b.height();
+    }
+    return a.width() > b.width();
+  }
+
   QtopiaApplication *app;
 
   int QT_VideoInit(_THIS, SDL_PixelFormat *vformat) {
@@ -209,16 +296,41 @@ extern "C" {
       
     /* Initialize the EzX Application  */
     /* Determine the screen depth */
-    vformat->BitsPerPixel = 32; 
-
-    // For now we hardcode the current depth because anything else
-    // might as well be emulated by SDL rather than by EzX.
-
-    QSize desktop_size = QSize(480, 640);//qApp->desktop()->size();
-    QT_AddMode(_this, ((vformat->BitsPerPixel+7)/8)-1,
-               desktop_size.width(), desktop_size.height());
-    QT_AddMode(_this, ((vformat->BitsPerPixel+7)/8)-1,
-               desktop_size.height(), desktop_size.width());
+    vformat->BitsPerPixel = QT_NativeBitsPerPixel();
+
+    /* Determine the screen size and the part not taken by the
+       title and soft menu bars */
+    QSize desktop_size = qApp->desktop()->size();
+    QSize avail_size = qApp->desktop()->availableGeometry().size();
+    if ( desktop_size.isEmpty() ) {
+      desktop_size = QSize(480, 640);
+    }
+    if ( avail_size.isEmpty() ) {
+      avail_size = desktop_size;
+    }
+    QT_desktop_size = desktop_size;
+
+    QList<QSize> sizes;
+    sizes << desktop_size << QT_Transposed(desktop_size);
+    sizes << avail_size << QT_Transposed(avail_size);
+    for ( size_t i = 0; i < QT_NUM_MODE_SIZES; ++i ) {
+      QSize size(QT_mode_sizes[i].w, QT_mode_sizes[i].h);
+      if ( size.width() <= desktop_size.width() &&
+           size.height() <= desktop_size.height() ) {
+        sizes << size;
+      }
+      if ( size.height() <= desktop_size.width() &&
+           size.width() <= desktop_size.height() ) {
+        sizes << QT_Transposed(size);
+      }
+    }
+    qSort(sizes.begin(), sizes.end(), QT_ModeGreaterThan);
+    for ( int i = 0; i < QT_NUM_DEPTHS; ++i ) {
+      foreach ( QSize size, sizes ) {
+        QT_AddMode(_this, ((QT_depths[i]+7)/8)-1,
+                   size.width(), size.height());
+      }
+    }
 
     /* Determine the current screen size */
     _this->info.current_w = desktop_size.width();
@@ -247,69 +359,25 @@ extern "C" {
     /* Fill in some window manager capabilities */
     _this->info.wm_available = 0;
 
-    struct fb_var_screeninfo fbi;
-    Uint32 r = 0, g = 0, b = 0, a = 0;
-
-    fbi.red.length = 8;
-    fbi.red.offset = 16;
-    fbi.green.length = 8;
-    fbi.green.offset = 8;
-    fbi.blue.length = 8;
-    fbi.blue.offset = 0;
-    fbi.transp.length = 0;
-    fbi.transp.offset = 0;
-
-    int i;
-    for (i = 0; i < fbi.red.length; i++) {
-      r <<= 1;
-      r |= 1 << fbi.red.offset;
-    }
-
-    for (i = 0; i < fbi.blue.length; i++) {
-      b <<= 1;
-      b |= 1 << fbi.blue.offset;
-    }
-
-    for (i = 0; i < fbi.green.length; i++) {
-      g <<= 1;
-      g |= 1 << fbi.green.offset;
-    }
-
-    for (i = 0; i < fbi.transp.length; i++) {
-      a <<= 1;
-      a |= 1 << fbi.transp.offset;
-    }
-
-    vformat->Rmask = r;
-    vformat->Gmask = g;
-    vformat->Bmask = b;
-    vformat->Amask = a;
-
-    vformat->Rshift = fbi.red.offset;
-    vformat->Gshift = fbi.green.offset;
-    vformat->Bshift = fbi.blue.offset;
-    vformat->Ashift = fbi.transp.offset;
-
-    vformat->Rloss = 8 - fbi.red.length;
-    vformat->Gloss = 8 - fbi.green.length;
-    vformat->Bloss = 8 - fbi.blue.length;
-    vformat->Aloss = 8 - fbi.transp.length;
+    QT_SetFormatMasks(vformat->BitsPerPixel, &vformat->Rmask,
+                      &vformat->Gmask, &vformat->Bmask);
+    vformat->Amask = 0;
     /* We're done! */
     return(0);
   }
 
-  /* We support any dimension at our bit-depth */
+  /* We support any dimension at the depths QScreen can blit */
   SDL_Rect **QT_ListModes(_THIS, SDL_PixelFormat *format, Uint32 flags) {
     SDL_Rect **modes;
 
     modes = ((SDL_Rect **)0);
+    if ( !QT_SupportedDepth(format->BitsPerPixel) ) {
+      return(modes);
+    }
     if ( (flags & SDL_FULLSCREEN) == SDL_FULLSCREEN ) {
       modes = SDL_modelist[((format->BitsPerPixel+7)/8)-1];
     } else {
-      if ( format->BitsPerPixel ==
-           _this->screen->format->BitsPerPixel ) {
-        modes = ((SDL_Rect **)-1);
-      }
+      modes = ((SDL_Rect **)-1);
     }
     return(modes);
   }
@@ -317,6 +385,107 @@ extern "C" {
   /* Various screen update functions available */
   static void QT_NormalUpdate(_THIS, int numrects, SDL_Rect *rects);
 
+  static void QT_FreePresent(_THIS) {
+    if ( QT_physical ) {
+      SDL_FreeSurface(QT_physical);
+      QT_physical = NULL;
+    }
+    if ( QT_logical_pixels ) {
+      SDL_free(QT_logical_pixels);
+      QT_logical_pixels = NULL;
+    }
+  }
+
+  /* Set up a screen sized back buffer showing 'current' through the
+     present stage */
+  static int QT_SetupPresent(_THIS, SDL_Surface *current, int bpp,
+                             int rotation, const char *scale) {
+    QSize desktop_size = QT_desktop_size;
+    Uint32 Rmask, Gmask, Bmask;
+    int filter = SDL_PRESENT_NEAREST;
+    SDL_Rect area;
+
+    QImage *qimage = new QImage(desktop_size, QT_ImageFormat(bpp));
+    if ( qimage->isNull() ) {
+      SDL_SetError("Couldn't create screen bitmap");
+      delete qimage;
+      return(-1);
+    }
+    qimage->fill(0);
+
+    QT_SetFormatMasks(bpp, &Rmask, &Gmask, &Bmask);
+    QT_physical = SDL_CreateRGBSurfaceFrom(qimage->bits(),
+                                           qimage->width(), qimage->height(),
+                                           bpp, qimage->bytesPerLine(),
+                                           Rmask, Gmask, Bmask, 0);
+    current->pitch = (current->w * (bpp / 8) + 3) & ~3;
+    QT_logical_pixels = SDL_malloc(current->pitch * current->h);
+    if ( QT_physical == NULL || QT_logical_pixels == NULL ) {
+      QT_FreePresent(_this);
+      delete qimage;
+      SDL_OutOfMemory();
+      return(-1);
+    }
+    current->pixels = QT_logical_pixels;
+
+    if ( scale && *scale ) {
+      if ( SDL_strcmp(scale, "bilinear") == 0 ) {
+        filter = SDL_PRESENT_BILINEAR;
+      }
+      SDL_PresentFitArea(current->w, current->h, rotation,
+                         desktop_size.width(), desktop_size.height(),
+                         SDL_strcmp(scale, "integer") == 0, &area);
+    } else {
+      area.w = (rotation & 1) ? current->h : current->w;
+      area.h = (rotation & 1) ? current->w : current->h;
+      area.x = (desktop_size.width() - area.w) / 2;
+      area.y = (desktop_size.height() - area.h) / 2;
+    }
+    if ( SDL_SetupPresent(&QT_present, current, QT_physical,
+                          &area, rotation, filter) < 0 ) {
+      QT_FreePresent(_this);
+      delete qimage;
+      return(-1);
+    }
+
+    SDL_Win->setBackBuffer((rotation == SDL_PRESENT_ROTATE_270) ?
+                           SDL_QWin::CounterClockwise :
+                           (rotation == SDL_PRESENT_ROTATE_90) ?
+                           SDL_QWin::Clockwise : SDL_QWin::NoRotation,
+                           qimage);
+    return(0);
+  }
+
+  /* Set up the buffers SDL_Flip() cycles through */
+  static int QT_SetupFlipping(_THIS, SDL_Surface *current, int bpp) {
+    QImage *buffers[SDL_QWin::MaxFlipBuffers];
+    const char *env = SDL_getenv(SDL_QT_BUFFERS_ENV_NAME);
+    int count = env ? atoi(env) : SDL_QWin::MaxFlipBuffers;
+    int i;
+
+    if ( count < 2 || count > SDL_QWin::MaxFlipBuffers ) {
+      count = SDL_QWin::MaxFlipBuffers;
+    }
+    for ( i = 0; i < count; ++i ) {
+      buffers[i] = new QImage(current->w, current->h, QT_ImageFormat(bpp));
+      if ( buffers[i]->isNull() ) {
+        delete buffers[i];
+        while ( i-- ) {
+          delete buffers[i];
+        }
+        return(-1);
+      }
+      buffers[i]->fill(0);
+    }
+    SDL_Win->setBackBuffer(SDL_QWin::NoRotation, NULL);
+    if ( !SDL_Win->setFlipBuffers(buffers, count) ) {
+      return(-1);
+    }
+    current->pitch = buffers[0]->bytesPerLine();
+    current->pixels = buffers[0]->bits();
+    return(0);
+  }
+
   static int QT_SetFullScreen(_THIS, SDL_Surface *screen, int fullscreen) {
     return -1;
   }
@@ -329,41 +498,112 @@ extern "C" {
   SDL_Surface *QT_SetVideoMode(_THIS, SDL_Surface *current,
                                int width, int height, int bpp, Uint32 flags) {
     QImage *qimage;
-    QSize desktop_size = QSize(480, 640);// qApp->desktop()->size();
+    QSize desktop_size = QT_desktop_size;
+    const char *scale = SDL_getenv(SDL_QT_SCALE_ENV_NAME);
 
     current->flags = 0; //SDL_FULLSCREEN; // We always run fullscreen.
     SDL_QWin::Rotation rotation = SDL_QWin::NoRotation;
+    int present_rotation = SDL_PRESENT_ROTATE_0;
 
+    QT_FreePresent(_this);
+    _this->gamma_lut = NULL;
+
+    /* The back buffer is only as big as requested, the window
+       itself always covers the screen */
     if (width <= desktop_size.width()
         && height <= desktop_size.height()) {
-      current->w = desktop_size.width();
-      current->h = desktop_size.height();
+      current->w = width;
+      current->h = height;
       printf("portrait mode\n");
     } else if (width <= desktop_size.height() && height <= desktop_size.width()) {
       // Landscape mode
       printf("landscape mode\n");
       char * envString = SDL_getenv(SDL_QT_ROTATION_ENV_NAME);
       int envValue = envString ? atoi(envString) : 0;
-      //rotation = envValue ? SDL_QWin::CounterClockwise : SDL_QWin::Clockwise;
-      current->h = desktop_size.width();
-      current->w = desktop_size.height();
+      rotation = envValue ? SDL_QWin::CounterClockwise : SDL_QWin::Clockwise;
+      present_rotation = envValue ? SDL_PRESENT_ROTATE_270 : SDL_PRESENT_ROTATE_90;
+      current->w = width;
+      current->h = height;
     } else {
       SDL_SetError("Unsupported resolution, %dx%d\n", width, height);
+      return(NULL);
     }
     if ( flags & SDL_OPENGL ) {
       SDL_SetError("OpenGL not supported");
       return(NULL);
     }
-    /* Create the QImage framebuffer */
-    qimage = new QImage(current->w, current->h, QImage::Format_RGB32);
+    if ( !QT_SupportedDepth(bpp) ) {
+      bpp = QT_NativeBitsPerPixel();
+    }
+    Uint32 Rmask, Gmask, Bmask;
+    QT_SetFormatMasks(bpp, &Rmask, &Gmask, &Bmask);
+    if ( ! SDL_ReallocFormat(current, bpp, Rmask, Gmask, Bmask, 0) ) {
+      SDL_SetError("Couldn't allocate new pixel format for requested mode");
+      return(NULL);
+    }
+    /* Rotated or scaled modes draw into a plain buffer, which is
+       presented into a screen sized QImage */
+    if ( present_rotation != SDL_PRESENT_ROTATE_0 || (scale && *scale) ) {
+      if ( QT_SetupPresent(_this, current, bpp, present_rotation, scale) < 0 ) {
+        return(NULL);
+      }
+      SDL_Win->setPresent(&QT_present);
+      /* Gamma ramps are emulated while presenting */
+      SDL_BuildGammaLUT(&QT_gamma, _this->gamma);
+      SDL_PresentSetGamma(&QT_present, &QT_gamma);
+      _this->gamma_lut = &QT_gamma;
+      _this->UpdateRects = QT_NormalUpdate;
+      return(current);
+    }
+
+    /* Without a present stage, the window puts the buffer through the
+       gamma tables on its way to the screen */
+    SDL_BuildGammaLUT(&QT_gamma, _this->gamma);
+
+    /* SDL_Flip() hands the finished frame to a present thread and
+       returns the next buffer right away */
+    if ( (flags & SDL_DOUBLEBUF) == SDL_DOUBLEBUF &&
+         QT_SetupFlipping(_this, current, bpp) == 0 ) {
+      current->flags |= (SDL_HWSURFACE | SDL_DOUBLEBUF);
+      SDL_Win->setGamma(&QT_gamma, current->format);
+      _this->gamma_lut = &QT_gamma;
+      _this->UpdateRects = QT_NormalUpdate;
+      return(current);
+    }
+
+    /* Create the QImage framebuffer. For direct mode it has the same
+       layout as the real framebuffer, so the pitch never changes when
+       switching between the two. */
+    const char *direct = SDL_getenv(SDL_QT_DIRECT_ENV_NAME);
+    uchar *data = NULL;
+    if ( direct && atoi(direct) && rotation == SDL_QWin::NoRotation &&
+         QDirectPainter::frameBuffer() != NULL &&
+         QDirectPainter::linestep() >= current->w * (bpp / 8) ) {
+      data = (uchar *)SDL_malloc(QDirectPainter::linestep() * current->h);
+      if ( data == NULL ) {
+        SDL_OutOfMemory();
+        return(NULL);
+      }
+      qimage = new QImage(data, current->w, current->h,
+                          QDirectPainter::linestep(), QT_ImageFormat(bpp));
+    } else {
+      qimage = new QImage(current->w, current->h, QT_ImageFormat(bpp));
+    }
     if (qimage->isNull()) {
       SDL_SetError("Couldn't create screen bitmap");
       delete qimage;
+      SDL_free(data);
       return(NULL);
     }
     current->pitch = qimage->bytesPerLine();
     current->pixels = (void *)qimage->bits();
-    SDL_Win->setBackBuffer(rotation, qimage);
+    SDL_Win->setBackBuffer(rotation, qimage, data);
+    SDL_Win->setGamma(&QT_gamma, current->format);
+    _this->gamma_lut = &QT_gamma;
+    if ( data && SDL_QWin::directModeAvailable(qimage) ) {
+      SDL_Win->setDirectMode(true);
+      current->flags |= SDL_HWSURFACE;
+    }
     _this->UpdateRects = QT_NormalUpdate;
     /* We're done */
     return(current);
@@ -394,17 +634,44 @@ extern "C" {
     return;
   }
   static int QT_LockHWSurface(_THIS, SDL_Surface *surface) {
+    if ( surface == _this->screen && (surface->flags & SDL_HWSURFACE) ) {
+      /* Either the framebuffer or the back buffer, same pitch */
+      surface->pixels = SDL_Win->lockBuffer();
+      return(0);
+    }
     SDL_Win->repaint();
     return(0);
   }
   static void QT_UnlockHWSurface(_THIS, SDL_Surface *surface) {
-    return;
+    if ( surface == _this->screen && (surface->flags & SDL_HWSURFACE) ) {
+      SDL_Win->unlockBuffer();
+    }
+  }
+
+  static int QT_FlipHWSurface(_THIS, SDL_Surface *surface) {
+    surface->pixels = SDL_Win->flip();
+    return(0);
   }
 
   static void QT_NormalUpdate(_THIS, int numrects, SDL_Rect *rects) {
+    /* Already on the screen, or shown by SDL_Flip().  A gamma ramp set
+       while drawing directly is shown from the next lock on. */
+    if ( SDL_Win->isDirect() || SDL_Win->isFlipping() ) {
+      return;
+    }
+
     QRegion region;
-    for (int i=0; i<numrects; ++i )
-      region += QRect(rects[i].x, rects[i].y, rects[i].w, rects[i].h);
+    if ( QT_physical ) {
+      /* Scale/rotate into the back buffer, then show what changed */
+      SDL_Rect *dstrects = SDL_stack_alloc(SDL_Rect, numrects);
+      SDL_PresentRects(&QT_present, numrects, rects, dstrects);
+      for (int i=0; i<numrects; ++i )
+        region += QRect(dstrects[i].x, dstrects[i].y, dstrects[i].w, dstrects[i].h);
+      SDL_stack_free(dstrects);
+    } else {
+      for (int i=0; i<numrects; ++i )
+        region += QRect(rects[i].x, rects[i].y, rects[i].w, rects[i].h);
+    }
     
     if(SDL_Win->keyboardShown)
         SDL_Win->update(region);
@@ -418,6 +685,7 @@ extern "C" {
 
   void QT_VideoQuit(_THIS) {
     _this->screen->pixels = NULL;
+    QT_FreePresent(_this);
     delete SDL_Win;
     SDL_Win = 0;
   }
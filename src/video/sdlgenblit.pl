@@ -0,0 +1,270 @@
+#!/usr/bin/perl -w
+#
+# A script to generate the specialized N to N blitters in SDL_blit_auto.c
+#
+# Each blitter converts between two of the pixel formats below with the
+# masks, shifts and losses as constants.  They give exactly what BlitNtoN
+# and BlitNtoNCopyAlpha give for the same formats.
+#
+# Run it from this directory after changing the format list:
+#   perl sdlgenblit.pl
+#
+use strict;
+
+my $outc = "SDL_blit_auto.c";
+my $outh = "SDL_blit_auto.h";
+
+# name, bytes per pixel, R, G, B and A masks
+my @formats = (
+	[ "RGB565",   2, 0x0000F800, 0x000007E0, 0x0000001F, 0x00000000 ],
+	[ "BGR565",   2, 0x0000001F, 0x000007E0, 0x0000F800, 0x00000000 ],
+	[ "RGB555",   2, 0x00007C00, 0x000003E0, 0x0000001F, 0x00000000 ],
+	[ "BGR555",   2, 0x0000001F, 0x000003E0, 0x00007C00, 0x00000000 ],
+	[ "RGB24",    3, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000 ],
+	[ "BGR24",    3, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000 ],
+	[ "RGB888",   4, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000 ],
+	[ "BGR888",   4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000 ],
+	[ "ARGB8888", 4, 0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000 ],
+	[ "ABGR8888", 4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000 ],
+	[ "RGBA8888", 4, 0xFF000000, 0x00FF0000, 0x0000FF00, 0x000000FF ],
+	[ "BGRA8888", 4, 0x0000FF00, 0x00FF0000, 0xFF000000, 0x000000FF ],
+);
+
+# Shift and loss of a mask, like SDL_AllocFormat()
+sub shift_loss
+{
+	my $mask = shift;
+	my ($shift, $loss) = (0, 8);
+
+	return (0, 8) if ( $mask == 0 );
+	while ( !($mask & 1) ) {
+		$mask >>= 1;
+		++$shift;
+	}
+	while ( $mask & 1 ) {
+		$mask >>= 1;
+		--$loss;
+	}
+	return ($shift, $loss);
+}
+
+sub hex32
+{
+	return sprintf("0x%08X", shift);
+}
+
+# C expression for (value & mask) >> shift << loss
+sub unpack_channel
+{
+	my ($value, $mask) = @_;
+	my ($shift, $loss) = shift_loss($mask);
+	my $expr = "($value & " . hex32($mask) . ")";
+
+	$expr = "($expr >> $shift)" if ( $shift );
+	$expr = "($expr << $loss)" if ( $loss );
+	return $expr;
+}
+
+# C expression for value >> loss << shift
+sub pack_channel
+{
+	my ($value, $mask) = @_;
+	my ($shift, $loss) = shift_loss($mask);
+	my $expr = $value;
+
+	$expr = "($expr >> $loss)" if ( $loss );
+	$expr = "($expr << $shift)" if ( $shift );
+	return $expr;
+}
+
+sub same_rgb
+{
+	my ($a, $b) = @_;
+	return $a->[1] == $b->[1] && $a->[2] == $b->[2] &&
+	       $a->[3] == $b->[3] && $a->[4] == $b->[4];
+}
+
+# Whether a format without alpha has the same pixel size and RGB masks
+sub has_rgb_twin
+{
+	my $format = shift;
+
+	foreach my $other (@formats) {
+		return 1 if ( !$other->[5] && same_rgb($format, $other) );
+	}
+	return 0;
+}
+
+sub output_copyright
+{
+	my $fh = shift;
+	print $fh <<__EOF__;
+/* DO NOT EDIT!  This file is generated by sdlgenblit.pl */
+/*
+    SDL - Simple DirectMedia Layer
+    Copyright (C) 1997-2009 Sam Lantinga
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+    Sam Lantinga
+    slouken\@libsdl.org
+*/
+#include "SDL_config.h"
+__EOF__
+}
+
+sub output_blitter
+{
+	my ($fh, $name, $src, $dst, $copy_alpha) = @_;
+	my ($sname, $sbpp, $sR, $sG, $sB, $sA) = @$src;
+	my ($dname, $dbpp, $dR, $dG, $dB, $dA) = @$dst;
+	my $stype = ($sbpp == 2) ? "Uint16" : "Uint32";
+
+	print $fh "\nstatic void $name(SDL_BlitInfo *info)\n";
+	print $fh "{\n";
+	print $fh "\tint width = info->d_width;\n";
+	print $fh "\tint height = info->d_height;\n";
+	print $fh "\tUint8 *src = info->s_pixels;\n";
+	print $fh "\tint srcskip = info->s_skip;\n";
+	print $fh "\tUint8 *dst = info->d_pixels;\n";
+	print $fh "\tint dstskip = info->d_skip;\n";
+	if ( $dA && !$copy_alpha ) {
+		print $fh "\tUint32 A = " .
+		          pack_channel("(Uint32)info->src->alpha", $dA) . ";\n";
+	}
+	print $fh "\n";
+	print $fh "\twhile ( height-- ) {\n";
+	print $fh "\t\tDUFFS_LOOP(\n";
+	print $fh "\t\t{\n";
+	if ( $sbpp == 3 ) {
+		print $fh "\t\t\tUint32 pixel = SDL_READ24(src);\n";
+	} else {
+		print $fh "\t\t\tUint32 pixel = *($stype *)src;\n";
+	}
+	print $fh "\t\t\tUint32 R = " . unpack_channel("pixel", $sR) . ";\n";
+	print $fh "\t\t\tUint32 G = " . unpack_channel("pixel", $sG) . ";\n";
+	print $fh "\t\t\tUint32 B = " . unpack_channel("pixel", $sB) . ";\n";
+	if ( $copy_alpha ) {
+		print $fh "\t\t\tUint32 A = " . unpack_channel("pixel", $sA) . ";\n";
+	}
+	if ( $dbpp == 3 ) {
+		my ($Rshift) = shift_loss($dR);
+		my ($Gshift) = shift_loss($dG);
+		my ($Bshift) = shift_loss($dB);
+		print $fh "\t\t\tdst[BLIT_AUTO_BYTE24($Rshift)] = (Uint8)R;\n";
+		print $fh "\t\t\tdst[BLIT_AUTO_BYTE24($Gshift)] = (Uint8)G;\n";
+		print $fh "\t\t\tdst[BLIT_AUTO_BYTE24($Bshift)] = (Uint8)B;\n";
+	} else {
+		my $expr = pack_channel("R", $dR) . " |\n\t\t\t       " .
+		           pack_channel("G", $dG) . " |\n\t\t\t       " .
+		           pack_channel("B", $dB);
+		if ( $dA ) {
+			$expr .= " |\n\t\t\t       " .
+			         ($copy_alpha ? pack_channel("A", $dA) : "A");
+		}
+		print $fh "\t\t\tpixel = $expr;\n";
+		if ( $dbpp == 2 ) {
+			print $fh "\t\t\t*(Uint16 *)dst = (Uint16)pixel;\n";
+		} else {
+			print $fh "\t\t\t*(Uint32 *)dst = pixel;\n";
+		}
+	}
+	print $fh "\t\t\tsrc += $sbpp;\n";
+	print $fh "\t\t\tdst += $dbpp;\n";
+	print $fh "\t\t},\n";
+	print $fh "\t\twidth);\n";
+	print $fh "\t\tsrc += srcskip;\n";
+	print $fh "\t\tdst += dstskip;\n";
+	print $fh "\t}\n";
+	print $fh "}\n";
+}
+
+my @entries;
+
+open(my $fh, ">", $outc) or die "Can't write $outc: $!\n";
+output_copyright($fh);
+print $fh <<__EOF__;
+
+/* Specialized N to N blitters for common pairs of pixel formats */
+
+#include "SDL_video.h"
+#include "SDL_blit.h"
+#include "SDL_blit_auto.h"
+
+/* The byte of a 24-bit pixel that holds the bits from 'shift' up */
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+#define BLIT_AUTO_BYTE24(shift)	((shift) / 8)
+#else
+#define BLIT_AUTO_BYTE24(shift)	(2 - (shift) / 8)
+#endif
+__EOF__
+
+foreach my $src (@formats) {
+	foreach my $dst (@formats) {
+		my $copy_alpha = ($src->[5] && $dst->[5]) ? 1 : 0;
+
+		# Copies, or Blit4to4MaskAlpha
+		next if ( $src->[1] == $dst->[1] && same_rgb($src, $dst) );
+
+		# Without alpha on both sides the source alpha doesn't matter,
+		# so ARGB8888 shares the RGB888 blitters
+		next if ( !$copy_alpha && $src->[5] && has_rgb_twin($src) );
+
+		my $name = "Blit_$src->[0]_$dst->[0]";
+		output_blitter($fh, $name, $src, $dst, $copy_alpha);
+		push(@entries, [ $src, $dst, $copy_alpha, $name ]);
+	}
+}
+
+print $fh "\nconst SDL_BlitAutoEntry SDL_GeneratedBlitN[] = {\n";
+foreach my $entry (@entries) {
+	my ($src, $dst, $copy_alpha, $name) = @$entry;
+	print $fh "\t{ $src->[1], " . hex32($src->[2]) . ", " .
+	          hex32($src->[3]) . ", " . hex32($src->[4]) . ", " .
+	          hex32($copy_alpha ? $src->[5] : 0) . ",\n";
+	print $fh "\t  $dst->[1], " . hex32($dst->[2]) . ", " .
+	          hex32($dst->[3]) . ", " . hex32($dst->[4]) . ", " .
+	          hex32($dst->[5]) . ",\n";
+	print $fh "\t  $copy_alpha, $name, \"$name\" },\n";
+}
+print $fh "\t{ 0 }\n";
+print $fh "};\n";
+close($fh);
+
+open($fh, ">", $outh) or die "Can't write $outh: $!\n";
+output_copyright($fh);
+print $fh <<__EOF__;
+
+#ifndef _SDL_blit_auto_h
+#define _SDL_blit_auto_h
+
+/* A blitter from SDL_blit_auto.c.  The source alpha mask is only set for
+   blitters that copy alpha, the others ignore the source alpha. */
+typedef struct {
+	int srcbpp;
+	Uint32 srcR, srcG, srcB, srcA;
+	int dstbpp;
+	Uint32 dstR, dstG, dstB, dstA;
+	int copy_alpha;
+	SDL_loblit blitfunc;
+	const char *name;
+} SDL_BlitAutoEntry;
+
+/* Terminated by an entry with srcbpp 0 */
+extern const SDL_BlitAutoEntry SDL_GeneratedBlitN[];
+
+#endif /* _SDL_blit_auto_h */
+__EOF__
+close($fh);
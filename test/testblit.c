@@ -0,0 +1,2121 @@
+/* Test program to check the optimized (MMX, SSE2, NEON, AltiVec, ...)
+   blitters against plain C versions of the same conversions.
+
+   Each case blits random pixels at a few widths and alignments and
+   compares every pixel with the expected value.  Blends may be off by
+   one in each channel, as the vector and C blitters round differently,
+   except for colour keyed blends which must match ALPHA_BLEND exactly.
+
+   Then every pair of the formats below is blitted with and without the
+   generated blitters (SDL_BLIT_GENERATED=0), which must give the same
+   bytes as BlitNtoN, and SDL_BlitSurfaceBatch() must match one
+   SDL_BlitSurface() per rectangle.  Then SDL_SoftStretchFilter() is checked: nearest
+   against SDL_SoftStretch() and SDL_BlitSurface(), bilinear against the
+   filter worked out here, and whole factors pixel by pixel.  RLE pixel
+   alpha blits must match the plain ones to within one, surfaces locked
+   with SDL_LockSurfaceReadOnly() must stay RLE encoded, and surfaces
+   encoded in the background must blit the same before and after.
+   Rotated copies, the present stage (rotated, scaled, filtered and
+   gamma corrected) and SDL_GammaCopy() are compared with a pixel by
+   pixel reference, and SDL_GammaRotateRect() with both of them.
+   Last, YUV overlays of each format are shown on 16, 24 and 32 bit
+   surfaces, at their size, twice it, and scaled and clipped with the
+   bilinear filter, and compared with the conversion worked out here.
+   Exits with 1 if any case fails.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "SDL.h"
+
+/* The present stage and the rotated copies are internal to the library,
+   so they are built into this test from the source tree */
+#include "../src/video/SDL_rotate.c"
+#include "../src/video/SDL_present.c"
+
+typedef enum {
+	BLIT_COPY,
+	BLIT_KEY,
+	BLIT_SURFACE_ALPHA,
+	BLIT_KEY_SURFACE_ALPHA,
+	BLIT_PIXEL_ALPHA
+} BlitMode;
+
+typedef struct {
+	int bpp;
+	Uint32 Rmask, Gmask, Bmask, Amask;
+} Format;
+
+typedef struct {
+	const char *name;
+	Format src;
+	Format dst;
+	BlitMode mode;
+} BlitCase;
+
+#define ARGB8888	{ 32, 0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000 }
+#define ABGR8888	{ 32, 0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000 }
+#define RGBA8888	{ 32, 0xFF000000, 0x00FF0000, 0x0000FF00, 0x000000FF }
+#define BGRA8888	{ 32, 0x0000FF00, 0x00FF0000, 0xFF000000, 0x000000FF }
+#define RGB888		{ 32, 0x00FF0000, 0x0000FF00, 0x000000FF, 0 }
+#define RGB565		{ 16, 0xF800, 0x07E0, 0x001F, 0 }
+#define BGR565		{ 16, 0x001F, 0x07E0, 0xF800, 0 }
+#define RGB555		{ 16, 0x7C00, 0x03E0, 0x001F, 0 }
+#define BGR555		{ 16, 0x001F, 0x03E0, 0x7C00, 0 }
+#define RGB24		{ 24, 0x00FF0000, 0x0000FF00, 0x000000FF, 0 }
+#define BGR24		{ 24, 0x000000FF, 0x0000FF00, 0x00FF0000, 0 }
+#define BGR888		{ 32, 0x000000FF, 0x0000FF00, 0x00FF0000, 0 }
+
+static const BlitCase cases[] = {
+	{ "RGB888 -> RGB565", RGB888, RGB565, BLIT_COPY },
+	{ "RGB888 -> BGR565", RGB888, BGR565, BLIT_COPY },
+	{ "RGB888 -> RGB555", RGB888, RGB555, BLIT_COPY },
+	{ "RGB888 -> BGR555", RGB888, BGR555, BLIT_COPY },
+	{ "RGB565 -> ARGB8888", RGB565, ARGB8888, BLIT_COPY },
+	{ "RGB565 -> ABGR8888", RGB565, ABGR8888, BLIT_COPY },
+	{ "RGB565 -> RGBA8888", RGB565, RGBA8888, BLIT_COPY },
+	{ "RGB565 -> BGRA8888", RGB565, BGRA8888, BLIT_COPY },
+	{ "RGB565 -> RGB565 key", RGB565, RGB565, BLIT_KEY },
+	{ "RGB555 -> RGB555 key", RGB555, RGB555, BLIT_KEY },
+	{ "RGB888 -> RGB888 key", RGB888, RGB888, BLIT_KEY },
+	{ "ARGB8888 -> ARGB8888 key", ARGB8888, ARGB8888, BLIT_KEY },
+	{ "RGB565 -> RGB565 surface alpha", RGB565, RGB565, BLIT_SURFACE_ALPHA },
+	{ "RGB555 -> RGB555 surface alpha", RGB555, RGB555, BLIT_SURFACE_ALPHA },
+	{ "RGB888 -> RGB888 surface alpha", RGB888, RGB888, BLIT_SURFACE_ALPHA },
+	{ "RGB565 -> RGB565 key surface alpha", RGB565, RGB565, BLIT_KEY_SURFACE_ALPHA },
+	{ "RGB555 -> RGB555 key surface alpha", RGB555, RGB555, BLIT_KEY_SURFACE_ALPHA },
+	{ "RGB888 -> RGB888 key surface alpha", RGB888, RGB888, BLIT_KEY_SURFACE_ALPHA },
+	{ "BGR888 -> ABGR8888 key surface alpha", BGR888, ABGR8888, BLIT_KEY_SURFACE_ALPHA },
+	{ "ARGB8888 -> RGB565 pixel alpha", ARGB8888, RGB565, BLIT_PIXEL_ALPHA },
+	{ "ABGR8888 -> BGR565 pixel alpha", ABGR8888, BGR565, BLIT_PIXEL_ALPHA },
+	{ "ARGB8888 -> RGB555 pixel alpha", ARGB8888, RGB555, BLIT_PIXEL_ALPHA },
+	{ "ARGB8888 -> RGB888 pixel alpha", ARGB8888, RGB888, BLIT_PIXEL_ALPHA },
+};
+
+static const struct {
+	const char *name;
+	Format format;
+} formats[] = {
+	{ "RGB565", RGB565 }, { "BGR565", BGR565 },
+	{ "RGB555", RGB555 }, { "BGR555", BGR555 },
+	{ "RGB24", RGB24 }, { "BGR24", BGR24 },
+	{ "RGB888", RGB888 }, { "BGR888", BGR888 },
+	{ "ARGB8888", ARGB8888 }, { "ABGR8888", ABGR8888 },
+	{ "RGBA8888", RGBA8888 }, { "BGRA8888", BGRA8888 },
+};
+
+static const int widths[] = { 1, 3, 7, 8, 9, 15, 16, 17, 31, 33, 64, 67, 640 };
+static const Uint8 alphas[] = { 1, 64, 127, 128, 200, 254 };
+
+#define HEIGHT	4
+
+static Uint32 seed = 1;
+
+/* Same numbers on every platform */
+static Uint32 Random(void)
+{
+	seed = seed * 1103515245 + 12345;
+	return (seed >> 16) | (seed << 16);
+}
+
+static Uint32 GetPixel(SDL_Surface *surface, int x, int y)
+{
+	Uint8 *row = (Uint8 *)surface->pixels + y * surface->pitch;
+
+	if ( surface->format->BytesPerPixel == 2 ) {
+		return ((Uint16 *)row)[x];
+	}
+	if ( surface->format->BytesPerPixel == 3 ) {
+		row += x * 3;
+		return row[0] | (row[1] << 8) | (row[2] << 16);
+	}
+	return ((Uint32 *)row)[x];
+}
+
+static void PutPixel(SDL_Surface *surface, int x, int y, Uint32 pixel)
+{
+	Uint8 *row = (Uint8 *)surface->pixels + y * surface->pitch;
+
+	if ( surface->format->BytesPerPixel == 2 ) {
+		((Uint16 *)row)[x] = (Uint16)pixel;
+	} else if ( surface->format->BytesPerPixel == 3 ) {
+		row += x * 3;
+		row[0] = (Uint8)pixel;
+		row[1] = (Uint8)(pixel >> 8);
+		row[2] = (Uint8)(pixel >> 16);
+	} else {
+		((Uint32 *)row)[x] = pixel;
+	}
+}
+
+static SDL_Surface *CreateSurface(const Format *format, int w)
+{
+	return SDL_CreateRGBSurface(SDL_SWSURFACE, w, HEIGHT, format->bpp,
+	                            format->Rmask, format->Gmask,
+	                            format->Bmask, format->Amask);
+}
+
+/* Channel 'mask' of 'pixel', in its own number of bits */
+static Uint32 Field(Uint32 pixel, Uint32 mask)
+{
+	if ( !mask ) {
+		return 0;
+	}
+	while ( !(mask & 1) ) {
+		pixel >>= 1;
+		mask >>= 1;
+	}
+	return pixel & mask;
+}
+
+static Uint32 MakeField(Uint32 value, Uint32 mask)
+{
+	Uint32 shifted = mask;
+
+	if ( !mask ) {
+		return 0;
+	}
+	while ( !(shifted & 1) ) {
+		value <<= 1;
+		shifted >>= 1;
+	}
+	return value & mask;
+}
+
+static int Bits(Uint32 mask)
+{
+	int bits = 0;
+
+	for ( ; mask; mask >>= 1 ) {
+		bits += mask & 1;
+	}
+	return bits;
+}
+
+/* A source channel scaled to the destination channel */
+static Uint32 Convert(Uint32 pixel, Uint32 smask, Uint32 dmask)
+{
+	Uint32 value = Field(pixel, smask);
+	int sbits = Bits(smask);
+	int dbits = Bits(dmask);
+	Uint32 smax = (1 << sbits) - 1;
+	Uint32 dmax = (1 << dbits) - 1;
+
+	if ( dbits <= sbits ) {
+		return value >> (sbits - dbits);
+	}
+	/* Widened like the RGB565_*_LUT tables, which add up 6 bit green
+	   from its high and low 3 bits */
+	if ( sbits == 6 ) {
+		return ((value & 0x38) * dmax) / smax + ((value & 0x07) * dmax) / smax;
+	}
+	return (value * dmax) / smax;
+}
+
+/* Blend one channel with 'alpha' out of 'max' */
+static Uint32 Blend(Uint32 s, Uint32 d, Uint32 alpha, Uint32 max, int bits)
+{
+	return (s * alpha + d * (max - alpha)) >> bits;
+}
+
+/* The expected destination pixel, and whether it is a blend */
+static Uint32 Expected(const BlitCase *test, Uint32 s, Uint32 d,
+                       Uint8 surface_alpha, Uint32 key, int *tolerance)
+{
+	const Format *sf = &test->src;
+	const Format *df = &test->dst;
+	const Uint32 *smasks = &sf->Rmask;
+	const Uint32 *dmasks = &df->Rmask;
+	Uint32 pixel = 0;
+	Uint32 alpha, max;
+	int i, bits;
+
+	*tolerance = 0;
+	switch ( test->mode ) {
+	case BLIT_KEY:
+		/* The source alpha isn't part of the key, 32-bit blits without
+		   alpha drop the unused byte */
+		if ( (s & ~sf->Amask) == (key & ~sf->Amask) ) {
+			return d;
+		}
+		if ( df->bpp == 16 ) {
+			return s;
+		}
+		return s & (df->Rmask | df->Gmask | df->Bmask | df->Amask);
+
+	case BLIT_KEY_SURFACE_ALPHA:
+		/* Blended in 8 bits like ALPHA_BLEND, which rounds up */
+		if ( s == key ) {
+			return d;
+		}
+		for ( i = 0; i < 3; ++i ) {
+			int loss = 8 - Bits(dmasks[i]);
+			Uint32 sc = Field(s, smasks[i]) << loss;
+			Uint32 dc = Field(d, dmasks[i]) << loss;
+			Uint32 value = (sc * surface_alpha +
+			                dc * (256 - surface_alpha) + 255) >> 8;
+			pixel |= MakeField(value >> loss, dmasks[i]);
+		}
+		return pixel | df->Amask;
+
+	case BLIT_COPY:
+		for ( i = 0; i < 3; ++i ) {
+			pixel |= MakeField(Convert(s, smasks[i], dmasks[i]),
+			                   dmasks[i]);
+		}
+		return pixel | df->Amask;
+
+	case BLIT_SURFACE_ALPHA:
+	case BLIT_PIXEL_ALPHA:
+		alpha = (test->mode == BLIT_PIXEL_ALPHA) ? (s >> 24) : surface_alpha;
+		if ( df->bpp == 16 ) {
+			/* 16-bit targets blend with 5 bit alpha */
+			alpha >>= 3;
+			max = 32;
+			bits = 5;
+		} else {
+			max = 256;
+			bits = 8;
+		}
+		if ( test->mode == BLIT_PIXEL_ALPHA ) {
+			if ( alpha == 0 ) {
+				return d;
+			}
+			if ( alpha == max - 1 ) {
+				alpha = max;
+			}
+		}
+		for ( i = 0; i < 3; ++i ) {
+			Uint32 sc = Convert(s, smasks[i], dmasks[i]);
+			Uint32 dc = Field(d, dmasks[i]);
+			pixel |= MakeField(Blend(sc, dc, alpha, max, bits), dmasks[i]);
+		}
+		*tolerance = (alpha != max);
+		return pixel;
+	}
+	return 0;
+}
+
+/* The blitter used by the last CheckCase() */
+static const char *blitter;
+
+static int CheckCase(const BlitCase *test, int w, int offset, Uint8 alpha)
+{
+	SDL_Surface *src = CreateSurface(&test->src, w + offset);
+	SDL_Surface *dst = CreateSurface(&test->dst, w + offset);
+	SDL_Surface *ref = CreateSurface(&test->dst, w + offset);
+	SDL_Rect srect, drect;
+	Uint32 key = 0;
+	int x, y, errors = 0;
+
+	if ( !src || !dst || !ref ) {
+		fprintf(stderr, "Couldn't create surfaces: %s\n", SDL_GetError());
+		exit(2);
+	}
+	for ( y = 0; y < HEIGHT; ++y ) {
+		for ( x = 0; x < w + offset; ++x ) {
+			Uint32 s = Random();
+			Uint32 d = Random();
+			if ( test->mode == BLIT_PIXEL_ALPHA ) {
+				/* Plenty of transparent and opaque runs */
+				switch ( (x / 4 + y) % 4 ) {
+				case 0:
+					s &= 0x00FFFFFF;
+					break;
+				case 1:
+					s |= 0xFF000000;
+					break;
+				}
+			}
+			if ( test->src.bpp == 16 ) {
+				s &= 0xFFFF;
+			}
+			if ( test->mode == BLIT_SURFACE_ALPHA ) {
+				/* The C 555 blitters for alpha 128 carry the
+				   unused top bit into red */
+				s &= test->src.Rmask | test->src.Gmask |
+				     test->src.Bmask | ~0xFFFF;
+				d &= test->dst.Rmask | test->dst.Gmask |
+				     test->dst.Bmask | ~0xFFFF;
+			}
+			if ( test->dst.bpp == 16 ) {
+				d &= 0xFFFF;
+			}
+			PutPixel(src, x, y, s);
+			PutPixel(dst, x, y, d);
+			PutPixel(ref, x, y, d);
+		}
+	}
+
+	switch ( test->mode ) {
+	case BLIT_KEY:
+	case BLIT_KEY_SURFACE_ALPHA:
+		/* Every fourth pixel is the key, with any source alpha */
+		key = GetPixel(src, offset, 0);
+		for ( y = 0; y < HEIGHT; ++y ) {
+			for ( x = offset; x < w + offset; x += 4 ) {
+				PutPixel(src, x, y,
+				         key ^ (Random() & test->src.Amask));
+			}
+		}
+		SDL_SetColorKey(src, SDL_SRCCOLORKEY, key);
+		if ( test->mode == BLIT_KEY_SURFACE_ALPHA ) {
+			SDL_SetAlpha(src, SDL_SRCALPHA, alpha);
+		} else {
+			SDL_SetAlpha(src, 0, SDL_ALPHA_OPAQUE);
+		}
+		break;
+	case BLIT_SURFACE_ALPHA:
+		SDL_SetAlpha(src, SDL_SRCALPHA, alpha);
+		break;
+	case BLIT_PIXEL_ALPHA:
+		SDL_SetAlpha(src, SDL_SRCALPHA, SDL_ALPHA_OPAQUE);
+		break;
+	case BLIT_COPY:
+		SDL_SetAlpha(src, 0, SDL_ALPHA_OPAQUE);
+		break;
+	}
+
+	/* Source and destination start at different offsets */
+	srect.x = offset;
+	srect.y = 0;
+	srect.w = w;
+	srect.h = HEIGHT;
+	drect.x = 0;
+	drect.y = 0;
+	SDL_BlitSurface(src, &srect, dst, &drect);
+	blitter = SDL_GetBlitName(src, dst);
+	if ( !blitter && errors++ == 0 ) {
+		printf("  width %d, offset %d: %s\n", w, offset, SDL_GetError());
+	}
+
+	for ( y = 0; y < HEIGHT; ++y ) {
+		for ( x = 0; x < w + offset; ++x ) {
+			const Uint32 *dmasks = &test->dst.Rmask;
+			Uint32 d = GetPixel(ref, x, y);
+			Uint32 got = GetPixel(dst, x, y);
+			Uint32 want = d;
+			int tolerance = 0;
+			int i, bad = 0;
+
+			if ( x < w ) {
+				want = Expected(test, GetPixel(src, x + offset, y),
+				                d, alpha, key, &tolerance);
+			}
+			if ( test->mode == BLIT_KEY || x >= w ) {
+				bad = (got != want);
+			} else {
+				/* The alpha field too, the unused byte of
+				   32-bit pixels without alpha is undefined */
+				for ( i = 0; i < 4; ++i ) {
+					int diff = (int)Field(got, dmasks[i]) -
+					           (int)Field(want, dmasks[i]);
+					if ( diff < -tolerance || diff > tolerance ) {
+						bad = 1;
+					}
+				}
+			}
+			if ( bad && errors++ == 0 ) {
+				printf("  width %d, offset %d, alpha %d: pixel %d,%d "
+				       "is 0x%08x, expected 0x%08x\n",
+				       w, offset, alpha, x, y, got, want);
+			}
+		}
+	}
+
+	SDL_FreeSurface(src);
+	SDL_FreeSurface(dst);
+	SDL_FreeSurface(ref);
+	return errors;
+}
+
+static void FillRandom(SDL_Surface *surface)
+{
+	Uint8 *pixels = (Uint8 *)surface->pixels;
+	int i;
+
+	for ( i = 0; i < surface->h * surface->pitch; ++i ) {
+		pixels[i] = (Uint8)Random();
+	}
+}
+
+/* The generic C blitters that the generated ones replace */
+static int IsGenericBlitter(const char *name)
+{
+	return(SDL_strcmp(name, "BlitNtoN") == 0 ||
+	       SDL_strcmp(name, "BlitNtoNCopyAlpha") == 0);
+}
+
+/* Blit 'src' onto a copy of 'dst' with the generated blitters on or off,
+   counting a blitter without a name as an error */
+static SDL_Surface *BlitGenerated(SDL_Surface *src, SDL_Rect *srect,
+                                  SDL_Surface *dst, int generated,
+                                  const char **name, int *errors)
+{
+	SDL_Surface *copy;
+	SDL_Rect drect;
+
+	SDL_putenv(generated ? "SDL_BLIT_GENERATED=1" : "SDL_BLIT_GENERATED=0");
+	copy = SDL_ConvertSurface(dst, dst->format, SDL_SWSURFACE);
+	if ( !copy ) {
+		fprintf(stderr, "Couldn't copy surface: %s\n", SDL_GetError());
+		exit(2);
+	}
+	drect.x = 0;
+	drect.y = 0;
+	SDL_BlitSurface(src, srect, copy, &drect);
+	*name = SDL_GetBlitName(src, copy);
+	if ( !*name ) {
+		if ( (*errors)++ == 0 ) {
+			printf("  generated %d: %s\n", generated, SDL_GetError());
+		}
+		*name = "?";
+	}
+	return copy;
+}
+
+static int CheckGenerated(const Format *sf, const Format *df, int w, int offset)
+{
+	SDL_Surface *src = CreateSurface(sf, w + offset);
+	SDL_Surface *dst = CreateSurface(df, w + offset);
+	SDL_Surface *on, *off;
+	const char *onname, *offname;
+	SDL_Rect srect;
+	int y, errors = 0;
+
+	if ( !src || !dst ) {
+		fprintf(stderr, "Couldn't create surfaces: %s\n", SDL_GetError());
+		exit(2);
+	}
+	FillRandom(src);
+	FillRandom(dst);
+	SDL_SetAlpha(src, 0, SDL_ALPHA_OPAQUE);
+
+	srect.x = offset;
+	srect.y = 0;
+	srect.w = w;
+	srect.h = HEIGHT;
+	on = BlitGenerated(src, &srect, dst, 1, &onname, &errors);
+	off = BlitGenerated(src, &srect, dst, 0, &offname, &errors);
+	/* Every pair has a blitter of its own, and without the generated
+	   ones (and Blit4to4MaskAlpha) falls back to BlitNtoN(CopyAlpha) */
+	if ( IsGenericBlitter(onname) ||
+	     (SDL_strcmp(onname, offname) != 0 && !IsGenericBlitter(offname)) ) {
+		if ( errors++ == 0 ) {
+			printf("  blitters %s and %s\n", onname, offname);
+		}
+	}
+	for ( y = 0; y < HEIGHT; ++y ) {
+		Uint8 *a = (Uint8 *)on->pixels + y * on->pitch;
+		Uint8 *b = (Uint8 *)off->pixels + y * off->pitch;
+		int len = (w + offset) * df->bpp / 8;
+
+		if ( SDL_memcmp(a, b, len) != 0 && errors++ == 0 ) {
+			printf("  width %d, offset %d: row %d differs\n",
+			       w, offset, y);
+		}
+	}
+
+	SDL_FreeSurface(src);
+	SDL_FreeSurface(dst);
+	SDL_FreeSurface(on);
+	SDL_FreeSurface(off);
+	return errors;
+}
+
+static const struct {
+	const char *name;
+	Format src;
+	Format dst;
+	Uint32 flags;
+} batches[] = {
+	{ "RGB888 -> RGB888 batch", RGB888, RGB888, 0 },
+	{ "RGB888 -> RGB565 batch", RGB888, RGB565, 0 },
+	{ "RGB565 key RLE batch", RGB565, RGB565,
+	  SDL_SRCCOLORKEY|SDL_RLEACCEL },
+	{ "ARGB8888 -> RGB565 alpha batch", ARGB8888, RGB565,
+	  SDL_SRCALPHA },
+	{ "ARGB8888 RLE alpha batch", ARGB8888, RGB888,
+	  SDL_SRCALPHA|SDL_RLEACCEL },
+};
+
+#define BATCH_SIZE	300
+
+/* Blit many clipped rectangles with SDL_BlitSurfaceBatch() and one at a
+   time, without overlaps when the batch is sorted */
+static int CheckBatch(const Format *sf, const Format *df, Uint32 flags,
+                      Uint32 batchflags)
+{
+	SDL_Surface *src = SDL_CreateRGBSurface(SDL_SWSURFACE, 32, 16, sf->bpp,
+	                   sf->Rmask, sf->Gmask, sf->Bmask, sf->Amask);
+	SDL_Surface *one = SDL_CreateRGBSurface(SDL_SWSURFACE, 200, 100, df->bpp,
+	                   df->Rmask, df->Gmask, df->Bmask, df->Amask);
+	SDL_Surface *batch = SDL_CreateRGBSurface(SDL_SWSURFACE, 200, 100,
+	                     df->bpp, df->Rmask, df->Gmask, df->Bmask, df->Amask);
+	SDL_Rect srects[BATCH_SIZE], points[BATCH_SIZE];
+	int i, y, errors = 0;
+
+	if ( !src || !one || !batch ) {
+		fprintf(stderr, "Couldn't create surfaces: %s\n", SDL_GetError());
+		exit(2);
+	}
+	FillRandom(src);
+	FillRandom(one);
+	SDL_memcpy(batch->pixels, one->pixels, one->h * one->pitch);
+	for ( i = 0; i < 32 * 16; i += 3 ) {
+		PutPixel(src, i % 32, i / 32, 0);
+	}
+	SDL_SetAlpha(src, flags & (SDL_SRCALPHA|SDL_RLEACCEL), SDL_ALPHA_OPAQUE);
+	if ( flags & SDL_SRCCOLORKEY ) {
+		SDL_SetColorKey(src, flags & (SDL_SRCCOLORKEY|SDL_RLEACCEL), 0);
+	}
+
+	for ( i = 0; i < BATCH_SIZE; ++i ) {
+		srects[i].x = (Sint16)(Random() % 40) - 4;
+		srects[i].y = (Sint16)(Random() % 20) - 2;
+		srects[i].w = (Uint16)(Random() % 36);
+		srects[i].h = (Uint16)(Random() % 18);
+		if ( batchflags & SDL_BLITBATCH_SORT ) {
+			/* One cell each of a 6x6 grid, in random order */
+			points[i].x = (Sint16)((i * 7 % 36) % 6 * 40 - 20);
+			points[i].y = (Sint16)((i * 7 % 36) / 6 * 20 - 10);
+			if ( i >= 36 ) {
+				srects[i].w = 0;
+			}
+		} else {
+			points[i].x = (Sint16)(Random() % 240) - 20;
+			points[i].y = (Sint16)(Random() % 120) - 10;
+		}
+	}
+	for ( i = 0; i < BATCH_SIZE; ++i ) {
+		SDL_Rect srect = srects[i], drect = points[i];
+		SDL_BlitSurface(src, &srect, one, &drect);
+	}
+	if ( SDL_BlitSurfaceBatch(src, srects, batch, points,
+	                          BATCH_SIZE, batchflags) < 0 ) {
+		printf("  SDL_BlitSurfaceBatch: %s\n", SDL_GetError());
+		++errors;
+	}
+	for ( y = 0; y < one->h; ++y ) {
+		Uint8 *a = (Uint8 *)one->pixels + y * one->pitch;
+		Uint8 *b = (Uint8 *)batch->pixels + y * batch->pitch;
+
+		if ( SDL_memcmp(a, b, one->w * df->bpp / 8) != 0 &&
+		     errors++ == 0 ) {
+			printf("  row %d differs\n", y);
+		}
+	}
+
+	SDL_FreeSurface(src);
+	SDL_FreeSurface(one);
+	SDL_FreeSurface(batch);
+	return errors;
+}
+
+static const struct {
+	const char *name;
+	Format src;
+	Format dst;
+	Uint32 flags;
+} stretches[] = {
+	{ "RGB888 -> RGB888 stretch", RGB888, RGB888, 0 },
+	{ "RGB888 -> RGB565 stretch", RGB888, RGB565, 0 },
+	{ "RGB555 -> ARGB8888 stretch", RGB555, ARGB8888, 0 },
+	{ "RGB24 -> BGR888 stretch", RGB24, BGR888, 0 },
+	{ "ARGB8888 -> ABGR8888 stretch", ARGB8888, ABGR8888, 0 },
+	{ "RGB565 -> RGB565 key stretch", RGB565, RGB565, SDL_SRCCOLORKEY },
+	{ "RGB888 -> RGB555 key stretch", RGB888, RGB555, SDL_SRCCOLORKEY },
+	{ "ARGB8888 -> RGB888 alpha stretch", ARGB8888, RGB888, SDL_SRCALPHA },
+};
+
+static const SDL_Rect stretchrects[] = {
+	{ 3, 1, 37, 5 }, { 0, 0, 100, 13 },
+	{ 3, 1, 37, 5 }, { 5, 2, 17, 3 },
+	{ 0, 0, 40, 8 }, { 1, 1, 1, 1 },
+	{ 0, 0, 1, 1 }, { 7, 3, 90, 10 },
+};
+
+/* Stretch with each rectangle pair, the nearest filter must match a
+   stretch to the source format followed by a blit */
+static int CheckStretchNearest(const Format *sf, const Format *df,
+                               Uint32 flags)
+{
+	SDL_Surface *src = SDL_CreateRGBSurface(SDL_SWSURFACE, 40, 8, sf->bpp,
+	                   sf->Rmask, sf->Gmask, sf->Bmask, sf->Amask);
+	SDL_Surface *dst = SDL_CreateRGBSurface(SDL_SWSURFACE, 100, 13, df->bpp,
+	                   df->Rmask, df->Gmask, df->Bmask, df->Amask);
+	SDL_Surface *ref = SDL_CreateRGBSurface(SDL_SWSURFACE, 100, 13, df->bpp,
+	                   df->Rmask, df->Gmask, df->Bmask, df->Amask);
+	SDL_Surface *tmp = SDL_CreateRGBSurface(SDL_SWSURFACE, 100, 13, sf->bpp,
+	                   sf->Rmask, sf->Gmask, sf->Bmask, sf->Amask);
+	int i, x, y, errors = 0;
+
+	if ( !src || !dst || !ref || !tmp ) {
+		fprintf(stderr, "Couldn't create surfaces: %s\n", SDL_GetError());
+		exit(2);
+	}
+	FillRandom(src);
+	for ( i = 0; i < 40 * 8; i += 3 ) {
+		PutPixel(src, i % 40, i / 40, 0);
+	}
+	SDL_SetAlpha(src, flags & SDL_SRCALPHA, SDL_ALPHA_OPAQUE);
+	SDL_SetAlpha(tmp, flags & SDL_SRCALPHA, SDL_ALPHA_OPAQUE);
+	if ( flags & SDL_SRCCOLORKEY ) {
+		SDL_SetColorKey(src, SDL_SRCCOLORKEY, 0);
+		SDL_SetColorKey(tmp, SDL_SRCCOLORKEY, 0);
+	}
+
+	for ( i = 0; i < (int)SDL_arraysize(stretchrects); i += 2 ) {
+		SDL_Rect srect = stretchrects[i], drect = stretchrects[i+1];
+		SDL_Rect trect = drect;
+
+		FillRandom(dst);
+		SDL_memcpy(ref->pixels, dst->pixels, dst->h * dst->pitch);
+		if ( SDL_SoftStretchFilter(src, &srect, dst, &drect,
+		                           SDL_STRETCH_NEAREST) < 0 ||
+		     SDL_SoftStretch(src, &srect, tmp, &trect) < 0 ) {
+			printf("  stretch failed: %s\n", SDL_GetError());
+			++errors;
+			continue;
+		}
+		SDL_BlitSurface(tmp, &trect, ref, &drect);
+		for ( y = 0; y < dst->h; ++y ) {
+			for ( x = 0; x < dst->w; ++x ) {
+				Uint32 used = df->Rmask | df->Gmask |
+				              df->Bmask | df->Amask;
+				Uint32 a = GetPixel(dst, x, y) & used;
+				Uint32 b = GetPixel(ref, x, y) & used;
+				int c, diff = 0;
+
+				/* Blends round differently */
+				for ( c = 0; c < 32; c += 8 ) {
+					int d = (int)((a >> c) & 0xFF) -
+					        (int)((b >> c) & 0xFF);
+					if ( d < -2 || d > 2 ||
+					     (d && !(flags & SDL_SRCALPHA)) ) {
+						diff = 1;
+					}
+				}
+				if ( diff && errors++ == 0 ) {
+					printf("  rects %d, pixel %d,%d: %08X, "
+					       "expected %08X\n",
+					       i / 2, x, y, a, b);
+				}
+			}
+		}
+	}
+
+	SDL_FreeSurface(src);
+	SDL_FreeSurface(dst);
+	SDL_FreeSurface(ref);
+	SDL_FreeSurface(tmp);
+	return errors;
+}
+
+/* Where destination pixel 'i' of 'dst_n' samples 'src_n' source pixels
+   with the bilinear filter, in 16.16 fixed point from the first one */
+static int BilinearPos(int i, int src_n, int dst_n)
+{
+	int inc = (src_n << 16) / dst_n;
+	int pos = i * inc + inc / 2 - 0x8000;
+
+	if ( pos < 0 ) {
+		pos = 0;
+	}
+	if ( (pos >> 16) >= src_n - 1 ) {
+		pos = (src_n - 1) << 16;
+	}
+	return pos;
+}
+
+static Uint32 Lerp(Uint32 a, Uint32 b, int f)
+{
+	Uint32 pixel = 0;
+	int c;
+
+	for ( c = 0; c < 32; c += 8 ) {
+		Uint32 x = ((a >> c) & 0xFF) * (256 - f) +
+		           ((b >> c) & 0xFF) * f;
+		pixel |= ((x + 128) >> 8) << c;
+	}
+	return pixel;
+}
+
+/* Bilinear ARGB8888 stretches of each rectangle pair, worked out here */
+static int CheckStretchBilinear(void)
+{
+	SDL_Surface *src = SDL_CreateRGBSurface(SDL_SWSURFACE, 40, 8, 32,
+	                   0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000);
+	SDL_Surface *dst = SDL_CreateRGBSurface(SDL_SWSURFACE, 100, 13, 32,
+	                   0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000);
+	int i, x, y, errors = 0;
+
+	if ( !src || !dst ) {
+		fprintf(stderr, "Couldn't create surfaces: %s\n", SDL_GetError());
+		exit(2);
+	}
+	FillRandom(src);
+	SDL_SetAlpha(src, 0, SDL_ALPHA_OPAQUE);
+
+	for ( i = 0; i < (int)SDL_arraysize(stretchrects); i += 2 ) {
+		SDL_Rect srect = stretchrects[i], drect = stretchrects[i+1];
+
+		if ( SDL_SoftStretchFilter(src, &srect, dst, &drect,
+		                           SDL_STRETCH_BILINEAR) < 0 ) {
+			printf("  stretch failed: %s\n", SDL_GetError());
+			++errors;
+			continue;
+		}
+		for ( y = 0; y < drect.h; ++y ) {
+			int py = BilinearPos(y, srect.h, drect.h);
+			int y0 = srect.y + (py >> 16);
+			int y1 = y0 + (((py >> 8) & 0xFF) != 0);
+
+			for ( x = 0; x < drect.w; ++x ) {
+				int px = BilinearPos(x, srect.w, drect.w);
+				int x0 = srect.x + (px >> 16);
+				int x1 = x0 + (((px >> 8) & 0xFF) != 0);
+				int fx = (px >> 8) & 0xFF;
+				Uint32 top = Lerp(GetPixel(src, x0, y0),
+				                  GetPixel(src, x1, y0), fx);
+				Uint32 bottom = Lerp(GetPixel(src, x0, y1),
+				                     GetPixel(src, x1, y1), fx);
+				Uint32 expected = Lerp(top, bottom,
+				                       (py >> 8) & 0xFF);
+				Uint32 pixel = GetPixel(dst, drect.x + x,
+				                        drect.y + y);
+
+				if ( pixel != expected && errors++ == 0 ) {
+					printf("  rects %d, pixel %d,%d: %08X, "
+					       "expected %08X\n",
+					       i / 2, x, y, pixel, expected);
+				}
+			}
+		}
+	}
+
+	SDL_FreeSurface(src);
+	SDL_FreeSurface(dst);
+	return errors;
+}
+
+/* 37x5 scaled by 2 into 100x13 must be centred, with the rest left alone */
+static int CheckStretchInteger(void)
+{
+	SDL_Surface *src = SDL_CreateRGBSurface(SDL_SWSURFACE, 37, 5, 16,
+	                   0xF800, 0x07E0, 0x001F, 0);
+	SDL_Surface *dst = SDL_CreateRGBSurface(SDL_SWSURFACE, 100, 13, 16,
+	                   0xF800, 0x07E0, 0x001F, 0);
+	int x, y, errors = 0;
+
+	if ( !src || !dst ) {
+		fprintf(stderr, "Couldn't create surfaces: %s\n", SDL_GetError());
+		exit(2);
+	}
+	FillRandom(src);
+	SDL_FillRect(dst, NULL, 0x1234);
+	if ( SDL_SoftStretchFilter(src, NULL, dst, NULL,
+	                           SDL_STRETCH_INTEGER) < 0 ) {
+		printf("  stretch failed: %s\n", SDL_GetError());
+		return 1;
+	}
+	for ( y = 0; y < dst->h; ++y ) {
+		for ( x = 0; x < dst->w; ++x ) {
+			Uint32 expected = 0x1234;
+
+			if ( x >= 13 && x < 13 + 74 && y >= 1 && y < 1 + 10 ) {
+				expected = GetPixel(src, (x - 13) / 2,
+				                    (y - 1) / 2);
+			}
+			if ( GetPixel(dst, x, y) != expected && errors++ == 0 ) {
+				printf("  pixel %d,%d: %04X, expected %04X\n",
+				       x, y, GetPixel(dst, x, y), expected);
+			}
+		}
+	}
+
+	SDL_FreeSurface(src);
+	SDL_FreeSurface(dst);
+	return errors;
+}
+
+/* The overlay formats, with the planes (YV12 and IYUV), the bytes in
+   each pair of pixels (packed formats) or the bytes in each pair of
+   chroma samples (NV12 and NV21) of their luma and chroma */
+static const struct {
+	const char *name;
+	Uint32 format;
+	int lum, cr, cb;
+} yuvformats[] = {
+	{ "YV12", SDL_YV12_OVERLAY, 0, 1, 2 },
+	{ "IYUV", SDL_IYUV_OVERLAY, 0, 2, 1 },
+	{ "YUY2", SDL_YUY2_OVERLAY, 0, 3, 1 },
+	{ "UYVY", SDL_UYVY_OVERLAY, 1, 2, 0 },
+	{ "YVYU", SDL_YVYU_OVERLAY, 0, 1, 3 },
+	{ "NV12", SDL_NV12_OVERLAY, 0, 1, 0 },
+	{ "NV21", SDL_NV21_OVERLAY, 0, 0, 1 }
+};
+
+static const struct {
+	const char *name;
+	Format format;
+} yuvdisplays[] = {
+	{ "RGB565", RGB565 },
+	{ "BGR555", BGR555 },
+	{ "RGB24", RGB24 },
+	{ "RGB888", RGB888 },
+	{ "BGR888", BGR888 }
+};
+
+static int ClampYUV(int value)
+{
+	return value < 0 ? 0 : (value > 255 ? 255 : value);
+}
+
+/* Sample x,y of plane 0 (Y), 1 (Cr) or 2 (Cb) of an overlay, the chroma
+   samples numbered in their own plane */
+static int YUVSample(SDL_Overlay *overlay, int yuv, int plane, int x, int y)
+{
+	int offsets[3];
+
+	if ( overlay->planes == 3 ) {
+		int i = plane ? (plane == 1 ? yuvformats[yuv].cr :
+		                              yuvformats[yuv].cb) : 0;
+
+		return overlay->pixels[i][y * overlay->pitches[i] + x];
+	}
+	if ( overlay->planes == 2 ) {
+		if ( !plane ) {
+			return overlay->pixels[0][y * overlay->pitches[0] + x];
+		}
+		return overlay->pixels[1][y * overlay->pitches[1] + x * 2 +
+		                          (plane == 1 ? yuvformats[yuv].cr :
+		                                        yuvformats[yuv].cb)];
+	}
+	offsets[0] = yuvformats[yuv].lum;
+	offsets[1] = yuvformats[yuv].cr;
+	offsets[2] = yuvformats[yuv].cb;
+	if ( !plane ) {
+		return overlay->pixels[0][y * overlay->pitches[0] + x * 2 +
+		                          offsets[0]];
+	}
+	return overlay->pixels[0][y * overlay->pitches[0] + x * 4 +
+	                          offsets[plane]];
+}
+
+/* A pixel converted like the tables of SDL_yuv_sw.c */
+static Uint32 YUVPixel(int L, int Cr, int Cb, const Format *df)
+{
+	int r, g, b;
+
+	Cr -= 128;
+	Cb -= 128;
+	r = ClampYUV(L + (int)((0.419/0.299) * Cr));
+	g = ClampYUV(L + (int)(-(0.299/0.419) * Cr) +
+	                 (int)(-(0.114/0.331) * Cb));
+	b = ClampYUV(L + (int)((0.587/0.331) * Cb));
+	return MakeField(r >> (8 - Bits(df->Rmask)), df->Rmask) |
+	       MakeField(g >> (8 - Bits(df->Gmask)), df->Gmask) |
+	       MakeField(b >> (8 - Bits(df->Bmask)), df->Bmask);
+}
+
+/* Pixel x,y of an overlay */
+static Uint32 YUVExpected(SDL_Overlay *overlay, int yuv, const Format *df,
+                          int x, int y)
+{
+	int cy = (overlay->planes > 1) ? y / 2 : y;
+
+	return YUVPixel(YUVSample(overlay, yuv, 0, x, y),
+	                YUVSample(overlay, yuv, 1, x / 2, cy),
+	                YUVSample(overlay, yuv, 2, x / 2, cy), df);
+}
+
+/* A w x h overlay of random pixels shown at 1,0 of a surface, at its own
+   size or twice it, with the rest of the surface left alone.  w must be
+   a multiple of 4, the 24 bit converters need pitches of whole pixels. */
+static int CheckYUV(int yuv, const Format *df, int w, int h, int scale)
+{
+	SDL_Surface *dst = SDL_CreateRGBSurface(SDL_SWSURFACE,
+	                   w * scale + 4, h * scale, df->bpp,
+	                   df->Rmask, df->Gmask, df->Bmask, 0);
+	SDL_Overlay *overlay;
+	SDL_Rect rect;
+	Uint32 border;
+	int i, x, y, errors = 0;
+
+	if ( !dst ) {
+		fprintf(stderr, "Couldn't create surface: %s\n", SDL_GetError());
+		exit(2);
+	}
+	overlay = SDL_CreateYUVOverlay(w, h, yuvformats[yuv].format, dst);
+	if ( !overlay ) {
+		fprintf(stderr, "Couldn't create overlay: %s\n", SDL_GetError());
+		exit(2);
+	}
+	SDL_LockYUVOverlay(overlay);
+	for ( i = 0; i < overlay->planes; ++i ) {
+		int size = overlay->pitches[i] *
+		           ((overlay->planes > 1 && i) ? h / 2 : h);
+
+		for ( x = 0; x < size; ++x ) {
+			overlay->pixels[i][x] = (Uint8)Random();
+		}
+	}
+	SDL_UnlockYUVOverlay(overlay);
+
+	border = SDL_MapRGB(dst->format, 0x12, 0x34, 0x56);
+	SDL_FillRect(dst, NULL, border);
+	rect.x = 1;
+	rect.y = 0;
+	rect.w = w * scale;
+	rect.h = h * scale;
+	if ( SDL_DisplayYUVOverlay(overlay, &rect) < 0 ) {
+		printf("  display failed: %s\n", SDL_GetError());
+		errors = 1;
+	}
+	for ( y = 0; !errors && y < dst->h; ++y ) {
+		for ( x = 0; x < dst->w; ++x ) {
+			Uint32 expected = border;
+
+			if ( x >= 1 && x < 1 + w * scale ) {
+				expected = YUVExpected(overlay, yuv, df,
+				                       (x - 1) / scale,
+				                       y / scale);
+			}
+			if ( GetPixel(dst, x, y) != expected && errors++ == 0 ) {
+				printf("  %dx%d x%d pixel %d,%d: %X, expected %X\n",
+				       w, h, scale, x, y,
+				       GetPixel(dst, x, y), expected);
+			}
+		}
+	}
+
+	SDL_FreeYUVOverlay(overlay);
+	SDL_FreeSurface(dst);
+	return errors;
+}
+
+/* Where 'pos' (16.16) samples a plane between samples 'first' and 'last' */
+static void YUVStep(int pos, int first, int last, int *i, int *frac)
+{
+	if ( pos < (first << 16) ) {
+		pos = first << 16;
+	}
+	*i = pos >> 16;
+	*frac = (pos >> 8) & 0xFF;
+	if ( *i >= last ) {
+		*i = last;
+		*frac = 0;
+	}
+}
+
+static int YUVLerp(int a, int b, int f)
+{
+	return (a * (256 - f) + b * f + 128) >> 8;
+}
+
+/* A plane sampled at xpos,ypos, filtered across then down */
+static int YUVFiltered(SDL_Overlay *overlay, int yuv, int plane,
+                       int xpos, int xfirst, int xlast,
+                       int ypos, int yfirst, int ylast)
+{
+	int x, y, fx, fy, top, bottom;
+
+	YUVStep(xpos, xfirst, xlast, &x, &fx);
+	YUVStep(ypos, yfirst, ylast, &y, &fy);
+	top = YUVLerp(YUVSample(overlay, yuv, plane, x, y),
+	              YUVSample(overlay, yuv, plane, x + (fx != 0), y), fx);
+	bottom = YUVLerp(YUVSample(overlay, yuv, plane, x, y + (fy != 0)),
+	                 YUVSample(overlay, yuv, plane, x + (fx != 0),
+	                           y + (fy != 0)), fx);
+	return YUVLerp(top, bottom, fy);
+}
+
+/* A w x h overlay of random pixels shown in 'rect' with the bilinear
+   filter, which may be partly off the top left of the screen */
+static int CheckYUVScaled(int yuv, const Format *df, int w, int h,
+                          SDL_Rect rect)
+{
+	SDL_Surface *dst = SDL_CreateRGBSurface(SDL_SWSURFACE,
+	                   rect.x + rect.w + 3, rect.y + rect.h + 1, df->bpp,
+	                   df->Rmask, df->Gmask, df->Bmask, 0);
+	SDL_Overlay *overlay;
+	SDL_Rect src, shown;
+	Uint32 border;
+	int planar, i, x, y, errors = 0;
+
+	if ( !dst ) {
+		fprintf(stderr, "Couldn't create surface: %s\n", SDL_GetError());
+		exit(2);
+	}
+	overlay = SDL_CreateYUVOverlay(w, h, yuvformats[yuv].format, dst);
+	if ( !overlay ) {
+		fprintf(stderr, "Couldn't create overlay: %s\n", SDL_GetError());
+		exit(2);
+	}
+	planar = (overlay->planes > 1);
+	SDL_LockYUVOverlay(overlay);
+	for ( i = 0; i < overlay->planes; ++i ) {
+		int size = overlay->pitches[i] * ((planar && i) ? h / 2 : h);
+
+		for ( x = 0; x < size; ++x ) {
+			overlay->pixels[i][x] = (Uint8)Random();
+		}
+	}
+	SDL_UnlockYUVOverlay(overlay);
+
+	border = SDL_MapRGB(dst->format, 0x12, 0x34, 0x56);
+	SDL_FillRect(dst, NULL, border);
+	if ( SDL_DisplayYUVOverlay(overlay, &rect) < 0 ) {
+		printf("  display failed: %s\n", SDL_GetError());
+		errors = 1;
+	}
+
+	/* Clipped like SDL_DisplayYUVOverlay() */
+	src.x = 0;
+	src.y = 0;
+	src.w = w;
+	src.h = h;
+	shown = rect;
+	if ( rect.x < 0 ) {
+		src.x = -(rect.x * w) / rect.w;
+		src.w -= src.x;
+		shown.x = 0;
+		shown.w += rect.x;
+	}
+	if ( rect.y < 0 ) {
+		src.y = -(rect.y * h) / rect.h;
+		src.h -= src.y;
+		shown.y = 0;
+		shown.h += rect.y;
+	}
+
+	for ( y = 0; !errors && y < dst->h; ++y ) {
+		int incx = (src.w << 16) / shown.w;
+		int incy = (src.h << 16) / shown.h;
+		int ypos = (src.y << 16) + (y - shown.y) * incy + incy / 2;
+		int cypos = planar ? ypos / 2 : ypos;
+		int cyfirst = planar ? src.y / 2 : src.y;
+		int cylast = planar ? (src.y + src.h - 1) / 2 : src.y + src.h - 1;
+		int cxlast = (src.x + src.w - 1) / 2;
+
+		if ( planar && cylast > h / 2 - 1 ) {
+			cylast = h / 2 - 1;
+		}
+		if ( cxlast > w / 2 - 1 ) {
+			cxlast = w / 2 - 1;
+		}
+		for ( x = 0; x < dst->w; ++x ) {
+			Uint32 expected = border;
+
+			if ( x >= shown.x && x < shown.x + shown.w &&
+			     y >= shown.y && y < shown.y + shown.h ) {
+				int i = x - shown.x;
+				int xpos = (src.x << 16) + i * incx + incx / 2;
+				int cxpos = ((src.x << 16) +
+				             ((i / 2) * 2 + 1) * incx) / 2;
+
+				expected = YUVPixel(
+					YUVFiltered(overlay, yuv, 0,
+					            xpos - 0x8000, src.x,
+					            src.x + src.w - 1,
+					            ypos - 0x8000, src.y,
+					            src.y + src.h - 1),
+					YUVFiltered(overlay, yuv, 1,
+					            cxpos - 0x8000, src.x / 2,
+					            cxlast, cypos - 0x8000,
+					            cyfirst, cylast),
+					YUVFiltered(overlay, yuv, 2,
+					            cxpos - 0x8000, src.x / 2,
+					            cxlast, cypos - 0x8000,
+					            cyfirst, cylast), df);
+			}
+			if ( GetPixel(dst, x, y) != expected && errors++ == 0 ) {
+				printf("  %dx%d in %d,%d %dx%d pixel %d,%d: %X, "
+				       "expected %X\n", w, h, rect.x, rect.y,
+				       rect.w, rect.h, x, y,
+				       GetPixel(dst, x, y), expected);
+			}
+		}
+	}
+
+	SDL_FreeYUVOverlay(overlay);
+	SDL_FreeSurface(dst);
+	return errors;
+}
+
+/* Pixel alpha blits of an RLE surface onto 32 bit surfaces, clipped on
+   either side, against the same blits without RLE */
+static int CheckRLEAlpha(const Format *df)
+{
+	SDL_Surface *src = SDL_CreateRGBSurface(SDL_SWSURFACE, 67, 9, 32,
+	                   0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000);
+	SDL_Surface *rle = SDL_CreateRGBSurface(SDL_SWSURFACE, 67, 9, 32,
+	                   0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000);
+	SDL_Surface *one = SDL_CreateRGBSurface(SDL_SWSURFACE, 80, 12, df->bpp,
+	                   df->Rmask, df->Gmask, df->Bmask, df->Amask);
+	SDL_Surface *two = SDL_CreateRGBSurface(SDL_SWSURFACE, 80, 12, df->bpp,
+	                   df->Rmask, df->Gmask, df->Bmask, df->Amask);
+	Uint32 used = df->Rmask | df->Gmask | df->Bmask;
+	int i, x, y, errors = 0;
+
+	if ( !src || !rle || !one || !two ) {
+		fprintf(stderr, "Couldn't create surfaces: %s\n", SDL_GetError());
+		exit(2);
+	}
+	/* Runs of transparent, opaque and translucent pixels, short ones
+	   and then ones long enough for the vector span blenders */
+	for ( y = 0; y < src->h; ++y ) {
+		for ( x = 0; x < src->w; ++x ) {
+			Uint32 pixel = Random() & 0x00FFFFFF;
+			switch ((x / (y < 5 ? 5 : 23) + y) % 3) {
+			    case 0:
+				break;
+			    case 1:
+				pixel |= 0xFF000000;
+				break;
+			    default:
+				pixel |= (1 + Random() % 254) << 24;
+				break;
+			}
+			PutPixel(src, x, y, pixel);
+		}
+	}
+	SDL_memcpy(rle->pixels, src->pixels, src->h * src->pitch);
+	SDL_SetAlpha(src, SDL_SRCALPHA, SDL_ALPHA_OPAQUE);
+	SDL_SetAlpha(rle, SDL_SRCALPHA|SDL_RLEACCEL, SDL_ALPHA_OPAQUE);
+
+	for ( i = 0; i < 4; ++i ) {
+		SDL_Rect srect, drect;
+
+		srect.x = (Sint16)(i & 1 ? 3 : 0);
+		srect.y = (Sint16)(i & 2 ? 2 : 0);
+		srect.w = (Uint16)(src->w - (i ? 5 : 0));
+		srect.h = (Uint16)(src->h - srect.y);
+		FillRandom(one);
+		SDL_memcpy(two->pixels, one->pixels, one->h * one->pitch);
+		drect.x = drect.y = (Sint16)i;
+		SDL_BlitSurface(src, &srect, one, &drect);
+		drect.x = drect.y = (Sint16)i;
+		SDL_BlitSurface(rle, &srect, two, &drect);
+		for ( y = 0; y < one->h; ++y ) {
+			for ( x = 0; x < one->w; ++x ) {
+				Uint32 a = GetPixel(one, x, y) & used;
+				Uint32 b = GetPixel(two, x, y) & used;
+				int c, diff = 0;
+
+				for ( c = 0; c < 32; c += 8 ) {
+					int d = (int)((a >> c) & 0xFF) -
+					        (int)((b >> c) & 0xFF);
+					if ( d < -1 || d > 1 ) {
+						diff = 1;
+					}
+				}
+				if ( diff && errors++ == 0 ) {
+					printf("  clip %d, pixel %d,%d: %08X, "
+					       "expected %08X\n", i, x, y, b, a);
+				}
+			}
+		}
+	}
+	if ( !(rle->flags & SDL_RLEACCEL) && errors++ == 0 ) {
+		printf("  surface isn't RLE encoded\n");
+	}
+
+	SDL_FreeSurface(src);
+	SDL_FreeSurface(rle);
+	SDL_FreeSurface(one);
+	SDL_FreeSurface(two);
+	return errors;
+}
+
+/* Whether the pixels of two surfaces of the same size and format match */
+static int SameRows(SDL_Surface *a, SDL_Surface *b)
+{
+	int y;
+
+	for ( y = 0; y < a->h; ++y ) {
+		if ( SDL_memcmp((Uint8 *)a->pixels + y * a->pitch,
+		                (Uint8 *)b->pixels + y * b->pitch,
+		                a->w * a->format->BytesPerPixel) != 0 ) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/* Read only locks of a color keyed RLE surface keep the encoding and the
+   decoded pixels, a write lock inside one changes the pixels */
+static int CheckRLELock(void)
+{
+	SDL_Surface *src = SDL_CreateRGBSurface(SDL_SWSURFACE, 33, 7, 16,
+	                   0xF800, 0x07E0, 0x001F, 0);
+	SDL_Surface *copy;
+	SDL_Surface *dst = SDL_CreateRGBSurface(SDL_SWSURFACE, 33, 7, 16,
+	                   0xF800, 0x07E0, 0x001F, 0);
+	SDL_Rect rect;
+	void *pixels;
+	int i, errors = 0;
+
+	if ( !src || !dst ) {
+		fprintf(stderr, "Couldn't create surfaces: %s\n", SDL_GetError());
+		exit(2);
+	}
+	FillRandom(src);
+	for ( i = 0; i < 33 * 7; i += 4 ) {
+		PutPixel(src, i % 33, i / 33, 0);
+	}
+	copy = SDL_ConvertSurface(src, src->format, SDL_SWSURFACE);
+	if ( !copy ) {
+		fprintf(stderr, "Couldn't copy surface: %s\n", SDL_GetError());
+		exit(2);
+	}
+	SDL_SetColorKey(src, SDL_SRCCOLORKEY|SDL_RLEACCEL, 0);
+	rect.x = rect.y = 0;
+	SDL_BlitSurface(src, NULL, dst, &rect);	/* encodes it */
+
+	for ( i = 0; i < 2; ++i ) {
+		if ( SDL_LockSurfaceReadOnly(src) < 0 ) {
+			printf("  SDL_LockSurfaceReadOnly: %s\n", SDL_GetError());
+			return errors + 1;
+		}
+		if ( !SameRows(src, copy) && errors++ == 0 ) {
+			printf("  decoded pixels differ\n");
+		}
+		pixels = src->pixels;
+		SDL_UnlockSurface(src);
+		if ( (!(src->flags & SDL_RLEACCEL) ||
+		      src->pixels != pixels) && errors++ == 0 ) {
+			printf("  encoding or pixels not kept\n");
+		}
+	}
+
+	SDL_LockSurfaceReadOnly(src);
+	SDL_LockSurface(src);
+	PutPixel(src, 1, 1, 0x1234);
+	PutPixel(copy, 1, 1, 0x1234);
+	SDL_UnlockSurface(src);
+	SDL_UnlockSurface(src);
+	if ( !(src->flags & SDL_RLEACCEL) && errors++ == 0 ) {
+		printf("  surface isn't RLE encoded after writing\n");
+	}
+	SDL_FillRect(dst, NULL, 0);
+	rect.x = rect.y = 0;
+	SDL_BlitSurface(src, NULL, dst, &rect);
+	if ( !SameRows(dst, copy) && errors++ == 0 ) {
+		printf("  blit after writing differs\n");
+	}
+
+	SDL_FreeSurface(src);
+	SDL_FreeSurface(copy);
+	SDL_FreeSurface(dst);
+	return errors;
+}
+
+/* A large color keyed RLE surface is encoded in the background and must
+   blit the same before and after, one with short runs isn't encoded, and
+   one freed while it is being encoded must not leak or crash */
+static int CheckRLEBackground(void)
+{
+	SDL_Surface *src = SDL_CreateRGBSurface(SDL_SWSURFACE, 256, 128, 16,
+	                   0xF800, 0x07E0, 0x001F, 0);
+	SDL_Surface *one = SDL_CreateRGBSurface(SDL_SWSURFACE, 256, 128, 16,
+	                   0xF800, 0x07E0, 0x001F, 0);
+	SDL_Surface *two = SDL_CreateRGBSurface(SDL_SWSURFACE, 256, 128, 16,
+	                   0xF800, 0x07E0, 0x001F, 0);
+	SDL_Surface *plain, *spare;
+	SDL_RLEStats stats;
+	SDL_Rect rect;
+	Uint32 start;
+	int x, y, errors = 0;
+
+	SDL_putenv("SDL_RLE_HEURISTIC=1");
+
+	if ( !src || !one || !two ) {
+		fprintf(stderr, "Couldn't create surfaces: %s\n", SDL_GetError());
+		exit(2);
+	}
+	FillRandom(src);
+	for ( y = 0; y < src->h; ++y ) {
+		for ( x = 0; x < src->w; ++x ) {
+			if ( (x / 32 + y / 16) % 2 ) {
+				PutPixel(src, x, y, 0);
+			}
+		}
+	}
+	plain = SDL_ConvertSurface(src, src->format, SDL_SWSURFACE);
+	spare = SDL_ConvertSurface(src, src->format, SDL_SWSURFACE);
+	if ( !plain || !spare ) {
+		fprintf(stderr, "Couldn't copy surface: %s\n", SDL_GetError());
+		exit(2);
+	}
+	SDL_SetColorKey(plain, SDL_SRCCOLORKEY, 0);
+	SDL_SetColorKey(src, SDL_SRCCOLORKEY|SDL_RLEACCEL, 0);
+	SDL_ResetRLEStats();
+
+	start = SDL_GetTicks();
+	for ( ;; ) {
+		FillRandom(one);
+		SDL_memcpy(two->pixels, one->pixels, one->h * one->pitch);
+		rect.x = rect.y = 0;
+		SDL_BlitSurface(plain, NULL, one, &rect);
+		rect.x = rect.y = 0;
+		SDL_BlitSurface(src, NULL, two, &rect);
+		if ( !SameRows(one, two) && errors++ == 0 ) {
+			printf("  blit differs %s the encoding\n",
+			       (src->flags & SDL_RLEACCEL) ? "with" : "without");
+		}
+		if ( (src->flags & SDL_RLEACCEL) ||
+		     (SDL_GetTicks() - start) > 5000 ) {
+			break;
+		}
+		SDL_Delay(1);
+	}
+	SDL_GetRLEStats(&stats);
+	if ( (!(src->flags & SDL_RLEACCEL) || stats.encoded != 1 ||
+	      stats.bytes == 0 || stats.rle_blits != 1 || stats.skipped) &&
+	     errors++ == 0 ) {
+		printf("  not encoded: %u encoded, %u bytes, %u RLE blits\n",
+		       stats.encoded, (unsigned)stats.bytes, stats.rle_blits);
+	}
+
+	/* Freed while waiting for, or being, encoded */
+	SDL_SetColorKey(spare, SDL_SRCCOLORKEY|SDL_RLEACCEL, 0);
+	rect.x = rect.y = 0;
+	SDL_BlitSurface(spare, NULL, one, &rect);
+	SDL_FreeSurface(spare);
+
+	/* Alternating pixels don't compress */
+	for ( y = 0; y < plain->h; ++y ) {
+		for ( x = 0; x < plain->w; ++x ) {
+			if ( (x + y) % 2 ) {
+				PutPixel(plain, x, y, 0);
+			}
+		}
+	}
+	SDL_ResetRLEStats();
+	SDL_SetColorKey(plain, SDL_SRCCOLORKEY|SDL_RLEACCEL, 0);
+	rect.x = rect.y = 0;
+	SDL_BlitSurface(plain, NULL, one, &rect);
+	SDL_GetRLEStats(&stats);
+	if ( ((plain->flags & SDL_RLEACCEL) || stats.skipped != 1 ||
+	      stats.plain_blits != 1) && errors++ == 0 ) {
+		printf("  surface with short runs was encoded\n");
+	}
+
+	SDL_FreeSurface(src);
+	SDL_FreeSurface(plain);
+	SDL_FreeSurface(one);
+	SDL_FreeSurface(two);
+	SDL_putenv("SDL_RLE_HEURISTIC=0");
+	return errors;
+}
+
+/* Where pixel x,y of a w x h image ends up when rotated clockwise */
+static void RotatedPos(int w, int h, int rotation, int x, int y,
+                       int *rx, int *ry)
+{
+	switch (rotation) {
+	    case SDL_PRESENT_ROTATE_90:
+		*rx = h - 1 - y;
+		*ry = x;
+		break;
+	    case SDL_PRESENT_ROTATE_180:
+		*rx = w - 1 - x;
+		*ry = h - 1 - y;
+		break;
+	    case SDL_PRESENT_ROTATE_270:
+		*rx = y;
+		*ry = w - 1 - x;
+		break;
+	    default:
+		*rx = x;
+		*ry = y;
+		break;
+	}
+}
+
+/* SDL_RotateRect() must move every pixel of the rectangle (clipped to
+   the image) to its rotated position and leave the rest alone */
+static int CheckRotate(int bpp, int w, int h, SDL_Rect rect, int rotation)
+{
+	const int src_pitch = w * bpp + 3;
+	const int rot_w = (rotation & 1) ? h : w;
+	const int rot_h = (rotation & 1) ? w : h;
+	const int dst_pitch = rot_w * bpp + 5;
+	Uint8 *src, *dst, *expected;
+	int x, y, rx, ry, errors = 0;
+
+	src = (Uint8 *)malloc(src_pitch * h);
+	dst = (Uint8 *)malloc(dst_pitch * rot_h);
+	expected = (Uint8 *)malloc(dst_pitch * rot_h);
+	if ( !src || !dst || !expected ) {
+		fprintf(stderr, "Out of memory\n");
+		exit(2);
+	}
+	for ( x = 0; x < src_pitch * h; ++x ) {
+		src[x] = (Uint8)Random();
+	}
+	for ( x = 0; x < dst_pitch * rot_h; ++x ) {
+		dst[x] = expected[x] = (Uint8)Random();
+	}
+	if ( rect.x + rect.w > w ) {
+		rect.w = w - rect.x;
+	}
+	if ( rect.y + rect.h > h ) {
+		rect.h = h - rect.y;
+	}
+	for ( y = rect.y; y < rect.y + rect.h; ++y ) {
+		for ( x = rect.x; x < rect.x + rect.w; ++x ) {
+			RotatedPos(w, h, rotation, x, y, &rx, &ry);
+			memcpy(expected + ry * dst_pitch + rx * bpp,
+			       src + y * src_pitch + x * bpp, bpp);
+		}
+	}
+
+	SDL_RotateRect(src, src_pitch, dst, dst_pitch, bpp, w, h,
+	               &rect, rotation);
+
+	for ( y = 0; y < rot_h && !errors; ++y ) {
+		if ( memcmp(dst + y * dst_pitch, expected + y * dst_pitch,
+		            dst_pitch) != 0 ) {
+			printf("  %dx%d %d bytes, %d,%d %dx%d at %d degrees: "
+			       "row %d differs\n", w, h, bpp, rect.x, rect.y,
+			       rect.w, rect.h, rotation * 90, y);
+			++errors;
+		}
+	}
+	free(src);
+	free(dst);
+	free(expected);
+	return errors;
+}
+
+/* 8 bit R, G and B of a logical pixel, widened like RGB_FROM_PIXEL */
+static void PresentRGB(SDL_Surface *src, int x, int y,
+                       Uint32 *r, Uint32 *g, Uint32 *b)
+{
+	const SDL_PixelFormat *sf = src->format;
+	Uint32 pixel;
+
+	if ( sf->BytesPerPixel == 1 ) {
+		const SDL_Color *c = &sf->palette->colors[
+			((Uint8 *)src->pixels)[y * src->pitch + x]];
+
+		*r = c->r;
+		*g = c->g;
+		*b = c->b;
+		return;
+	}
+	pixel = GetPixel(src, x, y);
+	*r = Field(pixel, sf->Rmask) << (8 - Bits(sf->Rmask));
+	*g = Field(pixel, sf->Gmask) << (8 - Bits(sf->Gmask));
+	*b = Field(pixel, sf->Bmask) << (8 - Bits(sf->Bmask));
+}
+
+/* Physical pixel u,v of the presented area, worked out on its own: the
+   16.16 position of its centre in the rotated image, turned back into
+   logical coordinates, then sampled and converted */
+static Uint32 PresentExpected(SDL_Surface *src, const SDL_PixelFormat *df,
+                              const SDL_Rect *area, int rotation,
+                              int filter, const SDL_GammaLUT *lut,
+                              int u, int v)
+{
+	const int rot_w = (rotation & 1) ? src->h : src->w;
+	const int rot_h = (rotation & 1) ? src->w : src->h;
+	const Sint32 step_x = (rot_w << 16) / area->w;
+	const Sint32 step_y = (rot_h << 16) / area->h;
+	const Sint32 half = (filter == SDL_PRESENT_BILINEAR) ? 0x8000 : 0;
+	const Sint32 last_x = (filter == SDL_PRESENT_BILINEAR) ?
+	                      (src->w - 1) << 16 : (src->w << 16) - 1;
+	const Sint32 last_y = (filter == SDL_PRESENT_BILINEAR) ?
+	                      (src->h - 1) << 16 : (src->h << 16) - 1;
+	Sint32 pu = step_x / 2 - half + u * step_x;
+	Sint32 pv = step_y / 2 - half + v * step_y;
+	Sint32 x, y;
+	Uint32 r, g, b;
+
+	switch (rotation) {
+	    case SDL_PRESENT_ROTATE_90:
+		x = pv;
+		y = last_y - pu;
+		break;
+	    case SDL_PRESENT_ROTATE_180:
+		x = last_x - pu;
+		y = last_y - pv;
+		break;
+	    case SDL_PRESENT_ROTATE_270:
+		x = last_x - pv;
+		y = pu;
+		break;
+	    default:
+		x = pu;
+		y = pv;
+		break;
+	}
+
+	if ( filter == SDL_PRESENT_BILINEAR ) {
+		Uint32 c[4][3];
+		int x0, y0, x1, y1, fx, fy, i;
+
+		x = (x < 0) ? 0 : ((x > last_x) ? last_x : x);
+		y = (y < 0) ? 0 : ((y > last_y) ? last_y : y);
+		x0 = x >> 16;
+		y0 = y >> 16;
+		x1 = (x0 < src->w - 1) ? x0 + 1 : x0;
+		y1 = (y0 < src->h - 1) ? y0 + 1 : y0;
+		fx = (x >> 8) & 0xFF;
+		fy = (y >> 8) & 0xFF;
+		PresentRGB(src, x0, y0, &c[0][0], &c[0][1], &c[0][2]);
+		PresentRGB(src, x1, y0, &c[1][0], &c[1][1], &c[1][2]);
+		PresentRGB(src, x0, y1, &c[2][0], &c[2][1], &c[2][2]);
+		PresentRGB(src, x1, y1, &c[3][0], &c[3][1], &c[3][2]);
+		for ( i = 0; i < 3; ++i ) {
+			c[0][i] = ((c[0][i] * (256 - fx) + c[1][i] * fx) *
+			           (256 - fy) +
+			           (c[2][i] * (256 - fx) + c[3][i] * fx) * fy) >> 16;
+		}
+		r = c[0][0];
+		g = c[0][1];
+		b = c[0][2];
+	} else {
+		PresentRGB(src, x >> 16, y >> 16, &r, &g, &b);
+	}
+	if ( lut ) {
+		r = lut->r[r];
+		g = lut->g[g];
+		b = lut->b[b];
+	}
+	return MakeField(r >> (8 - Bits(df->Rmask)), df->Rmask) |
+	       MakeField(g >> (8 - Bits(df->Gmask)), df->Gmask) |
+	       MakeField(b >> (8 - Bits(df->Bmask)), df->Bmask);
+}
+
+typedef struct {
+	const char *name;
+	Format src;
+	Format dst;
+	int w, h;		/* The logical surface */
+	int dw, dh;		/* The physical one */
+	SDL_Rect area;
+	int filter;
+} PresentCase;
+
+static const PresentCase presents[] = {
+	{ "RGB565 -> RGB565 present", RGB565, RGB565,
+	  37, 23, 37, 37, { 0, 7, 37, 23 }, SDL_PRESENT_NEAREST },
+	{ "RGB565 -> RGB565 scaled present", RGB565, RGB565,
+	  37, 23, 110, 70, { 5, 3, 100, 61 }, SDL_PRESENT_NEAREST },
+	{ "RGB565 -> ARGB8888 bilinear present", RGB565, ARGB8888,
+	  37, 23, 110, 70, { 5, 3, 100, 61 }, SDL_PRESENT_BILINEAR },
+	{ "8 bit -> ARGB8888 bilinear present", { 8, 0, 0, 0, 0 }, ARGB8888,
+	  21, 17, 60, 50, { 5, 3, 50, 40 }, SDL_PRESENT_BILINEAR },
+	{ "ARGB8888 -> RGB24 present", ARGB8888, RGB24,
+	  19, 13, 45, 45, { 1, 2, 41, 39 }, SDL_PRESENT_NEAREST },
+	{ "ARGB8888 -> RGB565 shrinking present", ARGB8888, RGB565,
+	  64, 48, 33, 33, { 2, 1, 29, 21 }, SDL_PRESENT_BILINEAR },
+};
+
+static SDL_Surface *CreatePresentSurface(const Format *format, int w, int h)
+{
+	SDL_Surface *surface;
+	int x, y;
+
+	surface = SDL_CreateRGBSurface(SDL_SWSURFACE, w, h, format->bpp,
+	                               format->Rmask, format->Gmask,
+	                               format->Bmask, format->Amask);
+	if ( !surface ) {
+		fprintf(stderr, "Couldn't create surface: %s\n", SDL_GetError());
+		exit(2);
+	}
+	if ( format->bpp == 8 ) {
+		SDL_Color colors[256];
+
+		for ( x = 0; x < 256; ++x ) {
+			colors[x].r = (Uint8)Random();
+			colors[x].g = (Uint8)Random();
+			colors[x].b = (Uint8)Random();
+		}
+		SDL_SetColors(surface, colors, 0, 256);
+	}
+	for ( y = 0; y < h; ++y ) {
+		for ( x = 0; x < surface->pitch; ++x ) {
+			((Uint8 *)surface->pixels)[y * surface->pitch + x] =
+				(Uint8)Random();
+		}
+	}
+	return surface;
+}
+
+/* Present a w x h logical surface inside 'area' of a dw x dh physical one
+   and compare every pixel, inside the area with the reference and outside
+   with what was there.  Then part of the logical surface is changed and
+   presented again: the physical rectangle reported must hold everything
+   that changed. */
+static int CheckPresent(const Format *sf, const Format *df, int w, int h,
+                        int dw, int dh, SDL_Rect area, int rotation,
+                        int filter, const SDL_GammaLUT *lut)
+{
+	static const SDL_Rect update = { 3, 2, 7, 5 };
+	SDL_PresentInfo info;
+	SDL_Surface *src, *dst, *before;
+	SDL_Rect full, dstrect;
+	int pass, x, y, errors = 0;
+
+	src = CreatePresentSurface(sf, w, h);
+	dst = CreatePresentSurface(df, dw, dh);
+	before = CreatePresentSurface(df, dw, dh);
+	if ( SDL_SetupPresent(&info, src, dst, &area, rotation, filter) < 0 ) {
+		fprintf(stderr, "Couldn't set up present: %s\n", SDL_GetError());
+		exit(2);
+	}
+	SDL_PresentSetGamma(&info, lut);
+
+	for ( pass = 0; pass < 2 && !errors; ++pass ) {
+		memcpy(before->pixels, dst->pixels, dst->h * dst->pitch);
+		if ( pass == 0 ) {
+			full.x = 0;
+			full.y = 0;
+			full.w = w;
+			full.h = h;
+			SDL_PresentRects(&info, 1, &full, &dstrect);
+		} else {
+			for ( y = update.y; y < update.y + update.h; ++y ) {
+				for ( x = update.x * sf->bpp / 8;
+				      x < (update.x + update.w) * sf->bpp / 8; ++x ) {
+					((Uint8 *)src->pixels)[y * src->pitch + x] =
+						(Uint8)Random();
+				}
+			}
+			SDL_PresentRects(&info, 1, &update, &dstrect);
+		}
+		for ( y = 0; y < dh && !errors; ++y ) {
+			for ( x = 0; x < dw && !errors; ++x ) {
+				int inside = (x >= area.x && y >= area.y &&
+				              x < area.x + area.w &&
+				              y < area.y + area.h);
+				int updated = (x >= dstrect.x && y >= dstrect.y &&
+				               x < dstrect.x + dstrect.w &&
+				               y < dstrect.y + dstrect.h);
+				Uint32 old = GetPixel(before, x, y);
+				Uint32 expected = old;
+				Uint32 pixel = GetPixel(dst, x, y);
+
+				if ( inside ) {
+					expected = PresentExpected(src, dst->format,
+					                           &area, rotation,
+					                           filter, lut,
+					                           x - area.x,
+					                           y - area.y);
+				}
+				if ( updated ? (pixel != expected) :
+				               (pixel != old || expected != old) ) {
+					printf("  %dx%d -> %d,%d %dx%d at %d degrees, "
+					       "pass %d: pixel %d,%d: %X, "
+					       "expected %X\n", w, h, area.x, area.y,
+					       area.w, area.h, rotation * 90, pass,
+					       x, y, pixel, expected);
+					++errors;
+				}
+			}
+		}
+	}
+
+	SDL_FreeSurface(src);
+	SDL_FreeSurface(dst);
+	SDL_FreeSurface(before);
+	return errors;
+}
+
+/* Formats SDL_GammaCopy() is checked with */
+static const struct {
+	const char *name;
+	Format format;
+} gammaformats[] = {
+	{ "RGB565", RGB565 },
+	{ "BGR565", BGR565 },
+	{ "RGB555", RGB555 },
+	{ "ARGB4444", { 16, 0x0F00, 0x00F0, 0x000F, 0xF000 } },
+	{ "RGB24", RGB24 },
+	{ "ARGB8888", ARGB8888 },
+};
+
+/* The tables applied to each colour field, other bits are kept */
+static Uint32 GammaExpected(const SDL_PixelFormat *fmt,
+                            const SDL_GammaLUT *lut, Uint32 pixel)
+{
+	Uint32 r, g, b;
+
+	r = lut->r[((pixel & fmt->Rmask) >> fmt->Rshift) << fmt->Rloss];
+	g = lut->g[((pixel & fmt->Gmask) >> fmt->Gshift) << fmt->Gloss];
+	b = lut->b[((pixel & fmt->Bmask) >> fmt->Bshift) << fmt->Bloss];
+	return (pixel & ~(fmt->Rmask | fmt->Gmask | fmt->Bmask)) |
+	       ((r >> fmt->Rloss) << fmt->Rshift) |
+	       ((g >> fmt->Gloss) << fmt->Gshift) |
+	       ((b >> fmt->Bloss) << fmt->Bshift);
+}
+
+/* Run a w x h block through SDL_GammaCopy(), first into another surface
+   and then in place, and compare every pixel.  The pixels around the
+   block must stay as they were. */
+static int CheckGammaCopy(const Format *format, int w, int h,
+                          const SDL_GammaLUT *lut)
+{
+	SDL_Surface *src, *dst, *before, *target;
+	const SDL_PixelFormat *fmt;
+	int pass, x, y, bpp, errors = 0;
+
+	src = CreatePresentSurface(format, w + 2, h + 2);
+	dst = CreatePresentSurface(format, w + 2, h + 2);
+	before = CreatePresentSurface(format, w + 2, h + 2);
+	fmt = src->format;
+	bpp = fmt->BytesPerPixel;
+
+	for ( pass = 0; pass < 2 && !errors; ++pass ) {
+		target = pass ? src : dst;
+		memcpy(before->pixels, target->pixels, target->h * target->pitch);
+		SDL_GammaCopy(lut, fmt,
+		              (Uint8 *)src->pixels + src->pitch + bpp, src->pitch,
+		              (Uint8 *)target->pixels + target->pitch + bpp,
+		              target->pitch, w, h);
+		for ( y = 0; y < h + 2 && !errors; ++y ) {
+			for ( x = 0; x < w + 2 && !errors; ++x ) {
+				Uint32 old = GetPixel(before, x, y);
+				Uint32 expected = old;
+				Uint32 pixel = GetPixel(target, x, y);
+
+				if ( x >= 1 && y >= 1 && x <= w && y <= h ) {
+					expected = GammaExpected(fmt, lut,
+						GetPixel(pass ? before : src, x, y));
+				}
+				if ( pixel != expected ) {
+					printf("  %dx%d %s, pixel %d,%d: %X, "
+					       "expected %X\n", w, h,
+					       pass ? "in place" : "copy",
+					       x, y, pixel, expected);
+					++errors;
+				}
+			}
+		}
+	}
+
+	SDL_FreeSurface(src);
+	SDL_FreeSurface(dst);
+	SDL_FreeSurface(before);
+	return errors;
+}
+
+/* SDL_GammaRotateRect() must give the same pixels as SDL_RotateRect() of
+   the block after SDL_GammaCopy(), and leave the rest alone */
+static int CheckGammaRotate(const Format *format, int w, int h,
+                            int rotation, const SDL_GammaLUT *lut)
+{
+	SDL_Surface *src, *corrected, *dst, *expected;
+	const SDL_PixelFormat *fmt;
+	SDL_Rect rect;
+	int rot_w, rot_h, y, errors = 0;
+
+	rot_w = (rotation & 1) ? h : w;
+	rot_h = (rotation & 1) ? w : h;
+	src = CreatePresentSurface(format, w, h);
+	corrected = CreatePresentSurface(format, w, h);
+	dst = CreatePresentSurface(format, rot_w, rot_h);
+	expected = CreatePresentSurface(format, rot_w, rot_h);
+	fmt = src->format;
+	memcpy(expected->pixels, dst->pixels, dst->h * dst->pitch);
+
+	rect.x = 1;
+	rect.y = 2;
+	rect.w = w - 3;
+	rect.h = h - 2;
+	SDL_GammaCopy(lut, fmt, (Uint8 *)src->pixels, src->pitch,
+	              (Uint8 *)corrected->pixels, corrected->pitch, w, h);
+	SDL_RotateRect(corrected->pixels, corrected->pitch,
+	               expected->pixels, expected->pitch, fmt->BytesPerPixel,
+	               w, h, &rect, rotation);
+	SDL_GammaRotateRect(lut, fmt, src->pixels, src->pitch,
+	                    dst->pixels, dst->pitch, w, h, &rect, rotation);
+
+	for ( y = 0; y < rot_h && !errors; ++y ) {
+		if ( memcmp((Uint8 *)dst->pixels + y * dst->pitch,
+		            (Uint8 *)expected->pixels + y * expected->pitch,
+		            rot_w * fmt->BytesPerPixel) != 0 ) {
+			printf("  %dx%d at %d degrees: row %d differs\n",
+			       w, h, rotation * 90, y);
+			++errors;
+		}
+	}
+
+	SDL_FreeSurface(src);
+	SDL_FreeSurface(corrected);
+	SDL_FreeSurface(dst);
+	SDL_FreeSurface(expected);
+	return errors;
+}
+
+int main(int argc, char *argv[])
+{
+	int i, j, w, offset, a, errors, failed = 0;
+
+	if ( SDL_Init(0) < 0 ) {
+		fprintf(stderr, "Couldn't initialize SDL: %s\n", SDL_GetError());
+		return(2);
+	}
+	/* The RLE checks use short runs, which are otherwise left unencoded */
+	SDL_putenv("SDL_RLE_HEURISTIC=0");
+
+	for ( i = 0; i < (int)SDL_arraysize(cases); ++i ) {
+		const BlitCase *test = &cases[i];
+		int numalphas = (test->mode == BLIT_SURFACE_ALPHA ||
+		                 test->mode == BLIT_KEY_SURFACE_ALPHA) ?
+		                SDL_arraysize(alphas) : 1;
+
+		errors = 0;
+		for ( w = 0; w < (int)SDL_arraysize(widths); ++w ) {
+			for ( offset = 0; offset < 4; ++offset ) {
+				for ( a = 0; a < numalphas; ++a ) {
+					errors += CheckCase(test, widths[w],
+					                    offset, alphas[a]);
+				}
+			}
+		}
+		printf("%-36s %-6s %s\n", test->name,
+		       errors ? "FAILED" : "ok", blitter ? blitter : "?");
+		if ( errors ) {
+			++failed;
+		}
+	}
+
+	for ( i = 0; i < (int)SDL_arraysize(formats); ++i ) {
+		for ( j = 0; j < (int)SDL_arraysize(formats); ++j ) {
+			char name[64];
+
+			if ( i == j ) {
+				continue;
+			}
+			errors = 0;
+			for ( w = 0; w < (int)SDL_arraysize(widths); ++w ) {
+				for ( offset = 0; offset < 4; ++offset ) {
+					errors += CheckGenerated(&formats[i].format,
+					                         &formats[j].format,
+					                         widths[w], offset);
+				}
+			}
+			SDL_snprintf(name, sizeof(name), "%s -> %s generated",
+			             formats[i].name, formats[j].name);
+			printf("%-36s %s\n", name, errors ? "FAILED" : "ok");
+			if ( errors ) {
+				++failed;
+			}
+		}
+	}
+	SDL_putenv("SDL_BLIT_GENERATED=1");
+
+	for ( i = 0; i < (int)SDL_arraysize(batches); ++i ) {
+		for ( j = 0; j < 2; ++j ) {
+			char name[64];
+
+			errors = CheckBatch(&batches[i].src, &batches[i].dst,
+			                    batches[i].flags,
+			                    j ? SDL_BLITBATCH_SORT : 0);
+			SDL_snprintf(name, sizeof(name), "%s%s",
+			             batches[i].name, j ? " sorted" : "");
+			printf("%-36s %s\n", name, errors ? "FAILED" : "ok");
+			if ( errors ) {
+				++failed;
+			}
+		}
+	}
+
+	for ( i = 0; i < (int)SDL_arraysize(stretches); ++i ) {
+		errors = CheckStretchNearest(&stretches[i].src, &stretches[i].dst,
+		                             stretches[i].flags);
+		printf("%-36s %s\n", stretches[i].name,
+		       errors ? "FAILED" : "ok");
+		if ( errors ) {
+			++failed;
+		}
+	}
+	errors = CheckStretchBilinear();
+	printf("%-36s %s\n", "ARGB8888 bilinear stretch",
+	       errors ? "FAILED" : "ok");
+	if ( errors ) {
+		++failed;
+	}
+	errors = CheckStretchInteger();
+	printf("%-36s %s\n", "RGB565 integer stretch",
+	       errors ? "FAILED" : "ok");
+	if ( errors ) {
+		++failed;
+	}
+
+	for ( i = 0; i < 2; ++i ) {
+		static const Format rledst[] = { RGB888, BGR888 };
+
+		errors = CheckRLEAlpha(&rledst[i]);
+		printf("%-36s %s\n", i ? "ARGB8888 -> BGR888 RLE alpha" :
+		                            "ARGB8888 -> RGB888 RLE alpha",
+		       errors ? "FAILED" : "ok");
+		if ( errors ) {
+			++failed;
+		}
+	}
+	errors = CheckRLELock();
+	printf("%-36s %s\n", "RGB565 RLE read only lock",
+	       errors ? "FAILED" : "ok");
+	if ( errors ) {
+		++failed;
+	}
+	errors = CheckRLEBackground();
+	printf("%-36s %s\n", "RGB565 RLE background encoding",
+	       errors ? "FAILED" : "ok");
+	if ( errors ) {
+		++failed;
+	}
+
+	errors = 0;
+	for ( i = 1; i <= 4; ++i ) {
+		static const SDL_Rect rects[] = {
+			{ 0, 0, 37, 23 }, { 3, 5, 29, 11 }, { 36, 0, 1, 23 }
+		};
+
+		errors += CheckRotate(i, 1, 1, rects[0], SDL_PRESENT_ROTATE_90);
+		errors += CheckRotate(i, 5, 130, rects[1], SDL_PRESENT_ROTATE_270);
+		errors += CheckRotate(i, 64, 64, rects[1], SDL_PRESENT_ROTATE_180);
+		for ( j = 0; j < (int)SDL_arraysize(rects); ++j ) {
+			for ( a = SDL_PRESENT_ROTATE_0;
+			      a <= SDL_PRESENT_ROTATE_270; ++a ) {
+				errors += CheckRotate(i, 37, 23, rects[j], a);
+				errors += CheckRotate(i, 67, 45, rects[j], a);
+			}
+		}
+	}
+	printf("%-36s %s\n", "rotated copies", errors ? "FAILED" : "ok");
+	if ( errors ) {
+		++failed;
+	}
+	for ( i = 0; i < (int)SDL_arraysize(presents); ++i ) {
+		const PresentCase *test = &presents[i];
+		SDL_GammaLUT lut;
+		Uint16 ramp[3*256];
+
+		errors = 0;
+		for ( a = SDL_PRESENT_ROTATE_0; a <= SDL_PRESENT_ROTATE_270; ++a ) {
+			SDL_Rect area = test->area;
+
+			/* The unscaled cases keep the size for every rotation */
+			if ( (a & 1) && test->dw == test->dh &&
+			     area.w == test->w && area.h == test->h ) {
+				area.x = area.y;
+				area.y = 0;
+				area.w = test->h;
+				area.h = test->w;
+			}
+			errors += CheckPresent(&test->src, &test->dst,
+			                       test->w, test->h, test->dw, test->dh,
+			                       area, a, test->filter, NULL);
+		}
+		for ( j = 0; j < 3*256; ++j ) {
+			ramp[j] = (Uint16)(((j % 256) ^ (j / 256 * 0x55)) * 257);
+		}
+		SDL_BuildGammaLUT(&lut, ramp);
+		errors += CheckPresent(&test->src, &test->dst, test->w, test->h,
+		                       test->dw, test->dh, test->area,
+		                       SDL_PRESENT_ROTATE_0, test->filter, &lut);
+		errors += CheckPresent(&test->src, &test->dst, test->w, test->h,
+		                       test->dw, test->dh, test->area,
+		                       SDL_PRESENT_ROTATE_90, test->filter, &lut);
+		printf("%-36s %s\n", test->name, errors ? "FAILED" : "ok");
+		if ( errors ) {
+			++failed;
+		}
+	}
+	for ( i = 0; i < (int)SDL_arraysize(gammaformats); ++i ) {
+		static const int gammawidths[] = { 1, 15, 16, 17, 40, 71 };
+		SDL_GammaLUT lut;
+		Uint16 ramp[3*256];
+		char name[64];
+
+		for ( j = 0; j < 3*256; ++j ) {
+			ramp[j] = (Uint16)(Random() & 0xFFFF);
+		}
+		SDL_BuildGammaLUT(&lut, ramp);
+		errors = 0;
+		for ( w = 0; w < (int)SDL_arraysize(gammawidths); ++w ) {
+			errors += CheckGammaCopy(&gammaformats[i].format,
+			                         gammawidths[w], 3, &lut);
+		}
+		for ( a = SDL_PRESENT_ROTATE_0; a <= SDL_PRESENT_ROTATE_270; ++a ) {
+			errors += CheckGammaRotate(&gammaformats[i].format,
+			                           37, 45, a, &lut);
+		}
+		SDL_snprintf(name, sizeof(name), "%s gamma copy",
+		             gammaformats[i].name);
+		printf("%-36s %s\n", name, errors ? "FAILED" : "ok");
+		if ( errors ) {
+			++failed;
+		}
+	}
+
+	/* The overlays need a video mode, any will do */
+	SDL_putenv("SDL_VIDEODRIVER=dummy");
+	if ( (SDL_InitSubSystem(SDL_INIT_VIDEO) < 0) ||
+	     !SDL_SetVideoMode(640, 480, 32, SDL_SWSURFACE) ) {
+		fprintf(stderr, "Couldn't set video mode: %s\n", SDL_GetError());
+		return(2);
+	}
+	for ( i = 0; i < (int)SDL_arraysize(yuvformats); ++i ) {
+		for ( j = 0; j < (int)SDL_arraysize(yuvdisplays); ++j ) {
+			char name[64];
+
+			errors = CheckYUV(i, &yuvdisplays[j].format, 16, 2, 1);
+			errors += CheckYUV(i, &yuvdisplays[j].format, 36, 6, 1);
+			errors += CheckYUV(i, &yuvdisplays[j].format, 36, 6, 2);
+			/* Large enough to be converted in bands by 4 threads */
+			SDL_SetBlitThreads(4);
+			errors += CheckYUV(i, &yuvdisplays[j].format, 320, 210, 1);
+			errors += CheckYUV(i, &yuvdisplays[j].format, 200, 164, 2);
+			SDL_SetBlitThreads(0);
+			SDL_snprintf(name, sizeof(name), "%s -> %s overlay",
+			             yuvformats[i].name, yuvdisplays[j].name);
+			printf("%-36s %s\n", name, errors ? "FAILED" : "ok");
+			if ( errors ) {
+				++failed;
+			}
+		}
+	}
+	for ( i = 0; i < (int)SDL_arraysize(yuvformats); ++i ) {
+		for ( j = 0; j < (int)SDL_arraysize(yuvdisplays); ++j ) {
+			static const SDL_Rect rects[] = {
+				{ 1, 0, 50, 9 }, { 1, 0, 17, 4 },
+				{ -5, -3, 36, 6 }, { -7, -1, 61, 9 }
+			};
+			char name[64];
+			int r;
+
+			errors = 0;
+			for ( r = 0; r < (int)SDL_arraysize(rects); ++r ) {
+				errors += CheckYUVScaled(i, &yuvdisplays[j].format,
+				                         36, 6, rects[r]);
+			}
+			SDL_SetBlitThreads(4);
+			{
+				SDL_Rect large = { 0, 0, 400, 300 };
+
+				errors += CheckYUVScaled(i, &yuvdisplays[j].format,
+				                         320, 210, large);
+			}
+			SDL_SetBlitThreads(0);
+			SDL_snprintf(name, sizeof(name), "%s -> %s scaled overlay",
+			             yuvformats[i].name, yuvdisplays[j].name);
+			printf("%-36s %s\n", name, errors ? "FAILED" : "ok");
+			if ( errors ) {
+				++failed;
+			}
+		}
+	}
+
+	SDL_Quit();
+	return(failed ? 1 : 0);
+}
@@ -2,6 +2,13 @@
  * Benchmarks surface-to-surface blits in various formats.
  *
  *  Written by Ryan C. Gordon.
+ *
+ * With --matrix, every pair of common formats is blitted in every mode
+ *  and at several sizes on the dummy video driver, and the results are
+ *  printed as CSV (or JSON with --json) for comparing runs:
+ *
+ *    testblitspeed --matrix [--json] [--ms 50] [--seed 1]
+ *                  [--src RGB565] [--dst ARGB8888] [--mode key+rle]
  */
 
 #include <stdio.h>
@@ -405,9 +412,343 @@ static void test_blit_speed(void)
             (int) (((float)iterations) / (((float)elasped) / 1000.0f)));
 }
 
+/* The matrix benchmark. */
+
+typedef struct
+{
+    const char *name;
+    int bpp;
+    Uint32 rmask, gmask, bmask, amask;
+} MatrixFormat;
+
+static const MatrixFormat matrixFormats[] =
+{
+    { "INDEX8",   8,  0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+    { "RGB565",   16, 0x0000F800, 0x000007E0, 0x0000001F, 0x00000000 },
+    { "RGB555",   16, 0x00007C00, 0x000003E0, 0x0000001F, 0x00000000 },
+    { "RGB24",    24, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000 },
+    { "BGR24",    24, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000 },
+    { "RGB888",   32, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000 },
+    { "BGR888",   32, 0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000 },
+    { "ARGB8888", 32, 0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000 },
+    { "ABGR8888", 32, 0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000 },
+    { "RGBA8888", 32, 0xFF000000, 0x00FF0000, 0x0000FF00, 0x000000FF },
+    { "BGRA8888", 32, 0x0000FF00, 0x00FF0000, 0xFF000000, 0x000000FF },
+};
+
+#define MODE_KEY        0x01
+#define MODE_ALPHA      0x02  /* surface alpha, for sources without alpha */
+#define MODE_PIXELALPHA 0x04  /* for sources with alpha */
+#define MODE_RLE        0x08
+
+typedef struct
+{
+    const char *name;
+    int flags;
+} MatrixMode;
+
+static const MatrixMode matrixModes[] =
+{
+    { "copy",           0 },
+    { "key",            MODE_KEY },
+    { "key+rle",        MODE_KEY | MODE_RLE },
+    { "alpha",          MODE_ALPHA },
+    { "key+alpha",      MODE_KEY | MODE_ALPHA },
+    { "key+alpha+rle",  MODE_KEY | MODE_ALPHA | MODE_RLE },
+    { "pixelalpha",     MODE_PIXELALPHA },
+    { "pixelalpha+rle", MODE_PIXELALPHA | MODE_RLE },
+};
+
+static const int matrixSizes[][2] =
+{
+    { 8, 8 }, { 16, 16 }, { 64, 64 }, { 256, 256 }, { 640, 480 }
+};
+
+/* Our own generator, so a seed gives the same pixels everywhere. */
+static Uint32 matrixSeed = 1;
+
+static Uint32 matrixRandom(void)
+{
+    matrixSeed ^= matrixSeed << 13;
+    matrixSeed ^= matrixSeed >> 17;
+    matrixSeed ^= matrixSeed << 5;
+    return(matrixSeed);
+}
+
+static void putPixel(SDL_Surface *surface, int x, int y, Uint32 pixel)
+{
+    Uint8 *p = (Uint8 *) surface->pixels + y * surface->pitch +
+               x * surface->format->BytesPerPixel;
+
+    switch (surface->format->BytesPerPixel)
+    {
+        case 1:
+            *p = (Uint8) pixel;
+            break;
+        case 2:
+            *(Uint16 *) p = (Uint16) pixel;
+            break;
+        case 3:
+            #if SDL_BYTEORDER == SDL_LIL_ENDIAN
+            p[0] = (Uint8) pixel;
+            p[1] = (Uint8) (pixel >> 8);
+            p[2] = (Uint8) (pixel >> 16);
+            #else
+            p[0] = (Uint8) (pixel >> 16);
+            p[1] = (Uint8) (pixel >> 8);
+            p[2] = (Uint8) pixel;
+            #endif
+            break;
+        case 4:
+            *(Uint32 *) p = pixel;
+            break;
+    }
+}
+
+/*
+ * Sprite-like pixels: runs of the colour key, or of transparent, opaque
+ *  and translucent pixels with per-pixel alpha.
+ */
+static void fillMatrixSource(SDL_Surface *surface, Uint32 key)
+{
+    int x, y;
+
+    for (y = 0; y < surface->h; y++)
+    {
+        for (x = 0; x < surface->w; x++)
+        {
+            Uint32 r = matrixRandom();
+            Uint8 a;
+
+            switch ((x / 8 + y / 4) % 3)
+            {
+                case 0: a = 0; break;
+                case 1: a = 255; break;
+                default: a = (Uint8) (r >> 24); break;
+            }
+
+            if (a == 0)
+                putPixel(surface, x, y, key);
+            else
+            {
+                Uint32 pixel = SDL_MapRGBA(surface->format, (Uint8) r,
+                                           (Uint8) (r >> 8),
+                                           (Uint8) (r >> 16), a);
+                if (pixel == key)
+                    pixel ^= 1;
+                putPixel(surface, x, y, pixel);
+            }
+        }
+    }
+}
+
+static void fillMatrixDest(SDL_Surface *surface)
+{
+    int x, y;
+
+    for (y = 0; y < surface->h; y++)
+    {
+        for (x = 0; x < surface->w; x++)
+        {
+            Uint32 r = matrixRandom();
+            putPixel(surface, x, y,
+                     SDL_MapRGBA(surface->format, (Uint8) r, (Uint8) (r >> 8),
+                                 (Uint8) (r >> 16), (Uint8) (r >> 24)));
+        }
+    }
+}
+
+static SDL_Surface *createMatrixSurface(const MatrixFormat *format, int w, int h)
+{
+    return(SDL_CreateRGBSurface(SDL_SWSURFACE, w, h, format->bpp,
+                                format->rmask, format->gmask,
+                                format->bmask, format->amask));
+}
+
+/*
+ * Blit for at least 'ms' milliseconds, doubling the number of blits
+ *  between clock reads so tiny blits aren't swamped by SDL_GetTicks().
+ *  Returns the number of blits, or 0 if the combination isn't supported.
+ */
+static Uint32 runMatrixCase(SDL_Surface *srcsurf, SDL_Surface *dstsurf,
+                            int ms, Uint32 *elapsed)
+{
+    Uint32 blits = 0;
+    Uint32 batch = 1;
+    Uint32 i;
+    SDL_Rect dstRect;
+
+    dstRect.x = dstRect.y = 0;
+    if (SDL_BlitSurface(srcsurf, NULL, dstsurf, &dstRect) < 0)
+        return(0);
+
+    *elapsed = 0;
+    do
+    {
+        Uint32 start = SDL_GetTicks();
+        for (i = 0; i < batch; i++)
+        {
+            dstRect.x = dstRect.y = 0;
+            SDL_BlitSurface(srcsurf, NULL, dstsurf, &dstRect);
+        }
+        *elapsed += SDL_GetTicks() - start;
+        blits += batch;
+        if (batch < 0x10000)
+            batch *= 2;
+    } while (*elapsed < (Uint32) ms);
+
+    return(blits);
+}
+
+static int run_matrix(int argc, char **argv)
+{
+    const char *onlysrc = NULL;
+    const char *onlydst = NULL;
+    const char *onlymode = NULL;
+    int json = 0;
+    int ms = 50;
+    int first = 1;
+    int i, s, d, m, z;
+
+    for (i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+
+        if (strcmp(arg, "--json") == 0)
+            json = 1;
+        else if (strcmp(arg, "--csv") == 0)
+            json = 0;
+        else if ((strcmp(arg, "--ms") == 0) && (i + 1 < argc))
+            ms = atoi(argv[++i]);
+        else if ((strcmp(arg, "--seed") == 0) && (i + 1 < argc))
+            matrixSeed = (Uint32) atoi_hex(argv[++i]);
+        else if ((strcmp(arg, "--src") == 0) && (i + 1 < argc))
+            onlysrc = argv[++i];
+        else if ((strcmp(arg, "--dst") == 0) && (i + 1 < argc))
+            onlydst = argv[++i];
+        else if ((strcmp(arg, "--mode") == 0) && (i + 1 < argc))
+            onlymode = argv[++i];
+    }
+    if (matrixSeed == 0)
+        matrixSeed = 1;
+    if (ms < 1)
+        ms = 1;
+
+    /* Headless unless asked otherwise. */
+    if (getenv("SDL_VIDEODRIVER") == NULL)
+        SDL_putenv("SDL_VIDEODRIVER=dummy");
+    /* Encode RLE surfaces before the first blit returns, so the plain
+       blitter isn't timed while the encoding waits in the background. */
+    SDL_putenv("SDL_RLE_ASYNC=0");
+    if (SDL_Init(SDL_INIT_VIDEO) == -1)
+    {
+        fprintf(stderr, "SDL_Init failed: %s\n", SDL_GetError());
+        return(0);
+    }
+
+    if (json)
+        printf("[\n");
+    else
+        printf("src,dst,mode,width,height,kernel,blits,ms,mpixels_per_s\n");
+
+    for (s = 0; s < (int) SDL_arraysize(matrixFormats); s++)
+    for (d = 0; d < (int) SDL_arraysize(matrixFormats); d++)
+    for (m = 0; m < (int) SDL_arraysize(matrixModes); m++)
+    for (z = 0; z < (int) SDL_arraysize(matrixSizes); z++)
+    {
+        const MatrixFormat *sf = &matrixFormats[s];
+        const MatrixFormat *df = &matrixFormats[d];
+        const MatrixMode *mode = &matrixModes[m];
+        int w = matrixSizes[z][0];
+        int h = matrixSizes[z][1];
+        SDL_Surface *srcsurf;
+        SDL_Surface *dstsurf;
+        const char *kernel;
+        Uint32 key = 0;
+        Uint32 blits, elapsed = 0;
+        double rate;
+
+        if ((mode->flags & MODE_PIXELALPHA) ? !sf->amask :
+            (sf->amask && (mode->flags & MODE_ALPHA)))
+            continue;
+        if ((onlysrc && strcmp(onlysrc, sf->name)) ||
+            (onlydst && strcmp(onlydst, df->name)) ||
+            (onlymode && strcmp(onlymode, mode->name)))
+            continue;
+
+        srcsurf = createMatrixSurface(sf, w, h);
+        dstsurf = createMatrixSurface(df, w, h);
+        if ((srcsurf == NULL) || (dstsurf == NULL))
+        {
+            fprintf(stderr, "surface creation failed: %s\n", SDL_GetError());
+            SDL_Quit();
+            return(0);
+        }
+
+        if (mode->flags & MODE_KEY)
+            key = SDL_MapRGB(srcsurf->format, 0xFF, 0x00, 0xFF);
+        fillMatrixSource(srcsurf, key);
+        fillMatrixDest(dstsurf);
+
+        SDL_SetAlpha(srcsurf, 0, SDL_ALPHA_OPAQUE);
+        if (mode->flags & MODE_KEY)
+            SDL_SetColorKey(srcsurf, SDL_SRCCOLORKEY |
+                            ((mode->flags & MODE_RLE) ? SDL_RLEACCEL : 0), key);
+        if (mode->flags & MODE_ALPHA)
+            SDL_SetAlpha(srcsurf, SDL_SRCALPHA |
+                         ((mode->flags & MODE_RLE) ? SDL_RLEACCEL : 0), 128);
+        if (mode->flags & MODE_PIXELALPHA)
+            SDL_SetAlpha(srcsurf, SDL_SRCALPHA |
+                         ((mode->flags & MODE_RLE) ? SDL_RLEACCEL : 0), 255);
+
+        blits = runMatrixCase(srcsurf, dstsurf, ms, &elapsed);
+        kernel = SDL_GetBlitName(srcsurf, dstsurf);
+        if (kernel == NULL)
+            kernel = "unknown";
+        SDL_FreeSurface(srcsurf);
+        SDL_FreeSurface(dstsurf);
+        if (blits == 0)
+            continue;  /* not supported */
+
+        rate = ((double) blits * w * h) / ((double) elapsed * 1000.0);
+        if (json)
+        {
+            printf("%s  { \"src\": \"%s\", \"dst\": \"%s\", \"mode\": \"%s\", "
+                   "\"width\": %d, \"height\": %d, \"kernel\": \"%s\", "
+                   "\"blits\": %u, \"ms\": %u, \"mpixels_per_s\": %.2f }",
+                   first ? "" : ",\n", sf->name, df->name, mode->name,
+                   w, h, kernel, (unsigned int) blits,
+                   (unsigned int) elapsed, rate);
+        }
+        else
+        {
+            printf("%s,%s,%s,%d,%d,%s,%u,%u,%.2f\n",
+                   sf->name, df->name, mode->name, w, h, kernel,
+                   (unsigned int) blits, (unsigned int) elapsed, rate);
+        }
+        fflush(stdout);
+        first = 0;
+    }
+
+    if (json)
+        printf("\n]\n");
+
+    SDL_Quit();
+    return(1);
+}
+
 int main(int argc, char **argv)
 {
-    int initialized = setup_test(argc, argv);
+    int initialized;
+    int i;
+
+    for (i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--matrix") == 0)
+            return(!run_matrix(argc, argv));
+    }
+
+    initialized = setup_test(argc, argv);
     if (initialized)
     {
         test_blit_speed();